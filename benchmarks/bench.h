@@ -0,0 +1,188 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+
+/**
+ * @file bench.h
+ * @brief The grammar symbols, inputs and probes shared by the benchmarks of `parsix_bench` (the grammars themselves are in grammars.h).
+ * @details The grammar symbols (and their `toString()` functions) are declared before any parsix header is included, since the library names them from within its templates.
+ */
+
+// EXPRESSION GRAMMAR SYMBOLS
+enum class ExprTerminal {
+	T_ID,
+	T_PLUS,
+	T_STAR,
+	T_LEFT_PAREN,
+	T_RIGHT_PAREN,
+	T_EOF,
+	T_EPSILON,
+	T_COUNT
+};
+
+/**
+ * @brief The non-terminals of the expression grammars: the LR one uses `NT_EP`, `NT_E`, `NT_T` and `NT_F`; the LL one (without left recursion) uses `NT_E`, `NT_E_TAIL`, `NT_T`, `NT_T_TAIL` and `NT_F`.
+ */
+enum class ExprVariable {
+	NT_EP,
+	NT_E,
+	NT_E_TAIL,
+	NT_T,
+	NT_T_TAIL,
+	NT_F,
+	NT_COUNT
+};
+
+std::string toString(ExprTerminal);
+std::string toString(ExprVariable);
+
+// JSON GRAMMAR SYMBOLS
+enum class JsonTerminal {
+	T_STRING,
+	T_NUMBER,
+	T_TRUE,
+	T_FALSE,
+	T_NULL,
+	T_LEFT_BRACE,
+	T_RIGHT_BRACE,
+	T_LEFT_BRACKET,
+	T_RIGHT_BRACKET,
+	T_COMMA,
+	T_COLON,
+	T_EOF,
+	T_EPSILON,
+	T_COUNT
+};
+
+/**
+ * @brief The non-terminals of the JSON grammars: the LR one uses all of them but the `_TAIL` ones; the LL one (without left recursion) uses all of them but `NT_START`.
+ */
+enum class JsonVariable {
+	NT_START,
+	NT_VALUE,
+	NT_OBJECT,
+	NT_MEMBERS,
+	NT_MEMBERS_TAIL,
+	NT_PAIR,
+	NT_ARRAY,
+	NT_ELEMENTS,
+	NT_ELEMENTS_TAIL,
+	NT_COUNT
+};
+
+std::string toString(JsonTerminal);
+std::string toString(JsonVariable);
+
+// GENERATED GRAMMAR SYMBOLS
+/**
+ * @brief The maximum number of statement kinds of a generated grammar (see `make_generated_grammar()`).
+ */
+inline constexpr size_t MAX_STATEMENT_KINDS = 128;
+
+/**
+ * @brief The terminals of the generated grammars; keyword `i` is `T_KEYWORD + i`.
+ */
+enum class GenTerminal : size_t {
+	T_ID,
+	T_SEMI,
+	T_ASSIGN,
+	T_LEFT_PAREN,
+	T_RIGHT_PAREN,
+	T_PLUS,
+	T_STAR,
+	T_EOF,
+	T_EPSILON,
+	T_KEYWORD,
+	T_COUNT = T_KEYWORD + MAX_STATEMENT_KINDS
+};
+
+/**
+ * @brief The non-terminals of the generated grammars; the statement of kind `i` is `NT_KIND + i`.
+ */
+enum class GenVariable : size_t {
+	NT_START,
+	NT_PROGRAM,
+	NT_STATEMENT,
+	NT_E,
+	NT_T,
+	NT_F,
+	NT_KIND,
+	NT_COUNT = NT_KIND + MAX_STATEMENT_KINDS
+};
+
+std::string toString(GenTerminal);
+std::string toString(GenVariable);
+
+#include "parsix/PDataStructs.h"
+#include "parsix/StreamingLexer.h"
+
+namespace m0st4fa::parsix::bench {
+
+	/**
+	 * @brief The data of a state of the LR stack (and of the records of the LL stack).
+	 */
+	struct Value {
+		size_t value = 0;
+
+		operator std::string() const { return std::to_string(this->value); }
+		explicit operator bool() const { return true; }
+		bool operator==(const Value&) const = default;
+	};
+
+	/**
+	 * @brief The result of a parse.
+	 */
+	struct Result {
+		size_t value = 0;
+	};
+
+	/**
+	 * @brief Scans the tokens of the expression grammars: digit sequences are identifiers, and white space is skipped.
+	 */
+	struct ExprScanner {
+		ScanResult<ExprTerminal> operator()(std::string_view rest, bool atEnd) const noexcept(true);
+	};
+
+	/**
+	 * @brief Scans the tokens of the JSON grammars. Strings may contain escapes; numbers have an optional sign, fraction and exponent.
+	 */
+	struct JsonScanner {
+		ScanResult<JsonTerminal> operator()(std::string_view rest, bool atEnd) const noexcept(true);
+	};
+
+	using ExprLexer = StreamingLexer<ExprTerminal, ExprScanner>;
+	using JsonLexer = StreamingLexer<JsonTerminal, JsonScanner>;
+
+	std::string make_expression_source(size_t);
+	std::string make_json_source(size_t);
+
+	/**
+	 * @brief Counts the tokens of a source (without `TEOF`).
+	 */
+	template <typename TerminalT, typename ScanFnT>
+	size_t count_tokens(std::string_view source) {
+		ChunkedInput input = ChunkedInput::view(source);
+		StreamingLexer<TerminalT, ScanFnT> lexer{ input, ScanFnT{} };
+		size_t count = 0;
+
+		while (lexer.getNextToken().name != TerminalT::T_EOF)
+			count++;
+
+		return count;
+	}
+
+	/**
+	 * @brief The number of heap allocations (through the global `operator new`) and of allocated bytes since the program started.
+	 */
+	struct AllocationCount {
+		uint64_t allocations = 0;
+		uint64_t bytes = 0;
+	};
+
+	AllocationCount allocation_count() noexcept(true);
+	size_t peak_rss();
+
+}
@@ -0,0 +1,160 @@
+#include "grammars.h"
+
+namespace m0st4fa::parsix::bench {
+
+	/**
+	 * @brief Makes the (augmented, left-recursive) LR expression grammar:
+	 * @details E' -> E; E -> E + T | T; T -> T * F | F; F -> ( E ) | id.
+	 */
+	LRExprGrammar make_lr_expression_grammar()
+	{
+		using enum ExprTerminal;
+		using enum ExprVariable;
+		const auto T = terminal<ExprSymbol, ExprTerminal>;
+		const auto N = variable<ExprSymbol, ExprVariable>;
+
+		LRExprGrammar grammar;
+		push_production(grammar, N(NT_EP), { N(NT_E) });
+		push_production(grammar, N(NT_E), { N(NT_E), T(T_PLUS), N(NT_T) });
+		push_production(grammar, N(NT_E), { N(NT_T) });
+		push_production(grammar, N(NT_T), { N(NT_T), T(T_STAR), N(NT_F) });
+		push_production(grammar, N(NT_T), { N(NT_F) });
+		push_production(grammar, N(NT_F), { T(T_LEFT_PAREN), N(NT_E), T(T_RIGHT_PAREN) });
+		push_production(grammar, N(NT_F), { T(T_ID) });
+
+		return grammar;
+	}
+
+	/**
+	 * @brief Makes the LL(1) expression grammar:
+	 * @details E -> T E_TAIL; E_TAIL -> + T E_TAIL | epsilon; T -> F T_TAIL; T_TAIL -> * F T_TAIL | epsilon; F -> ( E ) | id.
+	 */
+	LLExprGrammar make_ll_expression_grammar()
+	{
+		using enum ExprTerminal;
+		using enum ExprVariable;
+		const auto T = terminal<ExprSymbol, ExprTerminal>;
+		const auto N = variable<ExprSymbol, ExprVariable>;
+
+		LLExprGrammar grammar;
+		push_production(grammar, N(NT_E), { N(NT_T), N(NT_E_TAIL) });
+		push_production(grammar, N(NT_E_TAIL), { T(T_PLUS), N(NT_T), N(NT_E_TAIL) });
+		push_production(grammar, N(NT_E_TAIL), { T(T_EPSILON) });
+		push_production(grammar, N(NT_T), { N(NT_F), N(NT_T_TAIL) });
+		push_production(grammar, N(NT_T_TAIL), { T(T_STAR), N(NT_F), N(NT_T_TAIL) });
+		push_production(grammar, N(NT_T_TAIL), { T(T_EPSILON) });
+		push_production(grammar, N(NT_F), { T(T_LEFT_PAREN), N(NT_E), T(T_RIGHT_PAREN) });
+		push_production(grammar, N(NT_F), { T(T_ID) });
+
+		return grammar;
+	}
+
+	/**
+	 * @brief Makes the (augmented, left-recursive) LR JSON grammar:
+	 * @details START -> VALUE; VALUE -> OBJECT | ARRAY | string | number | true | false | null; OBJECT -> { } | { MEMBERS }; MEMBERS -> MEMBERS , PAIR | PAIR; PAIR -> string : VALUE; ARRAY -> [ ] | [ ELEMENTS ]; ELEMENTS -> ELEMENTS , VALUE | VALUE.
+	 */
+	LRJsonGrammar make_lr_json_grammar()
+	{
+		using enum JsonTerminal;
+		using enum JsonVariable;
+		const auto T = terminal<JsonSymbol, JsonTerminal>;
+		const auto N = variable<JsonSymbol, JsonVariable>;
+
+		LRJsonGrammar grammar;
+		push_production(grammar, N(NT_START), { N(NT_VALUE) });
+
+		for (const JsonVariable value : { NT_OBJECT, NT_ARRAY })
+			push_production(grammar, N(NT_VALUE), { N(value) });
+
+		for (const JsonTerminal value : { T_STRING, T_NUMBER, T_TRUE, T_FALSE, T_NULL })
+			push_production(grammar, N(NT_VALUE), { T(value) });
+
+		push_production(grammar, N(NT_OBJECT), { T(T_LEFT_BRACE), T(T_RIGHT_BRACE) });
+		push_production(grammar, N(NT_OBJECT), { T(T_LEFT_BRACE), N(NT_MEMBERS), T(T_RIGHT_BRACE) });
+		push_production(grammar, N(NT_MEMBERS), { N(NT_MEMBERS), T(T_COMMA), N(NT_PAIR) });
+		push_production(grammar, N(NT_MEMBERS), { N(NT_PAIR) });
+		push_production(grammar, N(NT_PAIR), { T(T_STRING), T(T_COLON), N(NT_VALUE) });
+		push_production(grammar, N(NT_ARRAY), { T(T_LEFT_BRACKET), T(T_RIGHT_BRACKET) });
+		push_production(grammar, N(NT_ARRAY), { T(T_LEFT_BRACKET), N(NT_ELEMENTS), T(T_RIGHT_BRACKET) });
+		push_production(grammar, N(NT_ELEMENTS), { N(NT_ELEMENTS), T(T_COMMA), N(NT_VALUE) });
+		push_production(grammar, N(NT_ELEMENTS), { N(NT_VALUE) });
+
+		return grammar;
+	}
+
+	/**
+	 * @brief Makes the LL(1) JSON grammar:
+	 * @details VALUE -> OBJECT | ARRAY | string | number | true | false | null; OBJECT -> { MEMBERS }; MEMBERS -> PAIR MEMBERS_TAIL | epsilon; MEMBERS_TAIL -> , PAIR MEMBERS_TAIL | epsilon; PAIR -> string : VALUE; ARRAY -> [ ELEMENTS ]; ELEMENTS -> VALUE ELEMENTS_TAIL | epsilon; ELEMENTS_TAIL -> , VALUE ELEMENTS_TAIL | epsilon.
+	 */
+	LLJsonGrammar make_ll_json_grammar()
+	{
+		using enum JsonTerminal;
+		using enum JsonVariable;
+		const auto T = terminal<JsonSymbol, JsonTerminal>;
+		const auto N = variable<JsonSymbol, JsonVariable>;
+
+		LLJsonGrammar grammar;
+
+		for (const JsonVariable value : { NT_OBJECT, NT_ARRAY })
+			push_production(grammar, N(NT_VALUE), { N(value) });
+
+		for (const JsonTerminal value : { T_STRING, T_NUMBER, T_TRUE, T_FALSE, T_NULL })
+			push_production(grammar, N(NT_VALUE), { T(value) });
+
+		push_production(grammar, N(NT_OBJECT), { T(T_LEFT_BRACE), N(NT_MEMBERS), T(T_RIGHT_BRACE) });
+		push_production(grammar, N(NT_MEMBERS), { N(NT_PAIR), N(NT_MEMBERS_TAIL) });
+		push_production(grammar, N(NT_MEMBERS), { T(T_EPSILON) });
+		push_production(grammar, N(NT_MEMBERS_TAIL), { T(T_COMMA), N(NT_PAIR), N(NT_MEMBERS_TAIL) });
+		push_production(grammar, N(NT_MEMBERS_TAIL), { T(T_EPSILON) });
+		push_production(grammar, N(NT_PAIR), { T(T_STRING), T(T_COLON), N(NT_VALUE) });
+		push_production(grammar, N(NT_ARRAY), { T(T_LEFT_BRACKET), N(NT_ELEMENTS), T(T_RIGHT_BRACKET) });
+		push_production(grammar, N(NT_ELEMENTS), { N(NT_VALUE), N(NT_ELEMENTS_TAIL) });
+		push_production(grammar, N(NT_ELEMENTS), { T(T_EPSILON) });
+		push_production(grammar, N(NT_ELEMENTS_TAIL), { T(T_COMMA), N(NT_VALUE), N(NT_ELEMENTS_TAIL) });
+		push_production(grammar, N(NT_ELEMENTS_TAIL), { T(T_EPSILON) });
+
+		return grammar;
+	}
+
+	/**
+	 * @brief Makes a (augmented) grammar of a statement language with `kinds` kinds of statements, to measure table construction against the size of the grammar.
+	 * @details START -> PROGRAM; PROGRAM -> PROGRAM STATEMENT | STATEMENT; STATEMENT -> KIND_i (for every kind i); KIND_i -> kw_i id ; | kw_i id = E ; | kw_i ( PROGRAM ); E -> E + T | T; T -> T * F | F; F -> ( E ) | id.
+	 * Every kind adds a terminal, a non-terminal and four productions.
+	 * @throws std::invalid_argument If `kinds` is `0` or larger than `MAX_STATEMENT_KINDS`.
+	 */
+	GenGrammar make_generated_grammar(size_t kinds)
+	{
+		using enum GenTerminal;
+		using enum GenVariable;
+		const auto T = terminal<GenSymbol, GenTerminal>;
+		const auto N = variable<GenSymbol, GenVariable>;
+
+		if (kinds == 0 || kinds > MAX_STATEMENT_KINDS)
+			throw std::invalid_argument(std::format("A generated grammar has between 1 and {} kinds of statements, not {}.", MAX_STATEMENT_KINDS, kinds));
+
+		GenGrammar grammar;
+		push_production(grammar, N(NT_START), { N(NT_PROGRAM) });
+		push_production(grammar, N(NT_PROGRAM), { N(NT_PROGRAM), N(NT_STATEMENT) });
+		push_production(grammar, N(NT_PROGRAM), { N(NT_STATEMENT) });
+
+		for (size_t kind = 0; kind < kinds; kind++) {
+			const GenSymbol keyword = T(GenTerminal((size_t)T_KEYWORD + kind));
+			const GenSymbol statement = N(GenVariable((size_t)NT_KIND + kind));
+
+			push_production(grammar, N(NT_STATEMENT), { statement });
+			push_production(grammar, statement, { keyword, T(T_ID), T(T_SEMI) });
+			push_production(grammar, statement, { keyword, T(T_ID), T(T_ASSIGN), N(NT_E), T(T_SEMI) });
+			push_production(grammar, statement, { keyword, T(T_LEFT_PAREN), N(NT_PROGRAM), T(T_RIGHT_PAREN) });
+		}
+
+		push_production(grammar, N(NT_E), { N(NT_E), T(T_PLUS), N(NT_T) });
+		push_production(grammar, N(NT_E), { N(NT_T) });
+		push_production(grammar, N(NT_T), { N(NT_T), T(T_STAR), N(NT_F) });
+		push_production(grammar, N(NT_T), { N(NT_F) });
+		push_production(grammar, N(NT_F), { T(T_LEFT_PAREN), N(NT_E), T(T_RIGHT_PAREN) });
+		push_production(grammar, N(NT_F), { T(T_ID) });
+
+		return grammar;
+	}
+
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include <format>
+#include <stdexcept>
+#include <vector>
+
+#include "bench.h"
+#include "parsix/PDataStructs.h"
+#include "parsix/stack.h"
+
+namespace m0st4fa::parsix::bench {
+
+	// LR GRAMMARS
+	template <typename SymbolT>
+	using LRGrammarType = ProductionVector<ProductionRecord<SymbolT, LRProductionElement<SymbolT>>>;
+
+	using ExprSymbol = Symbol<ExprTerminal, ExprVariable>;
+	using JsonSymbol = Symbol<JsonTerminal, JsonVariable>;
+	using GenSymbol = Symbol<GenTerminal, GenVariable>;
+
+	using LRExprGrammar = LRGrammarType<ExprSymbol>;
+	using LRJsonGrammar = LRGrammarType<JsonSymbol>;
+	using GenGrammar = LRGrammarType<GenSymbol>;
+
+	// LL GRAMMARS
+	template <typename SymbolT>
+	using LLElementType = LLStackElement<SymbolT, LLSynthesizedRecord<Value>, LLActionRecord<Value>>;
+
+	template <typename SymbolT>
+	using LLGrammarType = ProductionVector<ProductionRecord<SymbolT, LLElementType<SymbolT>>>;
+
+	using LLExprGrammar = LLGrammarType<ExprSymbol>;
+	using LLJsonGrammar = LLGrammarType<JsonSymbol>;
+
+	/**
+	 * @brief Makes a terminal symbol.
+	 */
+	template <typename SymbolT, typename TerminalT>
+	SymbolT terminal(TerminalT terminal) {
+		return SymbolT{ .isTerminal = true, .as = {.terminal = terminal } };
+	}
+
+	/**
+	 * @brief Makes a non-terminal symbol.
+	 */
+	template <typename SymbolT, typename VariableT>
+	SymbolT variable(VariableT variable) {
+		return SymbolT{ .isTerminal = false, .as = {.nonTerminal = variable } };
+	}
+
+	/**
+	 * @brief Appends a production to a grammar, numbering it by its index.
+	 */
+	template <typename GrammarT, typename SymbolT>
+	void push_production(GrammarT& grammar, const SymbolT& head, const std::vector<SymbolT>& body) {
+		using ProductionType = std::remove_cvref_t<decltype(grammar.at(0))>;
+		using ElementType = std::remove_cvref_t<decltype(ProductionType{}.prodBody.at(0))>;
+
+		std::vector<ElementType> elements;
+		elements.reserve(body.size());
+
+		for (const SymbolT& symbol : body) {
+			if constexpr (std::is_constructible_v<ElementType, SymbolT>)
+				elements.emplace_back(symbol);
+			else
+				elements.push_back(ElementType{ .type = ProdElementType::PET_GRAM_SYMBOL, .as = {.gramSymbol = symbol, .synRecord = {}, .actRecord = {} } });
+		}
+
+		grammar.pushProduction(ProductionType{ head, elements, grammar.size() });
+	}
+
+	LRExprGrammar make_lr_expression_grammar();
+	LLExprGrammar make_ll_expression_grammar();
+	LRJsonGrammar make_lr_json_grammar();
+	LLJsonGrammar make_ll_json_grammar();
+	GenGrammar make_generated_grammar(size_t);
+
+	/**
+	 * @brief Constructs the LL(1) parsing table of a grammar from its FIRST and FOLLOW sets. The library has no LL table builder; this is the textbook construction.
+	 * @throws std::logic_error If the grammar is not LL(1).
+	 */
+	template <typename TableT, typename GrammarT>
+	TableT make_ll_table(GrammarT grammar) {
+		using ProductionType = std::remove_cvref_t<decltype(grammar.at(0))>;
+		using SymbolType = decltype(ProductionType{}.prodHead);
+		using TerminalType = decltype(SymbolType{}.as.terminal);
+
+		grammar.calculateFIRST();
+		grammar.calculateFOLLOW();
+
+		TableT table;
+		table.grammar = grammar;
+
+		const auto set = [&table](const ProductionType& production, TerminalType terminal) {
+			LLTableEntry& entry = table.table[(size_t)production.prodHead.as.nonTerminal][(size_t)terminal];
+
+			if (not entry.isError && entry.prodIndex != production.prodNumber)
+				throw std::logic_error(std::format("The grammar is not LL(1): productions {} and {} conflict.", entry.prodIndex, production.prodNumber));
+
+			entry.isError = false;
+			entry.isEmpty = false;
+			entry.prodIndex = production.prodNumber;
+		};
+
+		for (const ProductionType& production : grammar) {
+			bool nullable = true;
+
+			// FIRST of the body
+			for (const auto& element : production.prodBody) {
+				if (element.type != ProdElementType::PET_GRAM_SYMBOL)
+					continue;
+
+				const SymbolType& symbol = element.as.gramSymbol;
+
+				if (symbol.isTerminal) {
+					if (symbol.as.terminal == TerminalType::T_EPSILON)
+						continue;
+
+					set(production, symbol.as.terminal);
+					nullable = false;
+					break;
+				}
+
+				for (const SymbolType& first : grammar.getFIRSTSet(symbol.as.nonTerminal))
+					if (first.as.terminal != TerminalType::T_EPSILON)
+						set(production, first.as.terminal);
+
+				if (not grammar.isNullable(symbol.as.nonTerminal)) {
+					nullable = false;
+					break;
+				}
+			}
+
+			if (nullable)
+				for (const SymbolType& follow : grammar.getFOLLOWSet(production.prodHead.as.nonTerminal))
+					set(production, follow.as.terminal);
+		}
+
+		return table;
+	}
+
+}
@@ -0,0 +1,206 @@
+#include <array>
+#include <format>
+#include <string>
+
+#include "bench.h"
+
+// SYMBOL NAMES
+std::string toString(ExprTerminal terminal)
+{
+	static constexpr std::array<const char*, (size_t)ExprTerminal::T_COUNT> names{ "id", "+", "*", "(", ")", "$", "epsilon" };
+
+	return names.at((size_t)terminal);
+}
+
+std::string toString(ExprVariable variable)
+{
+	static constexpr std::array<const char*, (size_t)ExprVariable::NT_COUNT> names{ "E'", "E", "E_TAIL", "T", "T_TAIL", "F" };
+
+	return names.at((size_t)variable);
+}
+
+std::string toString(JsonTerminal terminal)
+{
+	static constexpr std::array<const char*, (size_t)JsonTerminal::T_COUNT> names{ "string", "number", "true", "false", "null", "{", "}", "[", "]", ",", ":", "$", "epsilon" };
+
+	return names.at((size_t)terminal);
+}
+
+std::string toString(JsonVariable variable)
+{
+	static constexpr std::array<const char*, (size_t)JsonVariable::NT_COUNT> names{ "START", "VALUE", "OBJECT", "MEMBERS", "MEMBERS_TAIL", "PAIR", "ARRAY", "ELEMENTS", "ELEMENTS_TAIL" };
+
+	return names.at((size_t)variable);
+}
+
+std::string toString(GenTerminal terminal)
+{
+	static constexpr std::array<const char*, (size_t)GenTerminal::T_KEYWORD> names{ "id", ";", "=", "(", ")", "+", "*", "$", "epsilon" };
+
+	if (terminal < GenTerminal::T_KEYWORD)
+		return names[(size_t)terminal];
+
+	return std::format("kw{}", (size_t)terminal - (size_t)GenTerminal::T_KEYWORD);
+}
+
+std::string toString(GenVariable variable)
+{
+	static constexpr std::array<const char*, (size_t)GenVariable::NT_KIND> names{ "START", "PROGRAM", "STATEMENT", "E", "T", "F" };
+
+	if (variable < GenVariable::NT_KIND)
+		return names[(size_t)variable];
+
+	return std::format("KIND{}", (size_t)variable - (size_t)GenVariable::NT_KIND);
+}
+
+namespace m0st4fa::parsix::bench {
+
+	namespace {
+
+		/**
+		 * @brief Gets the length of the run of white space at the beginning of `text`.
+		 */
+		size_t white_space_length(std::string_view text) noexcept(true) {
+			const size_t length = text.find_first_not_of(" \t\r\n");
+
+			return length == std::string_view::npos ? text.size() : length;
+		}
+
+		/**
+		 * @brief Gets the length of the run of digits starting at `from` within `text`.
+		 */
+		size_t digits_length(std::string_view text, size_t from) noexcept(true) {
+			size_t end = from;
+
+			while (end < text.size() && text[end] >= '0' && text[end] <= '9')
+				end++;
+
+			return end - from;
+		}
+
+	}
+
+	/**
+	 * @details A token that reaches the end of `rest` is returned as is: the lexical analyzer then extends its window and scans it again if it might continue.
+	 */
+	ScanResult<ExprTerminal> ExprScanner::operator()(std::string_view rest, bool atEnd) const noexcept(true)
+	{
+		(void)atEnd;
+
+		switch (rest[0]) {
+		case ' ': case '\t': case '\r': case '\n':
+			return { white_space_length(rest), ExprTerminal::T_EPSILON };
+		case '+':
+			return { 1, ExprTerminal::T_PLUS };
+		case '*':
+			return { 1, ExprTerminal::T_STAR };
+		case '(':
+			return { 1, ExprTerminal::T_LEFT_PAREN };
+		case ')':
+			return { 1, ExprTerminal::T_RIGHT_PAREN };
+		default:
+			return { digits_length(rest, 0), ExprTerminal::T_ID };
+		}
+	}
+
+	/**
+	 * @details An unterminated string is not scanned (its length is `0`), so that the lexical analyzer extends its window if it can.
+	 */
+	ScanResult<JsonTerminal> JsonScanner::operator()(std::string_view rest, bool atEnd) const noexcept(true)
+	{
+		(void)atEnd;
+
+		constexpr auto keyword = [](std::string_view rest, std::string_view word, JsonTerminal name) -> ScanResult<JsonTerminal> {
+			return { rest.starts_with(word) ? word.size() : 0, name };
+		};
+
+		switch (rest[0]) {
+		case ' ': case '\t': case '\r': case '\n':
+			return { white_space_length(rest), JsonTerminal::T_EPSILON };
+		case '{':
+			return { 1, JsonTerminal::T_LEFT_BRACE };
+		case '}':
+			return { 1, JsonTerminal::T_RIGHT_BRACE };
+		case '[':
+			return { 1, JsonTerminal::T_LEFT_BRACKET };
+		case ']':
+			return { 1, JsonTerminal::T_RIGHT_BRACKET };
+		case ',':
+			return { 1, JsonTerminal::T_COMMA };
+		case ':':
+			return { 1, JsonTerminal::T_COLON };
+		case 't':
+			return keyword(rest, "true", JsonTerminal::T_TRUE);
+		case 'f':
+			return keyword(rest, "false", JsonTerminal::T_FALSE);
+		case 'n':
+			return keyword(rest, "null", JsonTerminal::T_NULL);
+		case '"':
+			for (size_t end = 1; end < rest.size(); end++) {
+				if (rest[end] == '\\')
+					end++;
+				else if (rest[end] == '"')
+					return { end + 1, JsonTerminal::T_STRING };
+			}
+
+			return { 0, JsonTerminal::T_STRING };
+		default: {
+			// -?digits(.digits)?([eE][+-]?digits)?
+			size_t length = rest[0] == '-' ? 1 : 0;
+			length += digits_length(rest, length);
+
+			if (length < rest.size() && rest[length] == '.')
+				length += 1 + digits_length(rest, length + 1);
+
+			if (length < rest.size() && (rest[length] == 'e' || rest[length] == 'E')) {
+				length++;
+
+				if (length < rest.size() && (rest[length] == '+' || rest[length] == '-'))
+					length++;
+
+				length += digits_length(rest, length);
+			}
+
+			return { length == 0 || rest[length - 1] == '-' ? 0 : length, JsonTerminal::T_NUMBER };
+		}
+		}
+	}
+
+	/**
+	 * @brief Makes an expression of (at least) `size` bytes: a sum of nested products and sums, one term per line.
+	 */
+	std::string make_expression_source(size_t size)
+	{
+		constexpr std::string_view term = "((12+3)*(45+6)+7*(8+9*(10+11)))*2+\n";
+
+		std::string source;
+		source.reserve(size + term.size());
+
+		while (source.size() < size)
+			source += term;
+
+		source += "1";
+
+		return source;
+	}
+
+	/**
+	 * @brief Makes a JSON document of (at least) `size` bytes: an array of records, one per line.
+	 */
+	std::string make_json_source(size_t size)
+	{
+		std::string source;
+		source.reserve(size + 256);
+		source += "[\n";
+
+		for (size_t id = 0; source.size() < size; id++)
+			source += std::format(
+				"{{\"id\": {}, \"name\": \"item \\\"{}\\\"\", \"price\": {}.{}e-2, \"tags\": [\"a\", \"b\", {{}}], \"valid\": {}, \"next\": null, \"empty\": []}},\n",
+				id, id, id * 7, id % 100, id % 2 == 0 ? "true" : "false");
+
+		source += "{}\n]";
+
+		return source;
+	}
+
+}
@@ -0,0 +1,80 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <windows.h>
+#	include <psapi.h>
+#else
+#	include <sys/resource.h>
+#endif
+
+#include "bench.h"
+
+/**
+ * @file memory.cpp
+ * @brief Counts the heap allocations of the whole program by replacing the global (non-aligned) `operator new` and `operator delete`, and gets its peak resident set size.
+ */
+
+namespace {
+
+	std::atomic<uint64_t> g_Allocations{ 0 };
+	std::atomic<uint64_t> g_AllocatedBytes{ 0 };
+
+	void* counted_allocation(size_t size) {
+		g_Allocations.fetch_add(1, std::memory_order_relaxed);
+		g_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+		if (void* memory = std::malloc(size == 0 ? 1 : size))
+			return memory;
+
+		throw std::bad_alloc{};
+	}
+
+}
+
+void* operator new(size_t size) { return counted_allocation(size); }
+void* operator new[](size_t size) { return counted_allocation(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+
+namespace m0st4fa::parsix::bench {
+
+	AllocationCount allocation_count() noexcept(true)
+	{
+		return { g_Allocations.load(std::memory_order_relaxed), g_AllocatedBytes.load(std::memory_order_relaxed) };
+	}
+
+	/**
+	 * @brief Gets the peak resident set size of the process so far, in bytes.
+	 * @note It never decreases: it is the peak of the whole run up to now, which includes the inputs of the benchmarks.
+	 */
+	size_t peak_rss()
+	{
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS counters{};
+
+		if (not GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+			return 0;
+
+		return counters.PeakWorkingSetSize;
+#else
+		rusage usage{};
+
+		if (getrusage(RUSAGE_SELF, &usage) != 0)
+			return 0;
+
+#	ifdef __APPLE__
+		return (size_t)usage.ru_maxrss;
+#	else
+		return (size_t)usage.ru_maxrss * 1024;
+#	endif
+#endif
+	}
+
+}
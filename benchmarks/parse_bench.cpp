@@ -0,0 +1,320 @@
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "grammars.h"
+#include "parsix/GLRParser.h"
+#include "parsix/LLParser.h"
+#include "parsix/LRParser.h"
+#include "parsix/LRTableBuilder.h"
+#include "parsix/ParseTree.h"
+#include "parsix/PipelinedTokenBuffer.h"
+#include "parsix/SemanticActions.h"
+#include "parsix/SpeculativeParser.h"
+#include "parsix/TokenBuffer.h"
+
+/**
+ * @file parse_bench.cpp
+ * @brief Measures the throughput of `LLParser::parse()` and `LRParser::parse()` on the expression and JSON grammars (see grammars.cpp), at 1 KiB, 1 MiB and 100 MiB of input, and that of `GLRParser::parse()` on the (conflict-free) expression grammar, to be compared with the deterministic parsers.
+ * @details The expression parsers are also measured reading their tokens through a TokenBuffer (the `Buffered` benchmarks) and through a PipelinedTokenBuffer, which lexes on a thread of its own (the `Pipelined` benchmarks; they only gain with a spare core).
+ * @details The LR expression parser is also measured building the parse tree of its input (the `Tree` benchmark; see ParseTree).
+ * @details The LR JSON parser is also measured parsing its (pre-lexed) tokens in parallel with a SpeculativeParser split after the commas (the `Speculative` benchmark).
+ * @details Every benchmark reports the tokens and bytes parsed per second, the heap allocations (and allocated bytes) per parse and the peak resident set size of the process (see memory.cpp). The parsers read their input through a StreamingLexer over the source in memory, and reuse their parse context from one iteration to the next, as a long-running program would.
+ */
+
+namespace m0st4fa::parsix::bench {
+
+	namespace {
+
+		// STATES AND ACTIONS
+		using ExprToken = OffsetToken<ExprTerminal>;
+		using ExprState = LRState<Value, ExprToken>;
+		using ExprStack = LRStackType<Value, ExprToken>;
+
+		using JsonToken = OffsetToken<JsonTerminal>;
+		using JsonState = LRState<Value, JsonToken>;
+		using JsonStack = LRStackType<Value, JsonToken>;
+
+		/**
+		 * @brief The actions of the LR expression grammar, which evaluate the expression (the value of an identifier is its length).
+		 */
+		constexpr auto make_expression_actions() {
+			constexpr auto passLast = [](ExprStack& stack, ExprState& newState) { newState.data = stack.back().data; };
+
+			return LRActionTable{
+				[](ExprStack& stack, ExprState&, Result& result) { result.value = stack.back().data.value; },
+				[](ExprStack& stack, ExprState& newState) { newState.data.value = stack.at(stack.size() - 3).data.value + stack.back().data.value; },
+				passLast,
+				[](ExprStack& stack, ExprState& newState) { newState.data.value = stack.at(stack.size() - 3).data.value * stack.back().data.value; },
+				passLast,
+				[](ExprStack& stack, ExprState& newState) { newState.data = stack.at(stack.size() - 2).data; },
+				[](ExprStack& stack, ExprState& newState) { newState.data.value = stack.back().token.length; }
+			};
+		}
+
+		/**
+		 * @brief The actions of the LR JSON grammar: only the acceptance has one (the document is merely recognized).
+		 */
+		constexpr auto make_json_actions() {
+			return LRActionTable{ [](JsonStack&, JsonState&, Result& result) { result.value = 1; } };
+		}
+
+		// PARSERS
+		using LRExprTable = LRParsingTable<LRExprGrammar>;
+		using LRExprParser = LRParser<LRExprGrammar, ExprLexer, ExprSymbol, ExprState, LRExprTable, fsm::FSMTable, std::string, decltype(make_expression_actions())>;
+
+		using LRJsonTable = LRParsingTable<LRJsonGrammar>;
+		using LRJsonParser = LRParser<LRJsonGrammar, JsonLexer, JsonSymbol, JsonState, LRJsonTable, fsm::FSMTable, std::string, decltype(make_json_actions())>;
+
+		using LLExprTable = LLParsingTable<LLExprGrammar, ExprTerminal, ExprVariable>;
+		using LLExprParser = LLParser<LLExprGrammar, ExprLexer, ExprSymbol, LLExprTable, fsm::FSMTable, std::string_view>;
+
+		using GLRExprParser = GLRParser<LRExprGrammar, ExprLexer, ExprSymbol>;
+
+		using BufferedExprLexer = TokenBuffer<ExprLexer>;
+		using LRBufferedExprParser = LRParser<LRExprGrammar, BufferedExprLexer, ExprSymbol, ExprState, LRExprTable, fsm::FSMTable, std::string, decltype(make_expression_actions())>;
+		using LLBufferedExprParser = LLParser<LLExprGrammar, BufferedExprLexer, ExprSymbol, LLExprTable, fsm::FSMTable, std::string_view>;
+
+		using PipelinedExprLexer = PipelinedTokenBuffer<ExprLexer>;
+		using LRPipelinedExprParser = LRParser<LRExprGrammar, PipelinedExprLexer, ExprSymbol, ExprState, LRExprTable, fsm::FSMTable, std::string, decltype(make_expression_actions())>;
+		using LLPipelinedExprParser = LLParser<LLExprGrammar, PipelinedExprLexer, ExprSymbol, LLExprTable, fsm::FSMTable, std::string_view>;
+
+		using LLJsonTable = LLParsingTable<LLJsonGrammar, JsonTerminal, JsonVariable>;
+		using LLJsonParser = LLParser<LLJsonGrammar, JsonLexer, JsonSymbol, LLJsonTable, fsm::FSMTable, std::string_view>;
+
+		/**
+		 * @brief The lexical analyzers the parsers are constructed with; they are never used, since every parse is given its own.
+		 */
+		ExprLexer g_ExprLexer;
+		JsonLexer g_JsonLexer;
+		BufferedExprLexer g_BufferedExprLexer;
+		PipelinedExprLexer g_PipelinedExprLexer;
+
+		/**
+		 * @brief Constructs the LALR(1) table of a grammar, prepared to be shared by parsers of type `ParserT`.
+		 */
+		template <typename ParserT, typename GrammarT>
+		auto make_lr_table(const GrammarT& grammar) {
+			LRTableBuilder<GrammarT> builder{ grammar };
+
+			return ParserT::prepareTable(builder.build(LRTableType::LTT_LALR1));
+		}
+
+		const LRExprParser& lr_expression_parser() {
+			static const LRExprParser parser{ g_ExprLexer, make_lr_table<LRExprParser>(make_lr_expression_grammar()), variable<ExprSymbol>(ExprVariable::NT_EP), make_expression_actions() };
+
+			return parser;
+		}
+
+		const LRJsonParser& lr_json_parser() {
+			static const LRJsonParser parser{ g_JsonLexer, make_lr_table<LRJsonParser>(make_lr_json_grammar()), variable<JsonSymbol>(JsonVariable::NT_START), make_json_actions() };
+
+			return parser;
+		}
+
+		const LRBufferedExprParser& lr_buffered_expression_parser() {
+			static const LRBufferedExprParser parser{ g_BufferedExprLexer, make_lr_table<LRBufferedExprParser>(make_lr_expression_grammar()), variable<ExprSymbol>(ExprVariable::NT_EP), make_expression_actions() };
+
+			return parser;
+		}
+
+		const LRPipelinedExprParser& lr_pipelined_expression_parser() {
+			static const LRPipelinedExprParser parser{ g_PipelinedExprLexer, make_lr_table<LRPipelinedExprParser>(make_lr_expression_grammar()), variable<ExprSymbol>(ExprVariable::NT_EP), make_expression_actions() };
+
+			return parser;
+		}
+
+		const SpeculativeParser<LRJsonParser>& speculative_json_parser() {
+			static const SpeculativeParser<LRJsonParser> parser{ lr_json_parser(), { JsonTerminal::T_COMMA } };
+
+			return parser;
+		}
+
+		const GLRExprParser& glr_expression_parser() {
+			LRTableBuilder<LRExprGrammar> builder{ make_lr_expression_grammar() };
+			static const GLRExprParser parser{ g_ExprLexer, GLRExprParser::prepareTable(builder), variable<ExprSymbol>(ExprVariable::NT_EP) };
+
+			return parser;
+		}
+
+		const LLExprParser& ll_expression_parser() {
+			static const LLExprParser parser{ variable<ExprSymbol>(ExprVariable::NT_E), LLExprParser::prepareTable(make_ll_table<LLExprTable>(make_ll_expression_grammar())), g_ExprLexer };
+
+			return parser;
+		}
+
+		const LLBufferedExprParser& ll_buffered_expression_parser() {
+			static const LLBufferedExprParser parser{ variable<ExprSymbol>(ExprVariable::NT_E), LLBufferedExprParser::prepareTable(make_ll_table<LLExprTable>(make_ll_expression_grammar())), g_BufferedExprLexer };
+
+			return parser;
+		}
+
+		const LLPipelinedExprParser& ll_pipelined_expression_parser() {
+			static const LLPipelinedExprParser parser{ variable<ExprSymbol>(ExprVariable::NT_E), LLPipelinedExprParser::prepareTable(make_ll_table<LLExprTable>(make_ll_expression_grammar())), g_PipelinedExprLexer };
+
+			return parser;
+		}
+
+		const LLJsonParser& ll_json_parser() {
+			static const LLJsonParser parser{ variable<JsonSymbol>(JsonVariable::NT_VALUE), LLJsonParser::prepareTable(make_ll_table<LLJsonTable>(make_ll_json_grammar())), g_JsonLexer };
+
+			return parser;
+		}
+
+		/**
+		 * @brief Runs the iterations of a parse benchmark and reports its counters.
+		 * @param[in] source The input of every parse.
+		 * @param[in] parse Parses the input of the lexical analyzer it is called with.
+		 */
+		template <typename TerminalT, typename ScanFnT, typename ParseFnT>
+		void measure_parse(benchmark::State& state, const std::string& source, ParseFnT parse) {
+			const size_t tokenCount = count_tokens<TerminalT, ScanFnT>(source);
+			const size_t rssBefore = peak_rss();
+			const AllocationCount before = allocation_count();
+
+			for (auto _ : state) {
+				ChunkedInput input = ChunkedInput::view(source);
+				StreamingLexer<TerminalT, ScanFnT> lexer{ input, ScanFnT{} };
+
+				benchmark::DoNotOptimize(parse(lexer));
+			}
+
+			const AllocationCount after = allocation_count();
+			const size_t rssAfter = peak_rss();
+
+			state.SetBytesProcessed((int64_t)(state.iterations() * source.size()));
+			state.counters["tokens"] = benchmark::Counter((double)tokenCount);
+			state.counters["tokens_per_second"] = benchmark::Counter((double)tokenCount, benchmark::Counter::kIsIterationInvariantRate);
+			state.counters["allocations_per_parse"] = benchmark::Counter((double)(after.allocations - before.allocations), benchmark::Counter::kAvgIterations);
+			state.counters["allocated_bytes_per_parse"] = benchmark::Counter((double)(after.bytes - before.bytes), benchmark::Counter::kAvgIterations, benchmark::Counter::kIs1024);
+			state.counters["peak_rss"] = benchmark::Counter((double)rssAfter, benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+			state.counters["peak_rss_growth"] = benchmark::Counter((double)(rssAfter - rssBefore), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+		}
+
+	}
+
+	// BENCHMARKS
+	void BM_LRParseExpression(benchmark::State& state) {
+		const LRExprParser& parser = lr_expression_parser();
+		const std::string source = make_expression_source((size_t)state.range(0));
+		LRExprParser::ParseContext ctx;
+
+		measure_parse<ExprTerminal, ExprScanner>(state, source, [&](ExprLexer& lexer) { return parser.parse(ctx, lexer, Result{}).value; });
+	}
+
+	void BM_LRParseExpressionTree(benchmark::State& state) {
+		const LRExprParser& parser = lr_expression_parser();
+		const std::string source = make_expression_source((size_t)state.range(0));
+		ParseTree tree;
+		LRExprParser::ParseContext ctx;
+		ctx.tree = &tree;
+
+		measure_parse<ExprTerminal, ExprScanner>(state, source, [&](ExprLexer& lexer) { return parser.parse(ctx, lexer, Result{}).value + tree.size(); });
+	}
+
+	void BM_LRParseExpressionBuffered(benchmark::State& state) {
+		const LRBufferedExprParser& parser = lr_buffered_expression_parser();
+		const std::string source = make_expression_source((size_t)state.range(0));
+		LRBufferedExprParser::ParseContext ctx;
+
+		measure_parse<ExprTerminal, ExprScanner>(state, source, [&](ExprLexer& lexer) { BufferedExprLexer tokens{ lexer }; return parser.parse(ctx, tokens, Result{}).value; });
+	}
+
+	void BM_LRParseExpressionPipelined(benchmark::State& state) {
+		const LRPipelinedExprParser& parser = lr_pipelined_expression_parser();
+		const std::string source = make_expression_source((size_t)state.range(0));
+		LRPipelinedExprParser::ParseContext ctx;
+
+		measure_parse<ExprTerminal, ExprScanner>(state, source, [&](ExprLexer& lexer) { PipelinedExprLexer tokens{ lexer }; return parser.parse(ctx, tokens, Result{}).value; });
+	}
+
+	void BM_LRParseJson(benchmark::State& state) {
+		const LRJsonParser& parser = lr_json_parser();
+		const std::string source = make_json_source((size_t)state.range(0));
+		LRJsonParser::ParseContext ctx;
+
+		measure_parse<JsonTerminal, JsonScanner>(state, source, [&](JsonLexer& lexer) { return parser.parse(ctx, lexer, Result{}).value; });
+	}
+
+	void BM_LRParseJsonSpeculative(benchmark::State& state) {
+		const SpeculativeParser<LRJsonParser>& parser = speculative_json_parser();
+		const std::string source = make_json_source((size_t)state.range(0));
+		SpeculativeParser<LRJsonParser>::ParseContext ctx;
+		std::vector<JsonToken> tokens;
+
+		measure_parse<JsonTerminal, JsonScanner>(state, source, [&](JsonLexer& lexer) {
+			tokens.clear();
+
+			do
+				tokens.push_back(lexer.getNextToken());
+			while (tokens.back().name != JsonTerminal::T_EOF);
+
+			return parser.parse(ctx, tokens, Result{}).value;
+			});
+	}
+
+	void BM_GLRParseExpression(benchmark::State& state) {
+		const GLRExprParser& parser = glr_expression_parser();
+		const std::string source = make_expression_source((size_t)state.range(0));
+		GLRExprParser::ParseContext ctx;
+
+		measure_parse<ExprTerminal, ExprScanner>(state, source, [&](ExprLexer& lexer) { return parser.parse(ctx, lexer).root; });
+	}
+
+	void BM_LLParseExpression(benchmark::State& state) {
+		const LLExprParser& parser = ll_expression_parser();
+		const std::string source = make_expression_source((size_t)state.range(0));
+		LLExprParser::ParseContext ctx;
+
+		measure_parse<ExprTerminal, ExprScanner>(state, source, [&](ExprLexer& lexer) { return parser.parse<Result>(ctx, lexer).value; });
+	}
+
+	void BM_LLParseExpressionBuffered(benchmark::State& state) {
+		const LLBufferedExprParser& parser = ll_buffered_expression_parser();
+		const std::string source = make_expression_source((size_t)state.range(0));
+		LLBufferedExprParser::ParseContext ctx;
+
+		measure_parse<ExprTerminal, ExprScanner>(state, source, [&](ExprLexer& lexer) { BufferedExprLexer tokens{ lexer }; return parser.parse<Result>(ctx, tokens).value; });
+	}
+
+	void BM_LLParseExpressionPipelined(benchmark::State& state) {
+		const LLPipelinedExprParser& parser = ll_pipelined_expression_parser();
+		const std::string source = make_expression_source((size_t)state.range(0));
+		LLPipelinedExprParser::ParseContext ctx;
+
+		measure_parse<ExprTerminal, ExprScanner>(state, source, [&](ExprLexer& lexer) { PipelinedExprLexer tokens{ lexer }; return parser.parse<Result>(ctx, tokens).value; });
+	}
+
+	void BM_LLParseJson(benchmark::State& state) {
+		const LLJsonParser& parser = ll_json_parser();
+		const std::string source = make_json_source((size_t)state.range(0));
+		LLJsonParser::ParseContext ctx;
+
+		measure_parse<JsonTerminal, JsonScanner>(state, source, [&](JsonLexer& lexer) { return parser.parse<Result>(ctx, lexer).value; });
+	}
+
+	/**
+	 * @brief The input sizes: 1 KiB, 1 MiB and 100 MiB.
+	 */
+	void parse_sizes(benchmark::internal::Benchmark* benchmark) {
+		benchmark->Arg(1 << 10)->Arg(1 << 20)->Arg(100 << 20)->Unit(benchmark::kMicrosecond);
+	}
+
+	BENCHMARK(BM_LRParseExpression)->Apply(parse_sizes);
+	BENCHMARK(BM_LRParseExpressionTree)->Apply(parse_sizes);
+	BENCHMARK(BM_LRParseExpressionBuffered)->Apply(parse_sizes);
+	BENCHMARK(BM_LRParseExpressionPipelined)->Apply(parse_sizes)->UseRealTime();
+	BENCHMARK(BM_LRParseJson)->Apply(parse_sizes);
+	BENCHMARK(BM_LRParseJsonSpeculative)->Apply(parse_sizes)->UseRealTime();
+	BENCHMARK(BM_LLParseExpression)->Apply(parse_sizes);
+	BENCHMARK(BM_LLParseExpressionBuffered)->Apply(parse_sizes);
+	BENCHMARK(BM_LLParseExpressionPipelined)->Apply(parse_sizes)->UseRealTime();
+
+	// the forest of a GLR parse is linear in the size of the input (tens of bytes per token), hence no 100 MiB input
+	BENCHMARK(BM_GLRParseExpression)->Arg(1 << 10)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+	BENCHMARK(BM_LLParseJson)->Apply(parse_sizes);
+
+}
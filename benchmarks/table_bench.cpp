@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include "grammars.h"
+#include "parsix/LRTableBuilder.h"
+
+/**
+ * @file table_bench.cpp
+ * @brief Measures the construction of LR tables (the canonical collection by CLOSURE and GOTO, and the filling of the tables) and the calculation of the FIRST and FOLLOW sets, against the size of the grammar.
+ * @details The grammars are generated (see `make_generated_grammar()`); the first argument of every benchmark is the number of kinds of statements of the grammar, which it reports together with its number of productions.
+ */
+
+namespace m0st4fa::parsix::bench {
+
+	void BM_BuildLRTable(benchmark::State& state) {
+		const GenGrammar grammar = make_generated_grammar((size_t)state.range(0));
+		const LRTableType tableType = (LRTableType)state.range(1);
+		size_t stateCount = 0;
+
+		for (auto _ : state) {
+			LRTableBuilder<GenGrammar> builder{ grammar };
+			benchmark::DoNotOptimize(builder.build(tableType));
+			stateCount = builder.getStateCount();
+		}
+
+		state.SetLabel(toString(tableType));
+		state.counters["productions"] = benchmark::Counter((double)grammar.size());
+		state.counters["states"] = benchmark::Counter((double)stateCount);
+	}
+
+	void BM_FirstFollow(benchmark::State& state) {
+		const GenGrammar grammar = make_generated_grammar((size_t)state.range(0));
+
+		for (auto _ : state) {
+			state.PauseTiming();
+			GenGrammar copy = grammar;
+			state.ResumeTiming();
+
+			copy.calculateFIRST();
+			copy.calculateFOLLOW();
+			benchmark::DoNotOptimize(copy);
+		}
+
+		state.counters["productions"] = benchmark::Counter((double)grammar.size());
+	}
+
+	BENCHMARK(BM_BuildLRTable)
+		->ArgsProduct({ { 1, 4, 16, 64, 128 }, { (int64_t)LRTableType::LTT_SLR1, (int64_t)LRTableType::LTT_LALR1, (int64_t)LRTableType::LTT_CLR1 } })
+		->ArgNames({ "kinds", "type" })
+		->Unit(benchmark::kMicrosecond);
+
+	BENCHMARK(BM_FirstFollow)
+		->Arg(1)->Arg(4)->Arg(16)->Arg(64)->Arg(128)
+		->ArgNames({ "kinds" })
+		->Unit(benchmark::kMicrosecond);
+
+}
@@ -0,0 +1,177 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief A bump allocator: memory is carved out of large chunks by advancing a pointer, and is released all at once.
+	 * @details Arenas are meant for objects whose lifetime ends with a parse, e.g., AST nodes created by semantic actions. Allocation is a pointer bump (a new chunk is allocated only when the current one is exhausted), and `reset()` releases everything in O(1) by rewinding to the first chunk; the chunks are kept and reused by the next parse.
+	 * @attention Objects are never destroyed individually; hence, `create()` only accepts trivially destructible types. Objects needing cleanup may still be placed in memory from `allocate()`, but destroying them is then up to the caller.
+	 */
+	class Arena {
+
+		/**
+		 * @brief A single block of memory owned by the arena.
+		 */
+		struct Chunk {
+			std::unique_ptr<std::byte[]> memory;
+			size_t size = 0;
+		};
+
+		/**
+		 * @brief The arena the semantic actions of the current parse (on this thread) allocate from.
+		 */
+		static thread_local Arena* s_Current;
+
+		/**
+		 * @brief All of the chunks owned by the arena, in the order in which they are used.
+		 */
+		std::vector<Chunk> m_Chunks;
+
+		/**
+		 * @brief The index of the chunk currently being allocated from.
+		 */
+		size_t m_CurrChunk = 0;
+
+		/**
+		 * @brief The next free byte of the current chunk.
+		 */
+		std::byte* m_Ptr = nullptr;
+
+		/**
+		 * @brief The end of the current chunk.
+		 */
+		std::byte* m_End = nullptr;
+
+		/**
+		 * @brief The minimum size of a chunk.
+		 */
+		size_t m_ChunkSize;
+
+		void* _allocate_slow(size_t, size_t);
+
+	public:
+
+		/**
+		 * @brief The default minimum size of a chunk.
+		 */
+		static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+		/**
+		 * @brief Constructs an empty arena. No memory is allocated until the first allocation.
+		 * @param[in] chunkSize The minimum size of a chunk.
+		 */
+		explicit Arena(size_t chunkSize = DEFAULT_CHUNK_SIZE) : m_ChunkSize{ chunkSize ? chunkSize : DEFAULT_CHUNK_SIZE } {}
+
+		Arena(const Arena&) = delete;
+		Arena& operator=(const Arena&) = delete;
+
+		/**
+		 * @brief Move constructor. Takes the chunks of `other`, which is left empty (as if released), so that it never hands out memory it no longer owns.
+		 */
+		Arena(Arena&& other) noexcept(true) :
+			m_Chunks{ std::move(other.m_Chunks) },
+			m_CurrChunk{ std::exchange(other.m_CurrChunk, 0) },
+			m_Ptr{ std::exchange(other.m_Ptr, nullptr) },
+			m_End{ std::exchange(other.m_End, nullptr) },
+			m_ChunkSize{ other.m_ChunkSize }
+		{
+			other.m_Chunks.clear();
+		}
+
+		/**
+		 * @brief Move assignment operator. Releases the chunks of this arena and takes those of `other`, which is left empty (as if released).
+		 */
+		Arena& operator=(Arena&& other) noexcept(true) {
+			if (this == &other)
+				return *this;
+
+			this->m_Chunks = std::move(other.m_Chunks);
+			this->m_CurrChunk = std::exchange(other.m_CurrChunk, 0);
+			this->m_Ptr = std::exchange(other.m_Ptr, nullptr);
+			this->m_End = std::exchange(other.m_End, nullptr);
+			this->m_ChunkSize = other.m_ChunkSize;
+			other.m_Chunks.clear();
+
+			return *this;
+		}
+
+		/**
+		 * @brief Allocates memory from the arena.
+		 * @param[in] size The number of bytes to allocate.
+		 * @param[in] alignment The alignment of the memory; a power of 2.
+		 * @returns A pointer to `size` bytes aligned to `alignment`, valid until the arena is reset or destroyed.
+		 */
+		void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+			const uintptr_t ptr = reinterpret_cast<uintptr_t>(this->m_Ptr);
+			const uintptr_t aligned = (ptr + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+			if (this->m_Ptr && aligned + size <= reinterpret_cast<uintptr_t>(this->m_End)) {
+				this->m_Ptr = reinterpret_cast<std::byte*>(aligned + size);
+				return reinterpret_cast<void*>(aligned);
+			}
+
+			return this->_allocate_slow(size, alignment);
+		}
+
+		/**
+		 * @brief Constructs an object in memory allocated from the arena.
+		 * @tparam T The type of the object; it must be trivially destructible, since it is never destroyed.
+		 * @param[in] args The arguments forwarded to the constructor of `T`.
+		 * @returns A pointer to the new object, valid until the arena is reset or destroyed.
+		 */
+		template <typename T, typename... ArgsT>
+		T* create(ArgsT&&... args) {
+			static_assert(std::is_trivially_destructible_v<T>, "Objects created in an arena are never destroyed; they must be trivially destructible.");
+
+			return ::new (this->allocate(sizeof(T), alignof(T))) T(std::forward<ArgsT>(args)...);
+		}
+
+		/**
+		 * @brief Releases everything allocated from the arena at once, in O(1). The memory is kept to be reused by later allocations.
+		 */
+		void reset() noexcept(true) {
+			this->m_CurrChunk = 0;
+
+			if (this->m_Chunks.empty()) {
+				this->m_Ptr = this->m_End = nullptr;
+				return;
+			}
+
+			this->m_Ptr = this->m_Chunks.front().memory.get();
+			this->m_End = this->m_Ptr + this->m_Chunks.front().size;
+		}
+
+		void release() noexcept(true);
+
+		size_t getCapacity() const noexcept(true);
+
+		/**
+		 * @brief Gets the arena of the parse running on this thread, for use by semantic actions.
+		 * @returns The arena of the innermost active Arena::Scope on this thread; `nullptr` if there is none.
+		 */
+		static Arena* current() noexcept(true) { return s_Current; }
+
+		/**
+		 * @brief Makes an arena the current arena (see `current()`) of this thread for the lifetime of the scope object. Scopes may be nested; the previous arena is restored when the scope ends.
+		 */
+		class Scope {
+			Arena* m_Previous;
+
+		public:
+			explicit Scope(Arena& arena) noexcept(true) : m_Previous{ s_Current } { s_Current = &arena; }
+			~Scope() { s_Current = this->m_Previous; }
+
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+		};
+
+	};
+
+}
@@ -0,0 +1,176 @@
+#pragma once
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "parsix/parser.h"
+#include "parsix/WorkStealingPool.h"
+
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Parses batches of inputs in parallel using a single parser (and, thus, a single shared parsing table).
+	 * @details Every input is parsed by a call to the reentrant `parse()` of the parser, with its own lexical analyzer (created by a user-provided factory). Every worker has its own parse context, reused for all of the inputs it parses. The inputs are spread over the workers of a WorkStealingPool, so inputs of very uneven sizes are still balanced.
+	 * @attention Semantic actions of the grammar run concurrently, so they must not modify shared state without synchronization.
+	 * @attention The arena of a context is reset when the context is reused; hence, results must not refer to memory allocated from `Arena::current()`.
+	 * @tparam ParserT The type of the parser; an LRParser or an LLParser. It should have been constructed with a prepared, shared table (see `LRParser::prepareTable()`), so that copying it is cheap.
+	 */
+	template <typename ParserT>
+	class BatchParser {
+
+		/**
+		 * @brief The parser used for every input.
+		 */
+		ParserT m_Parser;
+
+		/**
+		 * @brief The pool on which the inputs are parsed.
+		 */
+		WorkStealingPool m_Pool;
+
+		/**
+		 * @brief Aliases the type of the parse context of the parser.
+		 */
+		using ParseContextType = typename ParserT::ParseContext;
+
+		/**
+		 * @brief Parses a single input with its own lexical analyzer, using whichever overload of the reentrant `parse()` the parser has.
+		 */
+		template <typename ParserResultT, typename LexicalAnalyzerT>
+		ParserResultT _parse_one(ParseContextType& ctx, LexicalAnalyzerT& lexer, const ParserResultT& initResult, ErrorRecoveryType errorRecoveryType) const {
+			if constexpr (requires { this->m_Parser.parse(ctx, lexer, initResult, errorRecoveryType); })
+				return this->m_Parser.parse(ctx, lexer, initResult, errorRecoveryType);
+			else
+				return this->m_Parser.template parse<ParserResultT>(ctx, lexer, errorRecoveryType);
+		}
+
+		/**
+		 * @brief Reads the entire contents of a file.
+		 * @throws std::runtime_error If the file cannot be read.
+		 */
+		static std::string _read_file(const std::filesystem::path& path) {
+			std::ifstream file{ path, std::ios::binary };
+
+			if (not file)
+				throw std::runtime_error(std::format("Cannot open file `{}` for parsing.", path.string()));
+
+			std::ostringstream contents;
+			contents << file.rdbuf();
+
+			return std::move(contents).str();
+		}
+
+		template <typename ParserResultT, typename InputT, typename GetSourceFnT, typename MakeLexerFnT>
+		std::vector<ParserResultT> _parse_all(const std::vector<InputT>&, GetSourceFnT&&, MakeLexerFnT&&, const ParserResultT&, ErrorRecoveryType, std::vector<std::exception_ptr>*) const;
+
+	public:
+
+		/**
+		 * @brief Constructs a batch parser.
+		 * @param[in] parser The parser used for every input. It is copied; the copy shares the table of `parser`.
+		 * @param[in] threadCount The maximum number of worker threads. If `0`, the number of hardware threads is used.
+		 */
+		explicit BatchParser(const ParserT& parser, size_t threadCount = 0) : m_Parser{ parser }, m_Pool{ threadCount } {}
+
+		/**
+		 * @brief Gets the maximum number of worker threads used to parse a batch.
+		 */
+		size_t getThreadCount() const { return this->m_Pool.getThreadCount(); }
+
+		/**
+		 * @brief Parses a batch of source strings in parallel.
+		 * @param[in] sources The source strings to be parsed. They must outlive the call.
+		 * @param[in] makeLexer A callable taking a source string (`std::string_view`) and returning a lexical analyzer for it. It is called concurrently from different threads.
+		 * @param[in] initResult The initial result of every parse.
+		 * @param[in] errorRecoveryType The type of recovery technique to use in case of an error.
+		 * @param[out] errors If not `nullptr`, it is resized to the number of sources and, for every source, set to the exception thrown while parsing it (`nullptr` if the parse succeeded). In this case, no exception is thrown.
+		 * @returns The results of the parses, in the order of `sources`. The result of a failed parse is a default-constructed object.
+		 * @throws Whatever the parse of the first failed source (in the order of `sources`) threw, if `errors` is `nullptr`. All of the sources are parsed anyway.
+		 */
+		template <typename ParserResultT = ParserResult, typename MakeLexerFnT>
+		std::vector<ParserResultT> parseAll(const std::vector<std::string_view>& sources, MakeLexerFnT&& makeLexer,
+			const ParserResultT& initResult = ParserResultT{}, ErrorRecoveryType errorRecoveryType = ErrorRecoveryType::ERT_NONE,
+			std::vector<std::exception_ptr>* errors = nullptr) const {
+
+			return this->_parse_all(sources, [](std::string_view source) { return source; }, makeLexer, initResult, errorRecoveryType, errors);
+		}
+
+		/**
+		 * @brief Parses a batch of files in parallel.
+		 * @details Every file is read by the worker parsing it, right before it is parsed, and its contents are freed right after.
+		 * @param[in] paths The paths of the files to be parsed.
+		 * @param[in] makeLexer A callable taking the contents of a file (`std::string_view`) and returning a lexical analyzer for it. It is called concurrently from different threads.
+		 * @param[in] initResult The initial result of every parse.
+		 * @param[in] errorRecoveryType The type of recovery technique to use in case of an error.
+		 * @param[out] errors If not `nullptr`, it is resized to the number of files and, for every file, set to the exception thrown while reading or parsing it (`nullptr` if the parse succeeded). In this case, no exception is thrown.
+		 * @returns The results of the parses, in the order of `paths`. The result of a failed parse is a default-constructed object.
+		 * @throws Whatever reading or parsing the first failed file (in the order of `paths`) threw, if `errors` is `nullptr`. All of the files are parsed anyway.
+		 */
+		template <typename ParserResultT = ParserResult, typename MakeLexerFnT>
+		std::vector<ParserResultT> parseAll(const std::vector<std::filesystem::path>& paths, MakeLexerFnT&& makeLexer,
+			const ParserResultT& initResult = ParserResultT{}, ErrorRecoveryType errorRecoveryType = ErrorRecoveryType::ERT_NONE,
+			std::vector<std::exception_ptr>* errors = nullptr) const {
+
+			return this->_parse_all(paths, [](const std::filesystem::path& path) { return _read_file(path); }, makeLexer, initResult, errorRecoveryType, errors);
+		}
+
+	};
+
+}
+
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Parses a batch of inputs in parallel.
+	 * @param[in] inputs The inputs to be parsed.
+	 * @param[in] getSource A callable taking an input and returning its source (anything convertible to `std::string_view` that stays alive while it is being parsed, e.g., a `std::string`).
+	 * @param[in] makeLexer A callable taking a source string and returning a lexical analyzer for it.
+	 * @param[in] initResult The initial result of every parse.
+	 * @param[in] errorRecoveryType The type of recovery technique to use in case of an error.
+	 * @param[out] errors See `parseAll()`.
+	 * @returns The results of the parses, in the order of `inputs`.
+	 */
+	template <typename ParserT>
+	template <typename ParserResultT, typename InputT, typename GetSourceFnT, typename MakeLexerFnT>
+	std::vector<ParserResultT> BatchParser<ParserT>::_parse_all(const std::vector<InputT>& inputs, GetSourceFnT&& getSource, MakeLexerFnT&& makeLexer,
+		const ParserResultT& initResult, ErrorRecoveryType errorRecoveryType, std::vector<std::exception_ptr>* errors) const
+	{
+		std::vector<ParserResultT> results(inputs.size());
+
+		// one context per worker; a worker runs one task at a time, so its context is never shared
+		std::vector<ParseContextType> contexts(this->m_Pool.getThreadCount());
+
+		// every task writes to its own slot, so neither vector needs any synchronization
+		std::vector<std::exception_ptr> failures(inputs.size());
+
+		this->m_Pool.run(inputs.size(), [&](size_t task, size_t worker) {
+			try {
+				const auto source = getSource(inputs[task]);
+				auto lexer = makeLexer(std::string_view{ source });
+
+				results[task] = this->_parse_one(contexts[worker], lexer, initResult, errorRecoveryType);
+			}
+			catch (...) {
+				failures[task] = std::current_exception();
+			}
+			});
+
+		if (errors) {
+			*errors = std::move(failures);
+			return results;
+		}
+
+		for (const std::exception_ptr& failure : failures)
+			if (failure)
+				std::rethrow_exception(failure);
+
+		return results;
+	}
+
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "parsix/MappedFile.h"
+
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief The input of a streaming parse: a bounded window over a (possibly huge) source, read in chunks.
+	 * @details Offsets are absolute (from the beginning of the source), so they stay meaningful when the window moves; see StreamingLexer, whose tokens hold offsets instead of copies of their text.
+		* A *streamed* input reads its source from a stream, a chunk at a time. Its window holds the bytes from the *discard point* (see `discard()`) to the end of the last chunk read; everything before the discard point is dropped when the next chunk is read. Thus, its memory use is bounded by the chunk size plus whatever the reader keeps (e.g., the longest token), however large the source is.
+		* A *mapped* input maps its source file instead (see MappedFile): its window is the whole file from the start, and the operating system pages it in and out as needed.
+		* A *viewed* input is like a mapped one, except that its window is a string kept in memory (and alive) by the caller.
+		* A *pushed* input has no source to read from: its bytes are appended to the window as they arrive (see `append()`), until `finish()` is called. It is meant for push-driven parses of network or pipe input (see `StreamingLexer::tryNextToken()` and `LRParser::feed()`).
+	 */
+	class ChunkedInput {
+
+		/**
+		 * @brief The stream the source is read from; `nullptr` for a mapped input.
+		 */
+		std::unique_ptr<std::istream> m_Stream;
+
+		/**
+		 * @brief The mapping of the source of a mapped input.
+		 */
+		MappedFile m_Mapping;
+
+		/**
+		 * @brief The storage of the window of a streamed input.
+		 */
+		std::vector<char> m_Buffer;
+
+		/**
+		 * @brief The bytes of the window.
+		 */
+		std::string_view m_Window;
+
+		/**
+		 * @brief The offset of the first byte of the window.
+		 */
+		uint64_t m_WindowOffset = 0;
+
+		/**
+		 * @brief The offset before which bytes may be dropped from the window.
+		 */
+		uint64_t m_DiscardOffset = 0;
+
+		/**
+		 * @brief The number of bytes read from the stream at a time.
+		 */
+		size_t m_ChunkSize = DEFAULT_CHUNK_SIZE;
+
+		/**
+		 * @brief Whether the whole source has been read into the window (at some point).
+		 */
+		bool m_AtEnd = false;
+
+		size_t _compact();
+
+	public:
+
+		/**
+		 * @brief The default number of bytes read at a time (1 MiB).
+		 */
+		static constexpr size_t DEFAULT_CHUNK_SIZE = size_t(1) << 20;
+
+		/**
+		 * @brief Default constructor. Constructs an empty input.
+		 */
+		ChunkedInput() : m_AtEnd{ true } {}
+
+		explicit ChunkedInput(std::unique_ptr<std::istream> stream, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+		static ChunkedInput open(const std::filesystem::path& path, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+		static ChunkedInput map(const std::filesystem::path& path);
+		static ChunkedInput view(std::string_view source);
+		static ChunkedInput pushed();
+
+		/**
+		 * @brief Gets the bytes currently in the window.
+		 */
+		std::string_view window() const noexcept(true) { return this->m_Window; }
+
+		/**
+		 * @brief Gets the offset of the first byte of the window.
+		 */
+		uint64_t windowOffset() const noexcept(true) { return this->m_WindowOffset; }
+
+		/**
+		 * @brief Gets the offset right past the last byte of the window.
+		 */
+		uint64_t windowEnd() const noexcept(true) { return this->m_WindowOffset + this->m_Window.size(); }
+
+		/**
+		 * @brief Checks whether the window reaches the end of the source, i.e., there is nothing more to read.
+		 */
+		bool atEnd() const noexcept(true) { return this->m_AtEnd; }
+
+		/**
+		 * @brief Gets the number of bytes allocated for the window (`0` for a mapped input).
+		 */
+		size_t capacity() const noexcept(true) { return this->m_Buffer.capacity(); }
+
+		/**
+		 * @brief Allows the bytes before `offset` to be dropped from the window the next time it is extended. The discard point never moves backwards.
+		 */
+		void discard(uint64_t offset) noexcept(true) {
+			if (offset > this->m_DiscardOffset)
+				this->m_DiscardOffset = offset;
+		}
+
+		bool extend();
+		void append(std::string_view bytes);
+		void finish();
+		std::string_view text(uint64_t offset, size_t length) const;
+
+	};
+
+}
@@ -0,0 +1,170 @@
+#pragma once
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "parsix/TerminalSet.h"
+#include "parsix/Logging.h"
+
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief An LR item packed into 64 bits: the index of its production within the grammar, the position of its dot and the id of its lookahead set (within a LookaheadPool).
+	 * @details Unlike Item, a CompactItem does not hold a copy of its production; it refers to it by index, so the grammar must outlive the items and be indexed the same way. The dot position counts grammar symbols only (non-grammar-symbol elements of the body are not counted).
+	 * @details The production index occupies the most significant bits, followed by the dot position and then the lookahead set id, so comparing the packed values orders items by production, then dot position, then lookaheads; and two items have the same core iff their `core()` values are equal.
+	 */
+	class CompactItem {
+
+		/**
+		 * @brief The packed value.
+		 */
+		uint64_t m_Bits = 0;
+
+		static constexpr size_t LOOKAHEADS_BITS = 32;
+		static constexpr size_t DOT_BITS = 10;
+		static constexpr size_t PROD_BITS = 64 - DOT_BITS - LOOKAHEADS_BITS;
+
+	public:
+
+		/**
+		 * @brief The largest production index that can be stored in an item.
+		 */
+		static constexpr size_t MAX_PROD_INDEX = (size_t(1) << PROD_BITS) - 1;
+
+		/**
+		 * @brief The largest dot position (i.e., the largest production body size) that can be stored in an item.
+		 */
+		static constexpr size_t MAX_DOT_POS = (size_t(1) << DOT_BITS) - 1;
+
+		/**
+		 * @brief The largest lookahead set id that can be stored in an item.
+		 */
+		static constexpr size_t MAX_LOOKAHEADS_ID = (size_t(1) << LOOKAHEADS_BITS) - 1;
+
+		/**
+		 * @brief Default constructor. Constructs the item of production 0, with the dot at 0 and with lookahead set 0.
+		 */
+		constexpr CompactItem() = default;
+
+		/**
+		 * @brief Constructs an item from its components. The components must not exceed their maxima (this is not checked; see LookaheadPool and LRTableBuilder for where it is).
+		 * @param[in] prodIndex The index of the production within the grammar.
+		 * @param[in] dotPos The position of the dot, counting grammar symbols only.
+		 * @param[in] lookaheadsId The id of the lookahead set.
+		 */
+		constexpr CompactItem(size_t prodIndex, size_t dotPos, size_t lookaheadsId = 0) noexcept(true) :
+			m_Bits{ (uint64_t(prodIndex) << (DOT_BITS + LOOKAHEADS_BITS)) | (uint64_t(dotPos) << LOOKAHEADS_BITS) | uint64_t(lookaheadsId) }
+		{}
+
+		constexpr size_t prodIndex() const noexcept(true) { return size_t(this->m_Bits >> (DOT_BITS + LOOKAHEADS_BITS)); }
+		constexpr size_t dotPos() const noexcept(true) { return size_t(this->m_Bits >> LOOKAHEADS_BITS) & MAX_DOT_POS; }
+		constexpr size_t lookaheadsId() const noexcept(true) { return size_t(this->m_Bits & MAX_LOOKAHEADS_ID); }
+
+		/**
+		 * @brief Gets the core of the item (its production and dot position, without its lookaheads) as a single value.
+		 */
+		constexpr uint64_t core() const noexcept(true) { return this->m_Bits >> LOOKAHEADS_BITS; }
+
+		/**
+		 * @brief Gets the packed value of the item.
+		 */
+		constexpr uint64_t bits() const noexcept(true) { return this->m_Bits; }
+
+		/**
+		 * @brief Gets the item obtained by moving the dot of this item over the next symbol.
+		 * @attention The dot must not be at the end of the production.
+		 */
+		constexpr CompactItem advanced() const noexcept(true) { return CompactItem{ this->prodIndex(), this->dotPos() + 1, this->lookaheadsId() }; }
+
+		/**
+		 * @brief Gets an item with the core of this item and another lookahead set.
+		 */
+		constexpr CompactItem withLookaheads(size_t lookaheadsId) const noexcept(true) { return CompactItem{ this->prodIndex(), this->dotPos(), lookaheadsId }; }
+
+		constexpr bool operator==(const CompactItem&) const = default;
+		constexpr std::strong_ordering operator<=>(const CompactItem&) const = default;
+
+	};
+
+	static_assert(sizeof(CompactItem) == sizeof(uint64_t), "A compact item must be packed into 64 bits.");
+
+	/**
+	 * @brief Interns lookahead sets, so that every distinct set is stored once and is referred to by a small id.
+	 * @details Equal sets always get the same id, which lets items (see CompactItem) and kernels be compared by value without comparing their lookaheads. Id `0` is always the empty set, which is the lookahead set of LR(0) items.
+	 * @tparam SymbolT The type of a grammar symbol.
+	 */
+	template <typename SymbolT>
+	class LookaheadPool {
+
+		/**
+		 * @brief Aliases the type of a lookahead set.
+		 */
+		using SetType = TerminalSet<SymbolT>;
+
+		/**
+		 * @brief The sets, indexed by id.
+		 */
+		std::vector<SetType> m_Sets{ SetType{} };
+
+		/**
+		 * @brief Maps the hash of a set to the ids of the sets having that hash.
+		 */
+		std::unordered_map<size_t, std::vector<uint32_t>> m_Index{ { SetType{}.hash(), { 0 } } };
+
+	public:
+
+		/**
+		 * @brief Gets the id of a set, adding the set to the pool if it is not in it yet.
+		 * @param[in] set The set to intern.
+		 * @returns The id of `set`.
+		 * @throws std::length_error If the pool already has as many sets as a CompactItem can refer to.
+		 */
+		size_t intern(const SetType& set) {
+			std::vector<uint32_t>& candidates = this->m_Index[set.hash()];
+
+			for (uint32_t id : candidates)
+				if (this->m_Sets[id] == set)
+					return id;
+
+			if (this->m_Sets.size() > CompactItem::MAX_LOOKAHEADS_ID) {
+				get_logger().log(LoggerInfo::ERR_INVALID_VAL, std::format("Too many distinct lookahead sets (more than {}).", CompactItem::MAX_LOOKAHEADS_ID));
+				throw std::length_error("Too many distinct lookahead sets.");
+			}
+
+			const uint32_t id = (uint32_t)this->m_Sets.size();
+			candidates.push_back(id);
+			this->m_Sets.push_back(set);
+
+			return id;
+		}
+
+		/**
+		 * @brief Gets the set having a given id.
+		 */
+		const SetType& at(size_t id) const { return this->m_Sets.at(id); }
+
+		/**
+		 * @brief Gets the set having a given id, without checking the id.
+		 */
+		const SetType& operator[](size_t id) const noexcept(true) { return this->m_Sets[id]; }
+
+		/**
+		 * @brief Gets the number of distinct sets in the pool (including the empty set).
+		 */
+		size_t size() const noexcept(true) { return this->m_Sets.size(); }
+
+		/**
+		 * @brief Removes all of the sets from the pool, except for the empty set.
+		 */
+		void clear() {
+			this->m_Sets.assign(1, SetType{});
+			this->m_Index = { { SetType{}.hash(), { 0 } } };
+		}
+
+	};
+
+}
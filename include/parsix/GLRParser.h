@@ -0,0 +1,1048 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "parsix/LRTableBuilder.h"
+#include "parsix/ParseStats.h"
+#include "parsix/ParseTree.h"
+#include "parsix/parser.h"
+
+// DECLARATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief An LR parsing table that keeps every action of the cells with conflicts, as needed by a GLRParser.
+	 * @details It is made of the (deterministic) table constructed by LRTableBuilder and of the conflicts the builder resolved while constructing it (see `LRTableBuilder::getConflicts()`): every cell with a conflict gets back all of the actions that were placed in it, the one that was kept first.
+	 * Cells without conflicts are looked up in the deterministic table directly; the conflicting cells are stored apart, by state, so a state without conflicts costs a single comparison more than a lookup in an LRParsingTable.
+	 * @tparam GrammarT The type of object representing the grammar. Generally, it is a vector of production record objects.
+	 */
+	template <typename GrammarT>
+	class GLRParsingTable {
+
+		/**
+		 * @brief Aliases the type of the deterministic table.
+		 */
+		using TableType = LRParsingTable<GrammarT>;
+
+		/**
+		 * @brief Aliases the type of a terminal.
+		 */
+		using TerminalType = typename TableType::TerminalType;
+
+		/**
+		 * @brief Aliases the type of a non-terminal.
+		 */
+		using VariableType = typename TableType::VariableType;
+
+		/**
+		 * @brief Aliases the type of the conflicts reported by LRTableBuilder.
+		 */
+		using ConflictType = LRTableConflict<TerminalType>;
+
+		/**
+		 * @brief A cell of the Action table with more than one action.
+		 */
+		struct ConflictCell {
+
+			/**
+			 * @brief The terminal (column) of the cell.
+			 */
+			TerminalType terminal;
+
+			/**
+			 * @brief The index of the first action of the cell in `m_Actions`.
+			 */
+			uint32_t first = 0;
+
+			/**
+			 * @brief The number of actions of the cell.
+			 */
+			uint32_t count = 0;
+		};
+
+		/**
+		 * @brief The deterministic table (frozen).
+		 */
+		TableType m_Table;
+
+		/**
+		 * @brief The index in `m_Cells` of the first conflicting cell of every state; the cells of state `s` are [`m_RowBegin[s]`, `m_RowBegin[s + 1]`).
+		 */
+		std::vector<uint32_t> m_RowBegin;
+
+		/**
+		 * @brief The conflicting cells, sorted by state and terminal.
+		 */
+		std::vector<ConflictCell> m_Cells;
+
+		/**
+		 * @brief The actions of the conflicting cells.
+		 */
+		std::vector<LRTableEntry> m_Actions;
+
+	public:
+
+		/**
+		 * @brief Default constructor.
+		 */
+		GLRParsingTable() = default;
+
+		GLRParsingTable(TableType, const std::vector<ConflictType>&);
+
+		/**
+		 * @brief Gets all of the actions of the cell at this `state` and this `terminal`; the span is empty if the cell is an error.
+		 * @details If the cell has a conflict, the action that LRTableBuilder kept comes first.
+		 */
+		std::span<const LRTableEntry> actions(size_t state, TerminalType terminal) const noexcept(true) {
+			for (uint32_t cell = this->m_RowBegin[state]; cell < this->m_RowBegin[state + 1]; cell++)
+				if (this->m_Cells[cell].terminal == terminal)
+					return { this->m_Actions.data() + this->m_Cells[cell].first, this->m_Cells[cell].count };
+
+			const LRTableEntry& entry = this->m_Table.view().atAction(state, terminal);
+
+			if (entry.isEmpty || entry.isError())
+				return {};
+
+			return { &entry, 1 };
+		}
+
+		/**
+		 * @brief Gets the GOTO entry at this `state` and this `nonTerminal`. No boundary-checking.
+		 */
+		const LRTableEntry& atGoto(size_t state, VariableType nonTerminal) const noexcept(true) {
+			return this->m_Table.view().atGoto(state, nonTerminal);
+		}
+
+		/**
+		 * @brief Gets the production whose number is `prodNumber`. No boundary-checking.
+		 */
+		const auto& production(size_t prodNumber) const noexcept(true) {
+			return this->m_Table.view().production(prodNumber);
+		}
+
+		/**
+		 * @brief Gets the deterministic table, i.e., the table constructed by LRTableBuilder, with the conflicts resolved.
+		 */
+		const TableType& getTable() const noexcept(true) { return this->m_Table; }
+
+		/**
+		 * @brief Gets the number of states of the table.
+		 */
+		size_t getStateCount() const noexcept(true) { return this->m_Table.actionTable.size(); }
+
+		/**
+		 * @brief Gets the number of cells with more than one action.
+		 */
+		size_t getConflictCount() const noexcept(true) { return this->m_Cells.size(); }
+
+		/**
+		 * @brief Checks whether the state `state` has a cell with more than one action.
+		 */
+		bool hasConflicts(size_t state) const noexcept(true) { return this->m_RowBegin[state] != this->m_RowBegin[state + 1]; }
+
+	};
+
+	/**
+	 * @brief A shared packed parse forest (SPPF): all of the parse trees of an input, with their common subtrees shared and the alternative derivations of a symbol over the same tokens packed into a single node.
+	 * @details The nodes, their alternatives and the children of the alternatives are stored in flat vectors and refer to one another by index. A node is labeled by a grammar symbol and spans the tokens [`start`, `end`) of the input; a terminal node has no alternatives and holds its token. An alternative of a non-terminal node is the production it was derived by, with the node of every symbol of the body (none for an epsilon production).
+	 * @details The input is ambiguous if (and only if) some node reachable from the root has more than one alternative.
+	 * @tparam SymbolT The type of grammar symbol objects.
+	 * @tparam TokenT The type of the tokens.
+	 */
+	template <typename SymbolT, typename TokenT>
+	struct ParseForest {
+
+		/**
+		 * @brief The index of no node or alternative.
+		 */
+		static constexpr uint32_t NONE = UINT32_MAX;
+
+		/**
+		 * @brief A node of the forest.
+		 */
+		struct Node {
+
+			/**
+			 * @brief The symbol of the node.
+			 */
+			SymbolT symbol{};
+
+			/**
+			 * @brief The index of the first token of the node, and the index right past its last token.
+			 */
+			uint32_t start = 0, end = 0;
+
+			/**
+			 * @brief The token of a terminal node.
+			 */
+			TokenT token{};
+
+			/**
+			 * @brief The index of the first alternative of the node; NONE for a terminal node.
+			 */
+			uint32_t firstAlternative = NONE;
+
+			/**
+			 * @brief The number of alternatives of the node.
+			 */
+			uint32_t alternativeCount = 0;
+
+			/**
+			 * @brief Checks whether the symbol of the node derives its tokens in more than one way (locally, i.e., by more than one alternative).
+			 */
+			bool isAmbiguous() const { return this->alternativeCount > 1; }
+		};
+
+		/**
+		 * @brief An alternative (packed node) of a non-terminal node.
+		 */
+		struct Alternative {
+
+			/**
+			 * @brief The number of the production of the alternative.
+			 */
+			uint32_t prodNumber = 0;
+
+			/**
+			 * @brief The index of the first child of the alternative in `children`, and the number of children.
+			 */
+			uint32_t firstChild = 0, childCount = 0;
+
+			/**
+			 * @brief The index of the next alternative of the same node; NONE for the last one.
+			 */
+			uint32_t next = NONE;
+		};
+
+		/**
+		 * @brief The nodes of the forest.
+		 */
+		std::vector<Node> nodes;
+
+		/**
+		 * @brief The alternatives of the nodes.
+		 */
+		std::vector<Alternative> alternatives;
+
+		/**
+		 * @brief The children of the alternatives (indices of nodes).
+		 */
+		std::vector<uint32_t> children;
+
+		/**
+		 * @brief The index of the node of the start symbol spanning the whole input; NONE if no input has been accepted.
+		 */
+		uint32_t root = NONE;
+
+		/**
+		 * @brief Removes all of the nodes, keeping the storage.
+		 */
+		void clear() {
+			this->nodes.clear();
+			this->alternatives.clear();
+			this->children.clear();
+			this->root = NONE;
+		}
+
+		/**
+		 * @brief Gets the children of an alternative, as indices of nodes, in the order of the body of its production.
+		 */
+		std::span<const uint32_t> getChildren(const Alternative& alternative) const {
+			return { this->children.data() + alternative.firstChild, alternative.childCount };
+		}
+
+		/**
+		 * @brief Gets the alternatives of a node.
+		 */
+		std::vector<const Alternative*> getAlternatives(uint32_t node) const {
+			std::vector<const Alternative*> res;
+
+			for (uint32_t alternative = this->nodes[node].firstAlternative; alternative != NONE; alternative = this->alternatives[alternative].next)
+				res.push_back(&this->alternatives[alternative]);
+
+			return res;
+		}
+
+		/**
+		 * @brief Checks whether the forest has more than one parse tree.
+		 */
+		bool isAmbiguous() const { return this->countTrees() > 1; }
+
+		uint64_t countTrees() const;
+
+		void extractTree(ParseTree&) const;
+	};
+
+	/**
+	 * @brief A generalized LR (GLR) parser: it parses with any context-free grammar that is not cyclic (i.e., no non-terminal derives itself, `A =>+ A`), whether it is LR(1) or not, even ambiguous ones.
+	 * @details It follows Tomita's algorithm, with Farshi's correction for epsilon productions. The parse is run on a *graph-structured stack* (GSS): whenever a cell of the table has more than one action, the stack forks, and the stacks that reach the same state after the same tokens are merged back into a single node, so the number of nodes for any input position is at most the number of states.
+	 * The output is a shared packed parse forest (see ParseForest) with every parse tree of the input; ambiguities are thus packed where they occur, and the cost of parsing is polynomial even for highly ambiguous inputs (unlike enumerating the trees by backtracking, which is exponential).
+	 * @details Where the table has no conflict, there is a single stack, and every step is a lookup in the table plus a constant amount of work on the GSS and the forest (whose nodes are found in constant time through states and hash maps reset for every token), i.e., close to the cost of an LRParser step; forking is only paid for in the cells with conflicts.
+	 * @details Like LRParser, the parser is reentrant: all of the state of a parse (the GSS, the forest and their working storage) lives in a ParseContext; reusing a context over many parses reuses its storage.
+	 * @attention Semantic actions are not executed: the result of a parse is its forest, to be disambiguated and evaluated by the caller. Error recovery is not supported.
+	 * @tparam GrammarT The type of the grammar object used by the parser. It must be augmented, as for LRTableBuilder.
+	 * @tparam LexicalAnalyzerT The type of the lexical analyzer object used by the parser.
+	 * @tparam SymbolT The type of grammar symbol objects of the language of the parser.
+	 * @tparam FSMTableT The type of the finite state machine table used by the state machine that is used by the lexical analyzer that is used by the parser.
+	 * @tparam InputT The type of the input string.
+	 */
+	template <typename GrammarT, typename LexicalAnalyzerT,
+		typename SymbolT,
+		typename FSMTableT = fsm::FSMTable,
+		typename InputT = std::string>
+	class GLRParser : public Parser<LexicalAnalyzerT, SymbolT, GLRParsingTable<GrammarT>, FSMTableT, InputT> {
+
+		/**
+		 * @brief Aliases the type of the parsing table.
+		 */
+		using ParsingTableT = GLRParsingTable<GrammarT>;
+
+		/**
+		 * @brief Alias for the base parser class template.
+		 */
+		using ParserBase = Parser<LexicalAnalyzerT, SymbolT, ParsingTableT, FSMTableT, InputT>;
+
+		/**
+		 * @brief Aliases the type of a production.
+		 */
+		using ProductionType = std::remove_cvref_t<decltype(GrammarT{}.at(0))>;
+
+		/**
+		 * @brief Aliases the type of a terminal.
+		 */
+		using TerminalType = decltype(SymbolT{}.as.terminal);
+
+		/**
+		 * @brief Aliases the type of the tokens produced by the lexical analyzer.
+		 */
+		using TokenType = decltype(LexicalAnalyzerT{}.getNextToken());
+
+	public:
+
+		/**
+		 * @brief Aliases the type of the parse forest produced by the parser.
+		 */
+		using ForestType = ParseForest<SymbolT, TokenType>;
+
+	private:
+
+		/**
+		 * @brief The index of no node or edge.
+		 */
+		static constexpr uint32_t NONE = UINT32_MAX;
+
+		/**
+		 * @brief A node of the GSS: a state reached after the first `level` tokens of the input.
+		 */
+		struct GSSNode {
+			lrstate_t state = 0;
+			uint32_t level = 0;
+
+			/**
+			 * @brief The index of the first edge going out of the node (toward the beginning of the input).
+			 */
+			uint32_t firstEdge = NONE;
+		};
+
+		/**
+		 * @brief An edge of the GSS, from a node to the node below it on the stack, labeled by the forest node of the symbol between them.
+		 */
+		struct GSSEdge {
+			uint32_t source = NONE;
+			uint32_t target = NONE;
+			uint32_t label = NONE;
+
+			/**
+			 * @brief The index of the next edge going out of `source`.
+			 */
+			uint32_t next = NONE;
+		};
+
+		/**
+		 * @brief A reduction to be done: by the production `prodNumber`, along the paths going out of `node`; if `edge` is not NONE, only along the paths through `edge`.
+		 */
+		struct PendingReduction {
+			uint32_t node = NONE;
+			uint32_t prodNumber = 0;
+			uint32_t edge = NONE;
+		};
+
+		/**
+		 * @brief A shift to be done, from `node` to state `state`.
+		 */
+		struct PendingShift {
+			uint32_t node = NONE;
+			lrstate_t state = 0;
+		};
+
+		/**
+		 * @brief A path found for a reduction: the node it ends at and the index of its first label in `ParseContext::pathLabels`.
+		 */
+		struct Path {
+			uint32_t node = NONE;
+			uint32_t firstLabel = 0;
+		};
+
+		/**
+		 * @brief A hash map from 64-bit keys to indices, emptied in O(1) (by bumping a stamp) for every token.
+		 */
+		class LevelMap {
+
+			struct Slot {
+				uint64_t key = 0;
+				uint32_t value = NONE;
+				uint32_t stamp = 0;
+			};
+
+			std::vector<Slot> m_Slots = std::vector<Slot>(16);
+			size_t m_Count = 0;
+			uint32_t m_Stamp = 1;
+
+			size_t _slot(uint64_t key) const {
+				uint64_t hash = key * 0x9E3779B97F4A7C15ull;
+				hash ^= hash >> 32;
+
+				size_t slot = (size_t)hash & (this->m_Slots.size() - 1);
+				while (this->m_Slots[slot].stamp == this->m_Stamp && this->m_Slots[slot].key != key)
+					slot = (slot + 1) & (this->m_Slots.size() - 1);
+
+				return slot;
+			}
+
+		public:
+
+			/**
+			 * @brief Empties the map, keeping its storage.
+			 */
+			void clear() {
+				this->m_Count = 0;
+
+				if (++this->m_Stamp == 0) {
+					std::ranges::fill(this->m_Slots, Slot{});
+					this->m_Stamp = 1;
+				}
+			}
+
+			/**
+			 * @brief Gets the value of `key`; NONE if it is not in the map.
+			 */
+			uint32_t find(uint64_t key) const {
+				const Slot& slot = this->m_Slots[this->_slot(key)];
+
+				return slot.stamp == this->m_Stamp ? slot.value : NONE;
+			}
+
+			/**
+			 * @brief Inserts `key`, which must not be in the map, with `value`.
+			 */
+			void insert(uint64_t key, uint32_t value) {
+				if (2 * (this->m_Count + 1) > this->m_Slots.size()) {
+					std::vector<Slot> slots(2 * this->m_Slots.size());
+					std::swap(slots, this->m_Slots);
+
+					for (const Slot& slot : slots)
+						if (slot.stamp == this->m_Stamp)
+							this->m_Slots[this->_slot(slot.key)] = slot;
+				}
+
+				this->m_Slots[this->_slot(key)] = Slot{ key, value, this->m_Stamp };
+				this->m_Count++;
+			}
+		};
+
+	public:
+
+		/**
+		 * @brief The state of a single parse: its forest and the GSS, with all of the working storage of the parse.
+		 * @details A context may be reused by any number of (consecutive) parses: its storage is then allocated once and recycled.
+		 * @attention A context must not be used by two parses at the same time.
+		 */
+		struct ParseContext {
+
+			/**
+			 * @brief The lexical analyzer providing the input of this parse.
+			 */
+			LexicalAnalyzerT* lexer = nullptr;
+
+			/**
+			 * @brief The parse forest of the last parse. It is valid until the context is reused by the next parse.
+			 */
+			ForestType forest;
+
+			/**
+			 * @brief If not `nullptr` (and the library is compiled with `PARSIX_STATS`), the statistics of the parse are added to it (shifts and reductions count every stack they are done on). It is left as is by `reset()`.
+			 */
+			ParseStats* stats = nullptr;
+
+			/**
+			 * @brief The nodes and edges of the GSS.
+			 */
+			std::vector<GSSNode> nodes;
+			std::vector<GSSEdge> edges;
+
+			/**
+			 * @brief The nodes of the current level of the GSS (the tops of the stacks), in the order in which they are processed; the first `processed` of them have been processed.
+			 */
+			std::vector<uint32_t> frontier;
+			size_t processed = 0;
+
+			/**
+			 * @brief The node of every state at level `stateLevels[state]` of the GSS.
+			 */
+			std::vector<uint32_t> stateNodes;
+			std::vector<uint32_t> stateLevels;
+
+			/**
+			 * @brief The non-terminal nodes of the forest ending at the current level, by non-terminal and start.
+			 */
+			LevelMap symbolNodes;
+
+			/**
+			 * @brief The edges going out of the nodes of the current level, by source and target.
+			 */
+			LevelMap levelEdges;
+
+			/**
+			 * @brief The work lists of the current level.
+			 */
+			std::vector<PendingReduction> reductions;
+			std::vector<PendingShift> shifts;
+
+			/**
+			 * @brief The paths found for the current reduction, and the labels of their edges (from the top of the stack down).
+			 */
+			std::vector<Path> paths;
+			std::vector<uint32_t> pathLabels;
+			std::vector<uint32_t> labelStack;
+
+			/**
+			 * @brief The children of the alternative being added to the forest.
+			 */
+			std::vector<uint32_t> children;
+
+			/**
+			 * @brief Prepares the context for a new parse of the input of `lexer`, keeping all of its storage.
+			 * @param[in] lexer The lexical analyzer of the parse.
+			 * @param[in] stateCount The number of states of the table.
+			 */
+			void reset(LexicalAnalyzerT& lexer, size_t stateCount) {
+				this->lexer = &lexer;
+				this->forest.clear();
+				this->nodes.clear();
+				this->edges.clear();
+				this->frontier.clear();
+				this->processed = 0;
+				this->stateNodes.assign(stateCount, NONE);
+				this->stateLevels.assign(stateCount, NONE);
+				this->symbolNodes.clear();
+				this->levelEdges.clear();
+				this->reductions.clear();
+				this->shifts.clear();
+			}
+		};
+
+	private:
+
+		/**
+		 * @brief Gets the node of state `state` at level `level` of the GSS, creating it (and adding it to the frontier) if there is none.
+		 * @returns The node, and whether it has been created.
+		 */
+		std::pair<uint32_t, bool> _get_node(ParseContext& ctx, lrstate_t state, uint32_t level) const {
+			if (ctx.stateLevels[state] == level)
+				return { ctx.stateNodes[state], false };
+
+			const uint32_t node = (uint32_t)ctx.nodes.size();
+			ctx.nodes.push_back(GSSNode{ .state = state, .level = level });
+			ctx.stateLevels[state] = level;
+			ctx.stateNodes[state] = node;
+			ctx.frontier.push_back(node);
+
+			return { node, true };
+		}
+
+		/**
+		 * @brief Adds an edge from `source` to `target`, labeled by the forest node `label`.
+		 * @returns The index of the edge.
+		 */
+		uint32_t _add_edge(ParseContext& ctx, uint32_t source, uint32_t target, uint32_t label) const {
+			const uint32_t edge = (uint32_t)ctx.edges.size();
+			ctx.edges.push_back(GSSEdge{ .source = source, .target = target, .label = label, .next = ctx.nodes[source].firstEdge });
+			ctx.nodes[source].firstEdge = edge;
+
+			return edge;
+		}
+
+		void _find_paths(ParseContext&, uint32_t, size_t, uint32_t) const;
+		uint32_t _symbol_node(ParseContext&, const SymbolT&, uint32_t, uint32_t) const;
+		void _add_alternative(ParseContext&, uint32_t, size_t, size_t) const;
+		void _reduce(ParseContext&, const PendingReduction&, TerminalType, uint32_t) const;
+
+	public:
+
+		/**
+		 * @brief Default constructor.
+		 */
+		GLRParser() = default;
+
+		/**
+		 * @brief Parameterized constructor for GLRParser, sharing an already prepared parsing table.
+		 *
+		 * @param lexer The lexical analyzer to be used by the parser.
+		 * @param parsingTable The parsing table to be used by the parser; it must have been returned by `prepareTable()`. It is shared, not copied.
+		 * @param startSymbol The start symbol for the grammar.
+		 *
+		 * @throws std::logic_error If `parsingTable` is null.
+		 */
+		GLRParser(LexicalAnalyzerT& lexer, std::shared_ptr<const ParsingTableT> parsingTable, const SymbolT& startSymbol) :
+			ParserBase{ lexer, std::move(parsingTable), startSymbol } {
+			if (this->p_Table == nullptr) {
+				get_logger().log(LoggerInfo::ERR_MISSING_VAL, "The parsing table given to the GLR parser is null. It must be obtained from `GLRParser::prepareTable()`.");
+				throw std::logic_error("The parsing table given to the GLR parser is null.");
+			}
+		};
+
+		/**
+		 * @brief Prepares a parsing table, with every action of its cells with conflicts, to be shared by any number of GLR parsers.
+		 * @param parsingTable The table constructed by LRTableBuilder.
+		 * @param conflicts The conflicts the builder resolved while constructing `parsingTable` (see `LRTableBuilder::getConflicts()`).
+		 * @throws std::logic_error If the table contains an invalid entry.
+		 * @return The prepared, immutable table.
+		 */
+		static std::shared_ptr<const ParsingTableT> prepareTable(LRParsingTable<GrammarT> parsingTable, const std::vector<LRTableConflict<TerminalType>>& conflicts) {
+			return std::make_shared<const ParsingTableT>(std::move(parsingTable), conflicts);
+		}
+
+		/**
+		 * @brief Constructs a table of the given type with `builder` and prepares it, with the conflicts found, to be shared by any number of GLR parsers.
+		 * @throws std::logic_error As `LRTableBuilder::build()` and `prepareTable()`.
+		 */
+		static std::shared_ptr<const ParsingTableT> prepareTable(LRTableBuilder<GrammarT>& builder, LRTableType type = LRTableType::LTT_LALR1) {
+			LRParsingTable<GrammarT> table = builder.build(type);
+
+			return prepareTable(std::move(table), builder.getConflicts());
+		}
+
+		/**
+		 * @brief Parses the input of the lexical analyzer the parser was constructed with, using a fresh parse context.
+		 * @returns The parse forest of the input.
+		 * @throws std::logic_error As the overload taking a context.
+		 */
+		ForestType parse() const {
+			ParseContext ctx;
+
+			this->parse(ctx, this->get_lexical_analyzer());
+			return std::move(ctx.forest);
+		}
+
+		const ForestType& parse(ParseContext&, LexicalAnalyzerT&) const;
+	};
+
+}
+
+// IMPLEMENTATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Converting constructor. Gathers the actions of the cells with conflicts.
+	 * @param[in] table The table constructed by LRTableBuilder. It is frozen (see `LRParsingTable::freeze()`).
+	 * @param[in] conflicts The conflicts the builder resolved while constructing `table`.
+	 * @throws std::logic_error If the table contains an invalid entry.
+	 */
+	template<typename GrammarT>
+	GLRParsingTable<GrammarT>::GLRParsingTable(TableType table, const std::vector<ConflictType>& conflicts) : m_Table{ std::move(table) }
+	{
+		this->m_Table.freeze();
+
+		const size_t stateCount = this->m_Table.actionTable.size();
+
+		// every action of a conflict, by cell (a cell with n actions has n - 1 conflicts, or more)
+		std::vector<std::tuple<size_t, size_t, LRTableEntry>> cellActions;
+		cellActions.reserve(2 * conflicts.size());
+
+		for (const ConflictType& conflict : conflicts) {
+			cellActions.emplace_back(conflict.state, (size_t)conflict.terminal, conflict.kept);
+			cellActions.emplace_back(conflict.state, (size_t)conflict.terminal, conflict.discarded);
+		}
+
+		std::ranges::stable_sort(cellActions, [](const auto& lhs, const auto& rhs) {
+			return std::tie(std::get<0>(lhs), std::get<1>(lhs)) < std::tie(std::get<0>(rhs), std::get<1>(rhs));
+			});
+
+		this->m_RowBegin.assign(stateCount + 1, 0);
+
+		for (size_t begin = 0, end = 0; begin < cellActions.size(); begin = end) {
+			const auto [state, terminal, _] = cellActions[begin];
+
+			for (end = begin; end < cellActions.size() && std::get<0>(cellActions[end]) == state && std::get<1>(cellActions[end]) == terminal; end++);
+
+			// the action kept in the table comes first
+			ConflictCell cell{ .terminal = (TerminalType)terminal, .first = (uint32_t)this->m_Actions.size() };
+			this->m_Actions.push_back(this->m_Table.actionTable[state][terminal]);
+
+			for (size_t i = begin; i < end; i++) {
+				const LRTableEntry& action = std::get<2>(cellActions[i]);
+
+				if (std::ranges::find(this->m_Actions.begin() + cell.first, this->m_Actions.end(), action) == this->m_Actions.end())
+					this->m_Actions.push_back(action);
+			}
+
+			cell.count = (uint32_t)(this->m_Actions.size() - cell.first);
+			this->m_Cells.push_back(cell);
+			this->m_RowBegin[state + 1]++;
+		}
+
+		for (size_t state = 0; state < stateCount; state++)
+			this->m_RowBegin[state + 1] += this->m_RowBegin[state];
+	}
+
+	/**
+	 * @brief Extracts a parse tree of the forest into a (flat) ParseTree: that of the first alternative of every node, i.e., the derivation an LRParser using the deterministic table would have built (see `GLRParsingTable::actions()`), if it is one of the trees.
+	 * @details The tree is extracted without recursion, so deep trees (e.g., of long left-recursive lists) do not overflow the call stack. Shared subtrees are copied as many times as they are used.
+	 * @param[out] tree The tree; it is cleared first, and left empty if no input has been accepted.
+	 */
+	template<typename SymbolT, typename TokenT>
+	void ParseForest<SymbolT, TokenT>::extractTree(ParseTree& tree) const
+	{
+		tree.clear();
+
+		if (this->root == NONE)
+			return;
+
+		// the node being extracted, and the number of its children extracted so far
+		std::vector<std::pair<uint32_t, uint32_t>> stack{ { this->root, 0 } };
+
+		while (not stack.empty()) {
+			const auto [node, extracted] = stack.back();
+			const Node& current = this->nodes[node];
+
+			if (current.symbol.isTerminal) {
+				if constexpr (requires { current.token.offset; current.token.length; })
+					tree.addLeaf((uint32_t)current.symbol.as.terminal, current.token.offset, (uint32_t)current.token.length);
+				else
+					tree.addLeaf((uint32_t)current.symbol.as.terminal);
+
+				stack.pop_back();
+				continue;
+			}
+
+			const Alternative& alternative = this->alternatives[current.firstAlternative];
+
+			if (extracted < alternative.childCount) {
+				stack.back().second++;
+				stack.emplace_back(this->getChildren(alternative)[extracted], 0);
+				continue;
+			}
+
+			tree.addNode(alternative.prodNumber, alternative.childCount);
+			stack.pop_back();
+		}
+	}
+
+	/**
+	 * @brief Counts the parse trees of the forest.
+	 * @details The count of every node is computed once (the forest is a DAG), so this is linear in the size of the forest, although the number of trees may be exponential in it.
+	 * @returns The number of trees; `0` if no input has been accepted; UINT64_MAX if there are at least that many.
+	 */
+	template<typename SymbolT, typename TokenT>
+	uint64_t ParseForest<SymbolT, TokenT>::countTrees() const
+	{
+		if (this->root == NONE)
+			return 0;
+
+		constexpr uint64_t MAX = UINT64_MAX;
+		const auto add = [](uint64_t lhs, uint64_t rhs) { return lhs > MAX - rhs ? MAX : lhs + rhs; };
+		const auto multiply = [](uint64_t lhs, uint64_t rhs) { return (rhs != 0 && lhs > MAX / rhs) ? MAX : lhs * rhs; };
+
+		// 0: not visited, 1: children being counted, 2: counted
+		std::vector<uint8_t> marks(this->nodes.size(), 0);
+		std::vector<uint64_t> counts(this->nodes.size(), 0);
+		std::vector<uint32_t> stack{ this->root };
+
+		while (not stack.empty()) {
+			const uint32_t node = stack.back();
+
+			if (marks[node] == 2) {
+				stack.pop_back();
+				continue;
+			}
+
+			const Node& current = this->nodes[node];
+
+			if (marks[node] == 0) {
+				marks[node] = 1;
+
+				for (uint32_t alternative = current.firstAlternative; alternative != NONE; alternative = this->alternatives[alternative].next)
+					for (uint32_t child : this->getChildren(this->alternatives[alternative]))
+						if (marks[child] == 0)
+							stack.push_back(child);
+
+				continue;
+			}
+
+			// all of the children have been counted
+			uint64_t count = current.symbol.isTerminal ? 1 : 0;
+
+			for (uint32_t alternative = current.firstAlternative; alternative != NONE; alternative = this->alternatives[alternative].next) {
+				uint64_t product = 1;
+
+				for (uint32_t child : this->getChildren(this->alternatives[alternative]))
+					product = multiply(product, counts[child]);
+
+				count = add(count, product);
+			}
+
+			counts[node] = count;
+			marks[node] = 2;
+			stack.pop_back();
+		}
+
+		return counts[this->root];
+	}
+
+	/**
+	 * @brief Finds the paths of `length` edges going out of `node` (through `edge`, unless it is NONE), for a reduction.
+	 * @details Every path is appended to `ctx.paths`, and the labels of its edges (from `node` down) to `ctx.pathLabels`.
+	 * @details Since the grammar is not cyclic, a path never visits a node twice; hence, a path through `edge` must take it when it reaches its source, and cannot reach it once below its level.
+	 */
+	template<typename GrammarT, typename LexicalAnalyzerT, typename SymbolT, typename FSMTableT, typename InputT>
+	void GLRParser<GrammarT, LexicalAnalyzerT, SymbolT, FSMTableT, InputT>::_find_paths(ParseContext& ctx, uint32_t node, size_t length, uint32_t edge) const
+	{
+		if (length == 0) {
+			if (edge == NONE) {
+				ctx.paths.push_back(Path{ .node = node, .firstLabel = (uint32_t)ctx.pathLabels.size() });
+				ctx.pathLabels.insert(ctx.pathLabels.end(), ctx.labelStack.begin(), ctx.labelStack.end());
+			}
+
+			return;
+		}
+
+		const uint32_t source = edge == NONE ? NONE : ctx.edges[edge].source;
+
+		if (source != NONE && ctx.nodes[node].level < ctx.nodes[source].level)
+			return;
+
+		if (node == source) {
+			ctx.labelStack.push_back(ctx.edges[edge].label);
+			this->_find_paths(ctx, ctx.edges[edge].target, length - 1, NONE);
+			ctx.labelStack.pop_back();
+			return;
+		}
+
+		for (uint32_t next = ctx.nodes[node].firstEdge; next != NONE; next = ctx.edges[next].next) {
+			ctx.labelStack.push_back(ctx.edges[next].label);
+			this->_find_paths(ctx, ctx.edges[next].target, length - 1, edge);
+			ctx.labelStack.pop_back();
+		}
+	}
+
+	/**
+	 * @brief Gets the forest node of the non-terminal `symbol` spanning the tokens [`start`, `level`), creating it if there is none.
+	 */
+	template<typename GrammarT, typename LexicalAnalyzerT, typename SymbolT, typename FSMTableT, typename InputT>
+	uint32_t GLRParser<GrammarT, LexicalAnalyzerT, SymbolT, FSMTableT, InputT>::_symbol_node(ParseContext& ctx, const SymbolT& symbol, uint32_t start, uint32_t level) const
+	{
+		const uint64_t key = ((uint64_t)symbol.as.nonTerminal << 32) | start;
+
+		if (const uint32_t node = ctx.symbolNodes.find(key); node != NONE)
+			return node;
+
+		const uint32_t node = (uint32_t)ctx.forest.nodes.size();
+		ctx.forest.nodes.push_back(typename ForestType::Node{ .symbol = symbol, .start = start, .end = level });
+		ctx.symbolNodes.insert(key, node);
+
+		return node;
+	}
+
+	/**
+	 * @brief Adds to the forest node `node` the alternative by the production `prodNumber` whose children are those of `ctx.children`, unless it already has it.
+	 * @param[in] firstChild The index of the first child in `ctx.children`.
+	 * @param[in] childCount The number of children.
+	 */
+	template<typename GrammarT, typename LexicalAnalyzerT, typename SymbolT, typename FSMTableT, typename InputT>
+	void GLRParser<GrammarT, LexicalAnalyzerT, SymbolT, FSMTableT, InputT>::_add_alternative(ParseContext& ctx, uint32_t node, size_t prodNumber, size_t childCount) const
+	{
+		ForestType& forest = ctx.forest;
+		const auto children = std::span<const uint32_t>{ ctx.children }.first(childCount);
+
+		// an alternative found again (e.g., through an edge added after its path had been found) is not packed twice
+		for (uint32_t alternative = forest.nodes[node].firstAlternative; alternative != NONE; alternative = forest.alternatives[alternative].next) {
+			const auto& current = forest.alternatives[alternative];
+
+			if (current.prodNumber == prodNumber && std::ranges::equal(forest.getChildren(current), children))
+				return;
+		}
+
+		forest.alternatives.push_back(typename ForestType::Alternative{ .prodNumber = (uint32_t)prodNumber, .firstChild = (uint32_t)forest.children.size(), .childCount = (uint32_t)childCount, .next = forest.nodes[node].firstAlternative });
+		forest.children.insert(forest.children.end(), children.begin(), children.end());
+		forest.nodes[node].firstAlternative = (uint32_t)(forest.alternatives.size() - 1);
+		forest.nodes[node].alternativeCount++;
+	}
+
+	/**
+	 * @brief Does a reduction on the GSS, along all of its paths.
+	 * @param[in, out] ctx The context of the parse.
+	 * @param[in] reduction The reduction.
+	 * @param[in] lookahead The current token.
+	 * @param[in] level The current level of the GSS.
+	 *
+	 * @details For every path, the forest node of the head of the production over the tokens of the path gets the alternative made of the labels of the path, and the top of the stack after the reduction, i.e., the node of GOTO[S][head] (where S is the end of the path) at the current level, gets an edge to the end of the path, labeled by the forest node.
+	 * If the node already existed but the edge did not, the stacks through the new edge have not been reduced yet: the reductions of the nodes processed so far are done again along the paths through the new edge (Farshi's correction, needed when the new edge can be reached through epsilon reductions).
+	 */
+	template<typename GrammarT, typename LexicalAnalyzerT, typename SymbolT, typename FSMTableT, typename InputT>
+	void GLRParser<GrammarT, LexicalAnalyzerT, SymbolT, FSMTableT, InputT>::_reduce(ParseContext& ctx, const PendingReduction& reduction, TerminalType lookahead, uint32_t level) const
+	{
+		const ParsingTableT& table = *this->p_Table;
+		const auto& production = table.production(reduction.prodNumber);
+		const size_t length = production.isEpsilon() ? 0 : production.size();
+
+		ctx.paths.clear();
+		ctx.pathLabels.clear();
+		this->_find_paths(ctx, reduction.node, length, reduction.edge);
+
+		for (const Path& path : ctx.paths) {
+			const uint32_t below = path.node;
+			const lrstate_t state = (lrstate_t)table.atGoto(ctx.nodes[below].state, production.prodHead.as.nonTerminal).number;
+
+			// the labels of the path are from the top of the stack down, i.e., in the reverse order of the body
+			ctx.children.assign(ctx.pathLabels.rbegin() + (ctx.pathLabels.size() - path.firstLabel - length), ctx.pathLabels.rbegin() + (ctx.pathLabels.size() - path.firstLabel));
+
+			const uint32_t label = this->_symbol_node(ctx, production.prodHead, ctx.nodes[below].level, level);
+			this->_add_alternative(ctx, label, reduction.prodNumber, length);
+			record_stats(ctx.stats, &ParseStats::recordReduction, (size_t)reduction.prodNumber);
+
+			const auto [top, created] = this->_get_node(ctx, state, level);
+			const uint64_t edgeKey = ((uint64_t)top << 32) | below;
+
+			if (created) {
+				ctx.levelEdges.insert(edgeKey, this->_add_edge(ctx, top, below, label));
+				continue;
+			}
+
+			// the edge exists: its label has just got the alternative
+			if (ctx.levelEdges.find(edgeKey) != NONE)
+				continue;
+
+			const uint32_t edge = this->_add_edge(ctx, top, below, label);
+			ctx.levelEdges.insert(edgeKey, edge);
+
+			for (size_t i = 0; i < ctx.processed; i++) {
+				const uint32_t node = ctx.frontier[i];
+
+				for (const LRTableEntry& action : table.actions(ctx.nodes[node].state, lookahead))
+					if (action.type == LRTableEntryType::TET_ACTION_REDUCE && not table.production(action.number).isEpsilon())
+						ctx.reductions.push_back(PendingReduction{ .node = node, .prodNumber = (uint32_t)action.number, .edge = edge });
+			}
+		}
+	}
+
+	/**
+	 * @brief Parses the input of `lexer`, building the forest of all of its parse trees.
+	 *
+	 * @param[in, out] ctx The context of the parse. It is reset first (keeping its storage).
+	 * @param[in] lexer The lexical analyzer providing the input.
+	 *
+	 * @details For every token, the nodes of the current level of the GSS are processed in turn: their reductions on the token are done right away (which may add nodes to the level, processed in turn), and their shifts are recorded. Then, the shifts are done together, making the next level, whose nodes share the forest node of the token.
+	 * The input is accepted if, at its end, the level has a node with an accept action; the root of the forest is the label of its edge down to the start state.
+	 *
+	 * @throws std::logic_error If the input does not belong to the grammar (i.e., every stack has reached an error).
+	 * @returns The forest of the input, in `ctx`.
+	 */
+	template<typename GrammarT, typename LexicalAnalyzerT, typename SymbolT, typename FSMTableT, typename InputT>
+	auto GLRParser<GrammarT, LexicalAnalyzerT, SymbolT, FSMTableT, InputT>::parse(ParseContext& ctx, LexicalAnalyzerT& lexer) const -> const ForestType&
+	{
+		const ParsingTableT& table = *this->p_Table;
+
+		ctx.reset(lexer, table.getStateCount());
+
+		uint32_t level = 0;
+		this->_get_node(ctx, 0, level);
+
+		TokenType token = this->get_next_token(lexer);
+		record_stats(ctx.stats, &ParseStats::recordToken);
+
+		while (true) {
+			ctx.symbolNodes.clear();
+			ctx.levelEdges.clear();
+			ctx.shifts.clear();
+
+			uint32_t acceptingNode = NONE;
+
+			// REDUCTIONS: process the nodes of the level, including the ones added by the reductions
+			for (size_t i = 0; i < ctx.frontier.size(); i++) {
+				const uint32_t node = ctx.frontier[i];
+				const auto actions = table.actions(ctx.nodes[node].state, token.name);
+				ctx.processed = i + 1;
+
+				if (actions.size() > 1)
+					this->log_trace(LoggerInfo::INFO, [&] { return std::format("Forking on {} actions in state {} on token {}", actions.size(), ctx.nodes[node].state, token.toString()); });
+
+				for (const LRTableEntry& action : actions) {
+					switch (action.type) {
+					case LRTableEntryType::TET_ACTION_SHIFT:
+						ctx.shifts.push_back(PendingShift{ .node = node, .state = (lrstate_t)action.number });
+						break;
+
+					case LRTableEntryType::TET_ACTION_REDUCE:
+						ctx.reductions.push_back(PendingReduction{ .node = node, .prodNumber = (uint32_t)action.number });
+						break;
+
+					case LRTableEntryType::TET_ACCEPT:
+						acceptingNode = node;
+						break;
+
+					default:
+						break;
+					}
+				}
+
+				while (not ctx.reductions.empty()) {
+					const PendingReduction reduction = ctx.reductions.back();
+					ctx.reductions.pop_back();
+					this->_reduce(ctx, reduction, token.name, level);
+				}
+			}
+
+			// ACCEPTANCE: the root is the label of the edge of the accepting node down to the start node
+			if (acceptingNode != NONE) {
+				for (uint32_t edge = ctx.nodes[acceptingNode].firstEdge; edge != NONE; edge = ctx.edges[edge].next)
+					if (ctx.edges[edge].target == 0)
+						ctx.forest.root = ctx.edges[edge].label;
+
+				return ctx.forest;
+			}
+
+			if (ctx.shifts.empty()) {
+				const std::string msg = std::format("Cannot continue further with the parse! Every stack has reached an error; It looks like this string does not belong to the grammar.\nCurrent token: {}\nToken number: {}\nCurrent input: {}", token.toString(), level, this->get_source_excerpt(lexer));
+				get_logger().log(LoggerInfo::ERR_UNACCEPTED_STRING, msg);
+
+				throw std::logic_error("Cannot continue further with the parse! Every stack has reached an error; It looks like this string does not belong to the grammar.");
+			}
+
+			// SHIFTS: make the next level; all of its nodes share the forest node of the token
+			const uint32_t tokenNode = (uint32_t)ctx.forest.nodes.size();
+			ctx.forest.nodes.push_back(typename ForestType::Node{ .symbol = SymbolT{ .isTerminal = true, .as = {.terminal = token.name } }, .start = level, .end = level + 1, .token = token });
+
+			level++;
+			ctx.frontier.clear();
+			ctx.processed = 0;
+
+			for (const PendingShift& shift : ctx.shifts) {
+				this->_add_edge(ctx, this->_get_node(ctx, shift.state, level).first, shift.node, tokenNode);
+				record_stats(ctx.stats, &ParseStats::recordShift);
+			}
+
+			token = this->get_next_token(lexer);
+			record_stats(ctx.stats, &ParseStats::recordToken);
+		}
+	}
+
+}
@@ -0,0 +1,585 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parsix/ChunkedInput.h"
+#include "parsix/StreamingLexer.h"
+#include "parsix/parser.h"
+
+// DECLARATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Reparses a source after small edits, reusing as much of the previous parse as is still valid (in the style of Wagner and Graham).
+	 * @details The source is kept in memory and parsed by a push-driven LR parse (see `LRParser::beginPush()`) whose lexical analyzer is a StreamingLexer. While parsing, two things are recorded:
+		* *Checkpoints*: copies of the stack (with the position of the lexical analyzer), every `checkpointInterval` steps.
+		* *Subtrees*: the states of the reduced nonterminals (see `ParseContext::reductions`), each with the span of its text and the state below it (which is where its parse began).
+	 * Every record is only a function of the text from its beginning up to its *dependency end*: the end of the token that was the lookahead when it was recorded, plus one byte (the byte after a token that decides where the token ends).
+	 * After an edit, the parse resumes from the last checkpoint whose dependency end is not past the edit, so the unchanged prefix is not parsed again. Past the edited text, before every token that begins a recorded subtree, the parser takes the reductions it would take on that token (see `LRParser::reduceOn()`); if the state on top of the stack is the state below the subtree, the parse from there would rebuild the very same subtree, so it is pushed as a whole (see `LRParser::pushSubtree()`) and its text is skipped. Hence, only the damaged region is parsed token by token; past it, the cost is about one step per reused subtree.
+	 * Records that do not depend on the edited text stay valid (those after it are moved by the length difference), so they are kept for the next edits.
+	 * @attention The data of reused subtrees is that computed by the previous parses: semantic actions must compute the data of the head of a production only from the states of its body, and that data must not depend on the absolute position of the text (e.g., it must not store offsets), since the text of a reused subtree may have moved.
+	 * @attention The arena of the parse context is never reset by an edit, since reused data may live in it; it is reset by `parse()`.
+	 * @tparam ParserT The type of the parser; an LRParser whose lexical analyzer is a StreamingLexer (i.e, whose tokens are OffsetToken objects).
+	 * @tparam ParserResultT The type of the result of a parse.
+	 */
+	template <typename ParserT, typename ParserResultT = ParserResult>
+	class IncrementalParser {
+
+		/**
+		 * @brief Aliases the type of the parse context of the parser.
+		 */
+		using ParseContextType = typename ParserT::ParseContext;
+
+		/**
+		 * @brief Aliases the type of the lexical analyzer of the parser.
+		 */
+		using LexerType = std::remove_pointer_t<decltype(ParseContextType{}.lexer)>;
+
+		/**
+		 * @brief Aliases the type of the parsing stack.
+		 */
+		using StackType = decltype(ParseContextType{}.stack);
+
+		/**
+		 * @brief Aliases the type of an LR parsing state.
+		 */
+		using StateType = typename StackType::value_type;
+
+		/**
+		 * @brief Aliases the type of a token.
+		 */
+		using TokenType = decltype(ParseContextType{}.currInputToken);
+
+		/**
+		 * @brief A copy of the stack of the parse at some point, from which the parse can be resumed.
+		 */
+		struct Checkpoint {
+
+			/**
+			 * @brief The offset of the first byte the lexical analyzer had not read.
+			 */
+			uint64_t offset = 0;
+
+			/**
+			 * @brief The line and column of the byte at `offset`.
+			 */
+			size_t line = 1, col = 1;
+
+			/**
+			 * @brief The end of the text the checkpoint depends on (see the class documentation).
+			 */
+			uint64_t dependencyEnd = 0;
+
+			/**
+			 * @brief The stack of the parse.
+			 */
+			StackType stack;
+		};
+
+		/**
+		 * @brief The state of a nonterminal recorded during a parse, which can be pushed as a whole by a later parse.
+		 */
+		struct Subtree {
+
+			/**
+			 * @brief The end of the text the subtree depends on (see the class documentation).
+			 */
+			uint64_t dependencyEnd = 0;
+
+			/**
+			 * @brief The number of the state below the nonterminal on the stack.
+			 */
+			lrstate_t stateBelow = 0;
+
+			/**
+			 * @brief The state of the nonterminal, with its data; its token spans the text of the nonterminal.
+			 */
+			StateType state;
+
+			/**
+			 * @brief Gets the offset of the beginning of the text of the nonterminal.
+			 */
+			uint64_t start() const { return this->state.token.offset; }
+
+			/**
+			 * @brief Gets the offset right past the end of the text of the nonterminal.
+			 */
+			uint64_t end() const { return this->state.token.offset + this->state.token.length; }
+
+			/**
+			 * @brief Orders subtrees by beginning, then outermost first; the rest of the fields only make the order total.
+			 */
+			bool operator<(const Subtree& rhs) const {
+				if (this->start() != rhs.start())
+					return this->start() < rhs.start();
+				if (this->end() != rhs.end())
+					return this->end() > rhs.end();
+				if (this->stateBelow != rhs.stateBelow)
+					return this->stateBelow < rhs.stateBelow;
+
+				return this->state.state < rhs.state.state;
+			}
+
+			/**
+			 * @brief Checks whether two records are of the same subtree.
+			 */
+			bool isSame(const Subtree& rhs) const {
+				return this->start() == rhs.start() && this->end() == rhs.end() && this->stateBelow == rhs.stateBelow && this->state.state == rhs.state.state;
+			}
+		};
+
+		/**
+		 * @brief An edit of the source: the bytes [`offset`, `oldEnd`) were replaced by the bytes [`offset`, `newEnd`). The default one is no edit.
+		 */
+		struct Edit {
+			uint64_t offset = UINT64_MAX, oldEnd = UINT64_MAX, newEnd = UINT64_MAX;
+
+			/**
+			 * @brief Moves an offset at or after the end of the removed bytes to the edited source.
+			 */
+			uint64_t moved(uint64_t oldOffset) const noexcept(true) { return oldOffset - this->oldEnd + this->newEnd; }
+
+			/**
+			 * @brief Moves a record past the edit to the edited source.
+			 */
+			Subtree moved(Subtree subtree) const {
+				subtree.dependencyEnd = this->moved(subtree.dependencyEnd);
+				subtree.state.token.offset = this->moved(subtree.state.token.offset);
+
+				return subtree;
+			}
+		};
+
+	public:
+
+		/**
+		 * @brief What the last (re)parse did.
+		 */
+		struct ReparseStats {
+
+			/**
+			 * @brief The offset the parse resumed from.
+			 */
+			uint64_t resumeOffset = 0;
+
+			/**
+			 * @brief The number of tokens scanned.
+			 */
+			size_t tokenCount = 0;
+
+			/**
+			 * @brief The number of subtrees pushed as a whole.
+			 */
+			size_t reusedSubtreeCount = 0;
+
+			/**
+			 * @brief The number of bytes skipped within reused subtrees.
+			 */
+			uint64_t reusedByteCount = 0;
+		};
+
+		/**
+		 * @brief The default number of parse steps between two checkpoints.
+		 */
+		static constexpr size_t DEFAULT_CHECKPOINT_INTERVAL = 256;
+
+		/**
+		 * @brief The default length of the text of the shortest subtrees that are recorded.
+		 */
+		static constexpr size_t DEFAULT_MIN_SUBTREE_LENGTH = 16;
+
+	private:
+
+		/**
+		 * @brief The parser.
+		 */
+		const ParserT* m_Parser = nullptr;
+
+		/**
+		 * @brief The source.
+		 */
+		std::string m_Source;
+
+		/**
+		 * @brief The input of the lexical analyzer; a view of the source.
+		 */
+		ChunkedInput m_Input;
+
+		/**
+		 * @brief The lexical analyzer.
+		 */
+		LexerType m_Lexer;
+
+		/**
+		 * @brief The context of the parse.
+		 */
+		ParseContextType m_Context;
+
+		/**
+		 * @brief The reductions of the current parse step.
+		 */
+		std::vector<typename ParseContextType::Reduction> m_Reductions;
+
+		/**
+		 * @brief The initial result of every parse.
+		 */
+		ParserResultT m_InitResult{};
+
+		/**
+		 * @brief The result of the last parse.
+		 */
+		ParserResultT m_Result{};
+
+		/**
+		 * @brief The number of parse steps between two checkpoints.
+		 */
+		size_t m_CheckpointInterval = DEFAULT_CHECKPOINT_INTERVAL;
+
+		/**
+		 * @brief The length of the text of the shortest subtrees that are recorded.
+		 */
+		size_t m_MinSubtreeLength = DEFAULT_MIN_SUBTREE_LENGTH;
+
+		/**
+		 * @brief The checkpoints, by offset. The first one is the start of the source; there are none before the first parse.
+		 */
+		std::vector<Checkpoint> m_Checkpoints;
+
+		/**
+		 * @brief The recorded subtrees that are still valid, in their order (see `Subtree::operator<()`).
+		 */
+		std::vector<Subtree> m_Subtrees;
+
+		/**
+		 * @brief The storage the subtrees are merged into (see `_finish()`).
+		 */
+		std::vector<Subtree> m_MergedSubtrees;
+
+		/**
+		 * @brief What the last parse did.
+		 */
+		ReparseStats m_Stats;
+
+		/**
+		 * @brief Finds the first (i.e., outermost) subtree beginning at `start`.
+		 * @returns An iterator to the subtree; the end of `subtrees` if there is none.
+		 */
+		static auto _first_subtree_at(std::span<const Subtree> subtrees, uint64_t start) {
+			auto it = std::lower_bound(subtrees.begin(), subtrees.end(), start, [](const Subtree& subtree, uint64_t start) { return subtree.start() < start; });
+
+			return it != subtrees.end() && it->start() == start ? it : subtrees.end();
+		}
+
+		void _record(uint64_t, std::vector<Subtree>&);
+		const Subtree* _find_subtree(std::span<const Subtree>, uint64_t, lrstate_t) const;
+		void _run(std::span<const Subtree>, const Edit&, std::vector<Subtree>&);
+		void _finish(std::vector<Subtree>, const Edit&);
+
+	public:
+
+		/**
+		 * @brief Constructs an incremental parser of a source, which is not parsed until `parse()` is called.
+		 * @param[in] parser The parser; it must outlive the incremental parser.
+		 * @param[in] source The source.
+		 * @param[in] scan The scan function of the lexical analyzer (see StreamingLexer).
+		 * @param[in] initResult The initial result of every parse.
+		 * @param[in] checkpointInterval The number of parse steps between two checkpoints; the smaller it is, the less of the prefix is parsed again after an edit, and the more memory checkpoints take.
+		 * @param[in] minSubtreeLength The length of the text of the shortest subtrees that are recorded. Reusing a subtree costs about as much as scanning a token, so recording short ones mostly costs memory (and time to keep them up to date after every edit).
+		 */
+		IncrementalParser(const ParserT& parser, std::string source, typename LexerType::ScanFunctionType scan, const ParserResultT& initResult = ParserResultT{}, size_t checkpointInterval = DEFAULT_CHECKPOINT_INTERVAL, size_t minSubtreeLength = DEFAULT_MIN_SUBTREE_LENGTH) :
+			m_Parser{ &parser }, m_Source{ std::move(source) }, m_Input{ ChunkedInput::view(m_Source) },
+			m_Lexer{ m_Input, std::move(scan) }, m_InitResult{ initResult }, m_CheckpointInterval{ std::max<size_t>(checkpointInterval, 1) },
+			m_MinSubtreeLength{ std::max<size_t>(minSubtreeLength, 1) }
+		{
+			this->m_Context.reductions = &this->m_Reductions;
+		}
+
+		IncrementalParser(const IncrementalParser&) = delete;
+		IncrementalParser& operator=(const IncrementalParser&) = delete;
+
+		const ParserResultT& parse();
+		const ParserResultT& edit(size_t offset, size_t removed, std::string_view inserted);
+
+		/**
+		 * @brief Gets the source, with every edit applied.
+		 */
+		const std::string& getSource() const { return this->m_Source; }
+
+		/**
+		 * @brief Gets the result of the last parse; it is meaningless if that parse failed.
+		 */
+		const ParserResultT& getResult() const { return this->m_Result; }
+
+		/**
+		 * @brief Gets the lexical analyzer, e.g., to get the text of tokens from within semantic actions (see `StreamingLexer::text()`).
+		 */
+		const LexerType& getLexer() const { return this->m_Lexer; }
+
+		/**
+		 * @brief Gets what the last parse did.
+		 */
+		const ReparseStats& getStats() const { return this->m_Stats; }
+
+		/**
+		 * @brief Gets the number of subtrees currently recorded.
+		 */
+		size_t getSubtreeCount() const { return this->m_Subtrees.size(); }
+
+	};
+
+}
+
+// IMPLEMENTATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Records the subtrees of the reductions of the current parse step, and clears them.
+	 * @param[in] dependencyEnd The dependency end of the new records.
+	 * @param[out] recorded The vector the records are appended to.
+	 */
+	template <typename ParserT, typename ParserResultT>
+	void IncrementalParser<ParserT, ParserResultT>::_record(uint64_t dependencyEnd, std::vector<Subtree>& recorded)
+	{
+		const auto& reductions = this->m_Reductions;
+
+		for (size_t i = 0; i < reductions.size(); i++) {
+			const StateType& state = reductions[i].state;
+
+			// short subtrees are not worth reusing (and those of empty text could not be found by the offset of their beginning anyway)
+			if (state.token.length < this->m_MinSubtreeLength)
+				continue;
+
+			// a chain of unit reductions on top of the same state gives subtrees of the same text; the outermost one is enough
+			if (i + 1 < reductions.size()) {
+				const auto& next = reductions[i + 1];
+
+				if (next.stateBelow == reductions[i].stateBelow && next.state.token.offset == state.token.offset && next.state.token.length == state.token.length)
+					continue;
+			}
+
+			recorded.push_back(Subtree{ .dependencyEnd = dependencyEnd, .stateBelow = reductions[i].stateBelow, .state = state });
+		}
+
+		this->m_Reductions.clear();
+	}
+
+	/**
+	 * @brief Finds the outermost subtree beginning at `start` and built on top of state `stateBelow`.
+	 * @returns The subtree; `nullptr` if there is none.
+	 */
+	template <typename ParserT, typename ParserResultT>
+	auto IncrementalParser<ParserT, ParserResultT>::_find_subtree(std::span<const Subtree> subtrees, uint64_t start, lrstate_t stateBelow) const -> const Subtree*
+	{
+		for (auto it = _first_subtree_at(subtrees, start); it != subtrees.end() && it->start() == start; ++it)
+			if (it->stateBelow == stateBelow)
+				return &*it;
+
+		return nullptr;
+	}
+
+	/**
+	 * @brief Runs the parse from the current position of the lexical analyzer to acceptance, recording checkpoints and subtrees.
+	 * @param[in] reusable The subtrees that may be pushed as a whole, in their order. They were recorded before `edit`, and they all begin after the removed bytes of it.
+	 * @param[in] edit The edit since the subtrees were recorded.
+	 * @param[out] recorded The vector the new subtree records are appended to.
+	 * @throws std::logic_error If the source does not belong to the grammar.
+	 * @throws std::runtime_error If the source cannot be scanned.
+	 */
+	template <typename ParserT, typename ParserResultT>
+	void IncrementalParser<ParserT, ParserResultT>::_run(std::span<const Subtree> reusable, const Edit& edit, std::vector<Subtree>& recorded)
+	{
+		ParseContextType& ctx = this->m_Context;
+		LexerType& lexer = this->m_Lexer;
+
+		for (size_t steps = 1; ; steps++) {
+			const uint64_t offset = lexer.getOffset();
+			const size_t line = lexer.getLine(), col = lexer.getCol();
+			const TokenType token = lexer.getNextToken();
+			this->m_Stats.tokenCount++;
+
+			uint64_t dependencyEnd = token.offset + token.length + 1;
+
+			const Subtree* subtree = nullptr;
+
+			// past the edited text, take the reductions that come before a token beginning a subtree (whose offsets are still those from before the edit), then see whether the subtree was built on top of the resulting state
+			if (token.offset >= edit.newEnd && token.name != TokenType::TEOF.name) {
+				const uint64_t oldOffset = token.offset - edit.newEnd + edit.oldEnd;
+
+				if (_first_subtree_at(reusable, oldOffset) != reusable.end()) {
+					this->m_Parser->reduceOn(ctx, token);
+					subtree = this->_find_subtree(reusable, oldOffset, ctx.currState);
+				}
+			}
+
+			if (subtree != nullptr) {
+				const Subtree moved = edit.moved(*subtree);
+
+				this->m_Parser->pushSubtree(ctx, moved.state);
+				this->_record(dependencyEnd, recorded);
+
+				lexer.seek(offset, line, col);
+				lexer.skip((size_t)(moved.end() - offset));
+
+				dependencyEnd = std::max(dependencyEnd, moved.dependencyEnd);
+				this->m_Stats.reusedSubtreeCount++;
+				this->m_Stats.reusedByteCount += moved.end() - moved.start();
+			}
+			else {
+				if (this->m_Parser->feed(ctx, token, this->m_Result) == PushStatus::PS_ACCEPTED)
+					return;
+
+				this->_record(dependencyEnd, recorded);
+			}
+
+			if (steps % this->m_CheckpointInterval == 0)
+				this->m_Checkpoints.push_back(Checkpoint{ .offset = lexer.getOffset(), .line = lexer.getLine(), .col = lexer.getCol(), .dependencyEnd = dependencyEnd, .stack = ctx.stack });
+		}
+	}
+
+	/**
+	 * @brief Updates the recorded subtrees past an edit, in a single pass: the ones that depend on the edited text are dropped, the ones after it are moved, and the (unordered) new ones are added, without duplicates.
+	 * @details The subtrees before the edit all come before the ones after it (see `Subtree::operator<()`), so moving the latter keeps the order.
+	 */
+	template <typename ParserT, typename ParserResultT>
+	void IncrementalParser<ParserT, ParserResultT>::_finish(std::vector<Subtree> recorded, const Edit& edit)
+	{
+		std::sort(recorded.begin(), recorded.end());
+
+		// merge into the storage of the previous merge, which is kept to spare allocating (and faulting in) as much memory again on every edit
+		std::vector<Subtree>& merged = this->m_MergedSubtrees;
+		merged.clear();
+		merged.reserve(this->m_Subtrees.size() + recorded.size());
+
+		auto append = [&merged](Subtree&& subtree) {
+			if (merged.empty() || not merged.back().isSame(subtree))
+				merged.push_back(std::move(subtree));
+		};
+
+		auto newIt = recorded.begin();
+
+		for (Subtree& subtree : this->m_Subtrees) {
+			if (subtree.start() >= edit.oldEnd)
+				subtree = edit.moved(std::move(subtree));
+			else if (subtree.dependencyEnd > edit.offset)
+				continue;
+
+			for (; newIt != recorded.end() && *newIt < subtree; ++newIt)
+				append(std::move(*newIt));
+
+			append(std::move(subtree));
+		}
+
+		for (; newIt != recorded.end(); ++newIt)
+			append(std::move(*newIt));
+
+		std::swap(this->m_Subtrees, merged);
+	}
+
+	/**
+	 * @brief Parses the whole source from scratch, discarding everything recorded so far and resetting the parse context (with its arena).
+	 * @returns The result of the parse.
+	 * @throws std::logic_error If the source does not belong to the grammar.
+	 * @throws std::runtime_error If the source cannot be scanned.
+	 */
+	template <typename ParserT, typename ParserResultT>
+	const ParserResultT& IncrementalParser<ParserT, ParserResultT>::parse()
+	{
+		this->m_Checkpoints.clear();
+		this->m_Subtrees.clear();
+		this->m_Stats = ReparseStats{};
+
+		this->m_Parser->beginPush(this->m_Context);
+		this->m_Context.lexer = &this->m_Lexer;
+		this->m_Lexer.seek(0, 1, 1);
+		this->m_Result = this->m_InitResult;
+
+		this->m_Checkpoints.push_back(Checkpoint{ .stack = this->m_Context.stack });
+
+		std::vector<Subtree> recorded;
+		this->m_Reductions.clear();
+
+		// whatever was recorded before an error is still valid for the source
+		try {
+			this->_run({}, Edit{}, recorded);
+		}
+		catch (...) {
+			this->_finish(std::move(recorded), Edit{});
+			throw;
+		}
+
+		this->_finish(std::move(recorded), Edit{});
+
+		return this->m_Result;
+	}
+
+	/**
+	 * @brief Replaces `removed` bytes of the source at `offset` by `inserted`, then reparses it, reusing whatever the edit did not affect (see the class documentation).
+	 * @details If there was no parse yet, the source is parsed from scratch (see `parse()`). A failed parse is as good a starting point as a successful one: whatever it recorded before the error is still valid, so fixing the error is as cheap as any other edit.
+	 * @returns The result of the parse.
+	 * @throws std::out_of_range If the removed bytes are not within the source.
+	 * @throws std::logic_error If the edited source does not belong to the grammar; the edit is applied anyway (and later edits can fix it).
+	 * @throws std::runtime_error If the edited source cannot be scanned; the edit is applied anyway (and later edits can fix it).
+	 */
+	template <typename ParserT, typename ParserResultT>
+	const ParserResultT& IncrementalParser<ParserT, ParserResultT>::edit(size_t offset, size_t removed, std::string_view inserted)
+	{
+		if (offset > this->m_Source.size() || removed > this->m_Source.size() - offset)
+			throw std::out_of_range(std::format("Cannot remove bytes [{}, {}) from a source of {} bytes.", offset, offset + removed, this->m_Source.size()));
+
+		this->m_Source.replace(offset, removed, inserted);
+		this->m_Input = ChunkedInput::view(this->m_Source);
+
+		if (this->m_Checkpoints.empty())
+			return this->parse();
+
+		const Edit edit{ .offset = offset, .oldEnd = offset + removed, .newEnd = offset + inserted.size() };
+
+		// the subtrees that begin after the removed bytes, which are the last ones, are still valid; they are moved to the edited source by `_finish()`
+		const auto reusableBegin = std::lower_bound(this->m_Subtrees.begin(), this->m_Subtrees.end(), edit.oldEnd, [](const Subtree& subtree, uint64_t start) { return subtree.start() < start; });
+		const std::span<const Subtree> reusable{ reusableBegin, this->m_Subtrees.end() };
+
+		// resume from the last checkpoint that does not depend on the edited text (the first one never does)
+		while (this->m_Checkpoints.size() > 1 && this->m_Checkpoints.back().dependencyEnd > offset)
+			this->m_Checkpoints.pop_back();
+
+		const Checkpoint& checkpoint = this->m_Checkpoints.back();
+		ParseContextType& ctx = this->m_Context;
+
+		ctx.stack = checkpoint.stack;
+		ctx.currState = ctx.stack.back().state;
+		ctx.accepted = false;
+		ctx.errorNum = 0;
+		ctx.lexer = &this->m_Lexer;
+
+		this->m_Lexer.seek(checkpoint.offset, checkpoint.line, checkpoint.col);
+		this->m_Result = this->m_InitResult;
+		this->m_Stats = ReparseStats{ .resumeOffset = checkpoint.offset };
+
+		std::vector<Subtree> recorded;
+		this->m_Reductions.clear();
+
+		// whatever was recorded before an error is still valid for the source
+		try {
+			this->_run(reusable, edit, recorded);
+		}
+		catch (...) {
+			this->_finish(std::move(recorded), edit);
+			throw;
+		}
+
+		this->_finish(std::move(recorded), edit);
+
+		return this->m_Result;
+	}
+
+}
@@ -1,20 +1,23 @@
 #pragma once
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "parsix/config.h"
 #include "parsix/production.h"
+#include "parsix/TerminalSet.h"
 #include "utility/common.h"
 
 // DECLARATOIN
 namespace m0st4fa::parsix {
 
 	/**
-	 * @brief A set of symbols that constitute the lookaheads of an Item.
+	 * @brief A set of symbols that constitute the lookaheads of an Item. Lookaheads are always terminals, so they are stored as a bitset (see TerminalSet).
 	 * @tparam SymbolT The type of a lookahead symbol.
 	*/
 	template <typename SymbolT>
-	using LookAheadSet = std::set<SymbolT>;
+	using LookAheadSet = TerminalSet<SymbolT>;
 
 	/**
 	 * @brief An LR item.
@@ -46,11 +49,6 @@ namespace m0st4fa::parsix {
 
 	protected:
 
-		/**
-		 * @brief The logger of a given instance of an Item object or of one of its subclasses.
-		 */
-		Logger p_Logger{};
-
 		/**
 		 * @brief The position of the dot within the production body, without caring about the types of the elements of the production body.
 		 */
@@ -109,7 +107,7 @@ namespace m0st4fa::parsix {
 
 			// check that the dot position is within range
 			if ((this->dotPos > psize) or (this->dotPos < 0)) {
-				this->p_Logger.log(LoggerInfo::ERR_INVALID_VAL, "Invalid dot position in item. Make sure the dot position is smaller than the size of the production body.");
+				get_logger().log(LoggerInfo::ERR_INVALID_VAL, "Invalid dot position in item. Make sure the dot position is smaller than the size of the production body.");
 				throw std::logic_error("Invalid dot position in item.");
 			}
 
@@ -247,6 +245,34 @@ namespace m0st4fa::parsix {
 		bool hasIdenticalCore(const Item& other) const {
 			return dotPos == other.dotPos && m_ActualDotPos == other.m_ActualDotPos && production == other.production;
 		}
+
+		/**
+		 * @brief Hashes the core of an item (its production and the position of its dot) without constructing the item. Items with identical cores have equal hashes.
+		 * @param[in] production The production of the item.
+		 * @param[in] dotPosition The position of the dot within `production`.
+		 * @returns The hash of the core.
+		 */
+		static size_t hashCore(const ProductionT& production, pos_t dotPosition) {
+			size_t hash = dotPosition;
+			auto combine = [&hash](const SymbolT& symbol) {
+				const size_t value = (symbol.isTerminal ? (size_t)symbol.as.terminal : (size_t)symbol.as.nonTerminal) * 2 + symbol.isTerminal;
+				hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+			};
+
+			combine(production.prodHead);
+			for (const auto& element : production.prodBody)
+				if (element.type == ProdElementType::PET_GRAM_SYMBOL)
+					combine(element.as.gramSymbol);
+
+			return hash;
+		}
+
+		/**
+		 * @brief Hashes the core of this Item object (its production and the position of its dot).
+		 */
+		size_t coreHash() const {
+			return hashCore(this->production, this->dotPos);
+		}
 	};
 
 	template <typename ProductionT>
@@ -255,6 +281,7 @@ namespace m0st4fa::parsix {
 
 	/**
 	 * @brief A set of Item objects.
+	 * @details The Item objects of the set are indexed by the hash of their cores, so finding the Item object having a given core (which inserting, merging and comparing sets all do) takes constant time on average instead of a scan of the set.
 	 * @note The ItemSet object doesn't have a grammar associated with it (i.e., doesn't have an attribute storing a particular grammar, which means that each time you want to calculate any thing requiring a grammar, you will have to input it). This may seem nonsense, however, the idea was that the same object could be utilized at different times for different grammars. This is because the object is large and expensive. I'm considering changing this behavior to the more logical one.
 	 * @todo Consider associating ItemSet objects with a grammar.
 	 * @tparam ItemT The type of an item in the set.
@@ -309,8 +336,43 @@ namespace m0st4fa::parsix {
 		 */
 		std::vector<ItemT> m_Closure{};
 
-		bool _add_to_closure_no_lookaheads(const ProdVecType&);
-		bool _add_to_closure_lookaheads(const ProdVecType&, const LookAheadSet&);
+		/**
+		 * @brief Maps the hash of the core of every Item object of the set to its index within `m_Set`.
+		 */
+		std::unordered_multimap<size_t, size_t> m_Index{};
+
+		/**
+		 * @brief Rebuilds the index of the Item objects of the set.
+		 */
+		void _index_items() {
+			this->m_Index.clear();
+			this->m_Index.reserve(this->m_Set.size());
+
+			for (size_t i = 0; i < this->m_Set.size(); i++)
+				this->m_Index.emplace(this->m_Set[i].coreHash(), i);
+		}
+
+		/**
+		 * @brief Finds the Item object of the set having a given core.
+		 * @param[in] production The production of the core.
+		 * @param[in] dotPosition The position of the dot of the core.
+		 * @returns The index of the Item object within `m_Set`; `SIZE_MAX` if there is no such Item object.
+		 */
+		size_t _find_core(const ProductionType& production, size_t dotPosition) const {
+			const auto [first, last] = this->m_Index.equal_range(ItemT::hashCore(production, dotPosition));
+
+			for (auto it = first; it != last; ++it) {
+				const ItemT& item = this->m_Set[it->second];
+
+				if (item.dotPos == dotPosition && item.production == production)
+					return it->second;
+			}
+
+			return SIZE_MAX;
+		}
+
+		bool _add_to_closure_no_lookaheads(const ProdVecType&, const std::vector<size_t>&, std::vector<size_t>&, std::vector<size_t>&);
+		bool _add_to_closure_lookaheads(const ProdVecType&, const std::vector<size_t>&, std::vector<size_t>&, std::vector<size_t>&, const LookAheadSet&);
 
 		/**
 		 * @brief Sets the closure cache of the ItemSet to `newClosure`, overriding whatever value was stored there.
@@ -322,11 +384,6 @@ namespace m0st4fa::parsix {
 
 	protected:
 
-		/**
-		 * @brief The logger of a given instance of an Item object or of one of its subclasses.
-		 */
-		Logger p_Logger;
-
 		/**
 		 * @brief Gets the iterator pointing to a given Item object. The Item object can be in the ItemSet collection or in the cached closure of the ItemSet collection of Item objects.
 		 * @param[in] production The production associated with the Item object.
@@ -335,6 +392,12 @@ namespace m0st4fa::parsix {
 		 * @returns If an Item object is found, a vector iterator object pointing to the found Item object; otherwise (if no Item object matches), returns vector iterator object pointing to the end of either the vector object used to store the Item object set or the vector object used to store the cached closure.
 		 */
 		std::vector<ItemT>::iterator get_item_it(const ProductionType& production, size_t dotPosition, bool fromClosure = false) {
+
+			if (not fromClosure) {
+				const size_t index = this->_find_core(production, dotPosition);
+				return index == SIZE_MAX ? this->m_Set.end() : this->m_Set.begin() + index;
+			}
+
 			auto begin = fromClosure ? this->m_Closure.begin() : this->m_Set.begin();
 			auto end = fromClosure ? this->m_Closure.end() : this->m_Set.end();
 
@@ -373,7 +436,7 @@ namespace m0st4fa::parsix {
 		 * @param items The Item objects to be stored in the ItemSet object.
 		 * @param sameClosure A redundant parameter for function overloading.
 		 */
-		ItemSet(const std::vector<ItemT> items, bool sameClosure) : m_Set{ items }, m_Closure{ items } {}
+		ItemSet(const std::vector<ItemT> items, bool sameClosure) : m_Set{ items }, m_Closure{ items } { this->_index_items(); }
 	public:
 
 		/**
@@ -385,34 +448,45 @@ namespace m0st4fa::parsix {
 		 * @brief Constructs an ItemSet object from an initializer list of Item objects.
 		 * @param[in] items The initializer list of Item objects.
 		 */
-		ItemSet(const std::initializer_list<ItemT>& items) : m_Set{ items } {};
+		ItemSet(const std::initializer_list<ItemT>& items) : m_Set{ items } { this->_index_items(); };
 
 		/**
 		 * @brief Constructs an ItemSet object from a vector of Item objects.
 		 * @param[in] items The vector of Item objects.
 		 */
-		ItemSet(const std::vector<ItemT> items) : m_Set{ items } {};
+		ItemSet(const std::vector<ItemT> items) : m_Set{ items } { this->_index_items(); };
 
 		/**
 		 * @brief Copy constructor.
 		 */
-		ItemSet(const ItemSet& other) : m_Set{ other.m_Set }, m_Closure{ other.m_Closure } {};
+		ItemSet(const ItemSet& other) : m_Set{ other.m_Set }, m_Closure{ other.m_Closure }, m_Index{ other.m_Index } {};
 
 		/**
 		 * @brief Move constructor.
 		 */
-		ItemSet(ItemSet&& other) : m_Set{ std::move(other.m_Set) }, m_Closure{ std::move(other.m_Closure) } {};
+		ItemSet(ItemSet&& other) : m_Set{ std::move(other.m_Set) }, m_Closure{ std::move(other.m_Closure) }, m_Index{ std::move(other.m_Index) } {};
 
 		// CAUTION: when implementing these functions, be cautious that a single item object may represent different items.
 
 		// OPERATOR FUNCTIONS
 		/**
 		* @brief Compares two ItemSet objects for equality.
+		* @details The order of the Item objects does not matter: the sets are equal iff they have the same cores, with the same lookaheads.
 		* @param[in] rhs The right hand side (the second operand) of the comparison operator.
 		* @returns `true` iff the two ItemSet objects are identical; `false` otherwise.
 		*/
 		bool operator==(const ItemSet& rhs) const {
-			return size() == size() && this->m_Set == rhs.m_Set;
+			if (this->size() != rhs.size())
+				return false;
+
+			for (const ItemT& item : rhs.m_Set) {
+				const size_t index = this->_find_core(item.production, item.dotPos);
+
+				if (index == SIZE_MAX || this->m_Set[index].lookaheads != item.lookaheads)
+					return false;
+			}
+
+			return true;
 		};
 
 		/**
@@ -475,6 +549,7 @@ namespace m0st4fa::parsix {
 
 		/**
 		 * @brief Gets the iterator pointing at the beginning of the underlying set storing the Item objects.
+		 * @attention Only the lookaheads of the Item objects may be modified through the iterator; their cores are indexed.
 		 */
 		auto begin() { return this->m_Set.begin(); }
 
@@ -514,6 +589,21 @@ namespace m0st4fa::parsix {
 
 		bool hasIdenticalCore(const ItemSet&) const;
 
+		/**
+		 * @brief Hashes this ItemSet object. The hash does not depend on the order of the Item objects, so equal ItemSet objects have equal hashes.
+		 */
+		size_t hash() const {
+			size_t hash = this->m_Set.size();
+
+			for (const ItemT& item : this->m_Set) {
+				size_t itemHash = item.coreHash() ^ (item.lookaheads.hash() * 0x9e3779b97f4a7c15ull);
+				itemHash ^= itemHash >> 29;
+				hash += itemHash * 0xbf58476d1ce4e5b9ull;
+			}
+
+			return hash;
+		}
+
 		ItemSet CLOSURE(ProdVecType*const);
 		
 		ItemSet GOTO(const SymbolType&, ProdVecType*const);
@@ -525,88 +615,76 @@ namespace m0st4fa::parsix {
 namespace m0st4fa::parsix {
 
 	/**
-	 * @brief Adds any new non-kernel Item objects, constructed from the given "grammar", to the (possibly already existing) CLOSURE set of this ItemSet object.
+	 * @brief Adds any new non-kernel Item objects, constructed from the given alternatives, to the (possibly already existing) CLOSURE set of this ItemSet object.
 	 * @details The new Item objects are all non-kernel, having the dot position always at 0.
-	 * @details Basically, what this function does is the following: it goes through every production in the grammar, constructs the non-kernel Item object and then inserts that Item object into this ItemSet object, if it wasn't there before.
+	 * @details Basically, what this function does is the following: it goes through every alternative production, constructs the non-kernel Item object and then inserts that Item object into the CLOSURE set, if it wasn't there before.
 	 * @details The new Item objects will have no lookaheads.
 	 * @tparam ItemT The type of an element of an ItemSet object.
-	 * @param[in] symbolProductions All of the productions of the grammar.
+	 * @param[in] grammar All of the productions of the grammar.
+	 * @param[in] alternatives The indices (within `grammar`) of the productions whose non-kernel Item objects are to be added.
+	 * @param[in, out] closureIndex Maps the index of a production to the index (within the CLOSURE set) of its Item object with the dot at 0; `SIZE_MAX` if there is no such Item object yet.
+	 * @param[in, out] worklist The indices of the Item objects of the CLOSURE set that are still to be scanned. The indices of new Item objects are appended to it.
 	 * @return `true` if at least one element has been added to the CLOSURE set (i.e., if the CLOSURE set has been modified); `false` otherwise.
 	 */
 	template<typename ItemT>
-	bool ItemSet<ItemT>::_add_to_closure_no_lookaheads(const ProdVecType& symbolProductions)
+	bool ItemSet<ItemT>::_add_to_closure_no_lookaheads(const ProdVecType& grammar, const std::vector<size_t>& alternatives, std::vector<size_t>& closureIndex, std::vector<size_t>& worklist)
 	{
 		bool inserted = false;
-		this->p_Logger.logDebug(std::format("(Possibly) adding new items to the closure of an item set"));
-		this->p_Logger.logDebug(std::format("Closure before:\n {}", m0st4fa::toString(this->m_Closure, false)));
 
-		// go through every production and insert the non-kernel items you create into the closure.
-		for (const ProductionType& production : symbolProductions) {
-			const ItemT item = ItemT{ production, 0 };
+		// go through every alternative and insert the non-kernel items you create into the closure.
+		for (size_t prodIndex : alternatives) {
 
-			// find an item with the same first component
-			const auto it = this->get_item_it(item.production, item.dotPos, false);
-			const auto end = this->m_Closure.end();
-			bool found = it != end;
-
-			// if no entry with the same first component is found
-			if (not found) {
-				this->m_Closure.push_back(item);
-				inserted = true;
-			} // if one was found, we cannot insert it again
+			// if an item with the same first component is already in the closure, we cannot insert it again
+			if (closureIndex[prodIndex] != SIZE_MAX)
+				continue;
 
+			closureIndex[prodIndex] = this->m_Closure.size();
+			worklist.push_back(this->m_Closure.size());
+			this->m_Closure.push_back(ItemT{ grammar.at(prodIndex), 0 });
+			inserted = true;
 		}
-		this->p_Logger.logDebug(std::format("Closure after:\n {}", m0st4fa::toString(this->m_Closure, false)));
 
 		return inserted;
 	}
 
 	/**
-	 * @brief Adds any new non-kernel Item objects, constructed from the given "grammar", to the (possibly already existing) CLOSURE set of this ItemSet object.
+	 * @brief Adds any new non-kernel Item objects, constructed from the given alternatives, to the (possibly already existing) CLOSURE set of this ItemSet object.
 	 * @details The new Item objects are all non-kernel, having the dot position always at 0.
-	 * @details Basically, what this function does is the following: it goes through every production in the grammar, constructs the non-kernel Item object and then inserts that Item object into this ItemSet object, if it wasn't there before.
+	 * @details Basically, what this function does is the following: it goes through every alternative production, constructs the non-kernel Item object and then inserts that Item object into the CLOSURE set, if it wasn't there before. If it was there before, only the lookaheads are merged into it.
 	 * @details The new Item objects will have lookaheads, given as an argument to this function.
 	 * @tparam ItemT The type of an element of an ItemSet object.
-	 * @param[in] symbolProductions All of the productions of the grammar.
+	 * @param[in] grammar All of the productions of the grammar.
+	 * @param[in] alternatives The indices (within `grammar`) of the productions whose non-kernel Item objects are to be added.
+	 * @param[in, out] closureIndex Maps the index of a production to the index (within the CLOSURE set) of its Item object with the dot at 0; `SIZE_MAX` if there is no such Item object yet.
+	 * @param[in, out] worklist The indices of the Item objects of the CLOSURE set that are still to be scanned. The indices of new Item objects, as well as those of Item objects whose lookaheads grew, are appended to it.
 	 * @param[in] lookaheads The lookaheads of the non-kernel Item objects that will be added to this ItemSet object.
-	 * @return `true` if at least one element has been added to the CLOSURE set (i.e., if the CLOSURE set has been modified); `false` otherwise.
+	 * @return `true` if at least one element has been added to the CLOSURE set or has had its lookaheads augmented (i.e., if the CLOSURE set has been modified); `false` otherwise.
 	 */
 	template<typename ItemT>
-	bool ItemSet<ItemT>::_add_to_closure_lookaheads(const ProdVecType& symbolProductions, const LookAheadSet& lookaheads)
+	bool ItemSet<ItemT>::_add_to_closure_lookaheads(const ProdVecType& grammar, const std::vector<size_t>& alternatives, std::vector<size_t>& closureIndex, std::vector<size_t>& worklist, const LookAheadSet& lookaheads)
 	{
 		bool inserted = false;
-		this->p_Logger.logDebug(std::format("Closure before:\n {}", m0st4fa::toString(this->m_Closure, false)));
-
-		// go through every production and insert the non-kernel items you create into the closure.
-		for (const ProductionType& production : symbolProductions) {
-			const ItemT item = ItemT{ production, 0 };
-
-			// go through every production and insert the non-kernel items you create into the closure
-			for (const ProductionType& production : symbolProductions) {
 
-				// find an item with the same first component
-				const auto it = this->get_item_it(production, 0, false);
-				const auto end = this->m_Closure.end();
-				bool found = it != end;
+		// go through every alternative and insert the non-kernel items you create into the closure
+		for (size_t prodIndex : alternatives) {
+			const size_t itemIndex = closureIndex[prodIndex];
 
-				// if an entry with the same first component is found
-				if (found) {
-					if (insertAndAssert(lookaheads, it->lookaheads))
-						inserted = true;
-				}
-				else {
-					// if no entry with the same first component is found
-					const auto item = ItemT{ production, 0, lookaheads };
-					this->m_Closure.push_back(item);
-					inserted = true;
-					this->p_Logger.logDebug(std::format("Adding new item {} to the closure of the item set", item.toString()));
-				}
+			// if no entry with the same first component is found
+			if (itemIndex == SIZE_MAX) {
+				closureIndex[prodIndex] = this->m_Closure.size();
+				worklist.push_back(this->m_Closure.size());
+				this->m_Closure.push_back(ItemT{ grammar.at(prodIndex), 0, lookaheads });
+				inserted = true;
+				continue;
+			}
 
+			// if an entry with the same first component is found, merge the lookaheads; if any of them is new, the item must be re-scanned for its lookaheads to propagate
+			if (this->m_Closure[itemIndex].lookaheads.unite(lookaheads)) {
+				worklist.push_back(itemIndex);
+				inserted = true;
 			}
 
-		}		
-		
-		this->p_Logger.logDebug(std::format("Closure after:\n {}", m0st4fa::toString(this->m_Closure, false)));
+		}
 
 		return inserted;
 	}
@@ -620,37 +698,15 @@ namespace m0st4fa::parsix {
 	template<typename ItemT>
 	inline bool ItemSet<ItemT>::contains(const ItemT& item) const
 	{
-		auto begin = this->m_Set.begin();
-		auto end = this->m_Set.end();
-
-		auto predicate = [this, &item](const ItemT& i) {
-			// 'item' is considered found if we found an 'i' such that:
-			// 1. the first components are the same.
-			// 2. the second component of 'item' is a subset of its 'i's counterpart.
-
-			// check for equality of the first components
-			if (item.dotPos != i.dotPos && item.production != i.production)
-				return false;
+		// 'item' is considered found if there is an item with the same first component, whose lookaheads include those of 'item'
+		const size_t index = this->_find_core(item.production, item.dotPos);
 
-			// check if item.lookaheads is a subset of i.lookaheads
-			// i.e. if i.lookaheads includes item.lookaheads
-
-			const auto ibegin = i.lookaheads.begin();
-			const auto iend = i.lookaheads.end();
-			const auto itembegin = item.lookaheads.begin();
-			const auto itemend = item.lookaheads.end();
-
-			return std::includes(ibegin, iend, itembegin, itemend);
-		};
-
-		return (std::find_if(begin, end, predicate) != end);
+		return index != SIZE_MAX && this->m_Set[index].lookaheads.includes(item.lookaheads);
 	}
 
-	// TODO: OPTIMIZE THIS FUNCTION
 	/**
 	 * @brief Checks whether this ItemSet object has an identical core with another ItemSet object.
 	 * @details The core of an item is its production together with the dot position. The core of an item set is the set of the cores of all of its items (the set of all of its items, without the lookaheads.) I.e., what this function does is that it checks that, for every item `i` within one of them, the other set has an item with an identical core to `i`.
-	 * @todo Optimize this function.
 	 * @param[in] other The ItemSet object with which to check for having the same core as this ItemSet object.
 	 * @returns `true` if this ItemSet object has the same core as `other`; `false` otherwise.
 	 */
@@ -660,21 +716,10 @@ namespace m0st4fa::parsix {
 		if (this->size() != other.size())
 			return false;
 
-		const auto thisBegin = this->m_Set.begin();
-		const auto thisEnd = this->m_Set.end();
-		const auto otherBegin = other.m_Set.begin();
-		const auto otherEnd = other.m_Set.end();
-
-		const auto pred = [this, &other, otherBegin, otherEnd](const ItemT& thisItem) {
-			bool t = std::any_of(otherBegin, otherEnd, [&thisItem](const ItemT& otherItem) {
-				return thisItem.hasIdenticalCore(otherItem);
-				});
-
-			return t;
-		};
-
-		// if they have the same size, they may have the same cores
-		return std::all_of(thisBegin, thisEnd, pred);
+		// the cores within a set are distinct, so if every core of this set is in the other one (of the same size), the cores are identical
+		return std::all_of(this->m_Set.begin(), this->m_Set.end(), [&other](const ItemT& item) {
+			return other._find_core(item.production, item.dotPos) != SIZE_MAX;
+			});
 	}
 
 	/**
@@ -686,20 +731,10 @@ namespace m0st4fa::parsix {
 	template<typename ItemT>
 	inline ItemT ItemSet<ItemT>::get(const ProductionType& production, size_t dotPosition) const
 	{
-		auto begin = this->m_Set.begin();
-		auto end = this->m_Set.end();
-
-		auto predicate = [this, &production, &dotPosition](const ItemT& item) {
-			const auto& itemProd = item.production;
-			size_t itemDotPos = item.dotPos;
-
-			return (itemDotPos == dotPosition) && (itemProd == production);
-		};
-
-		const auto& it = std::find_if(begin, end, predicate);
+		const size_t index = this->_find_core(production, dotPosition);
 
 		// return an item if it is found, else return an empty item
-		return (it == end ? ItemT{} : *it);
+		return (index == SIZE_MAX ? ItemT{} : this->m_Set[index]);
 	}
 
 	/**
@@ -717,43 +752,29 @@ namespace m0st4fa::parsix {
 
 		// if an entry with the same first component is found
 		if (found)
-			return insertAndAssert(item.lookaheads, it->lookaheads);
+			return it->lookaheads.unite(item.lookaheads);
 
 		// if no entry with the same first component is found
+		this->m_Index.emplace(item.coreHash(), this->m_Set.size());
 		this->m_Set.push_back(item);
 
 		return true;
 	}
 
-	// TODO: OPTIMIZE THIS FUNCTION
 	/**
 	 * @brief Merges an ItemSet object (`other`) with this ItemSet object.
 	 * @param[in] other The ItemSet object to be merged into this ItemSet object.
 	 * @details For each Item object `i` in `other`, either `i` already exists in this ItemSet object or not: 
 		* If `i` exists this ItemSet object, then any lookaheads that this `i` doesn't have will be added to its lookahead set.
 		* Otherwise (i.e. `i` doesn't exist), `i` will be added to this ItemSet object.
-	 * @todo Optimize this function.
 	 * @returns `true` if any new Item objects have been added after the merge is done; `false` otherwise.
 	 */
 	template<typename ItemT>
 	bool ItemSet<ItemT>::merge(const ItemSet& other)
 	{
 
-		for (const ItemT& item : other.m_Set) {
-			const auto itemIt = std::find_if(m_Set.begin(), m_Set.end(), [&item](const ItemT& i) {
-				return item.hasIdenticalCore(i);
-				});
-
-			// if the item does not exist
-			if (itemIt == m_Set.end()) {
-				this->m_Set.push_back(item);
-				continue;
-			}
-
-			// if such an item exists
-			itemIt->lookaheads.insert(item.lookaheads.begin(), item.lookaheads.end());
-
-		}
+		for (const ItemT& item : other.m_Set)
+			this->insert(item);
 
 		return true;
 	}
@@ -763,6 +784,7 @@ namespace m0st4fa::parsix {
 	 * @details The CLOSURE set of an item set, given a given grammar, is a set that, for every non-terminal in the grammar, stores all of the items of the item set in which the dot is just before this non-terminal in the production of that item. 
 	 * @details The name is generic; we think of it as constituting the "closing" calculation on the item set. It is used extensively for generating parsing tables.
 	 * @details The CLOSURE set is cached so that next time it is returned immediately. The reason for the caching is that the calculation is very expensive (especially as the number of lookaheads for each item (i.e., the number of items) increases).
+	 * @details Items are identified within the CLOSURE set by the number of their production (`prodNumber`) and the position of their dot, so the productions of the kernel items must be numbered by their index within `grammarPtr`. The lookaheads of LR(1) items are propagated until a fixed point is reached (an item whose lookaheads grow is scanned again).
 	 * @param[in] grammarPtr A pointer to the grammar (production vector) object that will be used for calculating the CLOSURE set.
 	 * @note You must input the grammar as, by design right now, an ItemSet object is not associated with any grammar.
 	 * @return The CLOSURE set of this ItemSet object.
@@ -772,117 +794,121 @@ namespace m0st4fa::parsix {
 	{
 		// check if the closure is already calculated
 		if (this->m_Closure.size() > 0) {
-			this->p_Logger.logDebug("CLOSURE set for this item set has already been calculated!");
-			return this->m_Closure;
+			get_logger().logDebug("CLOSURE set for this item set has already been calculated!");
+			return ItemSet{ this->m_Closure, true };
 		}
 
 		ProdVecType& grammar = *grammarPtr;
 		// check if the set is not empty (its closure would therefore be empty)
 		if (this->m_Set.size() == 0) {
-			this->p_Logger.log(LoggerInfo::WARNING, "Item set is empty. Returning empty CLOSURE!");
+			get_logger().log(LoggerInfo::WARNING, "Item set is empty. Returning empty CLOSURE!");
 			return *this;
 		}
 
-		// keep track of alternative productions of symbols
-		std::vector<size_t> alternativeProduction[(size_t)VariableType::NT_COUNT]{};
-		for (size_t prodIndex = 0; const ProductionType & prod : grammar.getVector()) {
-			size_t varIndex = (size_t)prod.prodHead.as.nonTerminal;
-			alternativeProduction[varIndex].push_back(prodIndex);
-			prodIndex++;
-		}
+		// the alternative productions of every non-terminal are indexed once per grammar
+		grammar.indexAlternatives();
 
-		this->p_Logger.logDebug("\nCALCULATING CLOSURE SET:\n");
-		this->p_Logger.logDebug(std::format("Items set:\n {}", (std::string)*this));
+		if constexpr (TRACE_ENABLED) {
+			get_logger().logDebug("\nCALCULATING CLOSURE SET:\n");
+			get_logger().logDebug(std::format("Items set:\n {}", (std::string)*this));
+		}
 
 		// initialize the closure to the item set
-		this->m_Closure = ItemSet{this->m_Set};
+		this->m_Closure = this->m_Set;
+
+		// index the items with the dot at 0 (the only ones the closure can add) by their production, and schedule every item for scanning
+		std::vector<size_t> closureIndex(grammar.size(), SIZE_MAX);
+		std::vector<size_t> worklist{};
+		worklist.reserve(this->m_Closure.size());
+
+		for (size_t i = this->m_Closure.size(); i > 0; i--) {
+			const ItemT& item = this->m_Closure[i - 1];
+
+			if (item.dotPos == 0 && item.production.prodNumber < closureIndex.size())
+				closureIndex[item.production.prodNumber] = i - 1;
+
+			worklist.push_back(i - 1);
+		}
 
 		// check whether the items are LR(0) or they have lookaheads
-		bool isLR0 = this->m_Closure.at(0).lookaheads.size() == 0;
-		std::vector<std::set<SymbolType>> first{};
+		bool isLR0 = std::all_of(this->m_Closure.begin(), this->m_Closure.end(), [](const ItemT& item) { return item.lookaheads.empty(); });
 		if (not isLR0)
-			grammar.calculateFIRST(), first = grammar.getFIRST();
+			grammar.calculateFIRST();
 
-		this->p_Logger.logDebug(std::format("The items in this set are LR({})", isLR0 ? "0" : "1"));
+		if constexpr (TRACE_ENABLED)
+			get_logger().logDebug(std::format("The items in this set are LR({})", isLR0 ? "0" : "1"));
 
 		// for every item of the closure, calculate the closure of that item
-		for (size_t i = 0; i < this->m_Closure.size(); i++) {
-			const ItemT item = this->m_Closure.at(i);
-			this->p_Logger.logDebug(std::format("Current item being scanned for CLOSURE:{}",item.toString()));
-			const ProductionType& itemProd = item.production;
+		while (not worklist.empty()) {
+			const size_t itemIndex = worklist.back();
+			worklist.pop_back();
+
+			// note: `m_Closure` may grow (and reallocate) below, so never hold a reference to one of its items across the insertions
+			const ProductionType& itemProd = this->m_Closure[itemIndex].production;
+			const size_t actualDotPos = this->m_Closure[itemIndex].getActualDotPosition();
 
 			// if the dot is at the end of the production
-			if (itemProd.size() == item.dotPos)
+			if (itemProd.size() == this->m_Closure[itemIndex].dotPos)
 				continue; // there is nothing more to add
 
-			// get the symbol before the dot; note that it is guaranteed to be a symbol
-			// BUG: item.getActualDotPosition()
-			const SymbolType& symbolAfterDot = itemProd.at(item.getActualDotPosition()).as.gramSymbol;
-			this->p_Logger.logDebug(std::format("Symbol after dot is {}", symbolAfterDot.toString()));
+			// get the symbol after the dot; note that it is guaranteed to be a symbol
+			const SymbolType symbolAfterDot = itemProd.at(actualDotPos).as.gramSymbol;
 			
 			// check if this symbol is a non-terminal
-			if (symbolAfterDot.isTerminal) {
-				// if it is a terminal, the closure of the item is itself and the itemisalrea there in the closure (since we are checking it now)
-				this->p_Logger.logDebug("No other item has been added to CLOSURE");
+			if (symbolAfterDot.isTerminal)
+				// if it is a terminal, the closure of the item is itself and the item is already there in the closure (since we are checking it now)
 				continue;
-			}
 
 			// if we are here, the symbol is a non-terminal
 			// get all the productions for that non-terminal (all of its alternatives)
-			ProdVecType symbolProductions {};
-			const std::vector<size_t>& prods = alternativeProduction[(size_t)symbolAfterDot.as.nonTerminal];
-			for (size_t prodIndex : prods)
-				symbolProductions.pushProduction(grammar.at(prodIndex));
-
-			this->p_Logger.logDebug(std::format("The alternatives of non-terminal {} are: {}",symbolAfterDot.toString(), symbolProductions.toString()));
+			const std::vector<size_t>& prods = grammar.getAlternatives(symbolAfterDot.as.nonTerminal);
 
 			// add the new items to the closure
-			if (isLR0)
-				_add_to_closure_no_lookaheads(symbolProductions);
-			else // it is LR(1)
-			{
-				auto predIsGramSymbol = [](const auto& stackElement) {
-					return stackElement.type == ProdElementType::PET_GRAM_SYMBOL;
-				};
-
-				// calculate the lookaheads
-				size_t prodSize = itemProd.prodBody.size();
-				size_t startIndex = item.getActualDotPosition() + 1;
-				SymbolStringType symString{};
-				
-				// the following loop corresponds to: std::copy_if(begin + startIndex, end, symString.symbols, predIsGramSymbol);
-				const auto& prodBody = itemProd.prodBody;
-				for (size_t i = startIndex; i < prodBody.size(); i++) {
-					const auto& se = prodBody.at(i);
-
-					// if `se` is a grammar symbol, concatenate its corresponding grammar symbol with `symString`
-					if (predIsGramSymbol(se))
-						symString.push_back(se.as.gramSymbol);
-
-				}
+			if (isLR0) {
+				_add_to_closure_no_lookaheads(grammar, prods, closureIndex, worklist);
+				continue;
+			}
 
-				this->p_Logger.logDebug(std::format("For item {} => Initial string after the grammar symbol: {}", item.toString(), symString.toString()));
+			// it is LR(1): the lookaheads of the new items are FIRST(beta a), for the string beta after the non-terminal and every lookahead a of the item
+			LookAheadSet lookaheads{};
+			bool betaIsNullable = true;
 
-				// go through each lookahead; each lookahead corresponds to a distinct item
-				for (const SymbolType& lookahead : item.lookaheads) {
-					// the string for the current item
-					SymbolStringType tempSymString = symString;
-					tempSymString.push_back(lookahead);
+			const auto& prodBody = itemProd.prodBody;
+			for (size_t i = actualDotPos + 1; i < prodBody.size() && betaIsNullable; i++) {
+				const auto& se = prodBody.at(i);
 
-					// the lookaheads of the current item
+				// skip non-grammar-symbol objects
+				if (se.type != ProdElementType::PET_GRAM_SYMBOL)
+					continue;
 
-					tempSymString.calculateFIRST(first);
-					LookAheadSet lookaheads{tempSymString.getFIRST()};
+				const SymbolType& symbol = se.as.gramSymbol;
 
-					this->p_Logger.logDebug(std::format("The lookaheads for the current item is: {}", m0st4fa::toString(lookaheads)));
+				if (symbol.isTerminal) {
+					if (symbol != SymbolType::EPSILON)
+						lookaheads.insert(symbol), betaIsNullable = false;
 
-					// add the item to the CLOSURE set
-					_add_to_closure_lookaheads(symbolProductions, lookaheads);
+					continue;
 				}
 
+				// word-wise OR of the (bitset) FIRST set
+				lookaheads |= grammar.getFIRSTSet(symbol.as.nonTerminal);
+				betaIsNullable = lookaheads.erase(SymbolType::EPSILON) > 0;
 			}
+
+			// if beta can derive the empty string, the lookaheads of the item itself follow the non-terminal
+			if (betaIsNullable)
+				lookaheads |= this->m_Closure[itemIndex].lookaheads;
+
+			if constexpr (TRACE_ENABLED)
+				get_logger().logDebug(std::format("The lookaheads for the alternatives of {} are: {}", symbolAfterDot.toString(), lookaheads.toString()));
+
+			// add the items to the CLOSURE set
+			_add_to_closure_lookaheads(grammar, prods, closureIndex, worklist, lookaheads);
 		}
 
+		if constexpr (TRACE_ENABLED)
+			get_logger().logDebug(std::format("Closure:\n {}", m0st4fa::toString(this->m_Closure, false)));
+
 		ItemSet res{ this->m_Closure, true };
 		return res;
 	}
@@ -901,15 +927,19 @@ namespace m0st4fa::parsix {
 	{
 		// check whether the closure is already calculated
 		if (this->m_Closure.size() == 0) {
-			this->p_Logger.log(LoggerInfo::INFO, "CLOSURE set is not already calculated for this set! Calculating it now.");
+			if constexpr (TRACE_ENABLED)
+				get_logger().log(LoggerInfo::INFO, "CLOSURE set is not already calculated for this set! Calculating it now.");
 
 			this->CLOSURE(grammarPtr);
 		}
 
 		ProdVecType& grammar = *grammarPtr;
-		this->p_Logger.logDebug("\nCALCULATING GOTO SET:\n");
-		this->p_Logger.logDebug(std::format("Item set:\n {}", (std::string)*this));
-		this->p_Logger.logDebug(std::format("GOTO symbol is {}", (std::string)symbol));
+
+		if constexpr (TRACE_ENABLED) {
+			get_logger().logDebug("\nCALCULATING GOTO SET:\n");
+			get_logger().logDebug(std::format("Item set:\n {}", (std::string)*this));
+			get_logger().logDebug(std::format("GOTO symbol is {}", (std::string)symbol));
+		}
 
 		ItemSet<ItemT> result = ItemSet{};
 
@@ -952,13 +982,18 @@ namespace m0st4fa::parsix {
 
 				// insert the item in `result`
 				result.insert(kernelItem);
-				this->p_Logger.log(LoggerInfo::DEBUG, std::format("Inserting kernel item {} to the GOTO set.", kernelItem.toString()));
+
+				if constexpr (TRACE_ENABLED)
+					get_logger().log(LoggerInfo::DEBUG, std::format("Inserting kernel item {} to the GOTO set.", kernelItem.toString()));
 			}
 
 		}
 
 		const ItemSet<ItemT> resultClosure = result.CLOSURE(grammarPtr);
-		this->p_Logger.logDebug(std::format("GOTO Set for the items: \n{}", (std::string)resultClosure));
+
+		if constexpr (TRACE_ENABLED)
+			get_logger().logDebug(std::format("GOTO Set for the items: \n{}", (std::string)resultClosure));
+
 		return resultClosure;
 	}
 
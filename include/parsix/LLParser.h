@@ -5,6 +5,9 @@
 
 // local includes
 #include "parsix/Parser.h"
+#include "parsix/Arena.h"
+#include "parsix/ParseStats.h"
+#include "parsix/ParseTree.h"
 
 namespace m0st4fa::parsix {
 
@@ -68,41 +71,88 @@ namespace m0st4fa::parsix {
 		
 		/**
 		 * @brief The grammar object. It is expected to be a vector of production objects.
+		 * @note This refers to the grammar of the (shared) parsing table.
 		 */
-		GrammarT& m_ProdRecords;
+		const GrammarT& m_ProdRecords;
 
-		/**
-		 * @brief The LL parsing stack.
-		 */
-		mutable std::vector<StackElementType> m_Stack;
+	public:
 
 		/**
-		 * @brief The top of element of the parsing stack.
+		 * @brief The state of a single parse.
+		 *
+		 * @details Every call to `parse()` uses a context and passes it down to the functions implementing the parse. The parser object itself is never modified by a parse, which is what makes it reentrant.
+		 * A context may be reused by any number of (consecutive) parses: its stack storage and arena memory are then allocated once and recycled.
+		 * @attention A context must not be used by two parses at the same time.
 		 */
-		mutable StackElementType m_CurrTopElement;
+		struct ParseContext {
+
+			/**
+			 * @brief The lexical analyzer providing the input of this parse.
+			 */
+			LexicalAnalyzerT* lexer = nullptr;
+
+			/**
+			 * @brief The LL parsing stack. Its storage is kept between parses.
+			 */
+			std::vector<StackElementType> stack;
+
+			/**
+			 * @brief The top of element of the parsing stack.
+			 */
+			StackElementType currTopElement{};
+
+			/**
+			 * @brief The most recent token (TokenType object) returned by the lexical analyzer.
+			 */
+			TokenType currInputToken{};
+
+			/**
+			 * @brief The number of errors detected (and recovered from) so far.
+			 */
+			size_t errorNum = 0;
+
+			/**
+			 * @brief If not `nullptr` (and the library is compiled with `PARSIX_STATS`), the statistics of the parse are added to it. It is left as is by `reset()`.
+			 */
+			ParseStats* stats = nullptr;
+
+			/**
+			 * @brief If not `nullptr`, the parse tree of the input is built into it: a node per expansion and a leaf per match (see ParseTree). It is cleared by `reset()`.
+			 */
+			ParseTree* tree = nullptr;
+
+			/**
+			 * @brief The arena semantic actions allocate from (through `Arena::current()`) during the parse.
+			 * @details Whatever is allocated from it lives until the context is reused by the next parse (which resets the arena in O(1)) or is destroyed.
+			 */
+			Arena arena;
+
+			/**
+			 * @brief Default constructor.
+			 * @param[in] stackCapacity The number of elements to reserve storage for in the stack.
+			 */
+			explicit ParseContext(size_t stackCapacity = 0) { this->stack.reserve(stackCapacity); }
+
+			/**
+			 * @brief Prepares the context for a new parse of the input of `lexer`, keeping all of its storage.
+			 */
+			void reset(LexicalAnalyzerT& lexer) {
+				this->lexer = &lexer;
+				this->stack.clear();
+				this->currTopElement = StackElementType{};
+				this->currInputToken = TokenType{};
+				this->errorNum = 0;
+				this->arena.reset();
+
+				if (this->tree != nullptr)
+					this->tree->clear();
+			}
+		};
 
-		/**
-		 * @brief The most recent token (TokenType object) returned by the lexical analyzer.
-		 */
-		mutable TokenType m_CurrInputToken;
+	private:
 
 		// PARSER FUNCTIONS
-		/**
-		 * @brief Resets the state of the LLParser object (i.e., sets the values of the most important fields to the default value).
-		 * @details The following fields have their values reset: m_Stack, m_CurrTopElement, m_CurrInputToken and, if `resetProductions` is set to `true`, m_ProdRecords.
-		 * @param resetProductions If `true`, resets the grammar object, i.e., empties the vector of all productions. If `false`, leaves the grammar object as it is.
-		 */
-		void reset_parser_state(bool resetProductions = false) {
-			m_Stack.clear();
-			m_CurrTopElement = StackElementType{};
-			m_CurrInputToken = TokenType{};
-
-			if (resetProductions)
-				m_ProdRecords.clear();
-
-			return;
-		};
-		void parse_grammar_symbol(ErrorRecoveryType);
+		void parse_grammar_symbol(ParseContext&, ErrorRecoveryType) const;
 
 		// ERROR RECOVERY FUNCTIONS
 		/**
@@ -115,46 +165,52 @@ namespace m0st4fa::parsix {
 		 * @tparam FSMTableT The type of the FSM table object.
 		 * @tparam InputT The type of the input string.
 		 *
+		 * @param ctx The context of the parse. Its error count is incremented for every error recovered from.
 		 * @param errRecovType The type of error recovery to be used.
 		 *
-		 * @details This function handles error recovery. It checks the error recovery limit and throws a runtime error if the limit is exceeded. It also handles invalid arguments and throws an invalid argument exception if the argument is ErrorRecoveryType::ERT_NUM. Depending on the type of error recovery, it calls the corresponding error recovery function and returns the result. If the error recovery type is ErrorRecoveryType::ERT_ABORT, it aborts the parser.
+		 * @details This function handles error recovery. It checks the error recovery limit (per parse) and throws a runtime error if the limit is exceeded. It also handles invalid arguments and throws an invalid argument exception if the argument is ErrorRecoveryType::ERT_NUM. Depending on the type of error recovery, it calls the corresponding error recovery function and returns the result. If the error recovery type is ErrorRecoveryType::ERT_ABORT, it aborts the parser.
 		 *
 		 * @return `true` if error recovery was successful (the error was recovered successfully); `false` otherwise.
 		 */
-		bool error_recovery(ErrorRecoveryType errRecovType = ErrorRecoveryType::ERT_NONE) {
+		bool error_recovery(ParseContext& ctx, ErrorRecoveryType errRecovType = ErrorRecoveryType::ERT_NONE) const {
 			// check the error recovery limit
-			static size_t numOfDetectedErrs = 0;
-
 			if (errRecovType != ErrorRecoveryType::ERT_NONE &&
 				errRecovType != ErrorRecoveryType::ERT_ABORT
 				)
 			{
-				if (numOfDetectedErrs == ParserBase::ERR_RECOVERY_LIMIT) {
+				if (ctx.errorNum == ParserBase::ERR_RECOVERY_LIMIT) {
 					LoggerInfo errInfo = { .level = LOG_LEVEL::LL_ERROR };
 
-					this->p_Logger.log(errInfo, std::format("Exceeded error recovery limit\nNote: error recovery limit {}", ParserBase::ERR_RECOVERY_LIMIT));
+					get_logger().log(errInfo, std::format("Exceeded error recovery limit\nNote: error recovery limit {}", ParserBase::ERR_RECOVERY_LIMIT));
 
 					throw std::runtime_error{ "Limit of recovered-from errors exceeded" };
 				};
+
+				ctx.errorNum++;
 			}
 
 			// handle invalid arguments
 			if (errRecovType == ErrorRecoveryType::ERT_NUM) {
 				LoggerInfo info = { .level = LOG_LEVEL::LL_ERROR };
 
-				this->p_Logger.log(info, "[ERR_RECOVERY]: Invalid argument.");
+				get_logger().log(info, "[ERR_RECOVERY]: Invalid argument.");
 
 				throw std::invalid_argument("Argument ERT_NONE cannot be used in this context.\nNote: it is just for knowing the number of possible values of this enum.");
 			}
 
-			this->p_Logger.logDebug("[ERR_RECOVERY]: started error recovery: " + toString(errRecovType));
+			this->log_trace(LoggerInfo::DEBUG, [&] { return "[ERR_RECOVERY]: started error recovery: " + toString(errRecovType); });
+			record_stats(ctx.stats, &ParseStats::recordErrorRecovery);
+
+			// trees are only built for inputs without errors
+			if (ctx.tree != nullptr)
+				ctx.tree->fail();
 
 			switch (errRecovType) {
 			case ErrorRecoveryType::ERT_NONE:
 				return false;
 
 			case ErrorRecoveryType::ERT_PANIC_MODE:
-				return panic_mode();
+				return panic_mode(ctx);
 
 			case ErrorRecoveryType::ERT_PHRASE_LEVE:
 				return phrase_level();
@@ -173,8 +229,8 @@ namespace m0st4fa::parsix {
 			};
 		};
 
-		bool panic_mode();
-		bool panic_mode_try_sync_variable(TokenType&);
+		bool panic_mode(ParseContext&) const;
+		bool panic_mode_try_sync_variable(ParseContext&, TokenType&) const;
 
 		// TODO: implement phrase level and global error recovery
 		bool phrase_level() const { return false; };
@@ -182,24 +238,23 @@ namespace m0st4fa::parsix {
 
 		// error helper functions
 
-		void check_prod_body(const ProductionType&) const;
-
 		/**
 		 * @brief Prints a synchronization message.
 		 *
+		 * @param ctx The context of the parse.
 		 * @param pos The position in the input stream at which to report. It is an ordered pair of line number and character number.
 		 *
 		 * This function prints a synchronization message. It formats a message with the current position in the input stream and the current input token, and logs the message at the info level.
 		 */
-		void print_sync_msg(const std::pair<size_t, size_t> pos) const {
+		void print_sync_msg(const ParseContext& ctx, const std::pair<size_t, size_t> pos) const {
 			static constexpr LoggerInfo info = { .level = LOG_LEVEL::LL_INFO };
 
 			std::string msg = std::format("({}, {}) Synchronized successfully. Current input token {}",
 				pos.first,
 				pos.second,
-				(std::string)m_CurrInputToken);
+				(std::string)ctx.currInputToken);
 
-			this->p_Logger.log(info, msg);
+			get_logger().log(info, msg);
 		};
 
 	public:
@@ -212,28 +267,70 @@ namespace m0st4fa::parsix {
 		/**
 		 * @brief Constructs an LLParser object.
 		 *
-		 * This constructor initializes an LLParser object. It initializes the base Parser object with the given lexer, parsing table, and start symbol. It also initializes the production records with the grammar from the parsing table. The stack, current input token, and current top element are initialized to their default values.
+		 * This constructor initializes an LLParser object. It initializes the base Parser object with the given lexer, a prepared copy of the parsing table (see `prepareTable()`), and start symbol. It also initializes the production records with the grammar from the parsing table. The stack, current input token, and current top element are initialized to their default values.
 		 */
 		LLParser(
 			const SymbolT& startSymbol,
 			const ParsingTableT& parsingTable,
-			const lexana::LexicalAnalyzer<TokenType, FSMTableT>& lexer
+			LexicalAnalyzerT& lexer
+		) : LLParser{ startSymbol, prepareTable(parsingTable), lexer }
+		{};
+
+		/**
+		 * @brief Constructs an LLParser object sharing an already prepared parsing table.
+		 *
+		 * This constructor does not copy the table; it is O(1). The table must have been returned by `prepareTable()`.
+		 */
+		LLParser(
+			const SymbolT& startSymbol,
+			std::shared_ptr<const ParsingTableT> parsingTable,
+			LexicalAnalyzerT& lexer
 		) :
 			Parser<LexicalAnalyzerT, SymbolT, ParsingTableT, FSMTableT, InputT>
-		{ lexer, parsingTable, startSymbol },
-			m_ProdRecords{ this->p_Table.grammar },
-			m_Stack{},
-			m_CurrInputToken{},
-			m_CurrTopElement{}
+		{ lexer, std::move(parsingTable), startSymbol },
+			m_ProdRecords{ this->p_Table->grammar }
 		{};
 
+		/**
+		 * @brief Prepares a parsing table to be shared by any number of LL parsers.
+		 * @details Freezes the table (see `LLParsingTable::freeze()`), which also lays out its production bodies reversed for the expansions. This is meant to be done once per table.
+		 * @param parsingTable The parsing table to be prepared. It is taken by value, so that the table of the caller is never modified.
+		 * @throws std::logic_error If the table contains an invalid entry or a production with an empty body.
+		 * @return The prepared, immutable table.
+		 */
+		static std::shared_ptr<const ParsingTableT> prepareTable(ParsingTableT parsingTable) {
+			parsingTable.freeze();
+
+			return std::make_shared<const ParsingTableT>(std::move(parsingTable));
+		}
+
 		/**
 		 * @brief Default destructor.
 		 */
 		~LLParser() = default;
 
+		/**
+		 * @brief Parses the input of the lexical analyzer the parser was constructed with.
+		 * @details Equivalent to `parse(lexer, errRecoveryType)`, where `lexer` is the lexical analyzer given to the constructor. Since that lexical analyzer is shared by all calls, they must not be concurrent.
+		 */
+		template<typename ParserResultT>
+		ParserResultT parse(ErrorRecoveryType errRecoveryType = ErrorRecoveryType::ERT_NONE) const {
+			return this->parse<ParserResultT>(this->get_lexical_analyzer(), errRecoveryType);
+		}
+
+		/**
+		 * @brief Parses the input of `lexer` using a fresh parse context.
+		 * @details Equivalent to `parse(ctx, lexer, errRecoveryType)` with a context local to the call; hence, whatever semantic actions allocate from the arena is released when the call returns. To keep arena-allocated results or to reuse the storage of the context over many parses, use the overload taking a context.
+		 */
+		template<typename ParserResultT>
+		ParserResultT parse(LexicalAnalyzerT& lexer, ErrorRecoveryType errRecoveryType = ErrorRecoveryType::ERT_NONE) const {
+			ParseContext ctx;
+
+			return this->parse<ParserResultT>(ctx, lexer, errRecoveryType);
+		}
+
 		template<typename ParserResultT>
-		ParserResultT parse(ErrorRecoveryType = ErrorRecoveryType::ERT_NONE);
+		ParserResultT parse(ParseContext&, LexicalAnalyzerT&, ErrorRecoveryType = ErrorRecoveryType::ERT_NONE) const;
 	};
 
 	// IMPLEMENTATIONS
@@ -248,31 +345,38 @@ namespace m0st4fa::parsix {
 	 * @tparam InputT The type of the input string.
 	 * @tparam ParserResultT The type of the parser result object.
 	 *
+	 * @param ctx The context of the parse. It is reset first (keeping its stack storage and arena memory), and its arena is the current arena (see `Arena::current()`) of the semantic actions for the duration of the parse.
+	 * @param lexer The lexical analyzer providing the input. It is used by this parse only.
 	 * @param errRecoveryType The type of error recovery to be used.
 	 *
-	 * @details This function parses the input based on a grammar. It initializes the parser to the initial configuration and gets the next input token. It then loops until the stack is empty. For each symbol on top of the stack, it makes the parsing decision based on the current symbol and the current input. If the symbol is a grammar symbol, it parses the grammar symbol. If the symbol is a synthesized record or an action record, it executes the corresponding action. After all symbols are processed, it resets the parser state and returns the result.
+	 * @details This function parses the input based on a grammar. It initializes the context to the initial configuration and gets the next input token. It then loops until the stack is empty. For each symbol on top of the stack, it makes the parsing decision based on the current symbol and the current input. If the symbol is a grammar symbol, it parses the grammar symbol. If the symbol is a synthesized record or an action record, it executes the corresponding action. After all symbols are processed, it returns the result.
 	 * @details If the input string `w` is in `L(G)` (`L` is the language and `G` is the grammar), it produces a leftmost derivation of `w`; otherwise, it produces an error indication.
 	 * 
 	 * @note It might execute actions during the leftmost derivation, for example, to make a parsing or syntax tree.
 	 *
-	 * @return The result of the parsing. Right now, the object is not filled with anything. This is for future implementation.
+	 * @return The result of the parsing. Right now, the object is not filled with anything. This is for future implementation. For the parse tree, attach a ParseTree to the context (see `ParseContext::tree`).
 	 */
 	template<typename GrammarT, typename LexicalAnalyzerT,
 		typename SymbolT,
 		typename ParsingTableT, typename FSMTableT,
 		typename InputT>
 	template<typename ParserResultT>
-	ParserResultT LLParser<GrammarT, LexicalAnalyzerT, SymbolT, ParsingTableT, FSMTableT, InputT>::parse(ErrorRecoveryType errRecoveryType)
+	ParserResultT LLParser<GrammarT, LexicalAnalyzerT, SymbolT, ParsingTableT, FSMTableT, InputT>::parse(ParseContext& ctx, LexicalAnalyzerT& lexer, ErrorRecoveryType errRecoveryType) const
 	{
 		using StackType = std::vector<StackElementType>;
 
 		ParserResultT res{};
-		LoggerInfo info{ LoggerInfo::INFO };
+
+		// all of the state of this parse lives in the context; the parser itself is not modified
+		ctx.reset(lexer);
+		const Arena::Scope arenaScope{ ctx.arena };
 
 		// Initialize the algorithm, such that the parser is in the initial configuration
-		m_Stack.push_back({ .type = ProdElementType::PET_GRAM_SYMBOL, .as = {.gramSymbol = this->get_start_symbol() } });
+		ctx.stack.push_back({ .type = ProdElementType::PET_GRAM_SYMBOL, .as = {.gramSymbol = this->get_start_symbol() } });
+		record_stats(ctx.stats, &ParseStats::recordStackDepth, ctx.stack.size());
 
-		this->m_CurrInputToken = this->getLexicalAnalyzer().get_next_token();
+		ctx.currInputToken = this->get_next_token(*ctx.lexer);
+		record_stats(ctx.stats, &ParseStats::recordToken);
 
 		/** Basic algorithm:
 		* Loop until the stack is empty.
@@ -281,16 +385,16 @@ namespace m0st4fa::parsix {
 		* Whenever a symbol is matched, it is popped off the stack.
 		* The purpose is to pop the start symbol off the stack (to match it, leaving the stack empty) and not produce any errors.
 		*/
-		while (-not m_Stack.empty()) {
+		while (-not ctx.stack.empty()) {
 			// get the current symbol on top of the stack, pop it and get the next input token
-			m_CurrTopElement = m_Stack.back();
-			m_Stack.pop_back();
+			ctx.currTopElement = ctx.stack.back();
+			ctx.stack.pop_back();
 
 			// switch on the type of the top symbol
 
-			switch (m_CurrTopElement.type) {
+			switch (ctx.currTopElement.type) {
 			case ProdElementType::PET_GRAM_SYMBOL:
-				parse_grammar_symbol(errRecoveryType);
+				parse_grammar_symbol(ctx, errRecoveryType);
 				continue;
 
 				/**
@@ -299,23 +403,23 @@ namespace m0st4fa::parsix {
 				*/
 			case ProdElementType::PET_SYNTH_RECORD: {
 				// extract the record
-				SynthesizedType topRecord = m_CurrTopElement.as.synRecord;
+				SynthesizedType topRecord = ctx.currTopElement.as.synRecord;
 				auto action = static_cast<void(*)(StackType&, SynDataType&)>(topRecord.action);
 
 				// execute the action if any
 				if (action)
-					action(this->m_Stack, topRecord.data);
+					action(ctx.stack, topRecord.data);
 				continue;
 			}
 
 			case ProdElementType::PET_ACTION_RECORD: {
 				// extract the record
-				ActionType topRecord = m_CurrTopElement.as.actRecord;
+				ActionType topRecord = ctx.currTopElement.as.actRecord;
 				auto action = static_cast<void(*)(StackType&, ActDataType&)>(topRecord.action);
 
 				// execute the action if any
 				if (action)
-					action(this->m_Stack, topRecord.data);
+					action(ctx.stack, topRecord.data);
 
 				continue;
 			}
@@ -325,7 +429,6 @@ namespace m0st4fa::parsix {
 			}
 		}
 
-		reset_parser_state();
 		return res;
 	}
 
@@ -349,11 +452,9 @@ namespace m0st4fa::parsix {
 		typename SymbolT,
 		typename ParsingTableT, typename FSMTableT,
 		typename InputT>
-	void LLParser<GrammarT, LexicalAnalyzerT, SymbolT, ParsingTableT, FSMTableT, InputT>::parse_grammar_symbol(ErrorRecoveryType errRecoveryType) {
-		using StackElement = StackElementType;
-
+	void LLParser<GrammarT, LexicalAnalyzerT, SymbolT, ParsingTableT, FSMTableT, InputT>::parse_grammar_symbol(ParseContext& ctx, ErrorRecoveryType errRecoveryType) const {
 		LoggerInfo info{ .level = LOG_LEVEL::LL_INFO };
-		const SymbolT topSymbol = m_CurrTopElement.as.gramSymbol;
+		const SymbolT topSymbol = ctx.currTopElement.as.gramSymbol;
 
 		// if the symbol at the top of the stack is a terminal symbol
 		if (topSymbol.isTerminal) {
@@ -362,47 +463,62 @@ namespace m0st4fa::parsix {
 				return;
 
 			// match it explicitly
-			bool matched = (topSymbol == m_CurrInputToken);
+			bool matched = (topSymbol == ctx.currInputToken);
 
-			this->p_Logger.logDebug(std::format("Stack size before: {}", m_Stack.size() + 1));
-			this->p_Logger.log(info, std::format("Matched {:s} with {:s}: {:s}", (std::string)topSymbol, (std::string)m_CurrInputToken, matched ? "true" : "false"));
+			this->log_trace(LoggerInfo::DEBUG, [&] { return std::format("Stack size before: {}", ctx.stack.size() + 1); });
+			this->log_trace(info, [&] { return std::format("Matched {:s} with {:s}: {:s}", (std::string)topSymbol, (std::string)ctx.currInputToken, matched ? "true" : "false"); });
+
+			if (matched && ctx.tree != nullptr) {
+				if constexpr (requires { ctx.currInputToken.offset; ctx.currInputToken.length; })
+					ctx.tree->addLeaf((uint32_t)ctx.currInputToken.name, ctx.currInputToken.offset, (uint32_t)ctx.currInputToken.length);
+				else
+					ctx.tree->addLeaf((uint32_t)ctx.currInputToken.name);
+			}
 
 			// get the next input token
-			m_CurrInputToken = this->getLexicalAnalyzer().get_next_token();
+			ctx.currInputToken = this->get_next_token(*ctx.lexer);
+			record_stats(ctx.stats, &ParseStats::recordToken);
 
 			// if the symbol at the top of the stack is not a terminal symbol and the input token is not matched,
 			if (!matched)
-				error_recovery(errRecoveryType);
+				error_recovery(ctx, errRecoveryType);
+			else
+				record_stats(ctx.stats, &ParseStats::recordMatch);
 		}
 		// if the symbol is a non-terminal symbol
 		else {
 			// get the production record for the current symbol and input
-			const LLTableEntry tableEntry = this->p_Table[EXTRACT_VARIABLE(this->m_CurrTopElement)][(size_t)m_CurrInputToken.name];
+			const LLTableEntry& tableEntry = this->p_Table->view()(EXTRACT_VARIABLE(ctx.currTopElement), (size_t)ctx.currInputToken.name);
 
 			// if the table entry is an error
 			if (tableEntry.isError) {
 				// TODO: do more robust logic based on the boolean returned from the function
-				error_recovery(errRecoveryType);
+				error_recovery(ctx, errRecoveryType);
 				return; // assuming we have synchronized and are ready to continue parsing
 			}
 
 			// if the table entry is not an error
 
-			// Caution: this is a reference
-			const auto& prod = this->m_ProdRecords[tableEntry.prodIndex];
-			const auto& prodBody = prod.prodBody;
+			// push the body of the production on top of the stack (it is stored reversed and was checked not to be empty when the table was frozen)
+			// the bodies are short; pushing their (trivially copyable) elements one by one beats a range insert
+			for (const StackElementType& se : this->p_Table->view().body(tableEntry.prodIndex))
+				ctx.stack.push_back(se);
 
-			// check that the production body is not empty
-			check_prod_body(prod);
+			// the node of the production is added once its grammar symbols (epsilon excluded) are complete
+			if (ctx.tree != nullptr) {
+				uint32_t symbolCount = 0;
 
-			// push the body of the production on top of the stack
-			for (auto it = prodBody.rbegin(); it != prodBody.rend(); ++it) {
-				StackElement se = *it;
-				m_Stack.push_back(se);
-			};
+				for (const StackElementType& se : this->p_Table->view().body(tableEntry.prodIndex))
+					symbolCount += se.type == ProdElementType::PET_GRAM_SYMBOL && not (se.as.gramSymbol == TokenType::EPSILON);
+
+				ctx.tree->expand((uint32_t)tableEntry.prodIndex, symbolCount);
+			}
 
-			this->p_Logger.logDebug(std::format("Stack size before: {}", m_Stack.size() + 1));
-			this->p_Logger.log(info, std::format("Expanded {:s} with {:s}: {:s}", (std::string)topSymbol, (std::string)m_CurrInputToken, (std::string)prod));
+			record_stats(ctx.stats, &ParseStats::recordExpansion);
+			record_stats(ctx.stats, &ParseStats::recordStackDepth, ctx.stack.size());
+
+			this->log_trace(LoggerInfo::DEBUG, [&] { return std::format("Stack size before: {}", ctx.stack.size() + 1); });
+			this->log_trace(info, [&] { return std::format("Expanded {:s} with {:s}: {:s}", (std::string)topSymbol, (std::string)ctx.currInputToken, (std::string)this->m_ProdRecords[tableEntry.prodIndex]); });
 		}
 
 		return;
@@ -431,58 +547,60 @@ namespace m0st4fa::parsix {
 		typename SymbolT,
 		typename ParsingTableT, typename FSMTableT,
 		typename InputT>
-	bool LLParser<GrammarT, LexicalAnalyzerT, SymbolT, ParsingTableT, FSMTableT, InputT>::panic_mode()
+	bool LLParser<GrammarT, LexicalAnalyzerT, SymbolT, ParsingTableT, FSMTableT, InputT>::panic_mode(ParseContext& ctx) const
 	{
 		using StackType = StackType<StackElementType>;
 
+		const ParseStats::PanicModeTimer timer{ ctx.stats };
+
 		// get top stack element
-		auto currInputToken = this->m_CurrInputToken;
-		const SymbolT topSymbol = m_CurrTopElement.as.gramSymbol;
+		auto currInputToken = ctx.currInputToken;
+		const SymbolT topSymbol = ctx.currTopElement.as.gramSymbol;
 
 		// set up the logger state
 		LoggerInfo info{ .level = LOG_LEVEL::LL_INFO };
 		LoggerInfo errInfo{ .level = LOG_LEVEL::LL_ERROR };
 
-		this->p_Logger.log(errInfo, std::format(
+		get_logger().log(errInfo, std::format(
 			"({}, {}) Didn't expect token {:s}",
-			this->getLexicalAnalyzer().getLine(),
-			this->getLexicalAnalyzer().getCol(),
-			(std::string)this->m_CurrInputToken
+			ctx.lexer->getLine(),
+			ctx.lexer->getCol(),
+			(std::string)ctx.currInputToken
 		));
 
 		// loop until the input and the stack are synchronized
 		while (true) {
 			// if the top symbol is a terminal
 			if (topSymbol.isTerminal) {
-				this->p_Logger.log(info, std::format(
-					"Added lexeme {:s} to the input stream.", currInputToken.attribute)
+				get_logger().log(info, std::format(
+					"Added lexeme {:s} to the input stream.", (std::string)currInputToken)
 				);
 
 				// pop the token of the stack and return to the parser
-				m_Stack.pop_back();
+				ctx.stack.pop_back();
 				return true;
 			}
 			// if the top symbol is a non-terminal
 			else {
 				// peak to see the next token
-				currInputToken = this->getLexicalAnalyzer().peak();
+				currInputToken = ctx.lexer->peak();
 
 				// check if it can be used to sync with the parser
-				bool synced = this->panic_mode_try_sync_variable(currInputToken);
+				bool synced = this->panic_mode_try_sync_variable(ctx, currInputToken);
 
 				if (synced)
 					break;
 
 				// if we've reached the end of the input and could not sync with this token
-				if (m_CurrInputToken == TokenType{}) {
+				if (ctx.currInputToken == TokenType{}) {
 					// pop this element since there is no way to synchronize using it
-					m_Stack.pop_back();
+					ctx.stack.pop_back();
 
 					// if the stack is empty, return to the caller
-					if (m_Stack.empty()) {
-						this->p_Logger.log(info, std::format("[ERROR_RECOVERY] ({}, {}) Failed to synchronize: current input: {:s}",
-							this->getLexicalAnalyzer().getLine(),
-							this->getLexicalAnalyzer().getCol(),
+					if (ctx.stack.empty()) {
+						get_logger().log(info, std::format("[ERROR_RECOVERY] ({}, {}) Failed to synchronize: current input: {:s}",
+							ctx.lexer->getLine(),
+							ctx.lexer->getCol(),
 							(std::string)currInputToken
 						));
 
@@ -518,13 +636,13 @@ namespace m0st4fa::parsix {
 		typename SymbolT,
 		typename ParsingTableT, typename FSMTableT,
 		typename InputT>
-	bool LLParser<GrammarT, LexicalAnalyzerT, SymbolT, ParsingTableT, FSMTableT, InputT>::panic_mode_try_sync_variable(TokenType& currInputToken) {
+	bool LLParser<GrammarT, LexicalAnalyzerT, SymbolT, ParsingTableT, FSMTableT, InputT>::panic_mode_try_sync_variable(ParseContext& ctx, TokenType& currInputToken) const {
 		using StackType = StackType<StackElementType>;
 
 		LoggerInfo info{ .level = LOG_LEVEL::LL_INFO };
 
 		// Check for whether the non-terminal has an epsilon production and use it to reduce that non-terminal.
-		LLTableEntry tableEntry = this->p_Table[EXTRACT_VARIABLE(this->m_CurrTopElement)][(size_t)TokenType::EPSILON.name];
+		LLTableEntry tableEntry = this->p_Table->view()(EXTRACT_VARIABLE(ctx.currTopElement), (size_t)TokenType::EPSILON.name);
 
 		// if it is not an err, there is an epsilon production
 		if (-not tableEntry.isError) {
@@ -532,49 +650,44 @@ namespace m0st4fa::parsix {
 
 			// Caution: this is a reference
 			const auto& prod = this->m_ProdRecords[tableEntry.prodIndex];
-			const auto& prodBody = prod.prodBody;
-
-			// check that the production body is not empty
-			check_prod_body(prod);
 
 			// push the body of the production on top of the stack
-			for (auto it = prodBody.rbegin(); it != prodBody.rend(); ++it) {
-				StackElementType se = *it;
-				m_Stack.push_back(se);
-			};
+			for (const StackElementType& se : this->p_Table->view().body(tableEntry.prodIndex))
+				ctx.stack.push_back(se);
 
-			this->p_Logger.log(info, std::format("[ERROR_RECOVERY] Expanded {:s} with {:s}: {:s}",
-				toString(m_CurrTopElement.as.gramSymbol.as.nonTerminal),
-				m_CurrInputToken.toString(),
+			get_logger().log(info, std::format("[ERROR_RECOVERY] Expanded {:s} with {:s}: {:s}",
+				toString(ctx.currTopElement.as.gramSymbol.as.nonTerminal),
+				ctx.currInputToken.toString(),
 				prod.toString()));
 
-			print_sync_msg(this->getLexicalAnalyzer().getPosition());
+			print_sync_msg(ctx, ctx.lexer->getPosition());
 
 			return true;
 		}
 
-		// get the production record for the current symbol and input
-		tableEntry = this->p_Table[EXTRACT_VARIABLE(this->m_CurrTopElement)][(size_t)currInputToken.name];
-
 		/**
 		* Assume the synchronization set of each non-terminal contains the first set of that non-terminal.
 		* For the rest of the tokens, the action to take would be specified in the table entry.
 		*/
 
 		/**
-		* If the entry is an error, check whether it has an action or no.
+		* If the entry is an error (a single bit test; see `LLParsingTable::syncSets`), check whether it has an action or no.
 		* If it has an associated action, do it, otherwise, continue to skip tokens.
 		*/
-		if (tableEntry.isError) {
+		if (not this->p_Table->view().synchronizes(EXTRACT_VARIABLE(ctx.currTopElement), (size_t)currInputToken.name)) {
+			// get the production record for the current symbol and input
+			tableEntry = this->p_Table->view()(EXTRACT_VARIABLE(ctx.currTopElement), (size_t)currInputToken.name);
+
 			// if the entry has an action
 			if (tableEntry.action) {
 				auto action = static_cast<bool (*)(StackType, StackElementType, TokenType)>(tableEntry.action);
 
 				// if the action results in a synchronization
-				if (action(m_Stack, m_CurrTopElement, currInputToken)) {
-					m_CurrInputToken = this->getLexicalAnalyzer().get_next_token();
+				if (action(ctx.stack, ctx.currTopElement, currInputToken)) {
+					ctx.currInputToken = this->get_next_token(*ctx.lexer);
+					record_stats(ctx.stats, &ParseStats::recordToken);
 
-					print_sync_msg(this->getLexicalAnalyzer().getPosition());
+					print_sync_msg(ctx, ctx.lexer->getPosition());
 
 					return true;
 				}
@@ -583,7 +696,8 @@ namespace m0st4fa::parsix {
 			// if the entry has no action or the action has failed to synchronize
 
 			// get the next input and try again to synchronize
-			m_CurrInputToken = this->getLexicalAnalyzer().get_next_token();
+			ctx.currInputToken = this->get_next_token(*ctx.lexer);
+			record_stats(ctx.stats, &ParseStats::recordToken);
 			return false;
 		}
 
@@ -592,8 +706,9 @@ namespace m0st4fa::parsix {
 		* Upon reaching here, this means the parser has synchronized with the current token.
 		* Since we've just peaked to see whether we can sync with it or not, now we need to fetch it so that parsing can continue from it.
 		*/
-		m_CurrInputToken = this->getLexicalAnalyzer().get_next_token();
-		print_sync_msg(this->getLexicalAnalyzer().getPosition());
+		ctx.currInputToken = this->get_next_token(*ctx.lexer);
+		record_stats(ctx.stats, &ParseStats::recordToken);
+		print_sync_msg(ctx, ctx.lexer->getPosition());
 
 		/**
 		* If the table entry is not an error, then we have synchronized correctly using FIRST set and possibly using FOLLOW set.
@@ -602,35 +717,4 @@ namespace m0st4fa::parsix {
 
 		return true;
 	}
-
-	/**
-	 * @brief Checks if the production body is empty.
-	 *
-	 * @tparam GrammarT The type of the grammar object.
-	 * @tparam LexicalAnalyzerT The type of the lexical analyzer object.
-	 * @tparam SymbolT The type of the symbol object.
-	 * @tparam ParsingTableT The type of the parsing table object.
-	 * @tparam FSMTableT The type of the FSM table object.
-	 * @tparam InputT The type of the input string.
-	 *
-	 * @param prod The production to be checked.
-	 *
-	 * @details This function checks if the production body is empty. If the production body is empty, it logs an error message and throws a logic  error.
-	 *
-	 * @return void
-	 */
-	template<typename GrammarT, typename LexicalAnalyzerT,
-		typename SymbolT,
-		typename ParsingTableT, typename FSMTableT,
-		typename InputT>
-	void LLParser<GrammarT, LexicalAnalyzerT, SymbolT, ParsingTableT, FSMTableT, InputT>::check_prod_body(const ProductionType& prod) const {
-		LoggerInfo errorInfo{ .level = LOG_LEVEL::LL_ERROR };
-
-		const auto& prodBody = prod.prodBody;
-
-		if (prodBody.empty()) {
-			this->p_Logger.log(errorInfo, std::format("Production body is empty: {:s}", prod.toString()));
-			throw std::logic_error("Production body is empty.");
-		};
-	}
 }
\ No newline at end of file
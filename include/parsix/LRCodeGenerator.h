@@ -0,0 +1,374 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "parsix/LRCompressedTable.h"
+#include "parsix/Logging.h"
+
+// DECLARATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Generates the C++ source of a standalone parser from an LR parsing table.
+	 * @details The generated header has no dependencies besides the standard library. It defines a class template with a single static `parse()` function implementing the table as a directly threaded state machine: a `switch` on the current state, whose every case is a `switch` on the current terminal leading straight to the shift, reduction or acceptance of that entry, yacc/bison style. A reduction calls the action of its production through `ActionsT::reduceProduction<P>()` (which an LRActionTable has), pops a constant number of states and looks its GOTO state up in a static array. Hence, a generated parser has neither the entry-type dispatch nor any of the table indirection of the interpreting LRParser, and the semantic actions written for an LRParser with an LRActionTable work unchanged.
+		* The generated class template is `template <typename TerminalT, typename StackT> class Name`, where `TerminalT` is the terminal type of the grammar and `StackT` the stack type of the parser (e.g., `LRStackType<...>`).
+		* `Name::parse(nextToken, actions, result)` parses the tokens returned by calls to `nextToken()` (anything having a `name` terminal field, e.g., the tokens of a lexical analyzer) and returns `result` as updated by the action of production 0. An overload takes the stack to use (so that its storage may be reused between parses).
+		* A syntax error throws `std::logic_error`; generated parsers do not recover from errors.
+	 * @tparam GrammarT The type of object representing the grammar. Generally, it is a vector of production record objects.
+	 */
+	template <typename GrammarT>
+	class LRCodeGenerator {
+
+		/**
+		 * @brief Aliases the type of the parsing table the code is generated from.
+		 */
+		using TableType = LRParsingTable<GrammarT>;
+
+		using SymbolType = typename TableType::SymbolType;
+		using TerminalType = typename TableType::TerminalType;
+		using VariableType = typename TableType::VariableType;
+
+	public:
+
+		/**
+		 * @brief The options of the generated code.
+		 */
+		struct Options {
+
+			/**
+			 * @brief The namespace the parser is generated in; it may be nested (e.g., `app::parsing`).
+			 */
+			std::string namespaceName = "generated";
+
+			/**
+			 * @brief The name of the class template of the parser.
+			 */
+			std::string className = "Parser";
+		};
+
+	private:
+
+		/**
+		 * @brief The (frozen) table the code is generated from.
+		 */
+		TableType m_Table;
+
+		/**
+		 * @brief Gets the smallest unsigned integer type that can hold `maxValue`, as spelled in the generated code.
+		 */
+		static std::string_view _uint_type(size_t maxValue) {
+			return maxValue <= UINT8_MAX ? "std::uint8_t" : maxValue <= UINT16_MAX ? "std::uint16_t" : "std::uint32_t";
+		}
+
+		/**
+		 * @brief Gets a block comment of the generated code holding the string representation of a symbol or a production.
+		 * @details The comment is kept on a single line, and a `*` followed by a `/` is split so that it does not end the comment early. Unlike a line comment, it is not continued on the next line if the representation ends with a backslash.
+		 */
+		static std::string _comment(const auto& object) {
+			std::string str = (std::string)object;
+			std::replace_if(str.begin(), str.end(), [](char c) { return c == '\n' || c == '\r'; }, ' ');
+
+			for (size_t pos = str.find("*/"); pos != std::string::npos; pos = str.find("*/", pos + 2))
+				str.replace(pos, 2, "* /");
+
+			return "/* " + str + " */";
+		}
+
+		void _check_identifier(std::string_view name, bool qualified) const;
+		void _emit_tables(std::string& out) const;
+		void _emit_helpers(std::string& out) const;
+		void _emit_state(std::string& out, size_t state) const;
+
+	public:
+
+		/**
+		 * @brief Constructs a generator for a parsing table.
+		 * @param[in] table The table; it is copied and frozen (see `LRParsingTable::freeze()`).
+		 * @throws std::logic_error If the table contains an invalid entry.
+		 */
+		explicit LRCodeGenerator(TableType table) : m_Table{ std::move(table) } {
+			this->m_Table.freeze();
+		}
+
+		std::string generate(const Options& options = Options{}) const;
+
+		/**
+		 * @brief Generates the source of the parser into a file.
+		 * @param[in] path The path of the header to generate; it is overwritten if it exists.
+		 * @param[in] options The options of the generated code.
+		 * @throws std::logic_error If an option is not a valid identifier.
+		 * @throws std::runtime_error If the file cannot be written.
+		 */
+		void generate(const std::filesystem::path& path, const Options& options = Options{}) const {
+			const std::string source = this->generate(options);
+			std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+
+			if (not (file << source).flush())
+				throw std::runtime_error(std::format("Cannot write the generated parser to file `{}`.", path.string()));
+		}
+
+	};
+
+}
+
+// IMPLEMENTATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Checks that a name is a valid C++ identifier (or a `::`-separated sequence of them, if `qualified`).
+	 * @throws std::logic_error If it is not.
+	 */
+	template <typename GrammarT>
+	void LRCodeGenerator<GrammarT>::_check_identifier(std::string_view name, bool qualified) const
+	{
+		const auto isIdentifier = [](std::string_view part) {
+			if (part.empty() || (part[0] >= '0' && part[0] <= '9'))
+				return false;
+
+			return std::all_of(part.begin(), part.end(), [](char c) {
+				return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+				});
+		};
+
+		bool valid = true;
+		size_t begin = 0;
+
+		while (valid) {
+			const size_t end = qualified ? name.find("::", begin) : std::string_view::npos;
+			valid = isIdentifier(name.substr(begin, end == std::string_view::npos ? end : end - begin));
+
+			if (end == std::string_view::npos)
+				break;
+
+			begin = end + 2;
+		}
+
+		if (not valid) {
+			get_logger().log(LoggerInfo::ERR_INVALID_VAL, std::format("`{}` is not a valid name for the generated parser.", name));
+			throw std::logic_error("Invalid name for the generated parser.");
+		}
+	}
+
+	/**
+	 * @brief Emits the static arrays of the parser: the GOTO table, indexed by state and then by non-terminal.
+	 * @details Only GOTO entries are stored; all of the other entries are compiled into the code of the states.
+	 */
+	template <typename GrammarT>
+	void LRCodeGenerator<GrammarT>::_emit_tables(std::string& out) const
+	{
+		const size_t stateCount = this->m_Table.gotoTable.size();
+
+		out += std::format("\t\tstatic constexpr {} GOTOS[STATE_COUNT][{}] = {{\n", _uint_type(stateCount), TableType::VAR_COUNT);
+
+		for (size_t state = 0; state < stateCount; state++) {
+			out += "\t\t\t{";
+
+			for (size_t variable = 0; variable < TableType::VAR_COUNT; variable++) {
+				const LRTableEntry& entry = this->m_Table.gotoTable[state][variable];
+				out += std::format("{}{}", variable ? ", " : " ", entry.isEmpty ? 0 : entry.number);
+			}
+
+			out += std::format(" }}, // {}\n", state);
+		}
+
+		out += "\t\t};\n\n";
+	}
+
+	/**
+	 * @brief Emits the helper functions of the parser: shifting a token, reducing a production (instantiated for every production) and reporting a syntax error.
+	 */
+	template <typename GrammarT>
+	void LRCodeGenerator<GrammarT>::_emit_helpers(std::string& out) const
+	{
+		out +=
+			"\t\t/**\n"
+			"\t\t * @brief Shifts `token`, pushing `state` on the stack.\n"
+			"\t\t */\n"
+			"\t\ttemplate <typename TokenT>\n"
+			"\t\tstatic void _shift(StackT& stack, TokenT& token, std::size_t state) {\n"
+			"\t\t\tStateT shifted{ state };\n"
+			"\t\t\tshifted.token = std::move(token);\n"
+			"\t\t\tstack.push_back(std::move(shifted));\n"
+			"\t\t}\n\n"
+			"\t\t/**\n"
+			"\t\t * @brief Reduces production `P`, whose body has `LENGTH` symbols and whose head is non-terminal `HEAD`.\n"
+			"\t\t */\n"
+			"\t\ttemplate <std::size_t P, std::size_t LENGTH, std::size_t HEAD, typename ActionsT>\n"
+			"\t\tstatic void _reduce(StackT& stack, const ActionsT& actions) {\n"
+			"\t\t\tStateT newState{};\n"
+			"\t\t\tactions.template reduceProduction<P>(stack, newState);\n"
+			"\n"
+			"\t\t\tif constexpr (LENGTH != 0)\n"
+			"\t\t\t\tstack.erase(stack.end() - LENGTH, stack.end());\n"
+			"\n"
+			"\t\t\tnewState.state = GOTOS[stack.back().state][HEAD];\n"
+			"\t\t\tstack.push_back(std::move(newState));\n"
+			"\t\t}\n\n"
+			"\t\t[[noreturn]] static void _syntax_error(std::size_t state, TerminalT terminal) {\n"
+			"\t\t\tthrow std::logic_error(\"Syntax error: unexpected terminal \" + std::to_string((std::size_t)terminal) + \" in state \" + std::to_string(state) + \".\");\n"
+			"\t\t}\n\n";
+	}
+
+	/**
+	 * @brief Emits the case of the state machine implementing a state: a `switch` on the current terminal, having a case for every distinct entry of the state.
+	 */
+	template <typename GrammarT>
+	void LRCodeGenerator<GrammarT>::_emit_state(std::string& out, size_t state) const
+	{
+		// the terminals of every distinct entry, in the order of their first terminal
+		std::map<uint32_t, std::vector<size_t>> byEntry;
+		std::vector<uint32_t> order;
+
+		for (size_t terminal = 0; terminal < TableType::TER_COUNT; terminal++) {
+			const LRTableEntry& entry = this->m_Table.actionTable[state][terminal];
+
+			if (entry.isEmpty || entry.type == LRTableEntryType::TET_ERROR)
+				continue;
+
+			const uint32_t key = LRPackedEntry::pack(entry).bits;
+			std::vector<size_t>& terminals = byEntry[key];
+
+			if (terminals.empty())
+				order.push_back(key);
+
+			terminals.push_back(terminal);
+		}
+
+		out += std::format("\t\t\t\tcase {}:\n\t\t\t\t\tswitch (token.name) {{\n", state);
+
+		for (const uint32_t key : order) {
+			for (const size_t terminal : byEntry[key])
+				out += std::format("\t\t\t\t\tcase TerminalT({}): {}\n", terminal, _comment(SymbolType{ .isTerminal = true, .as {.terminal = (TerminalType)terminal} }));
+
+			const LRTableEntry entry = LRPackedEntry{ key }.unpack();
+
+			switch (entry.type) {
+			case LRTableEntryType::TET_ACTION_SHIFT:
+				out += std::format("\t\t\t\t\t\t_shift(stack, token, {});\n\t\t\t\t\t\ttoken = nextToken();\n\t\t\t\t\t\tcontinue;\n", entry.number);
+				break;
+
+			case LRTableEntryType::TET_ACTION_REDUCE: {
+				const auto& production = this->m_Table.grammar.at(entry.number);
+				const size_t length = production.isEpsilon() ? 0 : production.size();
+
+				out += std::format("\t\t\t\t\t\t_reduce<{}, {}, {}>(stack, actions); {}\n\t\t\t\t\t\tcontinue;\n",
+					entry.number, length, (size_t)production.prodHead.as.nonTerminal, _comment(production));
+				break;
+			}
+
+			case LRTableEntryType::TET_ACCEPT:
+				out +=
+					"\t\t\t\t\t{\n"
+					"\t\t\t\t\t\tStateT newState{};\n"
+					"\t\t\t\t\t\tactions.accept(stack, newState, result);\n"
+					"\t\t\t\t\t\treturn result;\n"
+					"\t\t\t\t\t}\n";
+				break;
+
+			default:
+				break;
+			}
+		}
+
+		out += std::format("\t\t\t\t\tdefault:\n\t\t\t\t\t\t_syntax_error({}, token.name);\n\t\t\t\t\t}}\n\n", state);
+	}
+
+	/**
+	 * @brief Generates the source of the parser.
+	 * @param[in] options The options of the generated code.
+	 * @returns The source of a standalone C++ header defining the parser (see the class documentation).
+	 * @throws std::logic_error If an option is not a valid identifier.
+	 */
+	template <typename GrammarT>
+	std::string LRCodeGenerator<GrammarT>::generate(const Options& options) const
+	{
+		this->_check_identifier(options.namespaceName, true);
+		this->_check_identifier(options.className, false);
+
+		const size_t stateCount = this->m_Table.actionTable.size();
+		std::string out;
+
+		out += std::format(
+			"// Generated by parsix::LRCodeGenerator from a parsing table of {} states and {} productions.\n"
+			"// Do not edit this file; generate it again from the grammar instead.\n"
+			"#pragma once\n"
+			"#include <cstddef>\n"
+			"#include <cstdint>\n"
+			"#include <stdexcept>\n"
+			"#include <string>\n"
+			"#include <utility>\n"
+			"\n"
+			"namespace {} {{\n"
+			"\n"
+			"\t/**\n"
+			"\t * @brief A generated LR parser: every state of its table is a case of a `switch`.\n"
+			"\t * @tparam TerminalT The type of a terminal of the grammar.\n"
+			"\t * @tparam StackT The type of the stack of the parser; a vector of LR states (having `state`, `token` and `data` fields).\n"
+			"\t */\n"
+			"\ttemplate <typename TerminalT, typename StackT>\n"
+			"\tclass {} {{\n"
+			"\n"
+			"\t\tusing StateT = typename StackT::value_type;\n"
+			"\n",
+			stateCount, this->m_Table.grammar.size(), options.namespaceName, options.className);
+
+		out += std::format("\tpublic:\n\n\t\tstatic constexpr std::size_t STATE_COUNT = {};\n\t\tstatic constexpr std::size_t PRODUCTION_COUNT = {};\n\n\tprivate:\n\n",
+			stateCount, this->m_Table.grammar.size());
+
+		this->_emit_tables(out);
+		this->_emit_helpers(out);
+
+		out +=
+			"\tpublic:\n"
+			"\n"
+			"\t\t/**\n"
+			"\t\t * @brief Parses the tokens returned by `nextToken()`, using `stack` as the stack of the parser (it is cleared first).\n"
+			"\t\t * @param[in] actions The semantic actions of the productions; an LRActionTable.\n"
+			"\t\t * @returns `result`, as updated by the action of production 0 on acceptance.\n"
+			"\t\t * @throws std::logic_error On a syntax error.\n"
+			"\t\t */\n"
+			"\t\ttemplate <typename NextTokenFnT, typename ActionsT, typename ResultT>\n"
+			"\t\tstatic ResultT parse(StackT& stack, NextTokenFnT&& nextToken, const ActionsT& actions, ResultT result) {\n"
+			"\t\t\tstack.clear();\n"
+			"\t\t\tstack.push_back(StateT{ 0 });\n"
+			"\t\t\tauto token = nextToken();\n"
+			"\n"
+			"\t\t\twhile (true) {\n"
+			"\t\t\t\tswitch (stack.back().state) {\n";
+
+		for (size_t state = 0; state < stateCount; state++)
+			this->_emit_state(out, state);
+
+		out +=
+			"\t\t\t\tdefault:\n"
+			"\t\t\t\t\t_syntax_error(stack.back().state, token.name);\n"
+			"\t\t\t\t}\n"
+			"\t\t\t}\n"
+			"\t\t}\n"
+			"\n"
+			"\t\t/**\n"
+			"\t\t * @brief Parses the tokens returned by `nextToken()` with a stack of its own.\n"
+			"\t\t */\n"
+			"\t\ttemplate <typename NextTokenFnT, typename ActionsT, typename ResultT>\n"
+			"\t\tstatic ResultT parse(NextTokenFnT&& nextToken, const ActionsT& actions, ResultT result) {\n"
+			"\t\t\tStackT stack;\n"
+			"\t\t\treturn parse(stack, std::forward<NextTokenFnT>(nextToken), actions, std::move(result));\n"
+			"\t\t}\n"
+			"\n"
+			"\t};\n"
+			"\n"
+			"}\n";
+
+		return out;
+	}
+
+}
@@ -0,0 +1,403 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "parsix/ptable.h"
+
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief An LRTableEntry object packed into 32 bits: a 3-bit kind followed by a 29-bit number.
+	 * @details The kind is 0 for an empty entry and `(size_t)type + 1` otherwise, so a zero-initialized packed entry is an empty (error) entry.
+	 */
+	struct LRPackedEntry {
+
+		/**
+		 * @brief The number of bits used to store the kind of the entry.
+		 */
+		static constexpr uint32_t KIND_BITS = 3;
+
+		/**
+		 * @brief The number of bits used to store the number (state or production number) of the entry.
+		 */
+		static constexpr uint32_t NUMBER_BITS = 32 - KIND_BITS;
+
+		/**
+		 * @brief The mask of the number part of the entry. This value of the number part stands for `SIZE_MAX` (i.e., "no number".)
+		 */
+		static constexpr uint32_t NUMBER_MASK = (uint32_t(1) << NUMBER_BITS) - 1;
+
+		static_assert((size_t)LRTableEntryType::TET_COUNT < (size_t(1) << KIND_BITS), "Not enough bits to store the kind of an LR table entry.");
+
+		/**
+		 * @brief The packed kind and number.
+		 */
+		uint32_t bits = 0;
+
+		/**
+		 * @brief Packs an LRTableEntry object.
+		 * @param[in] entry The entry to be packed.
+		 * @returns The packed entry.
+		 * @throws std::range_error If the number of `entry` does not fit in LRPackedEntry::NUMBER_BITS bits.
+		 */
+		static constexpr LRPackedEntry pack(const LRTableEntry& entry) {
+			if (entry.isEmpty)
+				return LRPackedEntry{};
+
+			if (entry.number != SIZE_MAX && entry.number >= NUMBER_MASK)
+				throw std::range_error(std::format("The number `{}` of the LR table entry does not fit in {} bits.", entry.number, NUMBER_BITS));
+
+			const uint32_t kind = (uint32_t)entry.type + 1;
+			const uint32_t number = entry.number == SIZE_MAX ? NUMBER_MASK : (uint32_t)entry.number;
+
+			return LRPackedEntry{ (kind << NUMBER_BITS) | number };
+		}
+
+		/**
+		 * @brief Checks whether this entry is empty.
+		 */
+		constexpr bool isEmpty() const { return (this->bits >> NUMBER_BITS) == 0; }
+
+		/**
+		 * @brief Gets the type of this entry. Empty entries are of type LRTableEntryType::TET_ERROR.
+		 */
+		constexpr LRTableEntryType type() const {
+			const uint32_t kind = this->bits >> NUMBER_BITS;
+			return kind == 0 ? LRTableEntryType::TET_ERROR : (LRTableEntryType)(kind - 1);
+		}
+
+		/**
+		 * @brief Gets the number (state or production number) of this entry.
+		 */
+		constexpr size_t number() const {
+			const uint32_t number = this->bits & NUMBER_MASK;
+			return this->isEmpty() || number == NUMBER_MASK ? SIZE_MAX : number;
+		}
+
+		/**
+		 * @brief Unpacks this entry.
+		 * @returns The LRTableEntry object this entry was packed from.
+		 */
+		constexpr LRTableEntry unpack() const {
+			return LRTableEntry{ this->isEmpty(), this->type(), this->number() };
+		}
+
+		/**
+		 * @brief Compares two packed entries for equality (bit by bit).
+		 */
+		constexpr bool operator==(const LRPackedEntry&) const = default;
+	};
+
+	static_assert(sizeof(LRPackedEntry) == 4);
+
+	/**
+	 * @brief A compressed, read-only LR parsing table. It can be used as the `ParsingTableT` of an LRParser instead of LRParsingTable.
+	 * @details The table is constructed from an LRParsingTable object and provides the same lookup interface (`atAction()`, `atGoto()`, `getActions()`, `getGotos()` and `grammar`). Internally:
+		* Entries are packed into 32 bits (see LRPackedEntry).
+		* The Action and GOTO rows of every state are merged into a single row, which is placed into a shared one-dimensional array at some displacement (the *base* of the state) such that its non-empty entries do not collide with those of other states (row displacement, also known as comb compression). A parallel *check* array records the state owning each cell, so a lookup is just `entries[base[state] + column]` if `check[base[state] + column] == state`.
+		* Optionally, the most common reduction of every state becomes its *default reduction*: it is removed from the row and returned for every terminal that does not have an entry of its own. This removes most of the entries of the table, but it means that some errors are detected only after a few (harmless) reductions are made.
+	 * @note Accept entries are never turned into default reductions and GOTO entries never have defaults.
+	 * @tparam GrammarT The type of object representing the grammar. Generally, it is a vector of production record objects.
+	 */
+	template <typename GrammarT>
+	class LRCompressedTable {
+
+		/**
+		 * @brief Aliases the type of the (uncompressed) table this table is constructed from.
+		 */
+		using TableType = LRParsingTable<GrammarT>;
+
+	public:
+
+		/**
+		 * @brief Aliases the type of a terminal.
+		 */
+		using TerminalType = typename TableType::TerminalType;
+
+		/**
+		 * @brief Aliases the type of a non-terminal.
+		 */
+		using VariableType = typename TableType::VariableType;
+
+		/**
+		 * @brief The total number of non-terminals in the grammar.
+		 */
+		static constexpr const size_t VAR_COUNT = TableType::VAR_COUNT;
+
+		/**
+		 * @brief The total number of terminals in the grammar.
+		 */
+		static constexpr const size_t TER_COUNT = TableType::TER_COUNT;
+
+	private:
+
+		/**
+		 * @brief The width of a merged row: the Action columns followed by the GOTO columns.
+		 */
+		static constexpr const size_t ROW_WIDTH = TER_COUNT + VAR_COUNT;
+
+		/**
+		 * @brief The value of a cell of the check array that is not owned by any state.
+		 */
+		static constexpr const uint32_t FREE_CELL = UINT32_MAX;
+
+		/**
+		 * @brief The displacement of the row of every state within `m_Entries` and `m_Check`.
+		 */
+		std::vector<uint32_t> m_Base;
+
+		/**
+		 * @brief The default reduction of every state; empty if the state has none.
+		 */
+		std::vector<LRPackedEntry> m_Default;
+
+		/**
+		 * @brief The entries of all of the rows, overlapped.
+		 */
+		std::vector<LRPackedEntry> m_Entries;
+
+		/**
+		 * @brief The state owning every cell of `m_Entries`; LRCompressedTable::FREE_CELL if no state owns it.
+		 */
+		std::vector<uint32_t> m_Check;
+
+		/**
+		 * @brief Looks up the cell of a given state and column.
+		 * @param[in] state The state.
+		 * @param[in] column The column within the merged row.
+		 * @returns A pointer to the entry if the state has a (non-default) entry in that column; `nullptr` otherwise.
+		 */
+		const LRPackedEntry* _lookup(size_t state, size_t column) const noexcept(true) {
+			const size_t index = this->m_Base[state] + column;
+
+			return this->m_Check[index] == state ? &this->m_Entries[index] : nullptr;
+		}
+
+		void _compress(const TableType&, bool);
+
+	public:
+
+		/**
+		 * @brief The grammar.
+		 */
+		GrammarT grammar;
+
+		/**
+		 * @brief Default constructor.
+		 */
+		LRCompressedTable() = default;
+
+		/**
+		 * @brief Converting constructor. Compresses an LRParsingTable object.
+		 * @param[in] table The table to be compressed. It is frozen (see `LRParsingTable::freeze()`) before being compressed.
+		 * @param[in] useDefaultReductions Whether to use default reductions (see the class documentation).
+		 * @throws std::range_error If a state or production number of `table` does not fit in an LRPackedEntry object.
+		 * @throws std::logic_error If `table` contains an invalid entry.
+		 */
+		LRCompressedTable(const TableType& table, bool useDefaultReductions = true) : grammar{ table.grammar } {
+			this->_compress(table, useDefaultReductions);
+		}
+
+		/**
+		 * @brief Does nothing; the table is validated when it is compressed and cannot be modified afterwards.
+		 */
+		void freeze() const noexcept(true) {}
+
+		/**
+		 * @brief Gets a read-only view of the table. Since the table is already read-only, this is the table itself.
+		 */
+		const LRCompressedTable& view() const noexcept(true) { return *this; }
+
+		/**
+		 * @brief Gets the production whose number is `prodNumber`. No boundary-checking.
+		 */
+		const auto& production(size_t prodNumber) const noexcept(true) {
+			return this->grammar.getVector()[prodNumber];
+		}
+
+		/**
+		 * @brief Gets the number of states of the table.
+		 */
+		size_t getStateCount() const { return this->m_Base.size(); }
+
+		/**
+		 * @brief Gets the number of bytes used to store the entries of the table (not counting the grammar).
+		 */
+		size_t getByteSize() const {
+			return this->m_Base.size() * sizeof(uint32_t) + this->m_Default.size() * sizeof(LRPackedEntry) +
+				this->m_Entries.size() * sizeof(LRPackedEntry) + this->m_Check.size() * sizeof(uint32_t);
+		}
+
+		/**
+		 * @brief Gets the Action entry at this `state` and this `terminal`.
+		 * @param[in] state The state used as the first index of the table.
+		 * @param[in] terminal The terminal used as the second index of the table.
+		 * @returns The Action entry for this `state` and this `terminal`; the default reduction of `state` (if any) if it has no entry of its own for `terminal`.
+		 */
+		LRTableEntry atAction(size_t state, TerminalType terminal) const noexcept(true) {
+			const LRPackedEntry* entry = this->_lookup(state, (size_t)terminal);
+
+			return (entry ? *entry : this->m_Default[state]).unpack();
+		}
+
+		/**
+		 * @brief Gets the GOTO entry at this `state` and this `nonTerminal`.
+		 * @param[in] state The state used as the first index of the table.
+		 * @param[in] nonTerminal The non-terminal used as the second index of the table.
+		 * @returns The GOTO entry for this `state` and this `nonTerminal`.
+		 */
+		LRTableEntry atGoto(size_t state, VariableType nonTerminal) const noexcept(true) {
+			const LRPackedEntry* entry = this->_lookup(state, TER_COUNT + (size_t)nonTerminal);
+
+			return entry ? entry->unpack() : LRTableEntry{};
+		}
+
+		/**
+		 * @brief Gets all of the terminals having a **non-error** Action entry in a given state (including the ones covered by its default reduction).
+		 * @param[in] state The state used as the index of the Action table.
+		 * @returns Only the terminals whose Action entry in `state` is not an error.
+		 */
+		std::vector<TerminalType> getActions(size_t state) const {
+			std::vector<TerminalType> res;
+
+			for (size_t terminal = 0; terminal < TER_COUNT; terminal++)
+				if (not this->atAction(state, (TerminalType)terminal).isError())
+					res.push_back((TerminalType)terminal);
+
+			return res;
+		}
+
+		/**
+		 * @brief Gets all of the non-terminals having a **non-error** GOTO entry in a given state.
+		 * @param[in] state The state used as the index of the GOTO table.
+		 * @returns Only the non-terminals whose GOTO entry in `state` is not an error.
+		 */
+		std::vector<VariableType> getGotos(size_t state) const {
+			std::vector<VariableType> res;
+
+			for (size_t variable = 0; variable < VAR_COUNT; variable++)
+				if (this->_lookup(state, TER_COUNT + variable))
+					res.push_back((VariableType)variable);
+
+			return res;
+		}
+
+	};
+
+}
+
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Compresses the rows of an LRParsingTable object into this table.
+	 * @details **Algorithm**:
+		* For every state, pick its default reduction (the reduction occurring the most in its Action row), if requested, and gather the columns of the remaining non-empty entries of its merged row.
+		* Place the rows, densest first, at the smallest displacement at which none of their columns land on a cell owned by another state (first fit).
+	 * @param[in] table The table to be compressed.
+	 * @param[in] useDefaultReductions Whether to use default reductions.
+	 */
+	template<typename GrammarT>
+	void LRCompressedTable<GrammarT>::_compress(const TableType& uncheckedTable, bool useDefaultReductions)
+	{
+		TableType table = uncheckedTable;
+		table.freeze();
+
+		const size_t stateCount = table.actionTable.size();
+
+		this->m_Base.assign(stateCount, 0);
+		this->m_Default.assign(stateCount, LRPackedEntry{});
+
+		// gather the (column, entry) pairs of every row
+		std::vector<std::vector<std::pair<uint32_t, LRPackedEntry>>> rows(stateCount);
+		for (size_t state = 0; state < stateCount; state++) {
+			auto& row = rows[state];
+
+			const auto& actions = table.actionTable[state];
+
+			// the default reduction is the most frequent reduction of the row
+			if (useDefaultReductions) {
+				size_t bestCount = 0;
+
+				for (const LRTableEntry& candidate : actions) {
+					if (candidate.isEmpty || candidate.type != LRTableEntryType::TET_ACTION_REDUCE)
+						continue;
+
+					const size_t count = std::count(actions.begin(), actions.end(), candidate);
+					if (count > bestCount)
+						bestCount = count, this->m_Default[state] = LRPackedEntry::pack(candidate);
+				}
+			}
+
+			for (size_t terminal = 0; terminal < TER_COUNT; terminal++) {
+				const LRPackedEntry entry = LRPackedEntry::pack(actions[terminal]);
+
+				if (not entry.isEmpty() && not (entry == this->m_Default[state]))
+					row.emplace_back((uint32_t)terminal, entry);
+			}
+
+			for (size_t variable = 0; variable < VAR_COUNT; variable++)
+				if (const auto& entry = table.gotoTable[state][variable]; not entry.isEmpty)
+					row.emplace_back((uint32_t)(TER_COUNT + variable), LRPackedEntry::pack(entry));
+		}
+
+		// place the densest rows first; they are the hardest to fit
+		std::vector<size_t> order(stateCount);
+		for (size_t state = 0; state < stateCount; state++)
+			order[state] = state;
+
+		std::stable_sort(order.begin(), order.end(), [&rows](size_t lhs, size_t rhs) {
+			return rows[lhs].size() > rows[rhs].size();
+			});
+
+		this->m_Entries.assign(ROW_WIDTH, LRPackedEntry{});
+		this->m_Check.assign(ROW_WIDTH, FREE_CELL);
+
+		// the cells below `firstFree` are all owned
+		size_t firstFree = 0;
+		for (size_t state : order) {
+			const auto& row = rows[state];
+
+			if (row.empty())
+				continue;
+
+			size_t base = firstFree > row.front().first ? firstFree - row.front().first : 0;
+			for (; ; base++) {
+
+				// make sure every column of the row at this displacement is within the arrays
+				if (base + ROW_WIDTH > this->m_Check.size()) {
+					this->m_Entries.resize(base + ROW_WIDTH, LRPackedEntry{});
+					this->m_Check.resize(base + ROW_WIDTH, FREE_CELL);
+				}
+
+				const bool fits = std::all_of(row.begin(), row.end(), [this, base](const auto& cell) {
+					return this->m_Check[base + cell.first] == FREE_CELL;
+					});
+
+				if (fits)
+					break;
+			}
+
+			this->m_Base[state] = (uint32_t)base;
+			for (const auto& [column, entry] : row) {
+				this->m_Entries[base + column] = entry;
+				this->m_Check[base + column] = (uint32_t)state;
+			}
+
+			while (firstFree < this->m_Check.size() && this->m_Check[firstFree] != FREE_CELL)
+				firstFree++;
+		}
+
+		// make sure `base + column` is within the arrays for every state (including those with empty rows, whose base is 0)
+		size_t maxBase = 0;
+		for (uint32_t base : this->m_Base)
+			maxBase = std::max<size_t>(maxBase, base);
+
+		this->m_Entries.resize(std::max(this->m_Entries.size(), maxBase + ROW_WIDTH), LRPackedEntry{});
+		this->m_Check.resize(std::max(this->m_Check.size(), maxBase + ROW_WIDTH), FREE_CELL);
+		this->m_Entries.shrink_to_fit();
+		this->m_Check.shrink_to_fit();
+	}
+
+}
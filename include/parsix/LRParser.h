@@ -2,9 +2,65 @@
 #include <vector>
 
 #include "Parser.h"
+#include "parsix/Arena.h"
+#include "parsix/LRRecoveryTable.h"
+#include "parsix/ParseTree.h"
+#include "parsix/ParseStats.h"
+#include "parsix/SemanticActions.h"
 
 namespace m0st4fa::parsix {
 
+	/**
+	 * @brief A parsing table prepared to be shared by any number of LR parsers: the frozen table, whose grammar has its FIRST and FOLLOW sets calculated, together with its panic-mode recovery metadata (see LRRecoveryTable).
+	 * @details Both are computed once, on construction, and live as long as the prepared table does. An LRParser shares a `std::shared_ptr<const PreparedLRTable>` (see `LRParser::prepareTable()`), so it can only be given a table that has been prepared.
+	 * @tparam ParsingTableT The type of the parsing table; any LR table type.
+	 * @tparam SymbolT The type of a grammar symbol.
+	 */
+	template <typename ParsingTableT, typename SymbolT>
+	class PreparedLRTable {
+
+		/**
+		 * @brief The parsing table (frozen).
+		 */
+		ParsingTableT m_Table;
+
+		/**
+		 * @brief The panic-mode recovery metadata of the table.
+		 */
+		LRRecoveryTable<SymbolT> m_Recovery;
+
+		/**
+		 * @brief Calculates the FIRST and FOLLOW sets of the grammar of a table and freezes it (see `LRParsingTable::freeze()`).
+		 */
+		static ParsingTableT _prepare(ParsingTableT table) {
+			table.grammar.calculateFIRST();
+			table.grammar.calculateFOLLOW();
+			table.freeze();
+
+			return table;
+		}
+
+	public:
+
+		/**
+		 * @brief Prepares a parsing table.
+		 * @param[in] table The parsing table.
+		 * @throws std::logic_error If the table contains an invalid entry.
+		 */
+		explicit PreparedLRTable(ParsingTableT table) : m_Table{ _prepare(std::move(table)) }, m_Recovery{ m_Table } {}
+
+		/**
+		 * @brief Gets the parsing table.
+		 */
+		const ParsingTableT& table() const noexcept(true) { return this->m_Table; }
+
+		/**
+		 * @brief Gets the panic-mode recovery metadata of the table.
+		 */
+		const LRRecoveryTable<SymbolT>& recovery() const noexcept(true) { return this->m_Recovery; }
+
+	};
+
 	/**
 	 * @brief An LR parser.
 	 * @tparam GrammarT The type of the grammar object used by the parser. This type represents a vector of production objects.
@@ -14,12 +70,14 @@ namespace m0st4fa::parsix {
 	 * @tparam ParsingTableT The type of the parsing table object used by the parser.
 	 * @tparam FSMTableT The type of the finite state machine table used by the state machine that is used by the  lexical analyzer that is used by the parser.
 	 * @tparam InputT The type of the input string.
+	 * @tparam ActionsT The type of the semantic actions of the productions: either DynamicActions, to call the function stored in the `postfixAction` field of every production, or an LRActionTable, to call actions whose types are known at compile time (and, thus, can be inlined).
 	 */
 	template <typename GrammarT, typename LexicalAnalyzerT,
 		typename SymbolT, typename StateT,
 		typename ParsingTableT,
 		typename FSMTableT = fsm::FSMTable,
-		typename InputT = std::string>
+		typename InputT = std::string,
+		typename ActionsT = DynamicActions>
 	class LRParser : public Parser<LexicalAnalyzerT, SymbolT, ParsingTableT, FSMTableT, InputT> {
 
 		/**
@@ -85,64 +143,168 @@ namespace m0st4fa::parsix {
 		 */
 		using TokenType = decltype(LexicalAnalyzerT{}.getNextToken());
 
-		/**
-		 * @brief Mutable member representing the parser's stack.
-		 *
-		 * Initialized to an empty stack with a starting capacity of 0.
-		 */
-		mutable StackType m_Stack{ 0 };
+	public:
 
 		/**
-		 * @brief Mutable member representing the current top state of the parser.
+		 * @brief The state of a single parse.
 		 *
-		 * @details Initialized to the starting state of the parser.
+		 * @details Every call to `parse()` uses a context and passes it down to the functions implementing the parse. The parser object itself is never modified by a parse, which is what makes it reentrant.
+		 * A push-driven parse (see `beginPush()` and `feed()`) is suspended in its context between calls, so a single thread may drive any number of them, one context each.
+		 * A context may be reused by any number of (consecutive) parses: its stack storage and arena memory are then allocated once and recycled.
+		 * @attention A context must not be used by two parses at the same time.
 		 */
-		mutable StackElementType m_CurrTopState{ START_STATE };
+		struct ParseContext {
+
+			/**
+			 * @brief The lexical analyzer providing the input of this parse; `nullptr` for a push-driven parse fed tokens directly.
+			 */
+			LexicalAnalyzerT* lexer = nullptr;
+
+			/**
+			 * @brief The parser's stack. Its storage is kept between parses.
+			 */
+			StackType stack{};
+
+			/**
+			 * @brief The number of the state on top of the stack.
+			 */
+			lrstate_t currState = START_STATE.state;
+
+			/**
+			 * @brief The current input token being processed.
+			 */
+			TokenType currInputToken{ TokenType{} };
+
+			/**
+			 * @brief The number of errors encountered (and recovered from) so far.
+			 */
+			size_t errorNum = 0;
+
+			/**
+			 * @brief Whether the parser has accepted the input.
+			 */
+			bool accepted = false;
+
+			/**
+			 * @brief A reduction, as logged in `reductions`.
+			 */
+			struct Reduction {
+
+				/**
+				 * @brief The number of the state below the head of the production, i.e., the state the GOTO table was consulted for.
+				 */
+				lrstate_t stateBelow = 0;
+
+				/**
+				 * @brief The state pushed for the head of the production, with its data.
+				 */
+				StateT state;
+			};
+
+			/**
+			 * @brief If not `nullptr`, every reduction is appended to it (e.g., see IncrementalParser). It is left as is by `reset()`.
+			 */
+			std::vector<Reduction>* reductions = nullptr;
+
+			/**
+			 * @brief If not `nullptr` (and the library is compiled with `PARSIX_STATS`), the statistics of the parse are added to it. It is left as is by `reset()`.
+			 */
+			ParseStats* stats = nullptr;
+
+			/**
+			 * @brief If not `nullptr`, the parse tree of the input is built into it: a leaf per shift and a node per reduction (see ParseTree). It is cleared by `reset()`.
+			 */
+			ParseTree* tree = nullptr;
+
+			/**
+			 * @brief The smallest depth reductions have popped the stack to since it was last set (`SIZE_MAX` after `reset()`); the parser only ever lowers it.
+			 * @details Every state above it was pushed since (see SpeculativeParser, which sets it to tell which of the states it started a parse with were reduced).
+			 */
+			size_t lowestDepth = SIZE_MAX;
+
+			/**
+			 * @brief The arena semantic actions allocate from (through `Arena::current()`) during the parse.
+			 * @details Whatever is allocated from it lives until the context is reused by the next parse (which resets the arena in O(1)) or is destroyed.
+			 */
+			Arena arena;
+
+			/**
+			 * @brief Default constructor.
+			 * @param[in] stackCapacity The number of states to reserve storage for in the stack.
+			 */
+			explicit ParseContext(size_t stackCapacity = 0) { this->stack.reserve(stackCapacity); }
+
+			/**
+			 * @brief Prepares the context for a new parse of the input of `lexer`, keeping all of its storage.
+			 */
+			void reset(LexicalAnalyzerT& lexer) {
+				this->reset();
+				this->lexer = &lexer;
+			}
+
+			/**
+			 * @brief Prepares the context for a new parse without a lexical analyzer (i.e., a push-driven one), keeping all of its storage.
+			 */
+			void reset() {
+				this->lexer = nullptr;
+				this->stack.clear();
+				this->currState = START_STATE.state;
+				this->currInputToken = TokenType{};
+				this->errorNum = 0;
+				this->accepted = false;
+				this->lowestDepth = SIZE_MAX;
+				this->arena.reset();
+
+				if (this->tree != nullptr)
+					this->tree->clear();
+			}
+		};
+
+	private:
 
 		/**
-		 * @brief Mutable member representing the current input token being processed.
-		 *
-		 * @details Initialized to a default-constructed instance of the token type.
+		 * @brief The outcome of a single parsing action (see `_take_parsing_action()`).
 		 */
-		mutable TokenType m_CurrInputToken{ TokenType{} };
+		enum class ActionResult {
+			//! @brief A reduction; the current token is still to be consumed.
+			AR_REDUCED,
+			//! @brief A shift; the current token was consumed and the next one is needed.
+			AR_SHIFTED,
+			//! @brief Acceptance of the input.
+			AR_ACCEPTED,
+		};
 
 		/**
-		 * @brief Resets the parser state.
-		 *
-		 * @details This function resets the parser state. It clears the parser's stack, sets the current top state to the starting state, and sets  the current input token to a default-constructed instance of the token type. It also logs the resetting process.
-		 *
-		 * @return void
+		 * @brief Gets an excerpt of the remaining input of a parse for error messages (see `get_source_excerpt()`); a push-driven parse fed tokens directly has no source to show.
 		 */
-		void _reset_parser_state() const {
-			this->p_Logger.log(LoggerInfo::INFO, "RESETTING PARSER.");
-			m_Stack.clear();
-			m_CurrTopState = START_STATE;
-			m_CurrInputToken = TokenType{};
+		std::string _source_excerpt(const ParseContext& ctx) const {
+			return ctx.lexer != nullptr ? this->get_source_excerpt(*ctx.lexer) : std::string{ "(the input is pushed token by token)" };
 		}
 
-		void _reduce(size_t);
+		void _reduce(ParseContext&, size_t) const;
 
 		/**
 		 * @brief Pushes a state object onto the stack.
 		 *
 		 * @param state The state object to be pushed onto the stack. It must be of type
-		 *        `StateT`.
+		 *        `StateT`. It is moved onto the stack.
 		 *
 		 * @post
-		 * - The `state` is appended to the `m_Stack` member variable.
-		 * - The `m_CurrTopState` member variable is updated to point to the top of
+		 * - The `state` is appended to the stack of `ctx`.
+		 * - The current state number of `ctx` is updated to that of the top of
 		 *   the stack.
-		 * - A log message is generated using the `p_Logger` member variable
+		 * - If tracing is enabled, a log message is generated through the library logger (see `get_logger()`)
 		 *   indicating that the state was pushed and containing the current state
 		 *   and the contents of the stack. The log message level is `INFO`.
 		 * 
 		 * @returns void
 		 */
-		void _push_state(const StateT& state) {
-			this->m_Stack.push_back(state);
-			this->m_CurrTopState = this->m_Stack.back();
+		void _push_state(ParseContext& ctx, StateT state) const {
+			ctx.currState = state.state;
+			ctx.stack.push_back(std::move(state));
+			record_stats(ctx.stats, &ParseStats::recordStackDepth, ctx.stack.size());
 
-			this->p_Logger.log(LoggerInfo::INFO, std::format("Pushing state {}\nCurrent stack: {}", (std::string)state, toString(this->m_Stack)));
+			this->log_trace(LoggerInfo::INFO, [&] { return std::format("Pushing state {}\nCurrent stack: {}", (std::string)ctx.stack.back(), toString(ctx.stack)); });
 		}
 
 		/**
@@ -151,25 +313,25 @@ namespace m0st4fa::parsix {
 		 * @throws std::runtime_error If the state storage is empty and attempting to pop results in an underflow condition.
 		 *
 		 * @post
-		 * - If successful, the top element is removed from the `m_Stack` member.
-		 * - The `m_CurrTopState` member is updated to point to the new top of the stack.
-		 * - A log message is generated using the `p_Logger` member variable indicating that the state was popped and containing the current state (obtained internally). The log message level is `INFO`.
+		 * - If successful, the top element is removed from the stack of `ctx`.
+		 * - The current state number of `ctx` is updated to that of the new top of the stack.
+		 * - If tracing is enabled, a log message is generated through the library logger (see `get_logger()`) indicating that the state was popped and containing the current state (obtained internally). The log message level is `INFO`.
 		 * 
 		 * @returns void. This function does not return a value.
 		 */
-		void _pop_state() {
-			if (this->m_Stack.size() <= 1) {
+		void _pop_state(ParseContext& ctx) const {
+			if (ctx.stack.size() <= 1) {
 				std::string msg = std::format("Cannot pop more states from the LR stack. The stack cannot reach an empty stated.");
 
-				this->p_Logger.log(LoggerInfo::ERR_STACK_UNDERFLOW, msg);
+				get_logger().log(LoggerInfo::ERR_STACK_UNDERFLOW, msg);
 
 				throw std::runtime_error((std::string)"Stack underflow: " + msg);
 			}
 
-			this->m_CurrTopState = this->m_Stack.back();
-			this->p_Logger.log(LoggerInfo::INFO, std::format("Popping state {}\nCurrent stack: {}", (std::string)this->m_CurrTopState, toString(this->m_Stack)));
+			this->log_trace(LoggerInfo::INFO, [&] { return std::format("Popping state {}\nCurrent stack: {}", (std::string)ctx.stack.back(), toString(ctx.stack)); });
 
-			this->m_Stack.pop_back();
+			ctx.stack.pop_back();
+			ctx.currState = ctx.stack.back().state;
 		}
 
 		/**
@@ -178,32 +340,30 @@ namespace m0st4fa::parsix {
 		 * @param num The number of states to be popped from the stack.
 		 *
 		 * This function pops a specified number of states from the parser's stack. 
-		 * It checks if the stack size is less than the number of states to be popped plus one. If so, it logs an error message and throws a runtime error. Otherwise, it creates a temporary stack with the states to be popped, erases these states from the original stack, logs the popped states and the current stack, and sets the current top state to the back of the stack.
+		 * It checks if the stack size is less than the number of states to be popped plus one. If so, it logs an error message and throws a runtime error. Otherwise, it erases these states from the original stack and sets the current state number to that of the back of the stack.
+		 * If tracing is enabled, it also logs the stack before the states are popped. Nothing is allocated.
 		 *
 		 * @throws std::runtime_error If the number of states to be popped is greater than the current stack  size.
 		 *
 		 * @return void
 		 */
-		void _pop_states(size_t num) {
-			if (this->m_Stack.size() < num + 1) {
+		void _pop_states(ParseContext& ctx, size_t num) const {
+			if (ctx.stack.size() < num + 1) {
 				std::string msg = std::format("Cannot pop {} states from the LR stack. The stack cannot reach an empty stated.", num);
 
-				this->p_Logger.log(LoggerInfo::ERR_STACK_UNDERFLOW, msg);
+				get_logger().log(LoggerInfo::ERR_STACK_UNDERFLOW, msg);
 
 				throw std::runtime_error((std::string)"Stack underflow: " + msg);
 			}
 
-			const auto end = this->m_Stack.end();
-
-			StackType temp{ end - num, end };
-
-			this->m_Stack.erase(end - num, end);
-			this->p_Logger.log(LoggerInfo::INFO, std::format("Popping states {}\nCurrent stack: {}", toString(temp), toString(this->m_Stack)));
+			this->log_trace(LoggerInfo::INFO, [&] { return std::format("Popping {} states\nStack before popping: {}", num, toString(ctx.stack)); });
 
-			this->m_CurrTopState = this->m_Stack.back();
+			ctx.stack.erase(ctx.stack.end() - num, ctx.stack.end());
+			ctx.currState = ctx.stack.back().state;
+			ctx.lowestDepth = std::min(ctx.lowestDepth, ctx.stack.size());
 		}
 
-		bool _check_and_resolve_parsing_errors(size_t, ErrorRecoveryType);
+		bool _check_and_resolve_parsing_errors(ParseContext&, ErrorRecoveryType) const;
 
 		/**
 		 * @brief Performs error recovery in panic mode.
@@ -219,7 +379,9 @@ namespace m0st4fa::parsix {
 		 *
 		 * @return void
 		 */
-		void _error_recov_panic_mode() {
+		void _error_recov_panic_mode(ParseContext& ctx) const {
+			const ParseStats::PanicModeTimer timer{ ctx.stats };
+
 			/** Algorithm
 			* Go through the stack top-down and consider state S, the top on the stack:
 			* For every non-terminal V:
@@ -238,79 +400,64 @@ namespace m0st4fa::parsix {
 			* If not, continue on to the next token T.
 
 			* If (not synchronized) ERROR(could not synchronize).
-			*/
 
-			auto rbegin = this->m_Stack.rbegin();
-			auto rend = this->m_Stack.rend();
+			* The GOTO non-terminals of every state and the union of their FOLLOW sets are precomputed (see LRRecoveryTable),
+			* so finding the state does not allocate and checking a token is a single bit test.
+			*/
 
-			std::vector<VariableType> nonTerminals;
+			const LRRecoveryTable<SymbolType>& recovery = *this->p_Recovery;
 			bool found = false;
 
 			// find a state with at least a single GOTO entry on some non-terminal
-			// record all non-terminals on which it has a GOTO
-			for (; rbegin < rend; rbegin = this->m_Stack.rbegin()) {
-				auto currState = *rbegin;
-				size_t stateNum = currState.state;
-
-				// get all non-error goto entries for this state
-				nonTerminals = this->p_Table.getGotos(stateNum);
-
+			while (not ctx.stack.empty()) {
 				// if this state has at least a single GOTO
 				// we have found the state we seek; break in this case
-				if (!nonTerminals.empty()) {
+				if (recovery.hasGotos(ctx.stack.back().state)) {
 					found = true;
 					break;
 				}
 
 				// if this state does not have any GOTOs,
 				// we still didn't find the state we seek
-				this->m_Stack.pop_back();
+				ctx.stack.pop_back();
 			}
 
 			// if no state was found
 			if (!found) {
-				this->p_Logger.log(LoggerInfo::FATAL_ERROR, "Unable to synchronize! TODO: implement professional handling of this case.");
+				get_logger().log(LoggerInfo::FATAL_ERROR, "Unable to synchronize! TODO: implement professional handling of this case.");
 				std::abort();
 			}
 
 			// if some state could be found
+			const lrstate_t stateNum = ctx.stack.back().state;
 
 			// loop through the remaining terminals of the input
-
 			bool hasReachedEnd = false;
-			for (; ; this->m_CurrInputToken = this->get_next_token()) {
+			for (; ; ctx.currInputToken = this->get_next_token(*ctx.lexer), record_stats(ctx.stats, &ParseStats::recordToken)) {
 				if (hasReachedEnd)
 					break;
 
-				hasReachedEnd = this->m_CurrInputToken == TokenType::TEOF;
+				hasReachedEnd = ctx.currInputToken == TokenType::TEOF;
 
-				TerminalType currT = this->m_CurrInputToken.name;
-				auto toSymbol = [](const TerminalType t) {
-					return SymbolT{ .isTerminal = true, .as {.terminal = t} };
-				};
+				// check whether the current terminal is in FOLLOW(V) for some GOTO non-terminal V of the state
+				const TerminalType currT = ctx.currInputToken.name;
 
-				for (VariableType nonTerminal : nonTerminals) {
-					const auto& follow = this->p_Table.grammar.getFOLLOW(nonTerminal);
+				if (not recovery.synchronizesOn(stateNum, currT))
+					continue;
 
-					// check whether the current terminal is in FOLLOW(nonTerminal)
-					// if it does not exist
-					if (bool exists = isIn(toSymbol(currT), follow); !exists)
-						continue;
+				const VariableType nonTerminal = recovery.syncVariable(stateNum, currT);
+				this->log_trace(LoggerInfo::DEBUG, [&] { return std::format("Synchronized with:\n Top state {}\nNon-terminal {}\nTerminal {}", ctx.stack.back().toString(), toString(nonTerminal), toString(currT)); });
 
-					const StackElementType& topState = this->m_Stack.back();
-					this->p_Logger.log(LoggerInfo::DEBUG, std::format("Synchronized with:\n Top state {}\nNon-terminal {}\nTerminal", topState.toString(), toString(nonTerminal), toString(currT)));
+				const LRTableEntry entry = this->p_Table->view().atGoto(stateNum, nonTerminal);
+				assert(not entry.isError());
 
-					LRTableEntry entry = this->p_Table.atGoto(topState.state, nonTerminal);
-					assert(not entry.isError());
-
-					StackElementType newState{ entry.number };
-					_push_state(newState);
-					return;
-				}
+				StackElementType newState{ entry.number };
+				_push_state(ctx, std::move(newState));
+				return;
 			}
 		}
 
-		bool _take_parsing_action(auto&);
+		ActionResult _take_parsing_action(ParseContext&, auto&) const;
 	protected:
 
 		/**
@@ -318,8 +465,48 @@ namespace m0st4fa::parsix {
 		 */
 		static const StateT START_STATE;
 
+		/**
+		 * @brief The semantic actions of the productions, if they are known at compile time (see LRActionTable).
+		 */
+		[[no_unique_address]] ActionsT p_Actions{};
+
+		/**
+		 * @brief The panic-mode recovery metadata of the table, owned by the prepared table the parser shares (see `prepareTable()`).
+		 */
+		const LRRecoveryTable<SymbolType>* p_Recovery = nullptr;
+
+		/**
+		 * @brief Gets the table of a prepared table as a shared table of its own, which keeps the prepared table alive.
+		 */
+		static std::shared_ptr<const ParsingTableT> share_table(const std::shared_ptr<const PreparedLRTable<ParsingTableT, SymbolType>>& prepared) {
+			if (prepared == nullptr)
+				return nullptr;
+
+			return std::shared_ptr<const ParsingTableT>{ prepared, &prepared->table() };
+		}
+
+		/**
+		 * @brief Checks that the action table (if any) does not have more actions than the grammar has productions.
+		 * @throws std::logic_error If the action table has more actions than the grammar has productions.
+		 */
+		void check_actions() const {
+			if constexpr (not std::is_same_v<ActionsT, DynamicActions>) {
+				const size_t prodCount = this->p_Table->grammar.size();
+
+				if (ActionsT::ACTION_COUNT > prodCount) {
+					get_logger().log(LoggerInfo::ERR_INVALID_VAL, std::format("The action table has {} actions, but the grammar has only {} productions.", ActionsT::ACTION_COUNT, prodCount));
+					throw std::logic_error("The action table has more actions than the grammar has productions.");
+				}
+			}
+		}
+
 	public:
 
+		/**
+		 * @brief Aliases the type of a table prepared to be shared by LR parsers (see `prepareTable()`).
+		 */
+		using PreparedTableType = PreparedLRTable<ParsingTableT, SymbolType>;
+
 		/**
 		 * @brief Default constructor for LRParser.
 		 *
@@ -333,14 +520,51 @@ namespace m0st4fa::parsix {
 		 * @param lexer The lexical analyzer to be used by the parser.
 		 * @param parsingTable The parsing table to be used by the parser.
 		 * @param startSymbol The start symbol for the grammar.
+		 * @param actions The semantic actions of the productions (only if `ActionsT` is an LRActionTable).
 		 *
-		 * @details This constructor initializes a new instance of the LRParser class using the provided lexical analyzer, parsing table, and start symbol. It also calculates the FIRST and FOLLOW sets for the grammar.
+		 * @details This constructor initializes a new instance of the LRParser class using the provided lexical analyzer, parsing table, and start symbol. It copies the table and prepares the copy (see `prepareTable()`).
+		 * @note To construct many parsers for the same table, prepare the table once using `prepareTable()` and use the constructor taking a shared table instead.
+		 * @throws std::logic_error If `actions` has more actions than the grammar has productions.
 		 */
-		LRParser(LexicalAnalyzerT& lexer, const ParsingTableT& parsingTable, const SymbolT& startSymbol) : ParserBase{ lexer, parsingTable, startSymbol } {
-			this->p_Table.grammar.calculateFIRST();
-			this->p_Table.grammar.calculateFOLLOW();
+		LRParser(LexicalAnalyzerT& lexer, const ParsingTableT& parsingTable, const SymbolT& startSymbol, const ActionsT& actions = ActionsT{}) :
+			LRParser{ lexer, prepareTable(parsingTable), startSymbol, actions } {};
+
+		/**
+		 * @brief Parameterized constructor for LRParser, sharing an already prepared parsing table.
+		 *
+		 * @param lexer The lexical analyzer to be used by the parser.
+		 * @param parsingTable The prepared parsing table to be used by the parser (see `prepareTable()`). It is shared, not copied.
+		 * @param startSymbol The start symbol for the grammar.
+		 * @param actions The semantic actions of the productions (only if `ActionsT` is an LRActionTable).
+		 *
+		 * @details This constructor does not copy the table nor calculate anything; it is O(1). The panic-mode recovery metadata of the table was computed once, when it was prepared.
+		 * @throws std::logic_error If `parsingTable` is null, or if `actions` has more actions than the grammar has productions.
+		 */
+		LRParser(LexicalAnalyzerT& lexer, std::shared_ptr<const PreparedTableType> parsingTable, const SymbolT& startSymbol, const ActionsT& actions = ActionsT{}) :
+			ParserBase{ lexer, share_table(parsingTable), startSymbol }, p_Actions{ actions }, p_Recovery{ parsingTable ? &parsingTable->recovery() : nullptr } {
+
+			if (this->p_Recovery == nullptr) {
+				get_logger().log(LoggerInfo::ERR_MISSING_VAL, "The parsing table given to the LR parser is null. It must be obtained from `LRParser::prepareTable()`.");
+				throw std::logic_error("The parsing table given to the LR parser is null.");
+			}
+
+			this->check_actions();
 		};
 
+		/**
+		 * @brief Prepares a parsing table to be shared by any number of LR parsers.
+		 *
+		 * @param parsingTable The parsing table to be prepared.
+		 *
+		 * @details Calculates the FIRST and FOLLOW sets of the grammar of the table, freezes it (see `LRParsingTable::freeze()`) and computes its panic-mode recovery metadata, which is kept with the table (see PreparedLRTable). This is meant to be done once per table; the result can then be given to as many parsers as needed.
+		 *
+		 * @throws std::logic_error If the table contains an invalid entry.
+		 * @return The prepared, immutable table.
+		 */
+		static std::shared_ptr<const PreparedTableType> prepareTable(ParsingTableT parsingTable) {
+			return std::make_shared<const PreparedTableType>(std::move(parsingTable));
+		}
+
 		/**
 		 * @brief Copy constructor for LRParser.
 		 *
@@ -355,33 +579,89 @@ namespace m0st4fa::parsix {
 		 *
 		 * @param rhs The LRParser instance to be copied.
 		 *
-		 * @details This is the copy assignment operator for the LRParser class. It copies the state of an existing instance into the current instance and returns a reference to the current instance.
+		 * @details This is the copy assignment operator for the LRParser class. It copies the configuration of an existing instance (a parser has no parse state to copy) into the current instance and returns a reference to the current instance.
 		 *
 		 * @return A reference to the current instance.
 		 */
-		LRParser& operator=(const LRParser& rhs) {
-			this->ParserBase::operator=(rhs);
-			this->m_Stack = rhs.m_Stack;
-			this->m_CurrTopState = rhs.m_CurrTopState;
-			this->m_CurrInputToken = rhs.m_CurrInputToken;
+		LRParser& operator=(const LRParser& rhs) = default;
 
-			return *this;
-		};
+		/**
+		 * @brief Parses the input of the lexical analyzer the parser was constructed with.
+		 * @details Equivalent to `parse(lexer, initResult, errorRecoveryType)`, where `lexer` is the lexical analyzer given to the constructor. Since that lexical analyzer is shared by all calls, they must not be concurrent.
+		 */
+		template<typename ParserResultT = ParserResult>
+		ParserResultT parse(const ParserResultT& initResult, ErrorRecoveryType errorRecoveryType = ErrorRecoveryType::ERT_NONE) const {
+			return this->parse(this->get_lexical_analyzer(), initResult, errorRecoveryType);
+		}
+
+		/**
+		 * @brief Parses the input of `lexer` using a fresh parse context.
+		 * @details Equivalent to `parse(ctx, lexer, initResult, errorRecoveryType)` with a context local to the call; hence, whatever semantic actions allocate from the arena is released when the call returns. To keep arena-allocated results (e.g., an AST) or to reuse the storage of the context over many parses, use the overload taking a context.
+		 */
+		template<typename ParserResultT = ParserResult>
+		ParserResultT parse(LexicalAnalyzerT& lexer, const ParserResultT& initResult, ErrorRecoveryType errorRecoveryType = ErrorRecoveryType::ERT_NONE) const {
+			ParseContext ctx;
 
+			return this->parse(ctx, lexer, initResult, errorRecoveryType);
+		}
 
 		template<typename ParserResultT = ParserResult>
-		ParserResultT parse(const ParserResultT&, ErrorRecoveryType = ErrorRecoveryType::ERT_NONE);
+		ParserResultT parse(ParseContext&, LexicalAnalyzerT&, const ParserResultT&, ErrorRecoveryType = ErrorRecoveryType::ERT_NONE) const;
+
+		/**
+		 * @brief Starts a push-driven parse in `ctx`: instead of pulling its tokens from a lexical analyzer until it is done (as `parse()` does), the parse advances as far as the tokens given to `feed()` allow and is then suspended in `ctx` until it is fed again.
+		 * @details The context is reset first (keeping its stack storage and arena memory). Feeding the parse may then be interleaved with feeding any number of other parses, each in its own context, on the same thread (e.g., one per connection).
+		 * @note Push-driven parses do not recover from errors (see `feed()`), since recovery needs to look ahead in the input.
+		 */
+		void beginPush(ParseContext& ctx) const {
+			ctx.reset();
+			this->_push_state(ctx, START_STATE);
+		}
+
+		template<typename ParserResultT>
+		PushStatus feed(ParseContext&, const TokenType&, ParserResultT&) const;
+
+		void reduceOn(ParseContext&, const TokenType&) const;
+
+		/**
+		 * @brief Pushes the state of a nonterminal on the stack of a push-driven parse, as if it had just been reduced; this is how a subtree of an earlier parse is reused (see IncrementalParser).
+		 * @pre `state` is the state the GOTO table gives for the state on top of the stack and the nonterminal, and the next token of the input is the one following the text of the nonterminal.
+		 * @note The parse tree of the context, if any, fails (see `ParseTree::fail()`), since the nodes of the subtree are not known.
+		 */
+		void pushSubtree(ParseContext& ctx, StateT state) const {
+			if (ctx.tree != nullptr)
+				ctx.tree->fail();
+
+			this->_push_state(ctx, std::move(state));
+		}
+
+		/**
+		 * @brief Feeds a push-driven parse every token the lexical analyzer `lexer` has enough input for (see `StreamingLexer::tryNextToken()`).
+		 * @details This is how a parse is fed bytes: append them to the pushed input of `lexer` (see `ChunkedInput::append()`), then call this function; once the input is finished (see `ChunkedInput::finish()`), the call feeds the end of the input as well. The lexical analyzer becomes that of the parse, so error messages show its remaining input.
+		 * @returns PushStatus::PS_ACCEPTED if the parser has accepted the input; PushStatus::PS_NEED_INPUT if it needs more bytes.
+		 * @throws std::logic_error As `feed()` with a token.
+		 */
+		template<typename ParserResultT>
+		PushStatus feed(ParseContext& ctx, LexicalAnalyzerT& lexer, ParserResultT& result) const {
+			ctx.lexer = &lexer;
+
+			while (const auto token = lexer.tryNextToken())
+				if (this->feed(ctx, *token, result) == PushStatus::PS_ACCEPTED)
+					return PushStatus::PS_ACCEPTED;
+
+			return PushStatus::PS_NEED_INPUT;
+		}
 	};
 
-	template<typename GrammarT, typename LexicalAnalyzerT, typename SymbolT, typename StateT, typename ParsingTableT, typename FSMTableT, typename InputT>
-	const StateT LRParser<GrammarT, LexicalAnalyzerT, SymbolT, StateT, ParsingTableT, FSMTableT, InputT>::START_STATE{ 0 };
+	template<typename GrammarT, typename LexicalAnalyzerT, typename SymbolT, typename StateT, typename ParsingTableT, typename FSMTableT, typename InputT, typename ActionsT>
+	const StateT LRParser<GrammarT, LexicalAnalyzerT, SymbolT, StateT, ParsingTableT, FSMTableT, InputT, ActionsT>::START_STATE{ 0 };
 
 	// IMPLEMENTATION
 
 	/**
 	 * @brief Checks for the existence of and resolves (if possible) parsing errors.
 	 *
-	 * @param errorNum The number of errors encountered so far.
+	 * @param ctx The context of the parse. Its error count is incremented for every error encountered.
 	 * @param errorRecoveryType The type of error recovery to be used.
 	 *
 	 * @details This function checks for parsing errors and attempts to resolve them. 
@@ -399,35 +679,40 @@ namespace m0st4fa::parsix {
 	 *
 	 * @return `true` if there has an been an error AND the error was resolved; `false` otherwise (there hasn't been an error or there has been an error that couldn't be resolved).
 	 */
-	template<typename GrammarT, typename LexicalAnalyzerT, typename SymbolT, typename StateT, typename ParsingTableT, typename FSMTableT, typename InputT>
-	inline bool LRParser<GrammarT, LexicalAnalyzerT, SymbolT, StateT, ParsingTableT, FSMTableT, InputT>::_check_and_resolve_parsing_errors(size_t errorNum, ErrorRecoveryType errorRecoveryType)
+	template<typename GrammarT, typename LexicalAnalyzerT, typename SymbolT, typename StateT, typename ParsingTableT, typename FSMTableT, typename InputT, typename ActionsT>
+	inline bool LRParser<GrammarT, LexicalAnalyzerT, SymbolT, StateT, ParsingTableT, FSMTableT, InputT, ActionsT>::_check_and_resolve_parsing_errors(ParseContext& ctx, ErrorRecoveryType errorRecoveryType) const
 	{
 
-		TerminalType currTokenName = this->m_CurrInputToken.name;
-		size_t currStateNum = this->m_CurrTopState.state;
-		LRTableEntry currEntry = this->p_Table.atAction(currStateNum, currTokenName);
+		TerminalType currTokenName = ctx.currInputToken.name;
+		size_t currStateNum = ctx.currState;
+		const LRTableEntry currEntry = this->p_Table->view().atAction(currStateNum, currTokenName);
 
 		if (!(currEntry.isEmpty || currEntry.type == LRTableEntryType::TET_ERROR))
 			return false;
 
-		const std::string_view src = this->get_source_code();
+		const std::string src = this->_source_excerpt(ctx);
 		// check we have not reached the maximum number of encountered errors
-		if (errorNum == ParserBase::ERR_RECOVERY_LIMIT) {
-			this->p_Logger.log(LoggerInfo::ERR_RECOV_LIMIT_EXCEEDED, std::format("Maximum number of errors to recover from is `{}` which has been exceeded.", ParserBase::ERR_RECOVERY_LIMIT));
+		if (ctx.errorNum == ParserBase::ERR_RECOVERY_LIMIT) {
+			get_logger().log(LoggerInfo::ERR_RECOV_LIMIT_EXCEEDED, std::format("Maximum number of errors to recover from is `{}` which has been exceeded.", ParserBase::ERR_RECOVERY_LIMIT));
 			throw std::logic_error("Error recovery limit exceeded!");
 		}
 
-		errorNum++;
+		ctx.errorNum++;
+		record_stats(ctx.stats, &ParseStats::recordErrorRecovery);
+
+		// trees are only built for inputs without errors
+		if (ctx.tree != nullptr)
+			ctx.tree->fail();
 
 		if (currEntry.isEmpty) {
-			std::string msg{ std::format("LR parsing table entry is empty!\nCurrent stack: {}\nCurrent token: {}\nCurrent input: {}", toString(this->m_Stack), m_CurrInputToken.toString(), src)};
-			this->p_Logger.log(LoggerInfo::ERR_INVALID_TABLE_ENTRY, msg);
+			std::string msg{ std::format("LR parsing table entry is empty!\nCurrent stack: {}\nCurrent token: {}\nCurrent input: {}", toString(ctx.stack), ctx.currInputToken.toString(), src)};
+			get_logger().log(LoggerInfo::ERR_INVALID_TABLE_ENTRY, msg);
 		}
 
 		// if error recovery is not enabled
 		if (errorRecoveryType == ErrorRecoveryType::ERT_NONE) {
-			std::string msg = std::format("Cannot continue further with the parse! Error entry encountered; It looks like this string does not belong to the grammar.\nCurrent stack: {}\n Current input: {}", toString(this->m_Stack), src);
-			this->p_Logger.log(LoggerInfo::ERR_UNACCEPTED_STRING, msg);
+			std::string msg = std::format("Cannot continue further with the parse! Error entry encountered; It looks like this string does not belong to the grammar.\nCurrent stack: {}\n Current input: {}", toString(ctx.stack), src);
+			get_logger().log(LoggerInfo::ERR_UNACCEPTED_STRING, msg);
 
 			throw std::logic_error("Cannot continue further with the parse! Error entry encountered; It looks like this string does not belong to the grammar.");
 		}
@@ -435,15 +720,15 @@ namespace m0st4fa::parsix {
 		// if error recovery is enabled, switch on the type
 		switch (errorRecoveryType) {
 		case ErrorRecoveryType::ERT_PANIC_MODE: {
-			_error_recov_panic_mode();
+			_error_recov_panic_mode(ctx);
 			break;
 		}
 		default: {
-			std::string errMsg = std::format("Cannot continue further with the parse! Error entry encountered; It looks like this string does not belong to the grammar.\nCurrent stack: {}\n Current input: {}", toString(this->m_Stack), src);
+			std::string errMsg = std::format("Cannot continue further with the parse! Error entry encountered; It looks like this string does not belong to the grammar.\nCurrent stack: {}\n Current input: {}", toString(ctx.stack), src);
 			std::string noteMsg = std::format("Error recovery type `{}` is not yet supported for LR parsing.", toString(errorRecoveryType));
 			std::string fullMsg = std::format("{}\nNote: ", errMsg, noteMsg);
 
-			this->p_Logger.log(LoggerInfo::ERR_UNACCEPTED_STRING, fullMsg);
+			get_logger().log(LoggerInfo::ERR_UNACCEPTED_STRING, fullMsg);
 			throw std::logic_error("Cannot continue further with the parse! Error entry encountered; It looks like this string does not belong to the grammar.");
 		}
 		}
@@ -457,6 +742,7 @@ namespace m0st4fa::parsix {
 	 * 
 	 * @throws std::logic_error If it comes across an entry in the parsing table that is not of type `GOTO`.
 	 *
+	 * @param ctx The context of the parse.
 	 * @param prodNumber The number of the production to be reduced.
 	 *
 	 * @details This function reduces the production based on the current state and token. 
@@ -467,113 +753,154 @@ namespace m0st4fa::parsix {
 	 *
 	 * @return void
  */
-	template<typename GrammarT, typename LexicalAnalyzerT, typename SymbolT, typename StateT, typename ParsingTableT, typename FSMTableT, typename InputT>
-	inline void LRParser<GrammarT, LexicalAnalyzerT, SymbolT, StateT, ParsingTableT, FSMTableT, InputT>::_reduce(size_t prodNumber)
+	template<typename GrammarT, typename LexicalAnalyzerT, typename SymbolT, typename StateT, typename ParsingTableT, typename FSMTableT, typename InputT, typename ActionsT>
+	inline void LRParser<GrammarT, LexicalAnalyzerT, SymbolT, StateT, ParsingTableT, FSMTableT, InputT, ActionsT>::_reduce(ParseContext& ctx, size_t prodNumber) const
 	{
-		const std::string_view src = this->get_source_code();
+		const auto& table = this->p_Table->view();
 
 		// get the production
-		const auto& production = this->p_Table.grammar.at(prodNumber);
+		const auto& production = table.production(prodNumber);
 
 		StackElementType newState = StackElementType{};
 
 		// execute the action, if any
-		if (auto action = static_cast<void(*)(StackType&, StackElementType&)>(production.postfixAction); action != nullptr)
-			action(this->m_Stack, newState);
+		if constexpr (std::is_same_v<ActionsT, DynamicActions>) {
+			if (auto action = static_cast<void(*)(StackType&, StackElementType&)>(production.postfixAction); action != nullptr)
+				action(ctx.stack, newState);
+		}
+		else
+			this->p_Actions.reduce(prodNumber, ctx.stack, newState);
 
-		// determine the length of the body of the production
-		const size_t prodBodyLength = production.prodBody.size();
+		// determine the length of the body of the production (epsilon productions have an empty body)
+		const size_t prodBodyLength = production.isEpsilon() ? 0 : production.size();
+
+		// tokens that refer to their text by offset (e.g., OffsetToken) give the state of the head the span of the body
+		if constexpr (requires { newState.token.offset; newState.token.length; }) {
+			if (prodBodyLength == 0) {
+				newState.token.offset = ctx.currInputToken.offset;
+				newState.token.length = 0;
+			}
+			else {
+				const auto& first = ctx.stack[ctx.stack.size() - prodBodyLength].token;
+				const auto& last = ctx.stack.back().token;
+				newState.token.offset = first.offset;
+				newState.token.length = decltype(newState.token.length)(last.offset + last.length - first.offset);
+			}
+		}
 
 		// pop prodBodyLength elements from the top of the stack and get the next entry
-		this->_pop_states(prodBodyLength);
-		size_t stateNum = this->m_CurrTopState.state;
-		LRTableEntry currEntry = this->p_Table.atGoto(stateNum, production.prodHead.as.nonTerminal);
+		this->_pop_states(ctx, prodBodyLength);
+		size_t stateNum = ctx.currState;
+		const LRTableEntry currEntry = table.atGoto(stateNum, production.prodHead.as.nonTerminal);
 		newState.state = currEntry.number;
 
 		// Note: errors are never detected when consulting the GOTO table
 		// this here is just a precaution for possible (probably logic) bugs
 		if (currEntry.type != LRTableEntryType::TET_GOTO) {
-			std::string msg{ std::format("Incorrect entry type! Expected type `GOTO` within function reduce after accessing the GOTO table.\nCurrent stack: {}\n Current input: {}", toString(this->m_Stack), src) };
-			this->p_Logger.log(LoggerInfo::ERR_INVALID_VAL, msg);
+			const std::string src = this->_source_excerpt(ctx);
+			std::string msg{ std::format("Incorrect entry type! Expected type `GOTO` within function reduce after accessing the GOTO table.\nCurrent stack: {}\n Current input: {}", toString(ctx.stack), src) };
+			get_logger().log(LoggerInfo::ERR_INVALID_VAL, msg);
 
 			throw std::logic_error("Incorrect entry type! Expected type `GOTO` within function reduce after accessing the GOTO table.");
 		}
 
+		if (ctx.reductions != nullptr)
+			ctx.reductions->push_back({ .stateBelow = stateNum, .state = newState });
+
+		record_stats(ctx.stats, &ParseStats::recordReduction, prodNumber);
+
+		if (ctx.tree != nullptr)
+			ctx.tree->addNode((uint32_t)prodNumber, (uint32_t)prodBodyLength);
+
 		// if the current entry is not an error
-		this->_push_state(newState);
+		this->_push_state(ctx, std::move(newState));
 	}
 
 	/**
 	 * @brief Takes the parsing action based on the current state and token.
 	 *
 	 * @tparam ParserResultT The type of the parser result.
+	 * @param ctx The context of the parse.
 	 * @param result The accumulative result of the parser up to the moment of the call. This function adds more to the aggregate. 
 	 * 
 	 * @note Right now, the `result` argument is not affected, but this behavior may change in the future.
 	 *
 	 * @details This function takes the parsing action based on the current state and token. 
 	 * It gets the current state number, current token name, and current table entry. It then switches on the type of the current entry. 
-		* If the entry type is shift, it pushes the state onto the stack and gets the next input token.
+		* If the entry type is shift, it pushes the state onto the stack.
 		* If the entry type is reduce, it reduces the current entry number. 
 		* If the entry type is accept, it gets the production,executes the action if any, and returns `true`.  
 		* If the entry type is none of the above, it logs a fatal error and	aborts the program. 
-	 * The function returns `false` (means that the parser didn't accept) after every action, except the action where it accepts. In this case, it returns `true` to indicate acceptance.
+	 * The function does not get the next token after a shift; the caller does (from the lexical analyzer for `parse()`, from the next call for `feed()`).
 	 *
-	 * @return `true` if the parser has accepted after taking the action; `false` otherwise.
+	 * @return ActionResult::AR_SHIFTED after a shift, ActionResult::AR_ACCEPTED on acceptance, and ActionResult::AR_REDUCED after a reduction.
  */
-	template<typename GrammarT, typename LexicalAnalyzerT, typename SymbolT, typename StateT, typename ParsingTableT, typename FSMTableT, typename InputT>
-	inline bool LRParser<GrammarT, LexicalAnalyzerT, SymbolT, StateT, ParsingTableT, FSMTableT, InputT>::_take_parsing_action(auto& result)
+	template<typename GrammarT, typename LexicalAnalyzerT, typename SymbolT, typename StateT, typename ParsingTableT, typename FSMTableT, typename InputT, typename ActionsT>
+	inline auto LRParser<GrammarT, LexicalAnalyzerT, SymbolT, StateT, ParsingTableT, FSMTableT, InputT, ActionsT>::_take_parsing_action(ParseContext& ctx, auto& result) const -> ActionResult
 	{
 		using ParserResultType = decltype(result);
 
-		size_t currStateNum = this->m_CurrTopState.state;
-		TerminalType currTokenName = this->m_CurrInputToken.name;
-		LRTableEntry currEntry = this->p_Table.atAction(currStateNum, currTokenName);
-		const std::string_view src = this->get_source_code();
+		size_t currStateNum = ctx.currState;
+		TerminalType currTokenName = ctx.currInputToken.name;
+		const auto& table = this->p_Table->view();
+		const LRTableEntry currEntry = table.atAction(currStateNum, currTokenName);
 
 		switch (currEntry.type)
 		{
 		case LRTableEntryType::TET_ACTION_SHIFT: {
 			StateT s = StateT{ currEntry.number };
-			s.token = this->m_CurrInputToken;
-			this->_push_state(s);
-			this->m_CurrInputToken = this->get_next_token();
-			break;
+			s.token = ctx.currInputToken;
+			this->_push_state(ctx, std::move(s));
+			record_stats(ctx.stats, &ParseStats::recordShift);
+
+			if (ctx.tree != nullptr) {
+				if constexpr (requires { ctx.currInputToken.offset; ctx.currInputToken.length; })
+					ctx.tree->addLeaf((uint32_t)currTokenName, ctx.currInputToken.offset, (uint32_t)ctx.currInputToken.length);
+				else
+					ctx.tree->addLeaf((uint32_t)currTokenName);
+			}
+			return ActionResult::AR_SHIFTED;
 		}
 
 		case LRTableEntryType::TET_ACTION_REDUCE:
-			_reduce(currEntry.number);
-			break;
+			_reduce(ctx, currEntry.number);
+			return ActionResult::AR_REDUCED;
 
 		case LRTableEntryType::TET_ACCEPT: {
 			// get the production
-			const auto& production = this->p_Table.grammar.at(0);
+			const auto& production = table.production(0);
 
 			StackElementType newState = StackElementType{};
 
 			// execute the action, if any
-			if (auto action = static_cast<void(*)(StackType&, StackElementType&, ParserResultType&)>(production.postfixAction); action != nullptr)
-				action(this->m_Stack, newState, result);
+			if constexpr (std::is_same_v<ActionsT, DynamicActions>) {
+				if (auto action = static_cast<void(*)(StackType&, StackElementType&, ParserResultType&)>(production.postfixAction); action != nullptr)
+					action(ctx.stack, newState, result);
+			}
 			else
-				std::cout << "ACCEPTED!";
+				this->p_Actions.accept(ctx.stack, newState, result);
 
-			return true;
+			this->log_trace(LoggerInfo::INFO, [] { return "ACCEPTED!"; });
+
+			return ActionResult::AR_ACCEPTED;
 		}
 
-		default: // TODO: ENHANCE THIS
-			this->p_Logger.log(LoggerInfo::FATAL_ERROR, std::format("[Unreachable] Invalid entry type `{}` on switch statement!\nCurrent stack: {}\n Current input: {}", toString(currEntry.type), toString(this->m_Stack), src));
-			std::string srcLoc = this->p_Logger.getCurrSourceLocation();
+		default: { // TODO: ENHANCE THIS
+			const std::string src = this->_source_excerpt(ctx);
+			get_logger().log(LoggerInfo::FATAL_ERROR, std::format("[Unreachable] Invalid entry type `{}` on switch statement!\nCurrent stack: {}\n Current input: {}", toString(currEntry.type), toString(ctx.stack), src));
+			std::string srcLoc = get_logger().getCurrSourceLocation();
 			assert(std::format("Source code location:\n{}", srcLoc).data());
 			std::abort();
 		}
-
-		return false;
+		}
 	}
 
 	/**
 	 * @brief Parses an input stream using the LR parsing algorithm.
 	 * 
 	 * @tparam ParserResultT The type of the result of the parser.
+	 * @param[in, out] ctx The context of the parse. It is reset first (keeping its stack storage and arena memory), and its arena is the current arena (see `Arena::current()`) of the semantic actions for the duration of the parse.
+	 * @param[in] lexer The lexical analyzer providing the input. It is used by this parse only.
 	 * @param[in] initResult The initial parser result. Right now, this also sets the return value by the function (i.e., this is also the returned result of this function).
 	 * @param[in] errorRecoveryType The type of recovery technique to use in case of an error.
 	 * 
@@ -584,17 +911,18 @@ namespace m0st4fa::parsix {
 	 * It iterates through the input stream using a loop, performing actions based on the current state on the stack and the next token from the input.
 	 * The function employs a combination of shift, reduce, and goto actions defined by the parsing tables to construct the parse tree or identify errors.
 	 * Error recovery is handled based on the specified `errorRecoveryType`.
+	 * All of the state of the parse is kept in `ctx`, and the parsing table is shared and read-only. Hence, this function is reentrant: any number of calls may run concurrently (on the same parser or on parsers sharing the same table), as long as each one uses its own `ctx` and `lexer`.
 	 *
 	 * @returns The result of the parsing. Right now, it just returns `initResult`.
 	 */
 	template<typename GrammarT, typename LexicalAnalyzerT, typename		SymbolT, typename StateT,
 		typename ParsingTableT,
-		typename FSMTableT, typename InputT>
+		typename FSMTableT, typename InputT, typename ActionsT>
 	template<typename ParserResultT>
 	ParserResultT LRParser<GrammarT, LexicalAnalyzerT,
 		SymbolT, StateT,
-		ParsingTableT, FSMTableT, InputT>::
-		parse(const ParserResultT& initResult, ErrorRecoveryType errorRecoveryType)
+		ParsingTableT, FSMTableT, InputT, ActionsT>::
+		parse(ParseContext& ctx, LexicalAnalyzerT& lexer, const ParserResultT& initResult, ErrorRecoveryType errorRecoveryType) const
 	{
 		ParserResultT result{initResult};
 
@@ -619,29 +947,116 @@ namespace m0st4fa::parsix {
 		* _error_recovery(errorRecoveryType): TBD.
 		*/
 
-		this->_reset_parser_state();
-		this->_push_state(START_STATE);
-		this->m_CurrInputToken = this->get_next_token();
+		// all of the state of this parse lives in the context; the parser itself is not modified
+		ctx.reset(lexer);
+		const Arena::Scope arenaScope{ ctx.arena };
 
-		// this variable keeps track of the number of errors encountered thus far
-		size_t errorNum = 0;
+		this->_push_state(ctx, START_STATE);
+		ctx.currInputToken = this->get_next_token(lexer);
+		record_stats(ctx.stats, &ParseStats::recordToken);
 
 		// main parser loop
 		while (true) {
 			// check for errors and resolve them if any
-			if(_check_and_resolve_parsing_errors(errorNum, errorRecoveryType))
+			if(_check_and_resolve_parsing_errors(ctx, errorRecoveryType))
 				continue; // if there is no error and has been resolved
 
 			// no error:
 
 			// do the action and break in case we accept
-			if (this->_take_parsing_action(result))
+			const ActionResult action = this->_take_parsing_action(ctx, result);
+
+			if (action == ActionResult::AR_ACCEPTED)
 				break;
-			
+
+			if (action == ActionResult::AR_SHIFTED) {
+				ctx.currInputToken = this->get_next_token(lexer);
+				record_stats(ctx.stats, &ParseStats::recordToken);
+			}
 		}
 
 		return result;
 	}
+
+	/**
+	 * @brief Feeds a push-driven parse (see `beginPush()`) its next token.
+	 *
+	 * @tparam ParserResultT The type of the result of the parser.
+	 * @param[in, out] ctx The context of the parse. Its arena is the current arena (see `Arena::current()`) of the semantic actions for the duration of the call.
+	 * @param[in] token The next token of the input; `TEOF` at the end of the input.
+	 * @param[in, out] result The result of the parse, given to the action of production 0 on acceptance.
+	 *
+	 * @details Takes parsing actions, exactly like `parse()` does, until `token` is shifted (and the parse is suspended until the next call) or the input is accepted.
+	 *
+	 * @throws std::logic_error If the parse has not been started with `beginPush()` or has already accepted, or if the input does not belong to the grammar (push-driven parses do not recover from errors).
+	 * @returns PushStatus::PS_ACCEPTED if the parser has accepted the input; PushStatus::PS_NEED_INPUT if it needs the next token.
+	 */
+	template<typename GrammarT, typename LexicalAnalyzerT, typename SymbolT, typename StateT, typename ParsingTableT, typename FSMTableT, typename InputT, typename ActionsT>
+	template<typename ParserResultT>
+	PushStatus LRParser<GrammarT, LexicalAnalyzerT, SymbolT, StateT, ParsingTableT, FSMTableT, InputT, ActionsT>::feed(ParseContext& ctx, const TokenType& token, ParserResultT& result) const
+	{
+		if (ctx.stack.empty() || ctx.accepted) {
+			get_logger().log(LoggerInfo::ERR_INVALID_VAL, std::format("Cannot feed token {} to a parse that {}.", token.toString(), ctx.accepted ? "has already accepted" : "has not been started with `beginPush()`"));
+			throw std::logic_error("Cannot feed a parse that has not been started or has already accepted.");
+		}
+
+		const Arena::Scope arenaScope{ ctx.arena };
+		ctx.currInputToken = token;
+		record_stats(ctx.stats, &ParseStats::recordToken);
+
+		// take actions until the token is consumed
+		while (true) {
+			// throws if there is an error, since push-driven parses do not recover
+			(void)this->_check_and_resolve_parsing_errors(ctx, ErrorRecoveryType::ERT_NONE);
+
+			switch (this->_take_parsing_action(ctx, result)) {
+			case ActionResult::AR_SHIFTED:
+				return PushStatus::PS_NEED_INPUT;
+
+			case ActionResult::AR_ACCEPTED:
+				ctx.accepted = true;
+				return PushStatus::PS_ACCEPTED;
+
+			default:
+				break;
+			}
+		}
+	}
+
+	/**
+	 * @brief Takes the reductions a push-driven parse (see `beginPush()`) makes on `lookahead` before shifting it, without shifting it.
+	 *
+	 * @param[in, out] ctx The context of the parse.
+	 * @param[in] lookahead The next token of the input; it must not be `TEOF`.
+	 *
+	 * @details Afterwards, the state on top of the stack is the one in which `lookahead` would be shifted. Feeding `lookahead` then shifts it right away; alternatively, a subtree of an earlier parse that begins with `lookahead` can be pushed (see `pushSubtree()`), if it was built on top of that state.
+	 *
+	 * @throws std::logic_error As `feed()`.
+	 */
+	template<typename GrammarT, typename LexicalAnalyzerT, typename SymbolT, typename StateT, typename ParsingTableT, typename FSMTableT, typename InputT, typename ActionsT>
+	void LRParser<GrammarT, LexicalAnalyzerT, SymbolT, StateT, ParsingTableT, FSMTableT, InputT, ActionsT>::reduceOn(ParseContext& ctx, const TokenType& lookahead) const
+	{
+		if (ctx.stack.empty() || ctx.accepted) {
+			get_logger().log(LoggerInfo::ERR_INVALID_VAL, std::format("Cannot reduce on token {} in a parse that {}.", lookahead.toString(), ctx.accepted ? "has already accepted" : "has not been started with `beginPush()`"));
+			throw std::logic_error("Cannot feed a parse that has not been started or has already accepted.");
+		}
+
+		const Arena::Scope arenaScope{ ctx.arena };
+		const auto& table = this->p_Table->view();
+		ctx.currInputToken = lookahead;
+
+		while (true) {
+			// throws if there is an error, since push-driven parses do not recover
+			(void)this->_check_and_resolve_parsing_errors(ctx, ErrorRecoveryType::ERT_NONE);
+
+			const LRTableEntry entry = table.atAction(ctx.currState, lookahead.name);
+
+			if (entry.type != LRTableEntryType::TET_ACTION_REDUCE)
+				return;
+
+			this->_reduce(ctx, entry.number);
+		}
+	}
 }
 
 namespace m0st4ta {
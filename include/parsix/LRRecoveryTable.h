@@ -0,0 +1,134 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "parsix/TerminalSet.h"
+
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief The metadata LR panic-mode error recovery needs, computed once from a parsing table, so that recovering does not allocate nor search any set.
+	 * @details For every state, it stores the non-terminals having a GOTO entry in that state (one after the other, in a single array), and the union of their FOLLOW sets as a bitset: the terminals the state synchronizes on. Checking whether a skipped token synchronizes with the state is then a single bit test.
+	 * @tparam SymbolT The type of a grammar symbol. Its terminal type must have a `T_COUNT` enumerator.
+	 */
+	template <typename SymbolT>
+	class LRRecoveryTable {
+	public:
+
+		/**
+		 * @brief Aliases the type of a terminal.
+		 */
+		using TerminalType = decltype(SymbolT{}.as.terminal);
+
+		/**
+		 * @brief Aliases the type of a non-terminal.
+		 */
+		using VariableType = decltype(SymbolT{}.as.nonTerminal);
+
+		/**
+		 * @brief Aliases the type of a set of terminals.
+		 */
+		using TerminalSetType = TerminalSet<SymbolT>;
+
+	private:
+
+		/**
+		 * @brief The non-terminals having a GOTO entry in state `i` are [`m_GotoOffsets[i]`, `m_GotoOffsets[i + 1]`) within `m_Gotos`.
+		 */
+		std::vector<uint32_t> m_GotoOffsets{ 0 };
+
+		/**
+		 * @brief The non-terminals having a GOTO entry in every state, one state after the other, each in increasing order.
+		 */
+		std::vector<VariableType> m_Gotos;
+
+		/**
+		 * @brief The terminals every state synchronizes on: the union of the FOLLOW sets of its GOTO non-terminals.
+		 */
+		std::vector<TerminalSetType> m_SyncSets;
+
+		/**
+		 * @brief The FOLLOW set of every non-terminal, indexed by the value of its enumerator.
+		 */
+		std::vector<TerminalSetType> m_FOLLOWSets;
+
+	public:
+
+		/**
+		 * @brief Default constructor. Constructs an empty table (of no state).
+		 */
+		LRRecoveryTable() = default;
+
+		/**
+		 * @brief Computes the recovery metadata of a parsing table.
+		 * @param[in] table The parsing table; any LR table type (`getStateCount()`, `getGotos()` and `grammar`), whose grammar has its FOLLOW sets calculated (as bitsets, see `ProductionVector::getFOLLOWSet()`).
+		 */
+		template <typename TableT>
+		explicit LRRecoveryTable(const TableT& table) {
+			constexpr size_t varCount = (size_t)VariableType::NT_COUNT;
+			const size_t stateCount = table.getStateCount();
+
+			this->m_FOLLOWSets.reserve(varCount);
+			for (size_t variable = 0; variable < varCount; variable++)
+				this->m_FOLLOWSets.push_back(table.grammar.getFOLLOWSet((VariableType)variable));
+
+			this->m_GotoOffsets.reserve(stateCount + 1);
+			this->m_SyncSets.resize(stateCount);
+
+			for (size_t state = 0; state < stateCount; state++) {
+				for (const VariableType variable : table.getGotos(state)) {
+					this->m_Gotos.push_back(variable);
+					this->m_SyncSets[state] |= this->m_FOLLOWSets[(size_t)variable];
+				}
+
+				this->m_GotoOffsets.push_back((uint32_t)this->m_Gotos.size());
+			}
+		}
+
+		/**
+		 * @brief Gets the number of states of the table.
+		 */
+		size_t getStateCount() const noexcept(true) { return this->m_SyncSets.size(); }
+
+		/**
+		 * @brief Gets the non-terminals having a GOTO entry in `state`, in increasing order. No boundary-checking.
+		 */
+		std::span<const VariableType> gotos(size_t state) const noexcept(true) {
+			const uint32_t begin = this->m_GotoOffsets[state];
+
+			return { this->m_Gotos.data() + begin, this->m_GotoOffsets[state + 1] - begin };
+		}
+
+		/**
+		 * @brief Checks whether `state` has a GOTO entry on any non-terminal. No boundary-checking.
+		 */
+		bool hasGotos(size_t state) const noexcept(true) {
+			return this->m_GotoOffsets[state + 1] != this->m_GotoOffsets[state];
+		}
+
+		/**
+		 * @brief Checks whether `terminal` is in the FOLLOW set of any GOTO non-terminal of `state`. No boundary-checking.
+		 */
+		bool synchronizesOn(size_t state, TerminalType terminal) const noexcept(true) {
+			return this->m_SyncSets[state].contains(terminal);
+		}
+
+		/**
+		 * @brief Gets the first GOTO non-terminal of `state` whose FOLLOW set contains `terminal`, the one panic mode shifts the GOTO of.
+		 * @pre `synchronizesOn(state, terminal)`.
+		 */
+		VariableType syncVariable(size_t state, TerminalType terminal) const noexcept(true) {
+			const std::span<const VariableType> variables = this->gotos(state);
+
+			for (const VariableType variable : variables)
+				if (this->m_FOLLOWSets[(size_t)variable].contains(terminal))
+					return variable;
+
+			return variables.front();
+		}
+
+	};
+
+}
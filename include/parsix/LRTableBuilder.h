@@ -0,0 +1,1121 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "parsix/CompactItem.h"
+#include "parsix/PDataStructs.h"
+#include "parsix/WorkStealingPool.h"
+
+// DECLARATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief A conflict found while constructing an LR parsing table, i.e., two different actions for the same state and terminal.
+	 * @tparam TerminalT The type of a terminal in the grammar.
+	 */
+	template <typename TerminalT>
+	struct LRTableConflict {
+
+		/**
+		 * @brief The state (row of the Action table) in which the conflict was found.
+		 */
+		size_t state = SIZE_MAX;
+
+		/**
+		 * @brief The terminal (column of the Action table) on which the conflict was found.
+		 */
+		TerminalT terminal{};
+
+		/**
+		 * @brief The entry that was kept in the table after resolving the conflict.
+		 */
+		LRTableEntry kept{};
+
+		/**
+		 * @brief The entry that was discarded after resolving the conflict.
+		 */
+		LRTableEntry discarded{};
+
+		/**
+		 * @brief Checks whether this is a shift/reduce conflict.
+		 * @returns `true` if one of the entries is a shift and the other is a reduction; `false` otherwise.
+		 */
+		bool isShiftReduce() const {
+			return (kept.type == LRTableEntryType::TET_ACTION_SHIFT && discarded.type == LRTableEntryType::TET_ACTION_REDUCE) ||
+				(kept.type == LRTableEntryType::TET_ACTION_REDUCE && discarded.type == LRTableEntryType::TET_ACTION_SHIFT);
+		}
+
+		/**
+		 * @brief Checks whether this is a reduce/reduce conflict.
+		 * @returns `true` if both of the entries are reductions; `false` otherwise.
+		 */
+		bool isReduceReduce() const {
+			return kept.type == LRTableEntryType::TET_ACTION_REDUCE && discarded.type == LRTableEntryType::TET_ACTION_REDUCE;
+		}
+
+		/**
+		 * @brief Converts this LRTableConflict object to string. This is syntactic sugar over toString.
+		 * @returns The string representation of this LRTableConflict object.
+		 */
+		operator std::string() const {
+			return this->toString();
+		}
+
+		/**
+		 * @brief Converts this LRTableConflict object to string.
+		 * @returns The string representation of this LRTableConflict object.
+		 */
+		std::string toString() const {
+			const char* kind = isShiftReduce() ? "shift/reduce" : (isReduceReduce() ? "reduce/reduce" : "accept");
+
+			return std::format("{} conflict in state {} on terminal `{}`: kept `{}`, discarded `{}`", kind, state, toString(terminal), kept.toString(), discarded.toString());
+		}
+
+	};
+
+	/**
+	 * @brief Constructs LR parsing tables (LRParsingTable objects) from a grammar.
+	 * @details The builder computes the canonical collection of item sets of the grammar (LR(0) items for LR(0), SLR(1) and LALR(1) tables, LR(1) items for canonical LR(1) tables) and fills the Action and GOTO tables from it.
+	 * @details Items are CompactItem objects: they refer to their production by index and to their lookaheads by the id of an interned set (see LookaheadPool), so an item is 64 bits whatever the size of its production and lookaheads, and comparing kernels compares integers. The grammar symbols of the bodies and the alternatives of every non-terminal are indexed once, when the builder is constructed; the closure of a state is computed into buffers that are reused for every state.
+	 * @details LALR(1) tables are not obtained by merging the states of the canonical LR(1) collection. Instead, the lookaheads of the kernel items of the LR(0) collection are computed directly, by determining which lookaheads are generated spontaneously and which propagate from one kernel item to another and then propagating them until a fixed point is reached. The table therefore has as many states as the LR(0) one.
+	 * @details Item sets are identified by their *kernels* only; kernels are kept sorted by production number and dot position and are looked up by hash, so finding whether a GOTO target already exists costs (on average) a single comparison and not a scan of all of the states.
+	 * @details The closures of the states can be computed on several threads (see build()); the states are still numbered deterministically, so the tables do not depend on the number of threads.
+	 * @details Conflicts are resolved as follows (and are all recorded, see getConflicts()): accepting wins over everything, shifting wins over reducing and, among reductions, the production with the smaller number wins.
+	 * @attention The grammar must be augmented: production 0 must be the only production of the start symbol, its body must be a single non-terminal and the start symbol must not appear in any body. Moreover, the number of every production (`prodNumber`) must equal its index within the grammar.
+	 * @note State 0 is always the start state. Epsilon productions (whose body is `EPSILON`) are treated as having an empty body.
+	 * @tparam GrammarT The type of object representing the grammar. Generally, it is a vector of production record objects.
+	 */
+	template <typename GrammarT>
+	class LRTableBuilder {
+
+		/**
+		 * @brief Aliases the type of a production.
+		 */
+		using ProductionType = std::remove_cvref_t<decltype(GrammarT{}.at(0))>;
+
+		/**
+		 * @brief Aliases the type of a grammar symbol.
+		 */
+		using SymbolType = decltype(ProductionType{}.prodHead);
+
+		/**
+		 * @brief Aliases the type of a non-terminal.
+		 */
+		using VariableType = decltype(SymbolType{}.as.nonTerminal);
+
+		/**
+		 * @brief Aliases the type of a terminal.
+		 */
+		using TerminalType = decltype(SymbolType{}.as.terminal);
+
+		/**
+		 * @brief Aliases the type of the tables constructed by the builder.
+		 */
+		using TableType = LRParsingTable<GrammarT>;
+
+		/**
+		 * @brief Aliases the type of the items of the states, as returned by getStates().
+		 */
+		using ItemType = Item<ProductionType>;
+
+		/**
+		 * @brief Aliases the type of the states (sets of items), as returned by getStates().
+		 */
+		using ItemSetType = ItemSet<ItemType>;
+
+		/**
+		 * @brief Aliases the type of the kernel of a state: its (compact) kernel items, sorted.
+		 */
+		using KernelType = std::vector<CompactItem>;
+
+		/**
+		 * @brief Aliases the type of a lookahead set.
+		 */
+		using LookAheadSetType = LookAheadSet<SymbolType>;
+
+		/**
+		 * @brief Aliases the type of the conflicts reported by the builder.
+		 */
+		using ConflictType = LRTableConflict<TerminalType>;
+
+		/**
+		 * @brief The total number of non-terminals in the grammar.
+		 */
+		static constexpr size_t VAR_COUNT = TableType::VAR_COUNT;
+
+		/**
+		 * @brief The total number of terminals in the grammar.
+		 */
+		static constexpr size_t TER_COUNT = TableType::TER_COUNT;
+
+		/**
+		 * @brief The total number of grammar symbols. Terminals are numbered first, then come the non-terminals.
+		 */
+		static constexpr size_t SYMBOL_COUNT = TER_COUNT + VAR_COUNT;
+
+		/**
+		 * @brief The grammar for which the tables are constructed.
+		 */
+		GrammarT m_Grammar;
+
+		/**
+		 * @brief The grammar symbols of the bodies of all of the productions, one body after the other. The bodies of epsilon productions are empty.
+		 */
+		std::vector<SymbolType> m_BodySymbols;
+
+		/**
+		 * @brief The offset within `m_BodySymbols` of the body of every production; the last element is the total number of symbols.
+		 */
+		std::vector<size_t> m_BodyOffsets;
+
+		/**
+		 * @brief The kernels of the states of the last constructed table, indexed by state number.
+		 */
+		std::vector<KernelType> m_Kernels;
+
+		/**
+		 * @brief The lookahead sets of the items of the last constructed table.
+		 */
+		LookaheadPool<SymbolType> m_Lookaheads;
+
+		/**
+		 * @brief The buffers into which a closure is computed (see _closure()). They are reused from one closure to the next; every worker thread has its own.
+		 */
+		struct ClosureBuffers {
+
+			/**
+			 * @brief The items of the last computed closure. Their lookaheads are in `lookaheads`, at the same index (their lookahead set ids are not used).
+			 */
+			std::vector<CompactItem> items;
+
+			/**
+			 * @brief The lookaheads of the items of the last computed closure.
+			 */
+			std::vector<LookAheadSetType> lookaheads;
+
+			/**
+			 * @brief Maps the index of a production to the index within `items` of its item with the dot at 0; `SIZE_MAX` if there is no such item.
+			 */
+			std::vector<size_t> index;
+
+			/**
+			 * @brief The indices of the items of the closure being computed that are still to be scanned.
+			 */
+			std::vector<size_t> worklist;
+
+			/**
+			 * @brief The items (with their lookaheads) of the GOTO kernels of the state being expanded, indexed by symbol; see _expand_state().
+			 */
+			std::vector<std::vector<std::pair<CompactItem, LookAheadSetType>>> gotoItems;
+		};
+
+		/**
+		 * @brief A GOTO kernel of a state, found while expanding the state (see _expand_state()), before its lookaheads are interned.
+		 */
+		struct PendingKernel {
+
+			/**
+			 * @brief The index of the symbol on which the state goes to this kernel.
+			 */
+			size_t symbol = 0;
+
+			/**
+			 * @brief The kernel items, sorted by core. Their lookahead set ids are not used.
+			 */
+			KernelType items;
+
+			/**
+			 * @brief The lookaheads of the items, at the same index; empty for LR(0) items.
+			 */
+			std::vector<LookAheadSetType> lookaheads;
+
+			/**
+			 * @brief The hash of the kernel; see _hash_kernel().
+			 */
+			size_t hash = 0;
+
+			/**
+			 * @brief The number of the state having this kernel, if the state already existed when the kernel was found; `SIZE_MAX` otherwise.
+			 */
+			size_t target = SIZE_MAX;
+		};
+
+		/**
+		 * @brief The result of expanding a state: the reductions called for by its closure and its GOTO kernels, by symbol order.
+		 */
+		struct StateExpansion {
+
+			/**
+			 * @brief The productions of the complete items of the closure, together with the lookaheads of the items.
+			 */
+			std::vector<std::pair<size_t, LookAheadSetType>> reductions;
+
+			/**
+			 * @brief The GOTO kernels of the state.
+			 */
+			std::vector<PendingKernel> gotos;
+		};
+
+		/**
+		 * @brief The closure buffers of the workers of the current construction.
+		 */
+		std::vector<ClosureBuffers> m_Buffers;
+
+		/**
+		 * @brief Maps the hash of a kernel to the numbers of the states having a kernel with that hash.
+		 */
+		std::unordered_map<size_t, std::vector<size_t>> m_KernelIndex;
+
+		/**
+		 * @brief The transitions of the states of the last constructed table: for every state, the GOTO targets of the state as (symbol index, target state) pairs, sorted by symbol index.
+		 */
+		std::vector<std::vector<std::pair<uint32_t, uint32_t>>> m_Transitions;
+
+		/**
+		 * @brief The conflicts found while constructing the last table.
+		 */
+		std::vector<ConflictType> m_Conflicts;
+
+		void _check_grammar() const;
+		void _index_grammar();
+		void _closure(const KernelType&, bool, ClosureBuffers&) const;
+		static size_t _hash_kernel(const KernelType&, const std::vector<LookAheadSetType>&);
+		bool _has_kernel(size_t, const PendingKernel&) const;
+		size_t _find_state(const PendingKernel&) const;
+		size_t _get_state(PendingKernel&);
+		void _expand_state(size_t, LRTableType, ClosureBuffers&, StateExpansion&) const;
+		void _set_action(TableType&, size_t, TerminalType, const LRTableEntry&);
+		void _add_reductions(TableType&, size_t, size_t, const LookAheadSetType&, LRTableType);
+		void _build_states(TableType&, LRTableType, const WorkStealingPool&);
+		size_t _get_kernel_item(size_t, CompactItem) const;
+		void _propagate_lookaheads(const WorkStealingPool&);
+		void _add_lookahead_reductions(TableType&, const WorkStealingPool&);
+
+		/**
+		 * @brief Gets the number of grammar symbols of the body of a production (`0` for epsilon productions).
+		 */
+		size_t _body_size(size_t prodIndex) const {
+			return this->m_BodyOffsets[prodIndex + 1] - this->m_BodyOffsets[prodIndex];
+		}
+
+		/**
+		 * @brief Gets the grammar symbol after the dot of an item.
+		 * @attention The item must not be complete.
+		 */
+		const SymbolType& _symbol_after_dot(CompactItem item) const {
+			return this->m_BodySymbols[this->m_BodyOffsets[item.prodIndex()] + item.dotPos()];
+		}
+
+		/**
+		 * @brief Checks whether the dot of an item is at the end of its production. Items of epsilon productions are always complete.
+		 * @param[in] item The item to check.
+		 * @returns `true` if `item` calls for a reduction; `false` otherwise.
+		 */
+		bool _is_complete(CompactItem item) const {
+			return item.dotPos() == this->_body_size(item.prodIndex());
+		}
+
+		/**
+		 * @brief A move of the dot over a symbol, found in the closure of a kernel item [K, #] while computing LALR(1) lookaheads; see _propagate_lookaheads().
+		 */
+		struct LookaheadLink {
+
+			/**
+			 * @brief The closure item whose dot moves.
+			 */
+			CompactItem item;
+
+			/**
+			 * @brief The lookaheads generated spontaneously for the item the dot moves to.
+			 */
+			LookAheadSetType spontaneous;
+
+			/**
+			 * @brief Whether the lookaheads of `K` propagate to the item the dot moves to.
+			 */
+			bool propagates = false;
+		};
+
+		/**
+		 * @brief Expands a compact item into an Item object (with a copy of its production and lookaheads).
+		 */
+		ItemType _to_item(CompactItem item) const {
+			return ItemType{ this->m_Grammar.at(item.prodIndex()), item.dotPos(), this->m_Lookaheads[item.lookaheadsId()] };
+		}
+
+		/**
+		 * @brief Gets the index of a grammar symbol among all of the grammar symbols (terminals first, then non-terminals).
+		 * @param[in] symbol The symbol whose index is to be returned.
+		 * @returns The index of `symbol`.
+		 */
+		static size_t _symbol_index(const SymbolType& symbol) {
+			return symbol.isTerminal ? (size_t)symbol.as.terminal : TER_COUNT + (size_t)symbol.as.nonTerminal;
+		}
+
+		/**
+		 * @brief Checks whether a table entry takes precedence over another when both are placed at the same position of the Action table.
+		 * @param[in] lhs The first entry.
+		 * @param[in] rhs The second entry.
+		 * @returns `true` if `lhs` is to be kept rather than `rhs`; `false` otherwise.
+		 */
+		static bool _takes_precedence(const LRTableEntry& lhs, const LRTableEntry& rhs) {
+			auto rank = [](const LRTableEntry& entry) {
+				switch (entry.type) {
+				case LRTableEntryType::TET_ACCEPT: return 0;
+				case LRTableEntryType::TET_ACTION_SHIFT: return 1;
+				default: return 2;
+				}
+			};
+
+			if (rank(lhs) != rank(rhs))
+				return rank(lhs) < rank(rhs);
+
+			return lhs.number < rhs.number;
+		}
+
+	public:
+
+		/**
+		 * @brief Converting constructor. Initializes the builder with the grammar for which tables are to be constructed.
+		 * @param[in] grammar The (augmented) grammar.
+		 * @throws std::logic_error If `grammar` does not satisfy the requirements of the builder (see the class documentation).
+		 */
+		LRTableBuilder(const GrammarT& grammar) : m_Grammar{ grammar } {
+			this->_check_grammar();
+			this->_index_grammar();
+		}
+
+		TableType build(LRTableType = LRTableType::LTT_CLR1, size_t threadCount = 1);
+
+		std::vector<ItemSetType> getStates() const;
+
+		/**
+		 * @brief Gets the number of states of the last constructed table.
+		 */
+		size_t getStateCount() const { return this->m_Kernels.size(); }
+
+		/**
+		 * @brief Gets the (compact) kernels of the states of the last constructed table. The lookaheads of their items are in getLookaheads().
+		 * @returns The kernels of the states, indexed by state number.
+		 */
+		const std::vector<KernelType>& getKernels() const { return this->m_Kernels; }
+
+		/**
+		 * @brief Gets the pool of the lookahead sets of the items of the last constructed table.
+		 */
+		const LookaheadPool<SymbolType>& getLookaheads() const { return this->m_Lookaheads; }
+
+		size_t getGoto(size_t, const SymbolType&) const;
+
+		/**
+		 * @brief Gets the conflicts found while constructing the last table.
+		 * @returns The conflicts, in the order in which they were found.
+		 */
+		const std::vector<ConflictType>& getConflicts() const { return this->m_Conflicts; }
+
+		/**
+		 * @brief Checks whether the last constructed table had conflicts.
+		 * @returns `true` if at least one conflict was found; `false` otherwise.
+		 */
+		bool hasConflicts() const { return not this->m_Conflicts.empty(); }
+
+	};
+
+}
+
+// IMPLEMENTATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Checks that the grammar of the builder satisfies the requirements of the builder.
+	 * @throws std::logic_error If the grammar is empty, is not augmented or its productions are not numbered by their indices.
+	 */
+	template<typename GrammarT>
+	void LRTableBuilder<GrammarT>::_check_grammar() const
+	{
+		if (this->m_Grammar.empty()) {
+			get_logger().log(LoggerInfo::ERR_INVALID_VAL, "Cannot construct an LR parsing table for an empty grammar.");
+			throw std::logic_error("Cannot construct an LR parsing table for an empty grammar.");
+		}
+
+		// the start production must be of the form S' -> S
+		const ProductionType& startProd = this->m_Grammar.at(0);
+		const SymbolType& startSymbol = startProd.prodHead;
+
+		const auto startBody = std::find_if(startProd.prodBody.begin(), startProd.prodBody.end(), [](const auto& element) {
+			return element.type == ProdElementType::PET_GRAM_SYMBOL;
+			});
+
+		if (startProd.size() != 1 || startBody->as.gramSymbol.isTerminal) {
+			get_logger().log(LoggerInfo::ERR_INVALID_VAL, std::format("The grammar is not augmented: production 0 `{}` must have a single non-terminal as its body.", startProd.toString()));
+			throw std::logic_error("The grammar is not augmented: production 0 must have a single non-terminal as its body.");
+		}
+
+		for (size_t prodIndex = 0; const ProductionType& prod : this->m_Grammar) {
+
+			if (prod.prodNumber != prodIndex) {
+				get_logger().log(LoggerInfo::ERR_INVALID_VAL, std::format("The number of production `{}` is {}, while its index within the grammar is {}.", prod.toString(), prod.prodNumber, prodIndex));
+				throw std::logic_error("The number of every production must equal its index within the grammar.");
+			}
+
+			if ((prodIndex > 0 && prod.prodHead == startSymbol) || prod.contains(startSymbol)) {
+				get_logger().log(LoggerInfo::ERR_INVALID_VAL, std::format("The grammar is not augmented: the start symbol {} must only appear as the head of production 0.", startSymbol.toString()));
+				throw std::logic_error("The grammar is not augmented: the start symbol must only appear as the head of production 0.");
+			}
+
+			prodIndex++;
+		}
+
+	}
+
+	/**
+	 * @brief Indexes the grammar: the grammar symbols of the body of every production (non-grammar-symbol elements are dropped and the bodies of epsilon productions are emptied) and the alternatives of every non-terminal.
+	 * @throws std::logic_error If the grammar has more productions, or a production has a longer body, than a CompactItem can refer to.
+	 */
+	template<typename GrammarT>
+	void LRTableBuilder<GrammarT>::_index_grammar()
+	{
+		if (this->m_Grammar.size() > CompactItem::MAX_PROD_INDEX + 1) {
+			get_logger().log(LoggerInfo::ERR_INVALID_VAL, std::format("The grammar has {} productions; at most {} are supported.", this->m_Grammar.size(), CompactItem::MAX_PROD_INDEX + 1));
+			throw std::logic_error("The grammar has too many productions.");
+		}
+
+		this->m_BodySymbols.clear();
+		this->m_BodyOffsets.assign(1, 0);
+
+		for (const ProductionType& prod : this->m_Grammar) {
+
+			if (not prod.isEpsilon())
+				for (const auto& element : prod.prodBody)
+					if (element.type == ProdElementType::PET_GRAM_SYMBOL)
+						this->m_BodySymbols.push_back(element.as.gramSymbol);
+
+			this->m_BodyOffsets.push_back(this->m_BodySymbols.size());
+
+			if (this->_body_size(this->m_BodyOffsets.size() - 2) > CompactItem::MAX_DOT_POS) {
+				get_logger().log(LoggerInfo::ERR_INVALID_VAL, std::format("The body of production `{}` has more than {} symbols.", prod.toString(), CompactItem::MAX_DOT_POS));
+				throw std::logic_error("The body of a production has too many symbols.");
+			}
+		}
+
+		this->m_Grammar.indexAlternatives();
+	}
+
+	/**
+	 * @brief Computes the closure of a kernel into a set of buffers, replacing the closure last computed into them.
+	 * @details The kernel items come first, in order, followed by the items added by the closure. For LR(1) items, the lookaheads of an added item [B -> .γ] are FIRST(βa) for every item [A -> α.Bβ, a]; an item whose lookaheads grow is scanned again, until a fixed point is reached.
+	 * @details The builder itself is only read, so closures can be computed concurrently into different buffers.
+	 * @param[in] kernel The kernel items.
+	 * @param[in] withLookaheads Whether the items are LR(1) items, in which case the lookaheads of the kernel items are the sets of the pool they refer to; otherwise, all lookaheads are empty.
+	 * @param[in, out] buffers The buffers into which the closure is computed.
+	 * @attention FIRST must have been calculated if `withLookaheads` is `true`.
+	 */
+	template<typename GrammarT>
+	void LRTableBuilder<GrammarT>::_closure(const KernelType& kernel, bool withLookaheads, ClosureBuffers& buffers) const
+	{
+		// forget the last closure
+		if (buffers.index.size() != this->m_Grammar.size())
+			buffers.index.assign(this->m_Grammar.size(), SIZE_MAX);
+
+		for (CompactItem item : buffers.items)
+			if (item.dotPos() == 0)
+				buffers.index[item.prodIndex()] = SIZE_MAX;
+
+		buffers.items.assign(kernel.begin(), kernel.end());
+		buffers.lookaheads.resize(kernel.size());
+		buffers.worklist.clear();
+
+		for (size_t i = kernel.size(); i > 0; i--) {
+			const CompactItem item = kernel[i - 1];
+
+			buffers.lookaheads[i - 1] = withLookaheads ? this->m_Lookaheads[item.lookaheadsId()] : LookAheadSetType{};
+
+			if (item.dotPos() == 0)
+				buffers.index[item.prodIndex()] = i - 1;
+
+			buffers.worklist.push_back(i - 1);
+		}
+
+		while (not buffers.worklist.empty()) {
+			const size_t itemIndex = buffers.worklist.back();
+			buffers.worklist.pop_back();
+
+			const CompactItem item = buffers.items[itemIndex];
+
+			if (this->_is_complete(item) || this->_symbol_after_dot(item).isTerminal)
+				continue;
+
+			// the lookaheads of the new items: FIRST(beta a), for the string beta after the non-terminal and every lookahead a of the item
+			LookAheadSetType lookaheads{};
+
+			if (withLookaheads) {
+				const size_t bodyStart = this->m_BodyOffsets[item.prodIndex()];
+				const size_t bodyEnd = this->m_BodyOffsets[item.prodIndex() + 1];
+				bool betaIsNullable = true;
+
+				for (size_t i = bodyStart + item.dotPos() + 1; i < bodyEnd && betaIsNullable; i++) {
+					const SymbolType& symbol = this->m_BodySymbols[i];
+
+					if (symbol.isTerminal) {
+						lookaheads.insert(symbol), betaIsNullable = false;
+						continue;
+					}
+
+					lookaheads |= this->m_Grammar.getFIRSTSet(symbol.as.nonTerminal);
+					betaIsNullable = lookaheads.erase(SymbolType::EPSILON) > 0;
+				}
+
+				if (betaIsNullable)
+					lookaheads |= buffers.lookaheads[itemIndex];
+			}
+
+			for (size_t prodIndex : this->m_Grammar.getAlternatives(this->_symbol_after_dot(item).as.nonTerminal)) {
+				size_t& closureIndex = buffers.index[prodIndex];
+
+				if (closureIndex == SIZE_MAX) {
+					closureIndex = buffers.items.size();
+					buffers.items.push_back(CompactItem{ prodIndex, 0 });
+					buffers.lookaheads.push_back(lookaheads);
+					buffers.worklist.push_back(closureIndex);
+					continue;
+				}
+
+				// the item is already there; only its lookaheads may grow
+				if (withLookaheads && buffers.lookaheads[closureIndex].unite(lookaheads))
+					buffers.worklist.push_back(closureIndex);
+			}
+
+		}
+
+	}
+
+	/**
+	 * @brief Hashes a (sorted) kernel. Both the cores and the lookaheads of the items take part in the hash.
+	 * @param[in] items The kernel items, sorted by core (their lookahead set ids are ignored).
+	 * @param[in] lookaheads The lookaheads of the items, at the same index; empty for LR(0) items.
+	 * @returns The hash of the kernel.
+	 */
+	template<typename GrammarT>
+	size_t LRTableBuilder<GrammarT>::_hash_kernel(const KernelType& items, const std::vector<LookAheadSetType>& lookaheads)
+	{
+		size_t hash = items.size();
+		auto combine = [&hash](size_t value) {
+			hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+		};
+
+		for (size_t i = 0; i < items.size(); i++) {
+			combine((size_t)items[i].core());
+
+			if (not lookaheads.empty())
+				combine(lookaheads[i].hash());
+		}
+
+		return hash;
+	}
+
+	/**
+	 * @brief Checks whether a state has a given kernel.
+	 * @param[in] state The number of the state.
+	 * @param[in] kernel The kernel.
+	 * @returns `true` if the kernel of `state` is identical to `kernel` (items as well as their lookaheads); `false` otherwise.
+	 */
+	template<typename GrammarT>
+	bool LRTableBuilder<GrammarT>::_has_kernel(size_t state, const PendingKernel& kernel) const
+	{
+		const KernelType& stateKernel = this->m_Kernels[state];
+
+		if (stateKernel.size() != kernel.items.size())
+			return false;
+
+		for (size_t i = 0; i < stateKernel.size(); i++) {
+
+			if (stateKernel[i].core() != kernel.items[i].core())
+				return false;
+
+			if (kernel.lookaheads.empty() ? stateKernel[i].lookaheadsId() != 0 : this->m_Lookaheads[stateKernel[i].lookaheadsId()] != kernel.lookaheads[i])
+				return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * @brief Finds the state having a given kernel, among the states created so far.
+	 * @param[in] kernel The kernel.
+	 * @returns The number of the state whose kernel is `kernel`; `SIZE_MAX` if there is no such state.
+	 */
+	template<typename GrammarT>
+	size_t LRTableBuilder<GrammarT>::_find_state(const PendingKernel& kernel) const
+	{
+		const auto it = this->m_KernelIndex.find(kernel.hash);
+
+		if (it == this->m_KernelIndex.end())
+			return SIZE_MAX;
+
+		for (size_t state : it->second)
+			if (this->_has_kernel(state, kernel))
+				return state;
+
+		return SIZE_MAX;
+	}
+
+	/**
+	 * @brief Gets the number of the state having a given kernel, creating the state if it does not exist yet.
+	 * @details Since equal lookahead sets get the same id when they are interned, the kernels of the states can afterwards be compared as integers.
+	 * @param[in, out] kernel The kernel. Its items are moved into the new state, if one is created.
+	 * @returns The number of the state whose kernel is `kernel`.
+	 */
+	template<typename GrammarT>
+	size_t LRTableBuilder<GrammarT>::_get_state(PendingKernel& kernel)
+	{
+		const size_t found = this->_find_state(kernel);
+
+		if (found != SIZE_MAX)
+			return found;
+
+		// if the kernel is new, make a new state for it
+		if (not kernel.lookaheads.empty())
+			for (size_t i = 0; i < kernel.items.size(); i++)
+				kernel.items[i] = kernel.items[i].withLookaheads(this->m_Lookaheads.intern(kernel.lookaheads[i]));
+
+		const size_t state = this->m_Kernels.size();
+		this->m_KernelIndex[kernel.hash].push_back(state);
+		this->m_Kernels.push_back(std::move(kernel.items));
+
+		return state;
+	}
+
+	/**
+	 * @brief Expands a state: computes its closure, the reductions called for by the closure (unless constructing an LALR(1) table) and its GOTO kernels.
+	 * @details The builder itself is only read (GOTO kernels are merely looked up among the existing states), so states can be expanded concurrently, with different buffers.
+	 * @param[in] state The number of the state.
+	 * @param[in] type The type of the table being constructed.
+	 * @param[in, out] buffers The buffers used to compute the closure.
+	 * @param[out] expansion The reductions and GOTO kernels of `state`.
+	 */
+	template<typename GrammarT>
+	void LRTableBuilder<GrammarT>::_expand_state(size_t state, LRTableType type, ClosureBuffers& buffers, StateExpansion& expansion) const
+	{
+		const bool isLR1 = type == LRTableType::LTT_CLR1;
+		const bool addReductions = type != LRTableType::LTT_LALR1;
+
+		this->_closure(this->m_Kernels[state], isLR1, buffers);
+		buffers.gotoItems.resize(SYMBOL_COUNT);
+
+		// reductions; group the rest of the items by the symbol after their dot
+		for (size_t i = 0; i < buffers.items.size(); i++) {
+			const CompactItem item = buffers.items[i];
+
+			if (this->_is_complete(item)) {
+				if (addReductions)
+					expansion.reductions.emplace_back(item.prodIndex(), buffers.lookaheads[i]);
+				continue;
+			}
+
+			buffers.gotoItems[_symbol_index(this->_symbol_after_dot(item))].emplace_back(item.advanced(), buffers.lookaheads[i]);
+		}
+
+		// the GOTO kernels, by symbol order
+		for (size_t symbol = 0; symbol < SYMBOL_COUNT; symbol++) {
+			auto& items = buffers.gotoItems[symbol];
+
+			if (items.empty())
+				continue;
+
+			std::sort(items.begin(), items.end(), [](const auto& lhs, const auto& rhs) { return lhs.first.core() < rhs.first.core(); });
+
+			PendingKernel& kernel = expansion.gotos.emplace_back();
+			kernel.symbol = symbol;
+			kernel.items.reserve(items.size());
+
+			for (const auto& [item, lookaheads] : items)
+				kernel.items.push_back(item);
+
+			if (isLR1)
+				for (auto& [item, lookaheads] : items)
+					kernel.lookaheads.push_back(std::move(lookaheads));
+
+			kernel.hash = _hash_kernel(kernel.items, kernel.lookaheads);
+			kernel.target = this->_find_state(kernel);
+			items.clear();
+		}
+
+	}
+
+	/**
+	 * @brief Places an entry in the Action table, resolving (and recording) any conflict with the entry already there.
+	 * @param[in, out] table The table being constructed.
+	 * @param[in] state The state (row) of the entry.
+	 * @param[in] terminal The terminal (column) of the entry.
+	 * @param[in] entry The entry to be placed.
+	 */
+	template<typename GrammarT>
+	void LRTableBuilder<GrammarT>::_set_action(TableType& table, size_t state, TerminalType terminal, const LRTableEntry& entry)
+	{
+		LRTableEntry& current = table.atAction(state, terminal);
+
+		if (current.isEmpty) {
+			current = entry;
+			return;
+		}
+
+		if (current == entry)
+			return;
+
+		// we have a conflict
+		const bool keepCurrent = _takes_precedence(current, entry);
+		ConflictType conflict{ state, terminal, keepCurrent ? current : entry, keepCurrent ? entry : current };
+		current = conflict.kept;
+
+		get_logger().log(LoggerInfo::WARNING, conflict.toString());
+		this->m_Conflicts.push_back(conflict);
+	}
+
+	/**
+	 * @brief Places the reductions called for by a complete item in the Action table.
+	 * @param[in, out] table The table being constructed.
+	 * @param[in] state The state to which the item belongs.
+	 * @param[in] prodNumber The number of the production of the complete item.
+	 * @param[in] lookaheads The lookaheads of the complete item (only used for LR(1) and LALR(1) tables).
+	 * @param[in] type The type of the table being constructed; it determines the terminals on which to reduce.
+	 */
+	template<typename GrammarT>
+	void LRTableBuilder<GrammarT>::_add_reductions(TableType& table, size_t state, size_t prodNumber, const LookAheadSetType& lookaheads, LRTableType type)
+	{
+		const LRTableEntry entry = prodNumber == 0 ? TE_ACCEPT() : TE_REDUCE(prodNumber);
+
+		// reducing by the start production means accepting, which is only possible at the end of the input
+		if (prodNumber == 0) {
+			this->_set_action(table, state, SymbolType::END_MARKER.as.terminal, entry);
+			return;
+		}
+
+		switch (type) {
+		case LRTableType::LTT_LR0:
+			for (size_t terminal = 0; terminal < TER_COUNT; terminal++)
+				if ((TerminalType)terminal != SymbolType::EPSILON.as.terminal)
+					this->_set_action(table, state, (TerminalType)terminal, entry);
+			break;
+
+		case LRTableType::LTT_SLR1:
+			for (const SymbolType& symbol : this->m_Grammar.getFOLLOWSet(this->m_Grammar.at(prodNumber).prodHead.as.nonTerminal))
+				if (symbol != SymbolType::EPSILON)
+					this->_set_action(table, state, symbol.as.terminal, entry);
+			break;
+
+		default:
+			for (const SymbolType& symbol : lookaheads)
+				if (symbol != SymbolType::EPSILON)
+					this->_set_action(table, state, symbol.as.terminal, entry);
+			break;
+		}
+
+	}
+
+	/**
+	 * @brief Computes the states (item sets) of the collection of the grammar and fills the table with their shifts, GOTOs and (unless constructing an LALR(1) table) reductions.
+	 * @details The collection is explored breadth-first, a level at a time. The states of a level are expanded concurrently on the pool (see _expand_state()); then, the GOTO kernels not found among the existing states are interned, one state after the other and by symbol order within a state. Hence, the states are numbered in the order in which a sequential breadth-first exploration would discover them, whatever the number of threads, and the tables are reproducible.
+	 * @details Every state is closed exactly once, and its GOTO targets are looked up by kernel and memoized in `m_Transitions`, so the construction takes time linear in the number of states (times the size of their closures).
+	 * @param[in, out] table The table being constructed.
+	 * @param[in] type The type of the table being constructed.
+	 * @param[in] pool The pool on which the states of a level are expanded.
+	 */
+	template<typename GrammarT>
+	void LRTableBuilder<GrammarT>::_build_states(TableType& table, LRTableType type, const WorkStealingPool& pool)
+	{
+		// the start state: CLOSURE({[S' -> .S, $]})
+		PendingKernel startKernel{ .symbol = 0, .items = KernelType{ CompactItem{ 0, 0 } }, .lookaheads = {}, .hash = 0, .target = SIZE_MAX };
+		if (type == LRTableType::LTT_CLR1)
+			startKernel.lookaheads.push_back(LookAheadSetType{ SymbolType::END_MARKER });
+		startKernel.hash = _hash_kernel(startKernel.items, startKernel.lookaheads);
+		this->_get_state(startKernel);
+
+		std::vector<StateExpansion> expansions;
+
+		for (size_t levelBegin = 0; levelBegin < this->m_Kernels.size(); ) {
+			const size_t levelEnd = this->m_Kernels.size();
+
+			expansions.clear();
+			expansions.resize(levelEnd - levelBegin);
+
+			pool.run(levelEnd - levelBegin, [&](size_t task, size_t worker) {
+				this->_expand_state(levelBegin + task, type, this->m_Buffers[worker], expansions[task]);
+				});
+
+			for (size_t state = levelBegin; state < levelEnd; state++) {
+				StateExpansion& expansion = expansions[state - levelBegin];
+				auto& transitions = this->m_Transitions.emplace_back();
+
+				for (const auto& [prodIndex, lookaheads] : expansion.reductions)
+					this->_add_reductions(table, state, prodIndex, lookaheads, type);
+
+				// shifts and GOTOs
+				for (PendingKernel& kernel : expansion.gotos) {
+					const size_t target = kernel.target != SIZE_MAX ? kernel.target : this->_get_state(kernel);
+					transitions.emplace_back((uint32_t)kernel.symbol, (uint32_t)target);
+
+					if (kernel.symbol < TER_COUNT)
+						this->_set_action(table, state, (TerminalType)kernel.symbol, TE_SHIFT(target));
+					else
+						table.atGoto(state, (VariableType)(kernel.symbol - TER_COUNT)) = TE_GOTO(target);
+				}
+			}
+
+			levelBegin = levelEnd;
+		}
+
+	}
+
+	/**
+	 * @brief Finds an item within the kernel of a state by its core.
+	 * @param[in] state The number of the state.
+	 * @param[in] item An item having the core to search for (its lookaheads are ignored).
+	 * @returns The index of the item within the (sorted) kernel of `state`.
+	 * @throws std::logic_error If the kernel of `state` has no item with the core of `item`.
+	 */
+	template<typename GrammarT>
+	size_t LRTableBuilder<GrammarT>::_get_kernel_item(size_t state, CompactItem item) const
+	{
+		const KernelType& kernel = this->m_Kernels[state];
+		const auto it = std::lower_bound(kernel.begin(), kernel.end(), item.core(), [](CompactItem lhs, uint64_t core) {
+			return lhs.core() < core;
+			});
+
+		// Note: this never happens for a correctly constructed collection; it is just a precaution for possible (probably logic) bugs
+		if (it == kernel.end() || it->core() != item.core()) {
+			get_logger().log(LoggerInfo::FATAL_ERROR, std::format("[Unreachable] Item {} is not in the kernel of state {}.", this->_to_item(item.withLookaheads(0)).toString(), state));
+			throw std::logic_error("Item is not in the kernel of the GOTO state.");
+		}
+
+		return it - kernel.begin();
+	}
+
+	/**
+	 * @brief Computes the LALR(1) lookaheads of the kernel items of the (LR(0)) states, storing them in the items themselves.
+	 * @details **Algorithm** (spontaneous generation and propagation of lookaheads):
+		* For every kernel item `K` of every state `I`, compute `J` = CLOSURE({[K, #]}), where `#` is a dummy lookahead that does not belong to the grammar (`EPSILON` plays that role, since it is never a lookahead otherwise).
+		* For every item [B -> γ.Xδ, a] of `J`, the kernel item [B -> γX.δ] of GOTO(`I`, `X`):
+			* Gets `a` generated spontaneously, if `a` is not `#`.
+			* Gets the lookaheads of `K` propagated to it, if `a` is `#`.
+		* The end marker is generated spontaneously for [S' -> .S] of the start state; then lookaheads are propagated along the links until no new lookahead can be added.
+	 * @details The closure of [K, #] only depends on the core of `K`, so it is computed once per distinct core (concurrently on the pool) and the links it yields are reused for every state whose kernel has that core.
+	 * @param[in] pool The pool on which the closures are computed.
+	 */
+	template<typename GrammarT>
+	void LRTableBuilder<GrammarT>::_propagate_lookaheads(const WorkStealingPool& pool)
+	{
+		const SymbolType& dummy = SymbolType::EPSILON;
+		const size_t dummyId = this->m_Lookaheads.intern({ dummy });
+		const size_t stateCount = this->m_Kernels.size();
+
+		// kernel items are referred to by a global index: the offset of their state plus their index within the (sorted) kernel of the state
+		std::vector<size_t> offsets(stateCount + 1, 0);
+		for (size_t state = 0; state < stateCount; state++)
+			offsets[state + 1] = offsets[state] + this->m_Kernels[state].size();
+
+		// the distinct cores of the kernel items, and the index of the core of every kernel item among them
+		std::unordered_map<uint64_t, size_t> coreIndex;
+		std::vector<CompactItem> cores;
+		std::vector<size_t> itemCores(offsets.back());
+
+		for (size_t state = 0; state < stateCount; state++)
+			for (size_t index = 0; CompactItem kernelItem : this->m_Kernels[state]) {
+				const auto [it, isNew] = coreIndex.try_emplace(kernelItem.core(), cores.size());
+				if (isNew)
+					cores.push_back(kernelItem.withLookaheads(dummyId));
+
+				itemCores[offsets[state] + index++] = it->second;
+			}
+
+		// the links of the closure of [K, #] for every distinct core
+		std::vector<std::vector<LookaheadLink>> links(cores.size());
+
+		pool.run(cores.size(), [&](size_t core, size_t worker) {
+			ClosureBuffers& buffers = this->m_Buffers[worker];
+			this->_closure(KernelType{ cores[core] }, true, buffers);
+
+			for (size_t i = 0; i < buffers.items.size(); i++) {
+				const CompactItem item = buffers.items[i];
+
+				if (this->_is_complete(item))
+					continue;
+
+				LookaheadLink& link = links[core].emplace_back(LookaheadLink{ item, buffers.lookaheads[i] });
+				link.propagates = link.spontaneous.erase(dummy) > 0;
+			}
+			});
+
+		std::vector<LookAheadSetType> lookaheads(offsets.back());
+		std::vector<std::vector<size_t>> propagatesTo(offsets.back());
+
+		// the end marker is generated spontaneously for the start item
+		lookaheads[0].insert(SymbolType::END_MARKER);
+
+		// determine the spontaneously generated lookaheads and the propagation links
+		for (size_t state = 0; state < stateCount; state++) {
+
+			for (size_t index = 0; index < this->m_Kernels[state].size(); index++) {
+
+				for (const LookaheadLink& link : links[itemCores[offsets[state] + index]]) {
+
+					// find the kernel item of GOTO(state, X) that this item moves to
+					const size_t target = this->getGoto(state, this->_symbol_after_dot(link.item));
+					const size_t targetItem = offsets[target] + this->_get_kernel_item(target, link.item.advanced());
+
+					if (link.propagates)
+						propagatesTo[offsets[state] + index].push_back(targetItem);
+
+					lookaheads[targetItem] |= link.spontaneous;
+				}
+
+			}
+
+		}
+
+		// propagate the lookaheads until a fixed point is reached
+		std::vector<size_t> worklist{};
+		for (size_t item = 0; item < lookaheads.size(); item++)
+			if (not lookaheads[item].empty())
+				worklist.push_back(item);
+
+		while (not worklist.empty()) {
+			const size_t item = worklist.back();
+			worklist.pop_back();
+
+			for (size_t targetItem : propagatesTo[item])
+				if (lookaheads[targetItem].unite(lookaheads[item]))
+					worklist.push_back(targetItem);
+
+		}
+
+		// store the lookaheads in the kernel items; this does not change the order of the items within the kernels, since they have distinct cores
+		for (size_t state = 0; state < stateCount; state++)
+			for (size_t index = 0; CompactItem& kernelItem : this->m_Kernels[state])
+				kernelItem = kernelItem.withLookaheads(this->m_Lookaheads.intern(lookaheads[offsets[state] + index++]));
+
+	}
+
+	/**
+	 * @brief Places the reductions called for by the closures of the LR(1) kernels of the states (with the LALR(1) lookaheads computed by _propagate_lookaheads()).
+	 * @details The closures are computed concurrently on the pool; the reductions are then placed state by state, so the conflicts are found in a reproducible order.
+	 * @param[in, out] table The table being constructed.
+	 * @param[in] pool The pool on which the closures are computed.
+	 */
+	template<typename GrammarT>
+	void LRTableBuilder<GrammarT>::_add_lookahead_reductions(TableType& table, const WorkStealingPool& pool)
+	{
+		std::vector<std::vector<std::pair<size_t, LookAheadSetType>>> reductions(this->m_Kernels.size());
+
+		pool.run(this->m_Kernels.size(), [&](size_t state, size_t worker) {
+			ClosureBuffers& buffers = this->m_Buffers[worker];
+			this->_closure(this->m_Kernels[state], true, buffers);
+
+			for (size_t i = 0; i < buffers.items.size(); i++)
+				if (this->_is_complete(buffers.items[i]))
+					reductions[state].emplace_back(buffers.items[i].prodIndex(), buffers.lookaheads[i]);
+			});
+
+		for (size_t state = 0; state < this->m_Kernels.size(); state++)
+			for (const auto& [prodIndex, lookaheads] : reductions[state])
+				this->_add_reductions(table, state, prodIndex, lookaheads, LRTableType::LTT_LALR1);
+	}
+
+	/**
+	 * @brief Gets the GOTO target of a state on a symbol, in the last constructed table. Unlike the table, this is not affected by conflict resolution.
+	 * @param[in] state The number of the state.
+	 * @param[in] symbol The grammar symbol (terminal or non-terminal).
+	 * @returns The number of the state GOTO(`state`, `symbol`); `SIZE_MAX` if there is no transition from `state` on `symbol`.
+	 */
+	template<typename GrammarT>
+	size_t LRTableBuilder<GrammarT>::getGoto(size_t state, const SymbolType& symbol) const
+	{
+		if (state >= this->m_Transitions.size())
+			return SIZE_MAX;
+
+		const auto& transitions = this->m_Transitions[state];
+		const uint32_t symbolIndex = (uint32_t)_symbol_index(symbol);
+		const auto it = std::lower_bound(transitions.begin(), transitions.end(), symbolIndex, [](const auto& transition, uint32_t index) {
+			return transition.first < index;
+			});
+
+		return (it != transitions.end() && it->first == symbolIndex) ? it->second : SIZE_MAX;
+	}
+
+	/**
+	 * @brief Gets the kernels of the states of the last constructed table, as ItemSet objects.
+	 * @details The items are expanded from the compact kernels of the builder on every call (see getKernels()), so every item holds a copy of its production.
+	 * @returns The kernels of the states, indexed by state number.
+	 */
+	template<typename GrammarT>
+	auto LRTableBuilder<GrammarT>::getStates() const -> std::vector<ItemSetType>
+	{
+		std::vector<ItemSetType> states;
+		states.reserve(this->m_Kernels.size());
+
+		for (const KernelType& kernel : this->m_Kernels) {
+			std::vector<ItemType> items;
+			items.reserve(kernel.size());
+
+			for (CompactItem item : kernel)
+				items.push_back(this->_to_item(item));
+
+			states.push_back(ItemSetType(std::move(items)));
+		}
+
+		return states;
+	}
+
+	/**
+	 * @brief Constructs an LR parsing table of the given type for the grammar of the builder.
+	 * @details The states and the conflicts found can be inspected afterwards via getStates() and getConflicts(). For LALR(1) tables, the kernels returned by getStates() carry the LALR(1) lookaheads.
+	 * @details With more than one thread, the closures of the states are computed concurrently (see _build_states()). The constructed table, the numbering of the states and the order of the conflicts do not depend on the number of threads.
+	 * @param[in] type The type of the table to be constructed.
+	 * @param[in] threadCount The maximum number of threads used for the construction. If `0`, the number of hardware threads is used. With `1` (the default), no thread is created.
+	 * @returns The constructed table. Its grammar is the grammar of the builder.
+	 * @throws std::logic_error If `type` is not a valid table type.
+	 */
+	template<typename GrammarT>
+	LRParsingTable<GrammarT> LRTableBuilder<GrammarT>::build(LRTableType type, size_t threadCount)
+	{
+		if ((size_t)type >= (size_t)LRTableType::LTT_COUNT) {
+			get_logger().log(LoggerInfo::ERR_INVALID_VAL, std::format("Invalid LR table type `{}`.", (size_t)type));
+			throw std::logic_error("Invalid LR table type.");
+		}
+
+		this->m_Kernels.clear();
+		this->m_KernelIndex.clear();
+		this->m_Transitions.clear();
+		this->m_Lookaheads.clear();
+		this->m_Conflicts.clear();
+
+		this->m_Grammar.calculateFIRST();
+		if (type == LRTableType::LTT_SLR1)
+			this->m_Grammar.calculateFOLLOW();
+
+		const WorkStealingPool pool{ threadCount };
+		this->m_Buffers.resize(pool.getThreadCount());
+
+		TableType table{ this->m_Grammar };
+		this->_build_states(table, type, pool);
+
+		// LALR(1): compute the lookaheads of the LR(0) kernels, then place the reductions called for by the closures of the resulting LR(1) kernels
+		if (type == LRTableType::LTT_LALR1) {
+			this->_propagate_lookaheads(pool);
+			this->_add_lookahead_reductions(table, pool);
+		}
+
+		table.reserveRows(this->m_Kernels.size());
+
+		if constexpr (TRACE_ENABLED)
+			get_logger().logDebug(std::format("Constructed {} table with {} states and {} conflicts.", toString(type), this->m_Kernels.size(), this->m_Conflicts.size()));
+
+		return table;
+	}
+
+}
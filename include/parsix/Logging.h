@@ -0,0 +1,15 @@
+#pragma once
+
+#include "utility/Logger.h"
+
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Gets the logger every parsix object logs through.
+	 * @details No parsix object holds a logger of its own (productions, production vectors, items and item sets are plain data, and copying them copies no logger state): every message is logged through the logger returned by `get_logger()`. By default, it is a process-wide, default-constructed Logger; a program installs its own with `set_logger()`.
+	 */
+	Logger& get_logger() noexcept(true);
+
+	void set_logger(Logger*) noexcept(true);
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief A read-only memory mapping of an entire file.
+	 * @details The file is mapped when the object is constructed and unmapped when it is destroyed; the pages are loaded lazily by the operating system, so mapping even a large file is O(1). The object is move-only, and moving it does not move the mapping, so pointers into the mapped data stay valid.
+	 */
+	class MappedFile {
+
+		/**
+		 * @brief The first byte of the mapping; `nullptr` if nothing is mapped.
+		 */
+		const std::byte* m_Data = nullptr;
+
+		/**
+		 * @brief The size of the file (and of the mapping), in bytes.
+		 */
+		size_t m_Size = 0;
+
+		/**
+		 * @brief Unmaps the file, if any.
+		 */
+		void _unmap() noexcept(true);
+
+	public:
+
+		/**
+		 * @brief Default constructor. Maps nothing.
+		 */
+		MappedFile() = default;
+
+		/**
+		 * @brief Maps a file.
+		 * @param[in] path The path of the file to be mapped.
+		 * @throws std::runtime_error If the file cannot be opened or mapped.
+		 */
+		explicit MappedFile(const std::filesystem::path& path);
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		MappedFile(MappedFile&& other) noexcept(true);
+		MappedFile& operator=(MappedFile&& other) noexcept(true);
+
+		~MappedFile() { this->_unmap(); }
+
+		/**
+		 * @brief Gets the first byte of the mapped file; `nullptr` if nothing is mapped.
+		 */
+		const std::byte* data() const noexcept(true) { return this->m_Data; }
+
+		/**
+		 * @brief Gets the size of the mapped file, in bytes.
+		 */
+		size_t size() const noexcept(true) { return this->m_Size; }
+
+	};
+
+}
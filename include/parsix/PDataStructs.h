@@ -1,8 +1,11 @@
 #pragma once
 
+#include "parsix/config.h"
 #include "parsix/enum.h"
 #include "parsix/production.h"
 #include "parsix/stack.h"
 #include "parsix/ptable.h"
+#include "parsix/LRCompressedTable.h"
+#include "parsix/StaticLRTable.h"
 #include "parsix/item.h"
 #include "parsix/exception.h"
@@ -0,0 +1,191 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "parsix/config.h"
+
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief The statistics of one or more parses: plain counters the parsers update as they go.
+	 * @details Attach an object to a parse context (through its `stats` member) to have the parses using the context update it. The counters accumulate over all of those parses, until `reset()` is called, so a single object may also aggregate the parses of a whole batch (one object per thread, combined with `merge()`).
+	 * @details The counters are only updated if the library is compiled with `PARSIX_STATS` (see config.h); otherwise, attaching an object has no effect.
+	 * @attention An object must not be updated by two parses at the same time.
+	 */
+	struct ParseStats {
+
+		/**
+		 * @brief The number of buckets of `stackDepthHistogram`.
+		 */
+		static constexpr size_t DEPTH_BUCKETS = 64;
+
+		/**
+		 * @brief The number of shifts (LR).
+		 */
+		uint64_t shifts = 0;
+
+		/**
+		 * @brief The number of reductions (LR).
+		 */
+		uint64_t reductions = 0;
+
+		/**
+		 * @brief The number of reductions by each production, indexed by the number of the production (LR). It only grows as large as the greatest production number reduced by.
+		 */
+		std::vector<uint64_t> reductionsByProduction;
+
+		/**
+		 * @brief The number of expansions of non-terminals (LL).
+		 */
+		uint64_t expansions = 0;
+
+		/**
+		 * @brief The number of terminals matched with the input (LL).
+		 */
+		uint64_t matches = 0;
+
+		/**
+		 * @brief The number of tokens the parser got from its lexical analyzer (or was fed), including the end of the input (`TEOF`) and the ones skipped by error recovery.
+		 */
+		uint64_t tokens = 0;
+
+		/**
+		 * @brief The maximum depth the parsing stack has reached.
+		 */
+		size_t maxStackDepth = 0;
+
+		/**
+		 * @brief The depth of the parsing stack after every push (LR) or expansion (LL), as a histogram with power-of-2 buckets: bucket `0` counts the depth `0` and bucket `i > 0` counts the depths in [2^(i - 1), 2^i).
+		 */
+		std::array<uint64_t, DEPTH_BUCKETS> stackDepthHistogram{};
+
+		/**
+		 * @brief The number of times error recovery was invoked.
+		 */
+		uint64_t errorRecoveries = 0;
+
+		/**
+		 * @brief The time spent in panic-mode error recovery, in nanoseconds.
+		 */
+		uint64_t panicModeNanoseconds = 0;
+
+		/**
+		 * @brief Resets all of the counters to zero, keeping the storage of `reductionsByProduction`.
+		 */
+		void reset() {
+			auto reductionsByProduction = std::move(this->reductionsByProduction);
+
+			*this = ParseStats{};
+			this->reductionsByProduction = std::move(reductionsByProduction);
+			std::ranges::fill(this->reductionsByProduction, 0);
+		}
+
+		/**
+		 * @brief Adds the counters of `other` to those of this object (and takes the greater of the maximum stack depths).
+		 */
+		void merge(const ParseStats& other) {
+			this->shifts += other.shifts;
+			this->reductions += other.reductions;
+			this->expansions += other.expansions;
+			this->matches += other.matches;
+			this->tokens += other.tokens;
+			this->maxStackDepth = std::max(this->maxStackDepth, other.maxStackDepth);
+			this->errorRecoveries += other.errorRecoveries;
+			this->panicModeNanoseconds += other.panicModeNanoseconds;
+
+			if (this->reductionsByProduction.size() < other.reductionsByProduction.size())
+				this->reductionsByProduction.resize(other.reductionsByProduction.size());
+
+			for (size_t i = 0; i < other.reductionsByProduction.size(); i++)
+				this->reductionsByProduction[i] += other.reductionsByProduction[i];
+
+			for (size_t i = 0; i < DEPTH_BUCKETS; i++)
+				this->stackDepthHistogram[i] += other.stackDepthHistogram[i];
+		}
+
+		// RECORDING FUNCTIONS (called by the parsers)
+		void recordShift() { this->shifts++; }
+		void recordExpansion() { this->expansions++; }
+		void recordMatch() { this->matches++; }
+		void recordToken() { this->tokens++; }
+		void recordErrorRecovery() { this->errorRecoveries++; }
+
+		void recordReduction(size_t prodNumber) {
+			this->reductions++;
+
+			if (prodNumber >= this->reductionsByProduction.size())
+				this->reductionsByProduction.resize(prodNumber + 1);
+
+			this->reductionsByProduction[prodNumber]++;
+		}
+
+		void recordStackDepth(size_t depth) {
+			this->maxStackDepth = std::max(this->maxStackDepth, depth);
+			this->stackDepthHistogram[std::min<size_t>(std::bit_width(depth), DEPTH_BUCKETS - 1)]++;
+		}
+
+		/**
+		 * @brief Measures the time spent in its scope (i.e., in panic mode) into `panicModeNanoseconds`; it does nothing if statistics are not collected.
+		 */
+		class PanicModeTimer {
+			ParseStats* m_Stats;
+			std::chrono::steady_clock::time_point m_Start{};
+
+		public:
+			explicit PanicModeTimer(ParseStats* stats) : m_Stats{ STATS_ENABLED ? stats : nullptr } {
+				if (this->m_Stats != nullptr)
+					this->m_Start = std::chrono::steady_clock::now();
+			}
+
+			PanicModeTimer(const PanicModeTimer&) = delete;
+			PanicModeTimer& operator=(const PanicModeTimer&) = delete;
+
+			~PanicModeTimer() {
+				if (this->m_Stats != nullptr)
+					this->m_Stats->panicModeNanoseconds += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->m_Start).count();
+			}
+		};
+
+		std::string toString() const {
+			std::string str = std::format("shifts: {}, reductions: {}, expansions: {}, matches: {}, tokens: {}, max stack depth: {}, error recoveries: {}, panic mode: {} ns",
+				this->shifts, this->reductions, this->expansions, this->matches, this->tokens, this->maxStackDepth, this->errorRecoveries, this->panicModeNanoseconds);
+
+			str += "\nreductions by production:";
+			for (size_t i = 0; i < this->reductionsByProduction.size(); i++)
+				if (this->reductionsByProduction[i] != 0)
+					str += std::format(" {}: {}", i, this->reductionsByProduction[i]);
+
+			str += "\nstack depth histogram:";
+			for (size_t i = 0; i < DEPTH_BUCKETS; i++)
+				if (this->stackDepthHistogram[i] != 0)
+					str += std::format(" [{}, {}): {}", i ? (uint64_t{ 1 } << (i - 1)) : 0, i ? (uint64_t{ 1 } << i) : 1, this->stackDepthHistogram[i]);
+
+			return str;
+		}
+
+		operator std::string() const {
+			return this->toString();
+		};
+	};
+
+	/**
+	 * @brief Calls the recording function `record` of `stats` with `args`, if statistics are collected (see `STATS_ENABLED`) and `stats` is not `nullptr`.
+	 * @details Compiles to nothing if statistics are not collected.
+	 */
+	template <typename RecordT, typename... ArgsT>
+	inline void record_stats(ParseStats* stats, RecordT record, ArgsT&&... args) {
+		if constexpr (STATS_ENABLED) {
+			if (stats != nullptr)
+				std::invoke(record, *stats, std::forward<ArgsT>(args)...);
+		}
+	}
+
+}
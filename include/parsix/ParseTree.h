@@ -0,0 +1,325 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <vector>
+
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief A node of a ParseTree: a production (an inner node) or a terminal (a leaf), with the span of its text.
+	 */
+	struct ParseTreeNode {
+
+		/**
+		 * @brief Set in `id` for a leaf.
+		 */
+		static constexpr uint32_t F_TERMINAL = uint32_t(1) << 31;
+
+		/**
+		 * @brief The number of the production of an inner node, or the value of the terminal of a leaf, ORed with F_TERMINAL.
+		 */
+		uint32_t id = 0;
+
+		/**
+		 * @brief The number of children of the node (that of the grammar symbols of the body of its production; `0` for a leaf and for an epsilon production).
+		 */
+		uint32_t childCount = 0;
+
+		/**
+		 * @brief The number of nodes of the subtree of the node, including itself; its first node is `subtreeSize - 1` nodes before it.
+		 */
+		uint32_t subtreeSize = 1;
+
+		/**
+		 * @brief The length of the text of the node, in bytes.
+		 */
+		uint32_t length = 0;
+
+		/**
+		 * @brief The offset of the first byte of the text of the node within the source.
+		 * @details Only tokens that refer to their text by offset (e.g., OffsetToken) give nodes a span; with other tokens, every span is empty.
+		 */
+		uint64_t offset = 0;
+
+		/**
+		 * @brief Checks whether the node is a leaf, i.e., a terminal.
+		 */
+		bool isTerminal() const noexcept(true) { return this->id & F_TERMINAL; }
+
+		/**
+		 * @brief Gets the number of the production of an inner node.
+		 */
+		uint32_t production() const noexcept(true) { return this->id; }
+
+		/**
+		 * @brief Gets the value of the terminal of a leaf.
+		 */
+		uint32_t terminal() const noexcept(true) { return this->id & ~F_TERMINAL; }
+
+		bool operator==(const ParseTreeNode&) const = default;
+	};
+
+	static_assert(sizeof(ParseTreeNode) == 24);
+
+	/**
+	 * @brief A concrete parse tree, stored as a single array of nodes in post-order (every node right after its subtree, and the root last).
+	 * @details Building the tree is appending to the array, with no allocation per node, and walking it is a linear scan of memory. A node finds its children through their subtree sizes: its last child is right before it, and every other child is right before the subtree of the next one (see `reversedChildren()`).
+		* Attach a tree to a parse context (through its `tree` member) to have the parses using the context build it (LRParser, LLParser); a GLR parse forest is extracted into one with `ParseForest::extractTree()`. The tree is cleared when the context is reset, keeping its storage, and a tree can be saved to and loaded from a stream (see `save()`).
+		* Trees are only built for inputs without errors: recovering from an error (or resuming a parse from reused subtrees, see `LRParser::pushSubtree()`) fails the tree (see `hasFailed()`).
+	 * @details The building functions are used by the parsers; an LR parser adds a leaf per shift and a node per reduction (see `addLeaf()` and `addNode()`), an LL parser a node per expansion and a leaf per match (see `expand()`).
+	 */
+	class ParseTree {
+
+		/**
+		 * @brief A production expanded by an LL parser whose node is pending until the symbols of its body are complete (see `expand()`).
+		 */
+		struct Pending {
+			uint32_t production = 0;
+			uint32_t symbolCount = 0;
+			uint32_t remaining = 0;
+		};
+
+		/**
+		 * @brief The nodes, in post-order.
+		 */
+		std::vector<ParseTreeNode> m_Nodes;
+
+		/**
+		 * @brief The indices of the nodes that do not have a parent yet (i.e., the roots of the subtrees of the stack of an LR parser), in order.
+		 */
+		std::vector<uint32_t> m_Roots;
+
+		/**
+		 * @brief The productions expanded by an LL parser whose nodes are pending.
+		 */
+		std::vector<Pending> m_Pending;
+
+		/**
+		 * @brief Whether building the tree has failed (see `fail()`).
+		 */
+		bool m_Failed = false;
+
+		void _add_node(uint32_t, uint32_t);
+
+		void _complete_symbol();
+
+	public:
+
+		/**
+		 * @brief An iterator over the children of a node, from the last to the first (the order in which post-order finds them in O(1): every child is right before the subtree of the next one).
+		 */
+		class ChildIterator {
+			const ParseTreeNode* m_Nodes = nullptr;
+			uint32_t m_Index = 0;
+			uint32_t m_Remaining = 0;
+
+		public:
+			using value_type = uint32_t;
+			using difference_type = std::ptrdiff_t;
+
+			ChildIterator() = default;
+
+			/**
+			 * @brief Constructs an iterator at the child at `index`, with `remaining` children left to visit (including it).
+			 */
+			ChildIterator(const ParseTreeNode* nodes, uint32_t index, uint32_t remaining) noexcept(true) : m_Nodes{ nodes }, m_Index{ index }, m_Remaining{ remaining } {}
+
+			/**
+			 * @brief Gets the index of the child.
+			 */
+			uint32_t operator*() const noexcept(true) { return this->m_Index; }
+
+			ChildIterator& operator++() noexcept(true) {
+				this->m_Index -= this->m_Nodes[this->m_Index].subtreeSize;
+				this->m_Remaining--;
+				return *this;
+			}
+
+			ChildIterator operator++(int) noexcept(true) {
+				ChildIterator old = *this;
+				++*this;
+				return old;
+			}
+
+			bool operator==(const ChildIterator& other) const noexcept(true) { return this->m_Remaining == other.m_Remaining; }
+		};
+
+		/**
+		 * @brief The children of a node, as a range of node indices, from the last to the first.
+		 */
+		struct ChildRange {
+			ChildIterator first, last;
+
+			ChildIterator begin() const noexcept(true) { return this->first; }
+			ChildIterator end() const noexcept(true) { return this->last; }
+		};
+
+		/**
+		 * @brief The header of a saved tree (see `save()`).
+		 * @details It is followed by the nodes, in the byte order of the machine that wrote them (which the header records, so a tree from a machine of another byte order is rejected rather than misread).
+		 * @note The version is increased whenever the format changes; trees of another version are rejected.
+		 */
+		struct FileHeader {
+
+			/**
+			 * @brief The first bytes of every saved tree.
+			 */
+			static constexpr std::array<char, 8> MAGIC{ 'P', 'A', 'R', 'S', 'I', 'X', 'P', 'T' };
+
+			/**
+			 * @brief A value whose bytes tell the byte order of the file.
+			 */
+			static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+			/**
+			 * @brief The current version of the format.
+			 */
+			static constexpr uint32_t VERSION = 1;
+
+			std::array<char, 8> magic = MAGIC;
+			uint32_t byteOrder = BYTE_ORDER_MARK;
+			uint32_t version = VERSION;
+			uint64_t nodeCount = 0;
+		};
+
+		static_assert(sizeof(FileHeader) == 24);
+
+		/**
+		 * @brief Default constructor. Constructs an empty tree.
+		 */
+		ParseTree() = default;
+
+		/**
+		 * @brief Removes all of the nodes (and clears the failure), keeping the storage.
+		 */
+		void clear() noexcept(true) {
+			this->m_Nodes.clear();
+			this->m_Roots.clear();
+			this->m_Pending.clear();
+			this->m_Failed = false;
+		}
+
+		/**
+		 * @brief Reserves storage for a number of nodes (e.g., about twice the number of tokens of the input).
+		 */
+		void reserve(size_t nodeCount) { this->m_Nodes.reserve(nodeCount); }
+
+		// BUILDING
+
+		/**
+		 * @brief Adds a leaf for a terminal, e.g., when an LR parser shifts it.
+		 * @param[in] terminal The value of the terminal.
+		 * @param[in] offset The offset of the text of the terminal.
+		 * @param[in] length The length of the text of the terminal.
+		 */
+		void addLeaf(uint32_t terminal, uint64_t offset = 0, uint32_t length = 0) {
+			if (this->m_Failed)
+				return;
+
+			this->m_Roots.push_back((uint32_t)this->m_Nodes.size());
+			this->m_Nodes.push_back(ParseTreeNode{ .id = terminal | ParseTreeNode::F_TERMINAL, .length = length, .offset = offset });
+
+			if (not this->m_Pending.empty())
+				this->_complete_symbol();
+		}
+
+		/**
+		 * @brief Adds a node for a production whose children are the last `childCount` subtrees without a parent, e.g., when an LR parser reduces by it.
+		 * @details The node spans the text of its children; a node without children has an empty span at the end of the node before it.
+		 */
+		void addNode(uint32_t production, uint32_t childCount) {
+			if (not this->m_Failed)
+				this->_add_node(production, childCount);
+		}
+
+		void expand(uint32_t production, uint32_t symbolCount);
+
+		/**
+		 * @brief Marks building the tree as failed (e.g., on a syntax error), and removes its nodes. Building functions are then ignored until the tree is cleared.
+		 */
+		void fail() noexcept(true) {
+			this->clear();
+			this->m_Failed = true;
+		}
+
+		// QUERYING
+
+		/**
+		 * @brief Checks whether building the tree has failed (see `fail()`).
+		 */
+		bool hasFailed() const noexcept(true) { return this->m_Failed; }
+
+		/**
+		 * @brief Checks whether the tree has no node.
+		 */
+		bool empty() const noexcept(true) { return this->m_Nodes.empty(); }
+
+		/**
+		 * @brief Gets the number of nodes of the tree.
+		 */
+		size_t size() const noexcept(true) { return this->m_Nodes.size(); }
+
+		/**
+		 * @brief Gets the nodes of the tree, in post-order.
+		 */
+		std::span<const ParseTreeNode> nodes() const noexcept(true) { return this->m_Nodes; }
+
+		/**
+		 * @brief Gets the node at `index`. No boundary-checking.
+		 */
+		const ParseTreeNode& operator[](size_t index) const noexcept(true) { return this->m_Nodes[index]; }
+
+		/**
+		 * @brief Gets the index of the root, i.e., of the last node. The tree must not be empty.
+		 * @details After a complete parse, the root is the node of the start symbol (the augmented production of an LR grammar is not part of the tree).
+		 */
+		uint32_t root() const noexcept(true) { return (uint32_t)this->m_Nodes.size() - 1; }
+
+		/**
+		 * @brief Gets the children of the node at `index`, from the last to the first (use `evaluate()` to visit them in order).
+		 */
+		ChildRange reversedChildren(uint32_t index) const noexcept(true) {
+			const uint32_t count = this->m_Nodes[index].childCount;
+
+			return { ChildIterator{ this->m_Nodes.data(), index - 1, count }, ChildIterator{ this->m_Nodes.data(), 0, 0 } };
+		}
+
+		auto begin() const noexcept(true) { return this->m_Nodes.begin(); }
+		auto end() const noexcept(true) { return this->m_Nodes.end(); }
+
+		/**
+		 * @brief Computes a value for every node bottom-up, in a single linear pass over the nodes, and returns that of the root.
+		 * @details This is how a tree is evaluated (e.g., into an AST) without recursion: the values of the subtrees are kept on a stack, and those of the children of a node are on top of it when the node is visited.
+		 * @param[in] visit A callable taking the node (`const ParseTreeNode&`) and the values of its children (`std::span<ValueT>`, in order), and returning the value of the node.
+		 * @attention The tree must not be empty, and must hold a single complete tree (e.g., after an accepted parse, or as returned by `load()`).
+		 * @tparam ValueT The type of a value; it need only be move-constructible.
+		 */
+		template <typename ValueT, typename VisitFnT>
+		ValueT evaluate(VisitFnT&& visit) const {
+			std::vector<ValueT> values;
+
+			for (const ParseTreeNode& node : this->m_Nodes) {
+				const size_t first = values.size() - node.childCount;
+				ValueT value = visit(node, std::span<ValueT>{ values.data() + first, node.childCount });
+
+				values.erase(values.begin() + first, values.end());
+				values.push_back(std::move(value));
+			}
+
+			return std::move(values.back());
+		}
+
+		// SERIALIZATION
+
+		void save(std::ostream&) const;
+
+		static ParseTree load(std::istream&);
+
+		bool operator==(const ParseTree& other) const noexcept(true) { return this->m_Nodes == other.m_Nodes; }
+
+	};
+
+}
@@ -0,0 +1,376 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <format>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "lexana/LexicalAnalyzer.h"
+
+// DECLARATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief A TokenBuffer whose lexical analyzer runs on a thread of its own: the producer thread lexes batches of tokens into a lock-free single-producer single-consumer ring of batches, from which the parser consumes the tokens (by index) on its own thread.
+	 * @details It has the consumer interface of TokenBuffer (`getNextToken()`, `peak()`, `peak(k)`, `at()`, the position functions), so it can be the `LexicalAnalyzerT` of the parsers. Lexing and parsing thus overlap, which pays off on large inputs when a core is spare; the producer gets ahead of the parser by at most a ring of batches, and waits for the parser to release a batch (by consuming all of its tokens) before it lexes the next one.
+		* The lexical analyzer is used by the producer thread only, from the construction of the buffer until it lexes `TEOF` (or throws), or until the buffer is destroyed. Hence, `getSourceCode()` is empty until lexing is done, and there is no `text()`: the text of a token has to be got from the source by its offset (see OffsetToken).
+		* An exception thrown by the lexical analyzer is rethrown to the parser when it reaches the token that could not be lexed, as with TokenBuffer.
+	 * @attention `at(k)` may only look ahead as far as the ring lets the producer go (see `maxLookahead()`); it throws `std::out_of_range` beyond that.
+	 * @tparam LexicalAnalyzerT The type of the wrapped lexical analyzer.
+	 */
+	template <typename LexicalAnalyzerT>
+	class PipelinedTokenBuffer {
+
+		/**
+		 * @brief Aliases the type of a token.
+		 */
+		using TokenType = decltype(LexicalAnalyzerT{}.getNextToken());
+
+		/**
+		 * @brief Aliases the type of a position (a line and a column, both starting at 1).
+		 */
+		using PositionType = std::pair<size_t, size_t>;
+
+		/**
+		 * @brief A batch of consecutive tokens and the positions after them. Batch `b` holds the tokens `b * batchSize()` on.
+		 */
+		struct Batch {
+			std::vector<TokenType> tokens;
+			std::vector<PositionType> positions;
+
+			/**
+			 * @brief The number of tokens in the batch; it is `batchSize()` for all but the last batch.
+			 */
+			size_t count = 0;
+
+			/**
+			 * @brief The exception the lexical analyzer threw for the token after the last one of the batch, if any (then, it is the last batch).
+			 */
+			std::exception_ptr error;
+		};
+
+		/**
+		 * @brief Marks that the last batch is not known yet (see `m_LastBatch`).
+		 */
+		static constexpr uint64_t NO_BATCH = UINT64_MAX;
+
+		/**
+		 * @brief The wrapped lexical analyzer (used by the producer thread only).
+		 */
+		LexicalAnalyzerT* mp_LexicalAnalyzer = nullptr;
+
+		/**
+		 * @brief The flags every token is lexed with (see `lexana::LA_FLAG`).
+		 */
+		unsigned m_Flags = (unsigned)lexana::LA_FLAG::LAF_ALLOW_WHITE_SPACE_CHARS;
+
+		/**
+		 * @brief The binary logarithm of the number of tokens of a batch.
+		 */
+		unsigned m_BatchShift = 0;
+
+		/**
+		 * @brief The ring of batches; batch `b` is in slot `b & m_RingMask`.
+		 */
+		std::unique_ptr<Batch[]> m_Batches;
+		size_t m_RingMask = 0;
+
+		// SHARED STATE (each counter is written by one thread only, and is on a cache line of its own)
+
+		/**
+		 * @brief The number of batches published by the producer, and the number of batches released by the consumer.
+		 */
+		alignas(64) std::atomic<uint64_t> m_Produced{ 0 };
+		alignas(64) std::atomic<uint64_t> m_Released{ 0 };
+
+		/**
+		 * @brief The number of the last batch, once the producer has lexed it (`NO_BATCH` before that); it is stored before that batch is published.
+		 */
+		std::atomic<uint64_t> m_LastBatch{ NO_BATCH };
+
+		/**
+		 * @brief Set (before `m_Released` is changed) to make the producer stop.
+		 */
+		std::atomic<bool> m_Stop{ false };
+
+		// CONSUMER STATE
+
+		/**
+		 * @brief The index of the next token to be consumed.
+		 */
+		alignas(64) uint64_t m_Next = 0;
+
+		/**
+		 * @brief The number of batches known by the consumer to be published (a cache of `m_Produced`), and the number of batches it has released.
+		 */
+		uint64_t m_KnownProduced = 0, m_KnownReleased = 0;
+
+		/**
+		 * @brief The position after the last consumed token.
+		 */
+		PositionType m_Position{ 1, 1 };
+
+		/**
+		 * @brief The producer thread; it is last so that it is started once everything else is initialized.
+		 */
+		std::jthread m_Producer;
+
+		void _produce();
+		uint64_t _acquire(uint64_t batch);
+
+		size_t _batch_size() const noexcept(true) { return size_t(1) << this->m_BatchShift; }
+		const Batch& _batch(uint64_t batch) const noexcept(true) { return this->m_Batches[(size_t)batch & this->m_RingMask]; }
+
+	public:
+
+		/**
+		 * @brief The default number of tokens of a batch.
+		 */
+		static constexpr size_t DEFAULT_BATCH_SIZE = 1024;
+
+		/**
+		 * @brief The default number of batches of the ring.
+		 */
+		static constexpr size_t DEFAULT_BATCH_COUNT = 8;
+
+		/**
+		 * @brief Default constructor. The buffer wraps no lexical analyzer and runs no thread; it must not be used.
+		 */
+		PipelinedTokenBuffer() = default;
+
+		/**
+		 * @brief Constructs a buffer over a lexical analyzer and starts lexing it on the producer thread. The lexical analyzer must outlive the buffer and must not be used but through it.
+		 * @param[in] lexer The lexical analyzer.
+		 * @param[in] batchSize The number of tokens of a batch; it is rounded up to a power of 2.
+		 * @param[in] batchCount The number of batches of the ring (at least 2); it is rounded up to a power of 2.
+		 * @param[in] flags The flags every token is lexed with (see `lexana::LA_FLAG`); by default, the ones the parsers use.
+		 */
+		explicit PipelinedTokenBuffer(LexicalAnalyzerT& lexer, size_t batchSize = DEFAULT_BATCH_SIZE, size_t batchCount = DEFAULT_BATCH_COUNT, unsigned flags = (unsigned)lexana::LA_FLAG::LAF_ALLOW_WHITE_SPACE_CHARS) :
+			mp_LexicalAnalyzer{ &lexer },
+			m_Flags{ flags },
+			m_BatchShift{ (unsigned)std::countr_zero(std::bit_ceil(std::max<size_t>(batchSize, 1))) },
+			m_Batches{ std::make_unique<Batch[]>(std::bit_ceil(std::max<size_t>(batchCount, 2))) },
+			m_RingMask{ std::bit_ceil(std::max<size_t>(batchCount, 2)) - 1 },
+			m_Position{ lexer.getPosition() }
+		{
+			for (size_t i = 0; i <= this->m_RingMask; i++) {
+				this->m_Batches[i].tokens.resize(this->_batch_size());
+				this->m_Batches[i].positions.resize(this->_batch_size());
+			}
+
+			this->m_Producer = std::jthread{ [this] { this->_produce(); } };
+		}
+
+		PipelinedTokenBuffer(const PipelinedTokenBuffer&) = delete;
+		PipelinedTokenBuffer& operator=(const PipelinedTokenBuffer&) = delete;
+
+		/**
+		 * @brief Stops the producer thread (after the batch it is lexing, if any) and joins it.
+		 */
+		~PipelinedTokenBuffer() {
+			if (not this->m_Producer.joinable())
+				return;
+
+			this->m_Stop.store(true);
+			this->m_Released.fetch_add(1);
+			this->m_Released.notify_one();
+		}
+
+		/**
+		 * @brief Gets the token `k` tokens past the next one to be consumed (`at(0)` is the next one), waiting for the producer to lex up to it if needed.
+		 * @details The reference is invalidated by the next call to any non-const function. Past `TEOF`, it is `TEOF`.
+		 * @throws std::out_of_range If `k` is greater than `maxLookahead()`.
+		 * @throws Whatever the lexical analyzer throws for one of the tokens up to it.
+		 */
+		const TokenType& at(size_t k) {
+			const uint64_t index = this->m_Next + k;
+			uint64_t batch = index >> this->m_BatchShift;
+			size_t slot = (size_t)index & (this->_batch_size() - 1);
+
+			if (batch >= this->m_KnownProduced) [[unlikely]] {
+				// past the last batch, the token is past its last one
+				if (const uint64_t acquired = this->_acquire(batch); acquired != batch) {
+					batch = acquired;
+					slot = this->_batch_size();
+				}
+			}
+
+			const Batch& current = this->_batch(batch);
+
+			if (slot >= current.count) [[unlikely]] {
+				if (current.error)
+					std::rethrow_exception(current.error);
+
+				// the last token of the last batch is `TEOF`
+				return current.tokens[current.count - 1];
+			}
+
+			return current.tokens[slot];
+		}
+
+		/**
+		 * @brief Gets the next token and consumes it; past `TEOF`, it is `TEOF`.
+		 * @param[in] flags Ignored (the flags are given to the constructor); it is there for interface compatibility with the lexical analyzers of lexana.
+		 * @throws Whatever the lexical analyzer throws for it.
+		 */
+		TokenType getNextToken(unsigned flags = 0) {
+			(void)flags;
+
+			const TokenType token = this->at(0);
+			this->m_Position = this->_batch(this->m_Next >> this->m_BatchShift).positions[(size_t)this->m_Next & (this->_batch_size() - 1)];
+
+			// `TEOF` is never consumed, so that it is returned forever (and its batch is never released)
+			if (token.name == TokenType::TEOF.name)
+				return token;
+
+			// release the batch once all of its tokens are consumed
+			if ((++this->m_Next & (this->_batch_size() - 1)) == 0) {
+				this->m_Released.store(++this->m_KnownReleased, std::memory_order_release);
+				this->m_Released.notify_one();
+			}
+
+			return token;
+		}
+
+		/**
+		 * @brief Gets the next token without consuming it.
+		 */
+		TokenType peak() { return this->at(0); }
+
+		/**
+		 * @brief Gets the token `k` tokens past the next one without consuming anything (`peak(0)` is `peak()`).
+		 */
+		TokenType peak(size_t k) { return this->at(k); }
+
+		/**
+		 * @brief Gets the greatest `k` for which `at(k)` is allowed: the tokens up to it are never more than a ring of batches past the first unreleased one.
+		 */
+		size_t maxLookahead() const noexcept(true) {
+			return ((this->m_RingMask + 1) << this->m_BatchShift) - 1 - (size_t)(this->m_Next & (this->_batch_size() - 1));
+		}
+
+		/**
+		 * @brief Gets the index of the next token to be consumed, i.e., the number of tokens consumed so far.
+		 */
+		uint64_t index() const noexcept(true) { return this->m_Next; }
+
+		/**
+		 * @brief Gets the source code of the lexical analyzer once it has lexed its last token; before that, it is empty, since the lexical analyzer is in use by the producer thread.
+		 */
+		std::string_view getSourceCode() const {
+			if (this->m_LastBatch.load(std::memory_order_acquire) == NO_BATCH)
+				return {};
+
+			return this->mp_LexicalAnalyzer->getSourceCode();
+		}
+
+		/**
+		 * @brief Gets the position after the last consumed token (before the first token, if none is consumed yet).
+		 */
+		PositionType getPosition() const noexcept(true) { return this->m_Position; }
+
+		size_t getLine() const noexcept(true) { return this->m_Position.first; }
+		size_t getCol() const noexcept(true) { return this->m_Position.second; }
+
+	};
+
+}
+
+// IMPLEMENTATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief The body of the producer thread: lexes one batch after the other into the ring, waiting for a free slot before each, until it lexes `TEOF`, the lexical analyzer throws or the buffer is destroyed.
+	 */
+	template <typename LexicalAnalyzerT>
+	void PipelinedTokenBuffer<LexicalAnalyzerT>::_produce()
+	{
+		LexicalAnalyzerT& lexer = *this->mp_LexicalAnalyzer;
+		const size_t batchSize = this->_batch_size();
+		const uint64_t ringSize = this->m_RingMask + 1;
+
+		for (uint64_t number = 0; ; number++) {
+			// wait for the consumer to release the batch that was in the slot
+			for (uint64_t released = this->m_Released.load(std::memory_order_acquire); number - released >= ringSize; released = this->m_Released.load(std::memory_order_acquire)) {
+				if (this->m_Stop.load())
+					return;
+
+				this->m_Released.wait(released, std::memory_order_acquire);
+			}
+
+			if (this->m_Stop.load())
+				return;
+
+			Batch& batch = this->m_Batches[(size_t)number & this->m_RingMask];
+			batch.count = 0;
+			batch.error = nullptr;
+
+			bool last = false;
+
+			while (batch.count < batchSize) {
+				try {
+					batch.tokens[batch.count] = lexer.getNextToken(this->m_Flags);
+				}
+				catch (...) {
+					batch.error = std::current_exception();
+					last = true;
+					break;
+				}
+
+				batch.positions[batch.count] = lexer.getPosition();
+
+				if (batch.tokens[batch.count++].name == TokenType::TEOF.name) {
+					last = true;
+					break;
+				}
+			}
+
+			if (last)
+				this->m_LastBatch.store(number, std::memory_order_release);
+
+			this->m_Produced.store(number + 1, std::memory_order_release);
+			this->m_Produced.notify_one();
+
+			if (last)
+				return;
+		}
+	}
+
+	/**
+	 * @brief Waits for the producer to publish batch `batch` (or the last batch, if it comes before).
+	 * @returns `batch`, or the number of the last batch if it comes before `batch`.
+	 * @throws std::out_of_range If `batch` is a ring of batches or more past the first unreleased one (the producer could never publish it).
+	 */
+	template <typename LexicalAnalyzerT>
+	uint64_t PipelinedTokenBuffer<LexicalAnalyzerT>::_acquire(uint64_t batch)
+	{
+		if (batch - this->m_KnownReleased > this->m_RingMask) {
+			// the last batch may already be known, in which case there is nothing to wait for
+			if (const uint64_t lastBatch = this->m_LastBatch.load(std::memory_order_acquire); lastBatch < batch)
+				return this->_acquire(lastBatch);
+
+			throw std::out_of_range(std::format("Cannot look ahead past {} tokens.", this->maxLookahead()));
+		}
+
+		while (batch >= this->m_KnownProduced) {
+			// the last batch is published right after `m_LastBatch` is stored
+			if (const uint64_t lastBatch = this->m_LastBatch.load(std::memory_order_acquire); lastBatch < batch) {
+				batch = lastBatch;
+				continue;
+			}
+
+			this->m_Produced.wait(this->m_KnownProduced, std::memory_order_acquire);
+			this->m_KnownProduced = this->m_Produced.load(std::memory_order_acquire);
+		}
+
+		return batch;
+	}
+
+}
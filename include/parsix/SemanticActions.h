@@ -0,0 +1,127 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Selects the default, dynamic dispatch of semantic actions: the action of a production is the function whose address is stored in its `postfixAction` field (as a `void*`).
+	 */
+	struct DynamicActions {};
+
+	/**
+	 * @brief A placeholder within an LRActionTable for a production that has no action.
+	 */
+	struct NoAction {};
+
+	/**
+	 * @brief A compile-time table of the semantic actions of the productions of a grammar, to be used by an LRParser instead of the `postfixAction` fields of the productions.
+	 * @details The action at index `i` is the action of production number `i`; productions whose number is not less than the number of actions have no action. Every action is a callable (function, lambda, function object) that is called directly, i.e., its type is known at compile time and the call can be inlined.
+		* The action of a production that is reduced is called with `(StackType& stack, StateT& newState)`.
+		* The action of production 0 (the augmented start production) is called on acceptance with `(StackType& stack, StateT& newState, ParserResultT& result)`.
+		* NoAction means "no action".
+	 * The signatures are checked at compile time: an action that cannot be called with the arguments above is a compilation error instead of a crash.
+	 * @tparam ActionTs The types of the actions.
+	 */
+	template <typename... ActionTs>
+	class LRActionTable {
+
+		/**
+		 * @brief The actions, indexed by production number.
+		 */
+		std::tuple<ActionTs...> m_Actions;
+
+		/**
+		 * @brief Calls the reduction action of production `I` (if any).
+		 */
+		template <size_t I, typename StackT, typename StateT>
+		void _call_reduce(StackT& stack, StateT& newState) const {
+			using ActionType = std::tuple_element_t<I, std::tuple<ActionTs...>>;
+
+			if constexpr (std::is_same_v<ActionType, NoAction>)
+				return;
+			else if constexpr (I == 0)
+				return; // production 0 is never reduced; its action runs on acceptance
+			else {
+				static_assert(std::is_invocable_v<const ActionType&, StackT&, StateT&>, "A reduction action must be callable with (StackType&, StateT&).");
+
+				std::invoke(std::get<I>(this->m_Actions), stack, newState);
+			}
+		}
+
+		template <size_t... Is, typename StackT, typename StateT>
+		void _reduce(std::index_sequence<Is...>, size_t prodNumber, StackT& stack, StateT& newState) const {
+			// expands to a chain of comparisons against constants, which the compiler turns into a switch
+			(void)((prodNumber == Is && (this->_call_reduce<Is>(stack, newState), true)) || ...);
+		}
+
+	public:
+
+		/**
+		 * @brief The number of actions (including NoAction placeholders) in the table.
+		 */
+		static constexpr size_t ACTION_COUNT = sizeof...(ActionTs);
+
+		/**
+		 * @brief Default constructor. Default-constructs every action.
+		 */
+		constexpr LRActionTable() = default;
+
+		/**
+		 * @brief Constructs the table from the actions of the productions, in production-number order. A table without actions is default-constructed.
+		 */
+		constexpr explicit LRActionTable(ActionTs... actions) requires (sizeof...(ActionTs) > 0) : m_Actions{ std::move(actions)... } {}
+
+		/**
+		 * @brief Calls the action of production `prodNumber`, which has just been reduced (if it has an action).
+		 * @param[in] prodNumber The number of the reduced production.
+		 * @param[in, out] stack The parsing stack. The states of the body of the production are still on top of it.
+		 * @param[out] newState The state that is to be pushed on the stack for the head of the production.
+		 */
+		template <typename StackT, typename StateT>
+		void reduce(size_t prodNumber, StackT& stack, StateT& newState) const {
+			this->_reduce(std::index_sequence_for<ActionTs...>{}, prodNumber, stack, newState);
+		}
+
+		/**
+		 * @brief Calls the action of production `ProdNumber`, which has just been reduced (if it has an action). Unlike `reduce()`, the production is known at compile time, so there is no dispatch at all (this is what generated parsers call; see LRCodeGenerator).
+		 * @param[in, out] stack The parsing stack. The states of the body of the production are still on top of it.
+		 * @param[out] newState The state that is to be pushed on the stack for the head of the production.
+		 */
+		template <size_t ProdNumber, typename StackT, typename StateT>
+		void reduceProduction(StackT& stack, StateT& newState) const {
+			if constexpr (ProdNumber < ACTION_COUNT)
+				this->_call_reduce<ProdNumber>(stack, newState);
+		}
+
+		/**
+		 * @brief Calls the action of production 0 on acceptance (if it has an action).
+		 * @returns `true` if production 0 has an action; `false` otherwise.
+		 */
+		template <typename StackT, typename StateT, typename ParserResultT>
+		bool accept(StackT& stack, StateT& newState, ParserResultT& result) const {
+			if constexpr (ACTION_COUNT == 0)
+				return false;
+			else {
+				using ActionType = std::tuple_element_t<0, std::tuple<ActionTs...>>;
+
+				if constexpr (std::is_same_v<ActionType, NoAction>)
+					return false;
+				else {
+					static_assert(std::is_invocable_v<const ActionType&, StackT&, StateT&, ParserResultT&>, "The action of production 0 must be callable with (StackType&, StateT&, ParserResultT&).");
+
+					std::invoke(std::get<0>(this->m_Actions), stack, newState, result);
+					return true;
+				}
+			}
+		}
+
+	};
+
+	template <typename... ActionTs>
+	LRActionTable(ActionTs...) -> LRActionTable<ActionTs...>;
+
+}
@@ -0,0 +1,359 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "parsix/parser.h"
+#include "parsix/WorkStealingPool.h"
+
+// DECLARATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Parses a single (huge) input in parallel with an LRParser, by parsing chunks of its tokens speculatively and stitching their stacks together.
+	 * @details The parse is first warmed up sequentially over the first few delimiter tokens chosen by the user (e.g., the end of a record of a log): after each of them (once the reductions on the token after it are taken), the stack is a candidate for the guess of the stack a chunk starts on, and the shallowest one is kept, along with the terminals just before it. Then, the rest of the tokens is split into chunks, one per worker, each beginning right after a delimiter preceded by the same terminals if there is one close enough (or else right after any delimiter), since the state of an LR parser mostly depends on its recent input. Every chunk but the first is parsed from the guess, with default-constructed data standing in for the states of the guess, while the first chunk is parsed for real.
+		* Then, chunk after chunk, the guess is checked against the real stack at the start of the chunk: the LR automaton only looks at the numbers of the states, so if they are the same, the stack the chunk ended with is exactly the one a sequential parse would reach, except for the data of the state the chunk reduced the top of the guess to. That state is given its real data by the user's merge function (see `parse()`), and the rest of the stack of the chunk is taken as is. If the guess is wrong, or the chunk failed, the chunk is parsed again sequentially on the real stack. Hence, the result is always the one of a sequential parse (with the same error on an invalid input); only the speed depends on how good the delimiters are.
+		* A good delimiter is one after which the parse is always in the same configuration, e.g., the terminator of the items of a top-level list (a left-recursive list keeps the stack shallow, so that only the state of the list itself is reduced out of the guess).
+	 * @attention Semantic actions run concurrently, and also on the default-constructed data of the states of the guess (e.g., null pointers), which they must tolerate; an exception they throw while parsing a chunk speculatively just has the chunk parsed again.
+	 * @tparam ParserT The type of the parser; an LRParser. It should have been constructed with a prepared, shared table (see `LRParser::prepareTable()`), so that copying it is cheap.
+	 */
+	template <typename ParserT>
+	class SpeculativeParser {
+
+		/**
+		 * @brief Aliases the type of the parse context of the parser.
+		 */
+		using ParseContextType = typename ParserT::ParseContext;
+
+		/**
+		 * @brief Aliases the type of an LR parsing state.
+		 */
+		using StateType = typename decltype(ParseContextType{}.stack)::value_type;
+
+		/**
+		 * @brief Aliases the type of a token.
+		 */
+		using TokenType = decltype(ParseContextType{}.currInputToken);
+
+		/**
+		 * @brief Aliases the type of a terminal.
+		 */
+		using TerminalType = decltype(TokenType{}.name);
+
+		/**
+		 * @brief The parser used for every chunk.
+		 */
+		ParserT m_Parser;
+
+		/**
+		 * @brief Whether every terminal is a delimiter, indexed by the value of its enumerator.
+		 */
+		std::vector<bool> m_IsDelimiter;
+
+		/**
+		 * @brief The pool on which the chunks are parsed.
+		 */
+		WorkStealingPool m_Pool;
+
+		/**
+		 * @brief The number of chunks an input is split into (at most).
+		 */
+		size_t m_ChunkCount = 0;
+
+		bool _is_delimiter(const TokenType& token) const noexcept(true) {
+			const size_t terminal = (size_t)token.name;
+
+			return terminal < this->m_IsDelimiter.size() && this->m_IsDelimiter[terminal];
+		}
+
+		std::vector<size_t> _split(std::span<const TokenType>, size_t, size_t, std::span<const TokenType>) const;
+
+	public:
+
+		/**
+		 * @brief The minimum number of tokens of a chunk; smaller inputs are split into fewer chunks.
+		 */
+		static constexpr size_t MIN_CHUNK_TOKENS = 1024;
+
+		/**
+		 * @brief The maximum number of delimiters the parse is warmed up over to find the guess.
+		 */
+		static constexpr size_t WARM_UP_DELIMITERS = 64;
+
+		/**
+		 * @brief The number of terminals (up to the delimiter) that should precede a chunk as they precede the guess.
+		 */
+		static constexpr size_t CONTEXT_TOKENS = 3;
+
+		/**
+		 * @brief The contexts of a speculative parse, one per chunk, and what it did.
+		 * @details Whatever the semantic actions allocate from the arena lives in the arena of the context of the chunk it was allocated for, so the result of a parse must not outlive its context (or its reuse by the next parse).
+		 */
+		struct ParseContext {
+
+			/**
+			 * @brief The contexts of the chunks; that of the first chunk is the context of the real parse. Their storage is kept between parses.
+			 */
+			std::vector<ParseContextType> chunks;
+
+			/**
+			 * @brief The number of chunks of the last parse.
+			 */
+			size_t chunkCount = 0;
+
+			/**
+			 * @brief The number of chunks of the last parse that had to be parsed again sequentially.
+			 */
+			size_t reparsedChunks = 0;
+		};
+
+		/**
+		 * @brief The merge function used by default: it leaves the states reduced out of the guess with the data the chunk gave them, for parses whose data does not depend on those states (e.g., only recognizing the input).
+		 */
+		struct NoMerge {
+			void operator()(std::span<const StateType>, StateType&) const noexcept(true) {}
+		};
+
+		/**
+		 * @brief Constructs a speculative parser.
+		 * @param[in] parser The parser used for every chunk. It is copied; the copy shares the table of `parser`.
+		 * @param[in] delimiters The terminals after which an input may be split.
+		 * @param[in] threadCount The maximum number of worker threads. If `0`, the number of hardware threads is used.
+		 * @param[in] chunkCount The maximum number of chunks an input is split into. If `0`, it is the number of worker threads.
+		 */
+		SpeculativeParser(const ParserT& parser, std::initializer_list<TerminalType> delimiters, size_t threadCount = 0, size_t chunkCount = 0) :
+			m_Parser{ parser }, m_Pool{ threadCount }
+		{
+			this->m_ChunkCount = chunkCount ? chunkCount : this->m_Pool.getThreadCount();
+
+			for (const TerminalType delimiter : delimiters) {
+				if ((size_t)delimiter >= this->m_IsDelimiter.size())
+					this->m_IsDelimiter.resize((size_t)delimiter + 1);
+
+				this->m_IsDelimiter[(size_t)delimiter] = true;
+			}
+		}
+
+		/**
+		 * @brief Gets the maximum number of worker threads used to parse an input.
+		 */
+		size_t getThreadCount() const { return this->m_Pool.getThreadCount(); }
+
+		template <typename ParserResultT = ParserResult, typename MergeFnT = NoMerge>
+		ParserResultT parse(ParseContext&, std::span<const TokenType>, const ParserResultT& = ParserResultT{}, MergeFnT&& = MergeFnT{}) const;
+
+	};
+
+}
+
+// IMPLEMENTATION
+namespace m0st4fa::parsix {
+
+
+	/**
+	 * @brief Splits tokens into chunks, each beginning right after a delimiter, as evenly as the delimiters allow.
+	 * @param[in] tokens The tokens, ending with `TEOF`.
+	 * @param[in] chunkCount The maximum number of chunks.
+	 * @param[in] begin The index before which no chunk but the first may begin.
+	 * @param[in] context The tokens a chunk should preferably begin right after (the last of which is a delimiter).
+	 * @returns The index of the first token of every chunk, followed by that of `TEOF`; the first chunk begins at `0`, and no chunk is empty.
+	 */
+	template <typename ParserT>
+	std::vector<size_t> SpeculativeParser<ParserT>::_split(std::span<const TokenType> tokens, size_t chunkCount, size_t begin, std::span<const TokenType> context) const
+	{
+		const size_t end = tokens.size() - 1;
+
+		const auto inContext = [&](size_t index) {
+			return index >= context.size() && std::ranges::equal(tokens.subspan(index - context.size(), context.size()), context, {}, &TokenType::name, &TokenType::name);
+		};
+
+		std::vector<size_t> bounds{ 0 };
+
+		for (size_t chunk = 1; chunk < chunkCount; chunk++) {
+			const size_t next = (chunk + 1) * end / chunkCount;
+			size_t index = std::max({ chunk * end / chunkCount, bounds.back() + 1, begin });
+			size_t fallback = end;
+
+			// a chunk begins right after a delimiter, preferably in the context of the guess, and before the next chunk would
+			for (; index < end; index++) {
+				if (not this->_is_delimiter(tokens[index - 1]))
+					continue;
+
+				if (inContext(index))
+					break;
+
+				fallback = std::min(fallback, index);
+
+				if (index >= next)
+					break;
+			}
+
+			if (index >= end || (index >= next && fallback < index))
+				index = fallback;
+
+			// the last chunk must not be empty
+			if (index >= end)
+				break;
+
+			bounds.push_back(index);
+		}
+
+		bounds.push_back(end);
+
+		return bounds;
+	}
+
+	/**
+	 * @brief Parses tokens, splitting them into chunks that are parsed in parallel (see the class documentation).
+	 *
+	 * @tparam MergeFnT The type of the merge function.
+	 * @param[in, out] ctx The contexts of the parse. They are reset first (keeping their storage).
+	 * @param[in] tokens The tokens of the input, ending with `TEOF` (e.g., as gathered from a lexical analyzer beforehand).
+	 * @param[in] initResult The initial result of the parse, given to the action of production 0 on acceptance.
+	 * @param[in] merge A callable taking the real states that a chunk was parsed on in place of its guess and that it reduced (`std::span<const StateType>`), and the state it reduced them (and what it parsed after them) to (`StateType&`), whose data it must fix up to be what it would have been had the real states been reduced. E.g., for a list whose data is the sum of its items, the value of the first real state (the list) is added to that of the reduced state. The span of the text of the reduced state (see OffsetToken) is fixed up beforehand.
+	 *
+	 * @returns The result of the parse.
+	 * @throws std::invalid_argument If `tokens` does not end with `TEOF`.
+	 * @throws std::logic_error As `LRParser::feed()`; the error is the same as that of a sequential parse.
+	 */
+	template <typename ParserT>
+	template <typename ParserResultT, typename MergeFnT>
+	ParserResultT SpeculativeParser<ParserT>::parse(ParseContext& ctx, std::span<const TokenType> tokens, const ParserResultT& initResult, MergeFnT&& merge) const
+	{
+		if (tokens.empty() || tokens.back().name != TokenType::TEOF.name)
+			throw std::invalid_argument("The tokens given to the speculative parser must end with `TEOF`.");
+
+		const size_t end = tokens.size() - 1;
+		const size_t maxChunkCount = std::max<size_t>(std::min(this->m_ChunkCount, end / MIN_CHUNK_TOKENS), 1);
+
+		// every context is there before any is referred to, since resizing would move them
+		if (ctx.chunks.size() < maxChunkCount)
+			ctx.chunks.resize(maxChunkCount);
+
+		ctx.chunkCount = 1;
+		ctx.reparsedChunks = 0;
+
+		ParserResultT result = initResult;
+		ParseContextType& real = ctx.chunks[0];
+		this->m_Parser.beginPush(real);
+
+		// warm up over the first delimiters, keeping the shallowest stack after them as the guess
+		std::vector<lrstate_t> guess;
+		size_t guessIndex = 0, warmUp = 0;
+
+		for (size_t delimiters = 0; warmUp < end / maxChunkCount && delimiters < WARM_UP_DELIMITERS; warmUp++) {
+			(void)this->m_Parser.feed(real, tokens[warmUp], result);
+
+			if (not this->_is_delimiter(tokens[warmUp]))
+				continue;
+
+			delimiters++;
+			this->m_Parser.reduceOn(real, tokens[warmUp + 1]);
+
+			if (guess.empty() || real.stack.size() < guess.size()) {
+				guess.clear();
+				for (const StateType& state : real.stack)
+					guess.push_back(state.state);
+
+				guessIndex = warmUp + 1;
+			}
+		}
+
+		const size_t contextSize = std::min(CONTEXT_TOKENS, guessIndex);
+		const std::vector<size_t> bounds = guess.empty() ? std::vector<size_t>{ 0, end } :
+			this->_split(tokens, maxChunkCount, warmUp + 1, tokens.subspan(guessIndex - contextSize, contextSize));
+
+		const size_t chunkCount = bounds.size() - 1;
+
+		// a single chunk is just a sequential parse
+		if (chunkCount == 1) {
+			for (size_t i = warmUp; i < tokens.size(); i++)
+				(void)this->m_Parser.feed(real, tokens[i], result);
+
+			return result;
+		}
+
+		ctx.chunkCount = chunkCount;
+		std::vector<std::exception_ptr> failures(chunkCount);
+
+		this->m_Pool.run(chunkCount, [&](size_t chunk, size_t) {
+			ParseContextType& chunkCtx = ctx.chunks[chunk];
+
+			// the result is only given to the action of production 0, which is not reduced before `TEOF`
+			ParserResultT chunkResult = initResult;
+
+			try {
+				if (chunk == 0) {
+					for (size_t i = warmUp; i < bounds[1]; i++)
+						(void)this->m_Parser.feed(chunkCtx, tokens[i], chunkResult);
+
+					return;
+				}
+
+				this->m_Parser.beginPush(chunkCtx);
+				for (size_t i = 1; i < guess.size(); i++)
+					this->m_Parser.pushSubtree(chunkCtx, StateType{ guess[i] });
+
+				chunkCtx.lowestDepth = guess.size();
+
+				for (size_t i = bounds[chunk]; i < bounds[chunk + 1]; i++)
+					(void)this->m_Parser.feed(chunkCtx, tokens[i], chunkResult);
+			}
+			catch (...) {
+				failures[chunk] = std::current_exception();
+			}
+			});
+
+		if (failures[0])
+			std::rethrow_exception(failures[0]);
+
+		// stitch the chunks together, in order
+		std::vector<StateType> reduced;
+
+		for (size_t chunk = 1; chunk < chunkCount; chunk++) {
+			ParseContextType& chunkCtx = ctx.chunks[chunk];
+			this->m_Parser.reduceOn(real, tokens[bounds[chunk]]);
+
+			if (failures[chunk] || not std::ranges::equal(real.stack, guess, {}, &StateType::state)) {
+				ctx.reparsedChunks++;
+
+				for (size_t i = bounds[chunk]; i < bounds[chunk + 1]; i++)
+					(void)this->m_Parser.feed(real, tokens[i], result);
+
+				continue;
+			}
+
+			// the states below `lowestDepth` are those of the guess the chunk never reduced, which the real ones stand for
+			const size_t kept = chunkCtx.lowestDepth;
+			reduced.assign(real.stack.begin() + kept, real.stack.end());
+			real.stack.resize(kept);
+
+			for (size_t i = kept; i < chunkCtx.stack.size(); i++) {
+				StateType& state = chunkCtx.stack[i];
+
+				// the first state above them is the one the chunk reduced the rest of the guess to
+				if (i == kept && not reduced.empty()) {
+					if constexpr (requires { state.token.offset; state.token.length; }) {
+						const auto stateEnd = std::max(state.token.offset + state.token.length, reduced.back().token.offset + reduced.back().token.length);
+						state.token.offset = reduced.front().token.offset;
+						state.token.length = decltype(state.token.length)(stateEnd - state.token.offset);
+					}
+
+					merge(std::span<const StateType>{ reduced }, state);
+				}
+
+				this->m_Parser.pushSubtree(real, std::move(state));
+			}
+		}
+
+		if (this->m_Parser.feed(real, tokens.back(), result) != PushStatus::PS_ACCEPTED)
+			throw std::logic_error("The speculative parser did not accept its input at `TEOF`.");
+
+		return result;
+	}
+
+}
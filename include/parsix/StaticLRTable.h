@@ -0,0 +1,793 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <set>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parsix/LRCompressedTable.h"
+#include "parsix/TerminalSet.h"
+
+// DECLARATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief A production whose body is stored inline, so that it can be constructed (and used) at compile time.
+	 * @details Static productions carry no `void*` action: a parser using a static table gets its semantic actions from an LRActionTable.
+	 * @tparam SymbolT The type of a grammar symbol.
+	 * @tparam MaxBodySize The maximum number of symbols in the body of a production.
+	 */
+	template <typename SymbolT, size_t MaxBodySize>
+	struct StaticProduction {
+
+		/**
+		 * @brief Aliases the type of a terminal.
+		 */
+		using TerminalType = decltype(SymbolT{}.as.terminal);
+
+		/**
+		 * @brief Aliases the type of a non-terminal.
+		 */
+		using VariableType = decltype(SymbolT{}.as.nonTerminal);
+
+		/**
+		 * @brief Static productions never have a dynamic action (see the class documentation).
+		 */
+		static constexpr void* postfixAction = nullptr;
+
+		/**
+		 * @brief The head symbol of the production. This must be a single non-terminal.
+		 */
+		SymbolT prodHead{};
+
+		/**
+		 * @brief The body of the production; only its first `bodySize` symbols are used.
+		 */
+		std::array<SymbolT, MaxBodySize> prodBody{};
+
+		/**
+		 * @brief The number of symbols in the body of the production.
+		 */
+		size_t bodySize = 0;
+
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr StaticProduction() = default;
+
+		/**
+		 * @brief Constructs a production from its head and its body (`{ EPSILON }` for an epsilon production).
+		 * @throws std::logic_error If `head` is a terminal, or if `body` is empty or has more than `MaxBodySize` symbols. At compile time, this is a compilation error.
+		 */
+		constexpr StaticProduction(const SymbolT& head, std::initializer_list<SymbolT> body) : prodHead{ head } {
+			if (head.isTerminal)
+				throw std::logic_error("The head of a production must be a non-terminal.");
+
+			if (body.size() == 0 || body.size() > MaxBodySize)
+				throw std::logic_error("The body of a production must have between 1 and `MaxBodySize` symbols.");
+
+			for (const SymbolT& symbol : body)
+				this->prodBody[this->bodySize++] = symbol;
+		}
+
+		/**
+		 * @brief Gets the number of symbols in the body of the production.
+		 */
+		constexpr size_t size() const noexcept(true) { return this->bodySize; }
+
+		/**
+		 * @brief Checks whether this is an epsilon production, i.e., its body is `EPSILON`.
+		 */
+		constexpr bool isEpsilon() const noexcept(true) {
+			return this->bodySize == 1 && this->prodBody[0].isTerminal && this->prodBody[0].as.terminal == TerminalType::T_EPSILON;
+		}
+
+		/**
+		 * @brief Gets the number of symbols the production derives, i.e., `0` for an epsilon production and `size()` otherwise.
+		 */
+		constexpr size_t length() const noexcept(true) { return this->isEpsilon() ? 0 : this->bodySize; }
+
+	};
+
+	/**
+	 * @brief A grammar of a fixed number of StaticProduction objects whose FIRST and FOLLOW sets are calculated when it is constructed, which may be at compile time.
+	 * @details It provides the part of the interface of ProductionVector used by the parsers (`at()`, `size()`, `getFOLLOW()`, ...). The FIRST and FOLLOW sets are stored as one flag per terminal.
+	 * @attention The grammar must be augmented as required by LRTableBuilder: production 0 is the only production of the start symbol.
+	 * @tparam SymbolT The type of a grammar symbol.
+	 * @tparam ProdCount The number of productions.
+	 * @tparam MaxBodySize The maximum number of symbols in the body of a production.
+	 */
+	template <typename SymbolT, size_t ProdCount, size_t MaxBodySize>
+	class StaticGrammar {
+	public:
+
+		/**
+		 * @brief Aliases the type of a production.
+		 */
+		using ProductionType = StaticProduction<SymbolT, MaxBodySize>;
+
+		/**
+		 * @brief Aliases the type of a terminal.
+		 */
+		using TerminalType = typename ProductionType::TerminalType;
+
+		/**
+		 * @brief Aliases the type of a non-terminal.
+		 */
+		using VariableType = typename ProductionType::VariableType;
+
+		/**
+		 * @brief The total number of non-terminals in the grammar.
+		 */
+		static constexpr size_t VAR_COUNT = (size_t)VariableType::NT_COUNT;
+
+		/**
+		 * @brief The total number of terminals in the grammar.
+		 */
+		static constexpr size_t TER_COUNT = (size_t)TerminalType::T_COUNT;
+
+		/**
+		 * @brief The number of productions.
+		 */
+		static constexpr size_t PROD_COUNT = ProdCount;
+
+		/**
+		 * @brief The maximum number of symbols in the body of a production.
+		 */
+		static constexpr size_t MAX_BODY_SIZE = MaxBodySize;
+
+		/**
+		 * @brief Aliases the type of a set of terminals: a flag for every terminal.
+		 */
+		using TerminalSetType = std::array<bool, TER_COUNT>;
+
+	private:
+
+		/**
+		 * @brief The productions, indexed by production number.
+		 */
+		std::array<ProductionType, ProdCount> m_Productions{};
+
+		/**
+		 * @brief The FIRST set of every non-terminal (without epsilon; see `m_Nullable`).
+		 */
+		std::array<TerminalSetType, VAR_COUNT> m_FIRST{};
+
+		/**
+		 * @brief The FOLLOW set of every non-terminal.
+		 */
+		std::array<TerminalSetType, VAR_COUNT> m_FOLLOW{};
+
+		/**
+		 * @brief Whether every non-terminal derives the empty string (i.e., has epsilon in its FIRST set).
+		 */
+		std::array<bool, VAR_COUNT> m_Nullable{};
+
+		/**
+		 * @brief Adds the terminals of `from` to `to`.
+		 * @returns `true` if `to` has changed; `false` otherwise.
+		 */
+		static constexpr bool _unite(TerminalSetType& to, const TerminalSetType& from) {
+			bool changed = false;
+
+			for (size_t terminal = 0; terminal < TER_COUNT; terminal++)
+				if (from[terminal] && not to[terminal])
+					to[terminal] = changed = true;
+
+			return changed;
+		}
+
+		constexpr void _calculate_FIRST();
+		constexpr void _calculate_FOLLOW();
+
+	public:
+
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr StaticGrammar() = default;
+
+		/**
+		 * @brief Constructs the grammar from its productions, in production-number order, and calculates its FIRST and FOLLOW sets.
+		 */
+		template <typename... ProdTs>
+			requires (sizeof...(ProdTs) + 1 == ProdCount)
+		constexpr StaticGrammar(const ProductionType& production, const ProdTs&... productions) : m_Productions{ production, productions... } {
+			this->_calculate_FIRST();
+			this->_calculate_FOLLOW();
+		}
+
+		/**
+		 * @brief Gets the production whose number is `prodNumber`.
+		 * @throws std::out_of_range If there is no such production.
+		 */
+		constexpr const ProductionType& at(size_t prodNumber) const {
+			if (prodNumber >= ProdCount)
+				throw std::out_of_range("There is no production with this number in the grammar.");
+
+			return this->m_Productions[prodNumber];
+		}
+
+		/**
+		 * @brief Gets the production whose number is `prodNumber`. No boundary-checking.
+		 */
+		constexpr const ProductionType& operator[](size_t prodNumber) const noexcept(true) { return this->m_Productions[prodNumber]; }
+
+		/**
+		 * @brief Gets the number of productions.
+		 */
+		constexpr size_t size() const noexcept(true) { return ProdCount; }
+
+		/**
+		 * @brief Whether the FIRST sets are calculated; they always are (see the class documentation).
+		 */
+		constexpr bool FIRSTCalculated() const noexcept(true) { return true; }
+
+		/**
+		 * @brief Whether the FOLLOW sets are calculated; they always are (see the class documentation).
+		 */
+		constexpr bool FOLLOWCalculated() const noexcept(true) { return true; }
+
+		/**
+		 * @brief Does nothing; the FIRST sets are calculated on construction.
+		 */
+		constexpr void calculateFIRST() const noexcept(true) {}
+
+		/**
+		 * @brief Does nothing; the FOLLOW sets are calculated on construction.
+		 */
+		constexpr void calculateFOLLOW() const noexcept(true) {}
+
+		/**
+		 * @brief Checks whether a non-terminal derives the empty string.
+		 */
+		constexpr bool isNullable(VariableType nonTerminal) const noexcept(true) { return this->m_Nullable[(size_t)nonTerminal]; }
+
+		/**
+		 * @brief Checks whether a terminal is in the FIRST set of a non-terminal.
+		 */
+		constexpr bool inFIRST(VariableType nonTerminal, TerminalType terminal) const noexcept(true) { return this->m_FIRST[(size_t)nonTerminal][(size_t)terminal]; }
+
+		/**
+		 * @brief Checks whether a terminal is in the FOLLOW set of a non-terminal.
+		 */
+		constexpr bool inFOLLOW(VariableType nonTerminal, TerminalType terminal) const noexcept(true) { return this->m_FOLLOW[(size_t)nonTerminal][(size_t)terminal]; }
+
+		/**
+		 * @brief Gets the FOLLOW set of a non-terminal as a set of symbols, like `ProductionVector::getFOLLOW()` does.
+		 */
+		std::set<SymbolT> getFOLLOW(VariableType nonTerminal) const {
+			std::set<SymbolT> follow;
+
+			for (size_t terminal = 0; terminal < TER_COUNT; terminal++)
+				if (this->m_FOLLOW[(size_t)nonTerminal][terminal])
+					follow.insert(SymbolT{ .isTerminal = true, .as {.terminal = (TerminalType)terminal} });
+
+			return follow;
+		}
+
+		/**
+		 * @brief Gets the FOLLOW set of a non-terminal as a bitset, like `ProductionVector::getFOLLOWSet()` does.
+		 */
+		constexpr TerminalSet<SymbolT> getFOLLOWSet(VariableType nonTerminal) const noexcept(true) {
+			TerminalSet<SymbolT> follow;
+
+			for (size_t terminal = 0; terminal < TER_COUNT; terminal++)
+				if (this->m_FOLLOW[(size_t)nonTerminal][terminal])
+					follow.insert((TerminalType)terminal);
+
+			return follow;
+		}
+
+	};
+
+	template <typename SymbolT, size_t MaxBodySize, typename... ProdTs>
+	StaticGrammar(StaticProduction<SymbolT, MaxBodySize>, ProdTs...) -> StaticGrammar<SymbolT, sizeof...(ProdTs) + 1, MaxBodySize>;
+
+	/**
+	 * @brief The canonical collection of LR(0) item sets of a StaticGrammar, with the GOTO function between them.
+	 * @details It is only meant to be constructed during the constant evaluation of a StaticLRTable (its storage is transient). An item `[p, d]` (production `p` with the dot before symbol `d`) is numbered `p * (MAX_BODY_SIZE + 1) + d`; an item set is a flag for every item.
+	 * @tparam GrammarT The type of the grammar; a StaticGrammar.
+	 */
+	template <typename GrammarT>
+	struct StaticLRCollection {
+
+		/**
+		 * @brief The number of items of a production.
+		 */
+		static constexpr size_t ITEM_STRIDE = GrammarT::MAX_BODY_SIZE + 1;
+
+		/**
+		 * @brief The total number of items of the grammar.
+		 */
+		static constexpr size_t ITEM_COUNT = GrammarT::PROD_COUNT * ITEM_STRIDE;
+
+		/**
+		 * @brief The total number of grammar symbols. Terminals are numbered first, then come the non-terminals.
+		 */
+		static constexpr size_t SYMBOL_COUNT = GrammarT::TER_COUNT + GrammarT::VAR_COUNT;
+
+		/**
+		 * @brief Aliases the type of a (closed) item set.
+		 */
+		using ItemSetType = std::array<bool, ITEM_COUNT>;
+
+		/**
+		 * @brief The item sets, indexed by state number. State 0 is the start state.
+		 */
+		std::vector<ItemSetType> states;
+
+		/**
+		 * @brief The GOTO of every state on every symbol; `SIZE_MAX` if there is none.
+		 */
+		std::vector<std::array<size_t, SYMBOL_COUNT>> transitions;
+
+		constexpr explicit StaticLRCollection(const GrammarT&);
+
+		/**
+		 * @brief Gets the index of a grammar symbol among all of the grammar symbols (terminals first, then non-terminals).
+		 */
+		template <typename SymbolT>
+		static constexpr size_t symbolIndex(const SymbolT& symbol) noexcept(true) {
+			return symbol.isTerminal ? (size_t)symbol.as.terminal : GrammarT::TER_COUNT + (size_t)symbol.as.nonTerminal;
+		}
+
+	private:
+
+		constexpr void _close(const GrammarT&, ItemSetType&) const;
+		constexpr size_t _get_state(ItemSetType&&);
+
+	};
+
+	/**
+	 * @brief An SLR(1) parsing table of a StaticGrammar, constructed at compile time and stored in fixed-size arrays (i.e., in read-only data if it is `constexpr`).
+	 * @details It provides the lookup interface of LRParsingTable (`atAction()`, `atGoto()`, `getActions()`, `getGotos()`, `production()` and `grammar`). Conflicts are resolved as LRTableBuilder resolves them and are counted (see `getConflictCount()`), so that a grammar can be required to be conflict-free with a `static_assert`.
+	 * @details Use `buildStaticLRTable()` to construct one, and StaticLRTableRef to give one to an LRParser.
+	 * @tparam GrammarT The type of the grammar; a StaticGrammar.
+	 * @tparam StateCount The number of states of the table.
+	 */
+	template <typename GrammarT, size_t StateCount>
+	class StaticLRTable {
+	public:
+
+		/**
+		 * @brief Aliases the type of a terminal.
+		 */
+		using TerminalType = typename GrammarT::TerminalType;
+
+		/**
+		 * @brief Aliases the type of a non-terminal.
+		 */
+		using VariableType = typename GrammarT::VariableType;
+
+		/**
+		 * @brief The total number of non-terminals in the grammar.
+		 */
+		static constexpr size_t VAR_COUNT = GrammarT::VAR_COUNT;
+
+		/**
+		 * @brief The total number of terminals in the grammar.
+		 */
+		static constexpr size_t TER_COUNT = GrammarT::TER_COUNT;
+
+		/**
+		 * @brief The number of states of the table.
+		 */
+		static constexpr size_t STATE_COUNT = StateCount;
+
+	private:
+
+		/**
+		 * @brief The width of a row: the Action columns followed by the GOTO columns.
+		 */
+		static constexpr size_t ROW_WIDTH = TER_COUNT + VAR_COUNT;
+
+		/**
+		 * @brief The Action and GOTO entries of every state.
+		 */
+		std::array<std::array<LRPackedEntry, ROW_WIDTH>, StateCount> m_Rows{};
+
+		/**
+		 * @brief The number of conflicts resolved while constructing the table.
+		 */
+		size_t m_ConflictCount = 0;
+
+		constexpr void _set_action(size_t, size_t, const LRTableEntry&);
+
+	public:
+
+		/**
+		 * @brief The grammar.
+		 */
+		GrammarT grammar;
+
+		/**
+		 * @brief Constructs the SLR(1) table of a grammar.
+		 * @throws std::logic_error If the grammar does not have exactly `StateCount` states. At compile time, this is a compilation error.
+		 */
+		constexpr explicit StaticLRTable(const GrammarT&);
+
+		/**
+		 * @brief Does nothing; the table cannot be modified after it is constructed.
+		 */
+		constexpr void freeze() const noexcept(true) {}
+
+		/**
+		 * @brief Gets a read-only view of the table. Since the table is already read-only, this is the table itself.
+		 */
+		constexpr const StaticLRTable& view() const noexcept(true) { return *this; }
+
+		/**
+		 * @brief Gets the production whose number is `prodNumber`. No boundary-checking.
+		 */
+		constexpr const auto& production(size_t prodNumber) const noexcept(true) { return this->grammar[prodNumber]; }
+
+		/**
+		 * @brief Gets the number of states of the table.
+		 */
+		constexpr size_t getStateCount() const noexcept(true) { return StateCount; }
+
+		/**
+		 * @brief Gets the number of conflicts resolved while constructing the table (see the class documentation).
+		 */
+		constexpr size_t getConflictCount() const noexcept(true) { return this->m_ConflictCount; }
+
+		/**
+		 * @brief Gets the Action entry at this `state` and this `terminal`. No boundary-checking.
+		 */
+		constexpr LRTableEntry atAction(size_t state, TerminalType terminal) const noexcept(true) {
+			return this->m_Rows[state][(size_t)terminal].unpack();
+		}
+
+		/**
+		 * @brief Gets the GOTO entry at this `state` and this `nonTerminal`. No boundary-checking.
+		 */
+		constexpr LRTableEntry atGoto(size_t state, VariableType nonTerminal) const noexcept(true) {
+			return this->m_Rows[state][TER_COUNT + (size_t)nonTerminal].unpack();
+		}
+
+		/**
+		 * @brief Gets all of the terminals having a **non-error** Action entry in a given state.
+		 */
+		std::vector<TerminalType> getActions(size_t state) const {
+			std::vector<TerminalType> res;
+
+			for (size_t terminal = 0; terminal < TER_COUNT; terminal++)
+				if (not this->m_Rows[state][terminal].isEmpty())
+					res.push_back((TerminalType)terminal);
+
+			return res;
+		}
+
+		/**
+		 * @brief Gets all of the non-terminals having a **non-error** GOTO entry in a given state.
+		 */
+		std::vector<VariableType> getGotos(size_t state) const {
+			std::vector<VariableType> res;
+
+			for (size_t variable = 0; variable < VAR_COUNT; variable++)
+				if (not this->m_Rows[state][TER_COUNT + variable].isEmpty())
+					res.push_back((VariableType)variable);
+
+			return res;
+		}
+
+	};
+
+	/**
+	 * @brief Constructs the SLR(1) table of a grammar at compile time.
+	 * @details The number of states is computed by a first constant evaluation of the LR(0) collection, which then sizes the arrays of the table. Use it to initialize a `constexpr` variable:
+		* `static constexpr StaticGrammar GRAMMAR{ ... };`
+		* `static constexpr auto TABLE = buildStaticLRTable<GRAMMAR>();`
+	 * @note Large grammars may need a higher constant-evaluation step limit (e.g., `-fconstexpr-ops-limit` with GCC, `/constexpr:steps` with MSVC).
+	 * @tparam GRAMMAR The grammar; a `constexpr` StaticGrammar object with static storage duration.
+	 */
+	template <const auto& GRAMMAR>
+	consteval auto buildStaticLRTable() {
+		using GrammarType = std::remove_cvref_t<decltype(GRAMMAR)>;
+
+		constexpr size_t stateCount = StaticLRCollection<GrammarType>{ GRAMMAR }.states.size();
+
+		return StaticLRTable<GrammarType, stateCount>{ GRAMMAR };
+	}
+
+	/**
+	 * @brief Binds a `constexpr` StaticLRTable object to a type, so that it can be the `ParsingTableT` of an LRParser.
+	 * @details The object itself is empty: `view()` returns the bound table, whose address is a compile-time constant, so the lookups of the parser compile down to indexing a constant array.
+	 * @tparam TABLE The table; a `constexpr` StaticLRTable object with static storage duration.
+	 */
+	template <const auto& TABLE>
+	struct StaticLRTableRef {
+
+		/**
+		 * @brief The grammar of the table.
+		 */
+		static constexpr const auto& grammar = TABLE.grammar;
+
+		/**
+		 * @brief Does nothing; the table cannot be modified.
+		 */
+		constexpr void freeze() const noexcept(true) {}
+
+		/**
+		 * @brief Gets the bound table.
+		 */
+		static constexpr const auto& view() noexcept(true) { return TABLE; }
+
+		/**
+		 * @brief Gets all of the non-terminals having a **non-error** GOTO entry in a given state.
+		 */
+		static auto getGotos(size_t state) { return TABLE.getGotos(state); }
+
+		/**
+		 * @brief Gets all of the terminals having a **non-error** Action entry in a given state.
+		 */
+		static auto getActions(size_t state) { return TABLE.getActions(state); }
+
+		/**
+		 * @brief Gets the number of states of the bound table.
+		 */
+		static constexpr size_t getStateCount() noexcept(true) { return TABLE.getStateCount(); }
+
+	};
+
+}
+
+// IMPLEMENTATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Calculates the FIRST set and the nullability of every non-terminal.
+	 * @details **Algorithm**: repeat until nothing changes: for every production `A -> X1...Xn`, add FIRST(Xi) to FIRST(A) for every `Xi` such that `X1...X(i-1)` are all nullable (FIRST of a terminal being itself); `A` is nullable if all of `X1...Xn` are.
+	 */
+	template <typename SymbolT, size_t ProdCount, size_t MaxBodySize>
+	constexpr void StaticGrammar<SymbolT, ProdCount, MaxBodySize>::_calculate_FIRST()
+	{
+		bool changed = true;
+
+		while (changed) {
+			changed = false;
+
+			for (const ProductionType& production : this->m_Productions) {
+				const size_t head = (size_t)production.prodHead.as.nonTerminal;
+				const size_t length = production.length();
+
+				size_t i = 0;
+				for (; i < length; i++) {
+					const SymbolT& symbol = production.prodBody[i];
+
+					if (symbol.isTerminal) {
+						if (not this->m_FIRST[head][(size_t)symbol.as.terminal])
+							this->m_FIRST[head][(size_t)symbol.as.terminal] = changed = true;
+						break;
+					}
+
+					changed |= _unite(this->m_FIRST[head], this->m_FIRST[(size_t)symbol.as.nonTerminal]);
+
+					if (not this->m_Nullable[(size_t)symbol.as.nonTerminal])
+						break;
+				}
+
+				if (i == length && not this->m_Nullable[head])
+					this->m_Nullable[head] = changed = true;
+			}
+		}
+	}
+
+	/**
+	 * @brief Calculates the FOLLOW set of every non-terminal. Requires the FIRST sets.
+	 * @details **Algorithm**: FOLLOW of the start symbol contains the end marker. Then, repeat until nothing changes: for every production `A -> X1...Xn` and every non-terminal `Xi`, add FIRST(X(i+1)...Xn) to FOLLOW(Xi), and add FOLLOW(A) to it as well if `X(i+1)...Xn` is nullable.
+	 */
+	template <typename SymbolT, size_t ProdCount, size_t MaxBodySize>
+	constexpr void StaticGrammar<SymbolT, ProdCount, MaxBodySize>::_calculate_FOLLOW()
+	{
+		this->m_FOLLOW[(size_t)this->m_Productions[0].prodHead.as.nonTerminal][(size_t)TerminalType::T_EOF] = true;
+
+		bool changed = true;
+
+		while (changed) {
+			changed = false;
+
+			for (const ProductionType& production : this->m_Productions) {
+				const size_t head = (size_t)production.prodHead.as.nonTerminal;
+				const size_t length = production.length();
+
+				for (size_t i = 0; i < length; i++) {
+					if (production.prodBody[i].isTerminal)
+						continue;
+
+					TerminalSetType& follow = this->m_FOLLOW[(size_t)production.prodBody[i].as.nonTerminal];
+
+					size_t j = i + 1;
+					for (; j < length; j++) {
+						const SymbolT& symbol = production.prodBody[j];
+
+						if (symbol.isTerminal) {
+							if (not follow[(size_t)symbol.as.terminal])
+								follow[(size_t)symbol.as.terminal] = changed = true;
+							break;
+						}
+
+						changed |= _unite(follow, this->m_FIRST[(size_t)symbol.as.nonTerminal]);
+
+						if (not this->m_Nullable[(size_t)symbol.as.nonTerminal])
+							break;
+					}
+
+					if (j == length)
+						changed |= _unite(follow, this->m_FOLLOW[head]);
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Closes an item set: adds the item `[q, 0]` for every production `q` of every non-terminal right after the dot of an item of the set, until nothing changes.
+	 */
+	template <typename GrammarT>
+	constexpr void StaticLRCollection<GrammarT>::_close(const GrammarT& grammar, ItemSetType& items) const
+	{
+		bool changed = true;
+
+		while (changed) {
+			changed = false;
+
+			for (size_t item = 0; item < ITEM_COUNT; item++) {
+				if (not items[item])
+					continue;
+
+				const auto& production = grammar[item / ITEM_STRIDE];
+				const size_t dot = item % ITEM_STRIDE;
+
+				if (dot >= production.length() || production.prodBody[dot].isTerminal)
+					continue;
+
+				for (size_t prodNumber = 0; prodNumber < grammar.size(); prodNumber++)
+					if (symbolIndex(grammar[prodNumber].prodHead) == symbolIndex(production.prodBody[dot]) && not items[prodNumber * ITEM_STRIDE])
+						items[prodNumber * ITEM_STRIDE] = changed = true;
+			}
+		}
+	}
+
+	/**
+	 * @brief Gets the number of the state having a given (closed) item set, adding a new state if there is none.
+	 */
+	template <typename GrammarT>
+	constexpr size_t StaticLRCollection<GrammarT>::_get_state(ItemSetType&& items)
+	{
+		for (size_t state = 0; state < this->states.size(); state++)
+			if (this->states[state] == items)
+				return state;
+
+		this->states.push_back(std::move(items));
+
+		std::array<size_t, SYMBOL_COUNT> none{};
+		none.fill(SIZE_MAX);
+		this->transitions.push_back(none);
+
+		return this->states.size() - 1;
+	}
+
+	/**
+	 * @brief Computes the canonical collection of LR(0) item sets of a grammar.
+	 * @details **Algorithm**: start with the closure of `[0, 0]`; then, for every state (in order of creation, including the ones added on the way) and every symbol, compute the closure of the items with the dot moved over that symbol and find or add its state.
+	 */
+	template <typename GrammarT>
+	constexpr StaticLRCollection<GrammarT>::StaticLRCollection(const GrammarT& grammar)
+	{
+		ItemSetType start{};
+		start[0] = true;
+		this->_close(grammar, start);
+		this->_get_state(std::move(start));
+
+		for (size_t state = 0; state < this->states.size(); state++) {
+			for (size_t symbol = 0; symbol < SYMBOL_COUNT; symbol++) {
+				ItemSetType target{};
+				bool empty = true;
+
+				for (size_t item = 0; item < ITEM_COUNT; item++) {
+					if (not this->states[state][item])
+						continue;
+
+					const auto& production = grammar[item / ITEM_STRIDE];
+					const size_t dot = item % ITEM_STRIDE;
+
+					if (dot < production.length() && symbolIndex(production.prodBody[dot]) == symbol)
+						target[item + 1] = true, empty = false;
+				}
+
+				if (empty)
+					continue;
+
+				this->_close(grammar, target);
+
+				// `_get_state()` may reallocate `transitions`; do not hold a reference across it
+				const size_t targetState = this->_get_state(std::move(target));
+				this->transitions[state][symbol] = targetState;
+			}
+		}
+	}
+
+	/**
+	 * @brief Places an entry in the Action table, resolving a conflict as LRTableBuilder does: accepting wins over everything, shifting wins over reducing and, among reductions, the production with the smaller number wins.
+	 */
+	template <typename GrammarT, size_t StateCount>
+	constexpr void StaticLRTable<GrammarT, StateCount>::_set_action(size_t state, size_t terminal, const LRTableEntry& entry)
+	{
+		LRPackedEntry& cell = this->m_Rows[state][terminal];
+
+		if (cell.isEmpty()) {
+			cell = LRPackedEntry::pack(entry);
+			return;
+		}
+
+		const LRTableEntry current = cell.unpack();
+		if (current == entry)
+			return;
+
+		this->m_ConflictCount++;
+
+		auto rank = [](const LRTableEntry& e) {
+			switch (e.type) {
+			case LRTableEntryType::TET_ACCEPT: return 0;
+			case LRTableEntryType::TET_ACTION_SHIFT: return 1;
+			default: return 2;
+			}
+			};
+
+		if (rank(entry) < rank(current) || (rank(entry) == rank(current) && entry.number < current.number))
+			cell = LRPackedEntry::pack(entry);
+	}
+
+	/**
+	 * @brief Constructs the SLR(1) table of a grammar.
+	 * @details Shifts and GOTOs come from the LR(0) collection; a complete item of production `p` reduces by `p` on every terminal of FOLLOW of its head, except for production 0, which accepts on the end marker.
+	 */
+	template <typename GrammarT, size_t StateCount>
+	constexpr StaticLRTable<GrammarT, StateCount>::StaticLRTable(const GrammarT& grammar) : grammar{ grammar }
+	{
+		using CollectionType = StaticLRCollection<GrammarT>;
+
+		const CollectionType collection{ grammar };
+
+		if (collection.states.size() != StateCount)
+			throw std::logic_error("The number of states of the grammar does not match the size of the static table.");
+
+		for (size_t state = 0; state < StateCount; state++) {
+
+			// shifts and GOTOs
+			for (size_t terminal = 0; terminal < TER_COUNT; terminal++)
+				if (const size_t target = collection.transitions[state][terminal]; target != SIZE_MAX)
+					this->_set_action(state, terminal, LRTableEntry{ false, LRTableEntryType::TET_ACTION_SHIFT, target });
+
+			for (size_t variable = 0; variable < VAR_COUNT; variable++)
+				if (const size_t target = collection.transitions[state][TER_COUNT + variable]; target != SIZE_MAX)
+					this->m_Rows[state][TER_COUNT + variable] = LRPackedEntry::pack(LRTableEntry{ false, LRTableEntryType::TET_GOTO, target });
+
+			// reductions
+			for (size_t item = 0; item < CollectionType::ITEM_COUNT; item++) {
+				if (not collection.states[state][item])
+					continue;
+
+				const size_t prodNumber = item / CollectionType::ITEM_STRIDE;
+				const auto& production = grammar[prodNumber];
+
+				if (item % CollectionType::ITEM_STRIDE != production.length())
+					continue;
+
+				if (prodNumber == 0) {
+					this->_set_action(state, (size_t)TerminalType::T_EOF, LRTableEntry{ false, LRTableEntryType::TET_ACCEPT });
+					continue;
+				}
+
+				for (size_t terminal = 0; terminal < TER_COUNT; terminal++)
+					if (grammar.inFOLLOW(production.prodHead.as.nonTerminal, (TerminalType)terminal))
+						this->_set_action(state, terminal, LRTableEntry{ false, LRTableEntryType::TET_ACTION_REDUCE, prodNumber });
+			}
+		}
+	}
+
+}
@@ -0,0 +1,339 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "parsix/ChunkedInput.h"
+
+// DECLARATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief A token that refers to its text by offset instead of holding a copy of it (see StreamingLexer).
+	 * @details It has the interface the parsers need from a token (`name`, `EPSILON`, `TEOF`, `toString()`), so it can be the token type of the states of an LRParser. Its text is got from the input it was read from (see `StreamingLexer::text()`).
+	 * @tparam TerminalT The type of a terminal.
+	 */
+	template <typename TerminalT>
+	struct OffsetToken {
+
+		static const OffsetToken EPSILON;
+		static const OffsetToken TEOF;
+
+		TerminalT name = TerminalT::T_EPSILON;
+
+		/**
+		 * @brief The offset of the first byte of the text of the token within the source.
+		 */
+		uint64_t offset = 0;
+
+		/**
+		 * @brief The length of the text of the token, in bytes.
+		 */
+		uint32_t length = 0;
+
+		bool operator==(const OffsetToken&) const = default;
+
+		operator std::string() const {
+			return this->toString();
+		}
+
+		/**
+		 * @brief Converts this token to a string, e.g., `<3 @ 1024+5>` (its name, offset and length).
+		 */
+		std::string toString() const {
+			return std::format("<{} @ {}+{}>", (size_t)this->name, this->offset, this->length);
+		}
+
+	};
+
+	template <typename TerminalT>
+	const OffsetToken<TerminalT> OffsetToken<TerminalT>::EPSILON{ TerminalT::T_EPSILON };
+
+	template <typename TerminalT>
+	const OffsetToken<TerminalT> OffsetToken<TerminalT>::TEOF{ TerminalT::T_EOF };
+
+	/**
+	 * @brief The result of scanning a single token (see StreamingLexer).
+	 * @tparam TerminalT The type of a terminal.
+	 */
+	template <typename TerminalT>
+	struct ScanResult {
+
+		/**
+		 * @brief The length of the scanned token; `0` means that the text cannot be scanned (an error at the end of the input, and "more input is needed" otherwise).
+		 */
+		size_t length = 0;
+
+		/**
+		 * @brief The name of the scanned token; `T_EPSILON` for text to be skipped (e.g., white space and comments).
+		 */
+		TerminalT name = TerminalT::T_EPSILON;
+	};
+
+	/**
+	 * @brief A lexical analyzer for files larger than memory: it pulls its input from a ChunkedInput and returns OffsetToken objects, so neither the source nor the text of the tokens is ever copied whole.
+	 * @details It can be the `LexicalAnalyzerT` of the parsers (it has `getNextToken()`, `peak()`, `getSourceCode()` and the position functions). Tokens are recognized by a user-provided scan function, called as `scan(std::string_view rest, bool atEnd)` with the unread part of the window (never empty), which returns a ScanResult for the token at the beginning of `rest`. When the scan function needs more input (it returns a length of `0`, or the token reaches the end of the window, where it might continue), the window is extended and the token is scanned again.
+		* Once a token is returned, everything before the last `history` bytes preceding it may be dropped from the window. Hence, the text of a token (see `text()`) can be got from within a semantic action as long as it is within that history, which it is for the tokens of the current handle when the history is larger than the longest handle. Memory use thus depends on the chunk size and the history, never on the size of the source; the parsing stack only holds offsets.
+		* `getSourceCode()` returns the window from the current token on, so error messages show the input around the error rather than all of it.
+		* A pushed input (see `ChunkedInput::pushed()`) is read with `tryNextToken()` instead of `getNextToken()`, since it may run out of bytes before its end.
+	 * @tparam TerminalT The type of a terminal.
+	 * @tparam ScanFnT The type of the scan function.
+	 */
+	template <typename TerminalT, typename ScanFnT>
+	class StreamingLexer {
+
+		/**
+		 * @brief Aliases the type of a token.
+		 */
+		using TokenType = OffsetToken<TerminalT>;
+
+		/**
+		 * @brief The input of the lexical analyzer.
+		 */
+		ChunkedInput* m_Input = nullptr;
+
+		/**
+		 * @brief The scan function.
+		 */
+		ScanFnT m_Scan{};
+
+		/**
+		 * @brief The number of bytes before the current token that are kept in the window.
+		 */
+		size_t m_History = DEFAULT_HISTORY;
+
+		/**
+		 * @brief The offset of the first unread byte.
+		 */
+		uint64_t m_Cursor = 0;
+
+		/**
+		 * @brief The offset of the last returned token.
+		 */
+		uint64_t m_TokenOffset = 0;
+
+		/**
+		 * @brief The line and column (both starting at 1) of the first unread byte.
+		 */
+		size_t m_Line = 1, m_Col = 1;
+
+		/**
+		 * @brief The token returned by `peak()` and not yet by `getNextToken()`, if any.
+		 */
+		std::optional<TokenType> m_Peeked;
+
+		/**
+		 * @brief Updates the line and column past some consumed text.
+		 */
+		void _advance_position(std::string_view consumed) noexcept(true) {
+			for (const char c : consumed) {
+				if (c == '\n') {
+					this->m_Line++;
+					this->m_Col = 1;
+				}
+				else
+					this->m_Col++;
+			}
+		}
+
+		std::optional<TokenType> _try_scan_token();
+
+		/**
+		 * @brief Scans the next token of an input that can always be extended (i.e., one that is not pushed).
+		 * @throws std::logic_error If the input is a pushed one that needs more bytes (see `tryNextToken()`).
+		 */
+		TokenType _scan_token() {
+			if (std::optional<TokenType> token = this->_try_scan_token())
+				return *token;
+
+			throw std::logic_error("The pushed input of the lexical analyzer needs more bytes; use `tryNextToken()` to read it.");
+		}
+
+	public:
+
+		/**
+		 * @brief Aliases the type of the scan function.
+		 */
+		using ScanFunctionType = ScanFnT;
+
+		/**
+		 * @brief The default number of bytes kept before the current token (64 KiB).
+		 */
+		static constexpr size_t DEFAULT_HISTORY = size_t(1) << 16;
+
+		/**
+		 * @brief Default constructor. The lexical analyzer has no input; it must not be used.
+		 */
+		StreamingLexer() = default;
+
+		/**
+		 * @brief Constructs a lexical analyzer.
+		 * @param[in] input The input; it must outlive the lexical analyzer.
+		 * @param[in] scan The scan function (see the class documentation).
+		 * @param[in] history The number of bytes before the current token whose text stays available (see the class documentation).
+		 */
+		StreamingLexer(ChunkedInput& input, ScanFnT scan, size_t history = DEFAULT_HISTORY) :
+			m_Input{ &input }, m_Scan{ std::move(scan) }, m_History{ history }, m_Cursor{ input.windowOffset() }
+		{}
+
+		/**
+		 * @brief Gets the next token; at the end of the input, it is `TEOF` (at the offset of the end).
+		 * @param[in] flags Ignored; it is there for interface compatibility with the lexical analyzers of lexana.
+		 * @throws std::runtime_error If the scan function cannot scan the rest of the input.
+		 * @throws std::logic_error If the input is a pushed one that needs more bytes (see `tryNextToken()`).
+		 */
+		TokenType getNextToken(unsigned flags = 0) {
+			(void)flags;
+
+			if (this->m_Peeked) {
+				const TokenType token = *this->m_Peeked;
+				this->m_Peeked.reset();
+				return token;
+			}
+
+			return this->_scan_token();
+		}
+
+		/**
+		 * @brief Gets the next token, if the input has enough bytes for it; this is how a pushed input (see `ChunkedInput::pushed()`) is read.
+		 * @returns The next token (`TEOF` once the input is finished and read whole); `std::nullopt` if more bytes must be appended to the input first, in which case nothing is consumed.
+		 * @throws std::runtime_error If the scan function cannot scan the rest of the input.
+		 */
+		std::optional<TokenType> tryNextToken() {
+			if (this->m_Peeked) {
+				const TokenType token = *this->m_Peeked;
+				this->m_Peeked.reset();
+				return token;
+			}
+
+			return this->_try_scan_token();
+		}
+
+		/**
+		 * @brief Gets the next token without consuming it.
+		 */
+		TokenType peak() {
+			if (not this->m_Peeked)
+				this->m_Peeked = this->_scan_token();
+
+			return *this->m_Peeked;
+		}
+
+		/**
+		 * @brief Moves the lexical analyzer to `offset`, which becomes the offset of the first unread byte; the window must reach it.
+		 * @param[in] offset The offset to move to.
+		 * @param[in] line The line of the byte at `offset` (starting at 1).
+		 * @param[in] col The column of the byte at `offset` (starting at 1).
+		 */
+		void seek(uint64_t offset, size_t line, size_t col) noexcept(true) {
+			this->m_Peeked.reset();
+			this->m_Cursor = offset;
+			this->m_Line = line;
+			this->m_Col = col;
+		}
+
+		/**
+		 * @brief Moves the lexical analyzer past the next `length` bytes without scanning them (e.g., the text of a subtree that is reused by an IncrementalParser); the window must hold them.
+		 * @throws std::out_of_range If the window does not hold the next `length` bytes.
+		 */
+		void skip(size_t length) {
+			this->m_Peeked.reset();
+			this->_advance_position(this->m_Input->text(this->m_Cursor, length));
+			this->m_Cursor += length;
+		}
+
+		/**
+		 * @brief Gets the text of a token. It must be within the history (see the class documentation).
+		 * @throws std::out_of_range If the text of `token` has already been dropped from the window.
+		 */
+		std::string_view text(const TokenType& token) const { return this->m_Input->text(token.offset, token.length); }
+
+		/**
+		 * @brief Gets the window of the input from the last returned token on.
+		 */
+		std::string_view getSourceCode() const {
+			const std::string_view window = this->m_Input->window();
+			const uint64_t from = std::max(this->m_TokenOffset, this->m_Input->windowOffset());
+
+			return window.substr(std::min((size_t)(from - this->m_Input->windowOffset()), window.size()));
+		}
+
+		/**
+		 * @brief Gets the offset of the first unread byte.
+		 */
+		uint64_t getOffset() const noexcept(true) { return this->m_Cursor; }
+
+		size_t getLine() const noexcept(true) { return this->m_Line; }
+		size_t getCol() const noexcept(true) { return this->m_Col; }
+		std::pair<size_t, size_t> getPosition() const noexcept(true) { return { this->m_Line, this->m_Col }; }
+
+	};
+
+}
+
+// IMPLEMENTATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Scans the next token, skipping the text for which the scan function returns `T_EPSILON`.
+	 * @returns The next token; `std::nullopt` if the input is a pushed one that needs more bytes to be appended first (the skipped text is consumed, though).
+	 * @throws std::runtime_error If the scan function cannot scan the rest of the input, or a token is too long for an OffsetToken.
+	 */
+	template <typename TerminalT, typename ScanFnT>
+	auto StreamingLexer<TerminalT, ScanFnT>::_try_scan_token() -> std::optional<TokenType>
+	{
+		ChunkedInput& input = *this->m_Input;
+
+		while (true) {
+			std::string_view rest = input.window().substr((size_t)(this->m_Cursor - input.windowOffset()));
+
+			if (rest.empty()) {
+				if (input.extend())
+					continue;
+
+				if (not input.atEnd())
+					return std::nullopt;
+
+				this->m_TokenOffset = this->m_Cursor;
+				return TokenType{ .name = TerminalT::T_EOF, .offset = this->m_Cursor };
+			}
+
+			ScanResult<TerminalT> result = this->m_Scan(rest, input.atEnd());
+
+			// the token may continue past the window (or the scan function needs more input to decide)
+			if ((result.length == 0 || result.length >= rest.size()) && not input.atEnd()) {
+				if (not input.extend() && not input.atEnd())
+					return std::nullopt;
+
+				continue;
+			}
+
+			if (result.length == 0 || result.length > rest.size())
+				throw std::runtime_error(std::format("({}, {}) Cannot scan the input at offset {}.", this->m_Line, this->m_Col, this->m_Cursor));
+
+			if (result.length > UINT32_MAX)
+				throw std::runtime_error(std::format("({}, {}) The token at offset {} is too long.", this->m_Line, this->m_Col, this->m_Cursor));
+
+			const uint64_t offset = this->m_Cursor;
+			this->_advance_position(rest.substr(0, result.length));
+			this->m_Cursor += result.length;
+
+			if (result.name == TerminalT::T_EPSILON) {
+				input.discard(this->m_Cursor - std::min<uint64_t>(this->m_Cursor, this->m_History));
+				continue;
+			}
+
+			this->m_TokenOffset = offset;
+			input.discard(offset - std::min<uint64_t>(offset, this->m_History));
+
+			return TokenType{ .name = result.name, .offset = offset, .length = (uint32_t)result.length };
+		}
+	}
+
+}
@@ -0,0 +1,776 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <initializer_list>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "parsix/LRCompressedTable.h"
+#include "parsix/MappedFile.h"
+#include "parsix/TerminalSet.h"
+
+// DECLARATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief The kind of table stored in a table file.
+	 */
+	enum class TableFileKind : uint32_t {
+		TFK_LR = 1,
+		TFK_LL = 2,
+	};
+
+	/**
+	 * @brief The record of a production within a table file: what the parsers need from it, plus its number, which lets a loaded table be matched against a grammar.
+	 */
+	struct TableFileProduction {
+
+		/**
+		 * @brief Set in `flags` for an epsilon production.
+		 */
+		static constexpr uint32_t F_EPSILON = 1;
+
+		/**
+		 * @brief The head of the production (the value of its non-terminal).
+		 */
+		uint32_t head = 0;
+
+		/**
+		 * @brief The `size()` of the production.
+		 */
+		uint32_t bodySize = 0;
+
+		uint32_t flags = 0;
+
+		/**
+		 * @brief The `prodNumber` of the production.
+		 */
+		uint32_t number = 0;
+
+		constexpr bool operator==(const TableFileProduction&) const = default;
+	};
+
+	static_assert(sizeof(TableFileProduction) == 16);
+
+	/**
+	 * @brief An LLTableEntry object within a table file.
+	 */
+	struct TableFileLLEntry {
+
+		/**
+		 * @brief Set in `flags` for an error entry.
+		 */
+		static constexpr uint32_t F_ERROR = 1;
+
+		/**
+		 * @brief Set in `flags` for an empty entry.
+		 */
+		static constexpr uint32_t F_EMPTY = 2;
+
+		uint32_t flags = F_ERROR | F_EMPTY;
+
+		/**
+		 * @brief The production index of the entry; `UINT32_MAX` for none.
+		 */
+		uint32_t prodIndex = UINT32_MAX;
+	};
+
+	static_assert(sizeof(TableFileLLEntry) == 8);
+
+	/**
+	 * @brief The header of a table file, i.e., a parsing table saved by `saveLRTable()` or `saveLLTable()`.
+	 * @details A table file is made of the following sections, in this order, each starting at a multiple of 8 bytes. Every value is stored in the byte order of the machine that wrote it (which the header records, so a file from a machine of another byte order is rejected rather than misread):
+		* The header.
+		* A TableFileProduction record for every production, in production-number order.
+		* LR only: the FIRST sets, then the FOLLOW sets, of every non-terminal; each set is `setWordCount` 64-bit words (see `TerminalSet::words()`).
+		* The rows of the table: LR tables have a row of LRPackedEntry objects for every state, holding its Action entries followed by its GOTO entries; LL tables have a row of TableFileLLEntry objects for every non-terminal.
+	 * @note The version is increased whenever the format changes; files of another version are rejected.
+	 */
+	struct TableFileHeader {
+
+		/**
+		 * @brief The first bytes of every table file.
+		 */
+		static constexpr std::array<char, 8> MAGIC{ 'P', 'A', 'R', 'S', 'I', 'X', 'T', 'B' };
+
+		/**
+		 * @brief A value whose bytes tell the byte order of the file.
+		 */
+		static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+		/**
+		 * @brief The current version of the format.
+		 */
+		static constexpr uint32_t VERSION = 1;
+
+		std::array<char, 8> magic = MAGIC;
+		uint32_t byteOrder = BYTE_ORDER_MARK;
+		uint32_t version = VERSION;
+		TableFileKind kind = TableFileKind::TFK_LR;
+		uint32_t terminalCount = 0;
+		uint32_t variableCount = 0;
+		uint32_t setWordCount = 0;
+		uint32_t productionCount = 0;
+
+		/**
+		 * @brief The number of states of an LR table; `0` for an LL table.
+		 */
+		uint32_t stateCount = 0;
+
+		/**
+		 * @brief Gets the offset of the TableFileProduction records.
+		 */
+		constexpr uint64_t productionsOffset() const noexcept(true) { return sizeof(TableFileHeader); }
+
+		/**
+		 * @brief Gets the offset of the FIRST sets; the FOLLOW sets follow them.
+		 */
+		constexpr uint64_t setsOffset() const noexcept(true) { return this->productionsOffset() + uint64_t(this->productionCount) * sizeof(TableFileProduction); }
+
+		/**
+		 * @brief Gets the offset of the rows of the table.
+		 */
+		constexpr uint64_t rowsOffset() const noexcept(true) { return this->setsOffset() + 2 * uint64_t(this->variableCount) * this->setWordCount * sizeof(uint64_t); }
+
+		/**
+		 * @brief Gets the size of a well-formed file having this header.
+		 */
+		constexpr uint64_t fileSize() const noexcept(true) {
+			const uint64_t rowsSize = this->kind == TableFileKind::TFK_LR ?
+				uint64_t(this->stateCount) * (uint64_t(this->terminalCount) + this->variableCount) * sizeof(LRPackedEntry) :
+				uint64_t(this->variableCount) * this->terminalCount * sizeof(TableFileLLEntry);
+
+			// the LR rows may end in the middle of a word; the file is padded to a multiple of 8 bytes
+			return (this->rowsOffset() + rowsSize + 7) / 8 * 8;
+		}
+
+		void validate(const std::filesystem::path& path, uint64_t size, TableFileKind expectedKind, size_t terCount, size_t varCount, size_t setWords) const;
+	};
+
+	static_assert(sizeof(TableFileHeader) == 40 && sizeof(TableFileHeader) % 8 == 0, "The header of a table file must keep the following sections 8-byte aligned.");
+
+	/**
+	 * @brief A read-only LR parsing table mapped from a table file (see `saveLRTable()`). It can be used as the `ParsingTableT` of an LRParser, with `MappedLRTable::GrammarType` as its `GrammarT`.
+	 * @details Loading the table maps the file and validates it (one pass over its entries); nothing is copied or calculated, and the table is read directly from the mapped pages, so a process can start parsing in well under a millisecond even with a large table. A parser is constructed from it by sharing it: `LRParser::prepareTable(MappedLRTable<Symbol>{ path })` only computes its panic-mode recovery metadata.
+	 * @attention Mapped productions carry no `void*` action (function addresses cannot be saved), so a parser using a mapped table gets its semantic actions from an LRActionTable.
+	 * @tparam SymbolT The type of a grammar symbol.
+	 */
+	template <typename SymbolT>
+	class MappedLRTable {
+	public:
+
+		/**
+		 * @brief Aliases the type of a terminal.
+		 */
+		using TerminalType = decltype(SymbolT{}.as.terminal);
+
+		/**
+		 * @brief Aliases the type of a non-terminal.
+		 */
+		using VariableType = decltype(SymbolT{}.as.nonTerminal);
+
+		/**
+		 * @brief Aliases the type of a set of terminals.
+		 */
+		using TerminalSetType = TerminalSet<SymbolT>;
+
+		/**
+		 * @brief The total number of terminals.
+		 */
+		static constexpr size_t TER_COUNT = (size_t)TerminalType::T_COUNT;
+
+		/**
+		 * @brief The total number of non-terminals.
+		 */
+		static constexpr size_t VAR_COUNT = (size_t)VariableType::NT_COUNT;
+
+		/**
+		 * @brief The number of entries of a row: the Action entries of a state, then its GOTO entries.
+		 */
+		static constexpr size_t ROW_SIZE = TER_COUNT + VAR_COUNT;
+
+		/**
+		 * @brief A production of a mapped table. It only has what the parser needs: its head and its size.
+		 */
+		struct Production {
+
+			/**
+			 * @brief Mapped productions never have a dynamic action (see the class documentation).
+			 */
+			static constexpr void* postfixAction = nullptr;
+
+			SymbolT prodHead{};
+			size_t prodNumber = 0;
+			size_t bodySize = 0;
+			bool epsilon = false;
+
+			size_t size() const noexcept(true) { return this->bodySize; }
+			bool isEpsilon() const noexcept(true) { return this->epsilon; }
+		};
+
+		/**
+		 * @brief The grammar of a mapped table: its productions and its FIRST and FOLLOW sets, read from the file. It provides the part of the interface of ProductionVector used by the parsers.
+		 */
+		class GrammarType {
+
+			const TableFileProduction* m_Productions = nullptr;
+			size_t m_ProdCount = 0;
+			const uint64_t* m_FIRST = nullptr;
+			const uint64_t* m_FOLLOW = nullptr;
+
+			friend class MappedLRTable;
+
+		public:
+
+			/**
+			 * @brief Gets the production whose number is `prodNumber`.
+			 * @throws std::out_of_range If there is no such production.
+			 */
+			Production at(size_t prodNumber) const {
+				if (prodNumber >= this->m_ProdCount)
+					throw std::out_of_range("There is no production with this number in the grammar.");
+
+				return (*this)[prodNumber];
+			}
+
+			/**
+			 * @brief Gets the production whose number is `prodNumber`. No boundary-checking.
+			 */
+			Production operator[](size_t prodNumber) const noexcept(true) {
+				const TableFileProduction& record = this->m_Productions[prodNumber];
+
+				return Production{
+					.prodHead = SymbolT{ .isTerminal = false, .as {.nonTerminal = (VariableType)record.head} },
+					.prodNumber = record.number,
+					.bodySize = record.bodySize,
+					.epsilon = (record.flags & TableFileProduction::F_EPSILON) != 0,
+				};
+			}
+
+			/**
+			 * @brief Gets the number of productions.
+			 */
+			size_t size() const noexcept(true) { return this->m_ProdCount; }
+
+			/**
+			 * @brief Whether the FIRST sets are calculated; they always are, since they are saved with the table.
+			 */
+			constexpr bool FIRSTCalculated() const noexcept(true) { return true; }
+
+			/**
+			 * @brief Whether the FOLLOW sets are calculated; they always are, since they are saved with the table.
+			 */
+			constexpr bool FOLLOWCalculated() const noexcept(true) { return true; }
+
+			/**
+			 * @brief Does nothing; the FIRST sets are saved with the table.
+			 */
+			constexpr void calculateFIRST() const noexcept(true) {}
+
+			/**
+			 * @brief Does nothing; the FOLLOW sets are saved with the table.
+			 */
+			constexpr void calculateFOLLOW() const noexcept(true) {}
+
+			/**
+			 * @brief Gets the FIRST set of a non-terminal as a bitset; it has `EPSILON` iff the non-terminal is nullable.
+			 */
+			TerminalSetType getFIRSTSet(VariableType nonTerminal) const noexcept(true) {
+				return TerminalSetType::fromWords(this->m_FIRST + (size_t)nonTerminal * TerminalSetType::WORD_COUNT);
+			}
+
+			/**
+			 * @brief Gets the FOLLOW set of a non-terminal as a bitset.
+			 */
+			TerminalSetType getFOLLOWSet(VariableType nonTerminal) const noexcept(true) {
+				return TerminalSetType::fromWords(this->m_FOLLOW + (size_t)nonTerminal * TerminalSetType::WORD_COUNT);
+			}
+
+			/**
+			 * @brief Gets the FIRST set of a non-terminal as a set of symbols, like `ProductionVector::getFIRST()` does.
+			 */
+			std::set<SymbolT> getFIRST(VariableType nonTerminal) const {
+				const TerminalSetType first = this->getFIRSTSet(nonTerminal);
+				return std::set<SymbolT>{ first.begin(), first.end() };
+			}
+
+			/**
+			 * @brief Gets the FOLLOW set of a non-terminal as a set of symbols, like `ProductionVector::getFOLLOW()` does.
+			 */
+			std::set<SymbolT> getFOLLOW(VariableType nonTerminal) const {
+				const TerminalSetType follow = this->getFOLLOWSet(nonTerminal);
+				return std::set<SymbolT>{ follow.begin(), follow.end() };
+			}
+
+			/**
+			 * @brief Checks whether a non-terminal derives the empty string.
+			 */
+			bool isNullable(VariableType nonTerminal) const noexcept(true) {
+				return this->getFIRSTSet(nonTerminal).contains(TerminalType::T_EPSILON);
+			}
+
+		};
+
+	private:
+
+		/**
+		 * @brief The mapped file; everything else points into it.
+		 */
+		MappedFile m_File;
+
+		/**
+		 * @brief The first row of the table.
+		 */
+		const LRPackedEntry* m_Rows = nullptr;
+
+		/**
+		 * @brief The number of states (rows) of the table.
+		 */
+		size_t m_StateCount = 0;
+
+		void _validate_entries(const std::filesystem::path&) const;
+
+	public:
+
+		/**
+		 * @brief The grammar of the table.
+		 */
+		GrammarType grammar;
+
+		explicit MappedLRTable(const std::filesystem::path& path);
+
+		/**
+		 * @brief Does nothing; the table is validated when it is loaded and cannot be modified.
+		 */
+		constexpr void freeze() const noexcept(true) {}
+
+		/**
+		 * @brief Gets a read-only view of the table. Since the table is already read-only, this is the table itself.
+		 */
+		const MappedLRTable& view() const noexcept(true) { return *this; }
+
+		/**
+		 * @brief Gets the production whose number is `prodNumber`. No boundary-checking.
+		 */
+		Production production(size_t prodNumber) const noexcept(true) { return this->grammar[prodNumber]; }
+
+		/**
+		 * @brief Gets the number of states of the table.
+		 */
+		size_t getStateCount() const noexcept(true) { return this->m_StateCount; }
+
+		/**
+		 * @brief Gets the Action entry at this `state` and this `terminal`. No boundary-checking.
+		 */
+		LRTableEntry atAction(size_t state, TerminalType terminal) const noexcept(true) {
+			return this->m_Rows[state * ROW_SIZE + (size_t)terminal].unpack();
+		}
+
+		/**
+		 * @brief Gets the GOTO entry at this `state` and this `nonTerminal`. No boundary-checking.
+		 */
+		LRTableEntry atGoto(size_t state, VariableType nonTerminal) const noexcept(true) {
+			return this->m_Rows[state * ROW_SIZE + TER_COUNT + (size_t)nonTerminal].unpack();
+		}
+
+		/**
+		 * @brief Gets all of the terminals having a **non-error** Action entry in a given state.
+		 */
+		std::vector<TerminalType> getActions(size_t state) const {
+			std::vector<TerminalType> res;
+
+			for (size_t terminal = 0; terminal < TER_COUNT; terminal++)
+				if (not this->m_Rows[state * ROW_SIZE + terminal].isEmpty())
+					res.push_back((TerminalType)terminal);
+
+			return res;
+		}
+
+		/**
+		 * @brief Gets all of the non-terminals having a **non-error** GOTO entry in a given state.
+		 */
+		std::vector<VariableType> getGotos(size_t state) const {
+			std::vector<VariableType> res;
+
+			for (size_t variable = 0; variable < VAR_COUNT; variable++)
+				if (not this->m_Rows[state * ROW_SIZE + TER_COUNT + variable].isEmpty())
+					res.push_back((VariableType)variable);
+
+			return res;
+		}
+
+	};
+
+	template <typename GrammarT>
+	void saveLRTable(const LRParsingTable<GrammarT>&, const std::filesystem::path&);
+
+	template <typename GrammarT, typename TerminalT, typename VariableT>
+	void saveLLTable(const LLParsingTable<GrammarT, TerminalT, VariableT>&, const std::filesystem::path&);
+
+	template <typename TableT>
+	TableT loadLLTable(const std::filesystem::path&, decltype(TableT::grammar));
+
+}
+
+// IMPLEMENTATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Checks that a file having this header can be read as a table of a given kind and for given terminal and non-terminal types.
+	 * @param[in] path The path of the file (for error messages only).
+	 * @param[in] size The size of the file.
+	 * @param[in] expectedKind The kind of table the file must have.
+	 * @param[in] terCount The number of terminals the table must have.
+	 * @param[in] varCount The number of non-terminals the table must have.
+	 * @param[in] setWords The number of words of a FIRST or FOLLOW set the file must have.
+	 * @throws std::runtime_error If the file is not a table file, is of another version or byte order, does not match the expected kind and counts, or is truncated.
+	 */
+	inline void TableFileHeader::validate(const std::filesystem::path& path, uint64_t size, TableFileKind expectedKind, size_t terCount, size_t varCount, size_t setWords) const
+	{
+		const std::string name = path.string();
+
+		if (this->magic != MAGIC)
+			throw std::runtime_error(std::format("File `{}` is not a parsing table file.", name));
+
+		if (this->byteOrder != BYTE_ORDER_MARK)
+			throw std::runtime_error(std::format("The parsing table file `{}` was saved on a machine of another byte order.", name));
+
+		if (this->version != VERSION)
+			throw std::runtime_error(std::format("The parsing table file `{}` has version {}, but only version {} is supported.", name, this->version, VERSION));
+
+		if (this->kind != expectedKind)
+			throw std::runtime_error(std::format("The parsing table file `{}` does not have an {} table.", name, expectedKind == TableFileKind::TFK_LR ? "LR" : "LL"));
+
+		if (this->terminalCount != terCount || this->variableCount != varCount || this->setWordCount != setWords)
+			throw std::runtime_error(std::format("The parsing table file `{}` is for a grammar of {} terminals and {} non-terminals, but the grammar symbols have {} terminals and {} non-terminals.",
+				name, this->terminalCount, this->variableCount, terCount, varCount));
+
+		if (size != this->fileSize())
+			throw std::runtime_error(std::format("The parsing table file `{}` has {} bytes instead of {}; it is truncated or corrupted.", name, size, this->fileSize()));
+	}
+
+	/**
+	 * @brief Maps and validates a table file saved by `saveLRTable()`.
+	 * @param[in] path The path of the file.
+	 * @throws std::runtime_error If the file cannot be mapped, is not a valid LR table file, or is for other terminal or non-terminal types (see `TableFileHeader::validate()`), or if it has an invalid production or entry.
+	 */
+	template <typename SymbolT>
+	MappedLRTable<SymbolT>::MappedLRTable(const std::filesystem::path& path) : m_File{ path }
+	{
+		TableFileHeader header;
+
+		if (this->m_File.size() < sizeof(header))
+			throw std::runtime_error(std::format("File `{}` is not a parsing table file.", path.string()));
+
+		std::memcpy(&header, this->m_File.data(), sizeof(header));
+		header.validate(path, this->m_File.size(), TableFileKind::TFK_LR, TER_COUNT, VAR_COUNT, TerminalSetType::WORD_COUNT);
+
+		// the mapping is page-aligned and every section is 8-byte aligned, so the sections can be read in place
+		const std::byte* data = this->m_File.data();
+		const size_t setsSize = VAR_COUNT * TerminalSetType::WORD_COUNT;
+
+		this->grammar.m_Productions = reinterpret_cast<const TableFileProduction*>(data + header.productionsOffset());
+		this->grammar.m_ProdCount = header.productionCount;
+		this->grammar.m_FIRST = reinterpret_cast<const uint64_t*>(data + header.setsOffset());
+		this->grammar.m_FOLLOW = this->grammar.m_FIRST + setsSize;
+		this->m_Rows = reinterpret_cast<const LRPackedEntry*>(data + header.rowsOffset());
+		this->m_StateCount = header.stateCount;
+
+		for (size_t prodNumber = 0; prodNumber < this->grammar.m_ProdCount; prodNumber++)
+			if (this->grammar.m_Productions[prodNumber].head >= VAR_COUNT)
+				throw std::runtime_error(std::format("Production {} of the parsing table file `{}` has an invalid head.", prodNumber, path.string()));
+
+		this->_validate_entries(path);
+	}
+
+	/**
+	 * @brief Validates every entry of the table, as `LRParsingTable::freeze()` does, since the view of the table is not checked.
+	 * @throws std::runtime_error If an entry is of the wrong type for its row or refers to a state or a production that does not exist.
+	 */
+	template <typename SymbolT>
+	void MappedLRTable<SymbolT>::_validate_entries(const std::filesystem::path& path) const
+	{
+		const size_t prodCount = this->grammar.size();
+
+		for (size_t state = 0; state < this->m_StateCount; state++)
+			for (size_t column = 0; column < ROW_SIZE; column++) {
+				const LRPackedEntry entry = this->m_Rows[state * ROW_SIZE + column];
+
+				if (entry.isEmpty())
+					continue;
+
+				bool valid = false;
+
+				switch (entry.type()) {
+				case LRTableEntryType::TET_ACTION_SHIFT:
+					valid = column < TER_COUNT && entry.number() < this->m_StateCount;
+					break;
+				case LRTableEntryType::TET_ACTION_REDUCE:
+					valid = column < TER_COUNT && entry.number() < prodCount;
+					break;
+				case LRTableEntryType::TET_ACCEPT:
+				case LRTableEntryType::TET_ERROR:
+					valid = column < TER_COUNT;
+					break;
+				case LRTableEntryType::TET_GOTO:
+					valid = column >= TER_COUNT && entry.number() < this->m_StateCount;
+					break;
+				default:
+					break;
+				}
+
+				if (not valid)
+					throw std::runtime_error(std::format("Invalid LR table entry `{}` at state {} of the parsing table file `{}`.", entry.unpack().toString(), state, path.string()));
+			}
+	}
+
+	/**
+	 * @brief Gets the record of every production of a grammar, as saved in a table file.
+	 * @throws std::length_error If the grammar has too many productions or a production is too large for the format.
+	 */
+	template <typename GrammarT>
+	std::vector<TableFileProduction> toTableFileProductions(const GrammarT& grammar)
+	{
+		if (grammar.size() >= UINT32_MAX)
+			throw std::length_error("The grammar has too many productions to be saved to a table file.");
+
+		std::vector<TableFileProduction> records;
+		records.reserve(grammar.size());
+
+		for (size_t prodIndex = 0; prodIndex < grammar.size(); prodIndex++) {
+			const auto& production = grammar.at(prodIndex);
+
+			if (production.size() >= UINT32_MAX || production.prodNumber >= UINT32_MAX)
+				throw std::length_error(std::format("Production {} is too large to be saved to a table file.", prodIndex));
+
+			records.push_back(TableFileProduction{
+				.head = (uint32_t)production.prodHead.as.nonTerminal,
+				.bodySize = (uint32_t)production.size(),
+				.flags = production.isEpsilon() ? TableFileProduction::F_EPSILON : 0,
+				.number = (uint32_t)production.prodNumber,
+				});
+		}
+
+		return records;
+	}
+
+	/**
+	 * @brief Writes the sections of a table file, padding it to a multiple of 8 bytes.
+	 * @param[in] path The path of the file; it is overwritten if it exists.
+	 * @param[in] header The header of the file.
+	 * @param[in] sections The sections following the header, as (data, size in bytes) pairs, in order.
+	 * @throws std::runtime_error If the file cannot be written.
+	 */
+	inline void writeTableFile(const std::filesystem::path& path, const TableFileHeader& header, std::initializer_list<std::pair<const void*, size_t>> sections)
+	{
+		std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+
+		if (not file)
+			throw std::runtime_error(std::format("Cannot open file `{}` for writing the parsing table.", path.string()));
+
+		uint64_t written = sizeof(header);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		for (const auto& [data, size] : sections) {
+			file.write(static_cast<const char*>(data), (std::streamsize)size);
+			written += size;
+		}
+
+		static constexpr char padding[8]{};
+		file.write(padding, (std::streamsize)(header.fileSize() - written));
+
+		if (not file.flush())
+			throw std::runtime_error(std::format("Cannot write the parsing table to file `{}`.", path.string()));
+	}
+
+	/**
+	 * @brief Saves an LR parsing table, with the metadata of the productions and the FIRST and FOLLOW sets of its grammar, to a table file, to be loaded by MappedLRTable.
+	 * @details The FIRST and FOLLOW sets are calculated on a copy of the grammar if they have not been calculated yet. The semantic actions of the productions are not saved (see MappedLRTable).
+	 * @param[in] table The table to be saved; it should be valid (see `LRParsingTable::freeze()`), as it is validated again when it is loaded.
+	 * @param[in] path The path of the file; it is overwritten if it exists.
+	 * @throws std::runtime_error If the file cannot be written.
+	 * @throws std::length_error If the table or its grammar is too large for the format.
+	 */
+	template <typename GrammarT>
+	void saveLRTable(const LRParsingTable<GrammarT>& table, const std::filesystem::path& path)
+	{
+		using TableType = LRParsingTable<GrammarT>;
+		using SetType = TerminalSet<typename TableType::SymbolType>;
+
+		const GrammarT* grammar = &table.grammar;
+		std::optional<GrammarT> prepared;
+
+		if (not grammar->FIRSTCalculated() || not grammar->FOLLOWCalculated()) {
+			prepared.emplace(table.grammar);
+			prepared->calculateFIRST();
+			prepared->calculateFOLLOW();
+			grammar = &*prepared;
+		}
+
+		const size_t stateCount = std::max(table.actionTable.size(), table.gotoTable.size());
+		if (stateCount > LRPackedEntry::NUMBER_MASK)
+			throw std::length_error("The LR table has too many states to be saved to a table file.");
+
+		const std::vector<TableFileProduction> productions = toTableFileProductions(*grammar);
+
+		// FIRST sets of all non-terminals, then their FOLLOW sets
+		std::vector<uint64_t> sets;
+		sets.reserve(2 * TableType::VAR_COUNT * SetType::WORD_COUNT);
+
+		for (size_t variable = 0; variable < TableType::VAR_COUNT; variable++) {
+			const auto& words = grammar->getFIRSTSet((typename TableType::VariableType)variable).words();
+			sets.insert(sets.end(), words.begin(), words.end());
+		}
+
+		for (size_t variable = 0; variable < TableType::VAR_COUNT; variable++) {
+			const auto& words = grammar->getFOLLOWSet((typename TableType::VariableType)variable).words();
+			sets.insert(sets.end(), words.begin(), words.end());
+		}
+
+		// missing rows (if one of the tables is shorter than the other) are empty
+		std::vector<LRPackedEntry> rows(stateCount * (TableType::TER_COUNT + TableType::VAR_COUNT));
+
+		for (size_t state = 0; state < stateCount; state++) {
+			LRPackedEntry* row = rows.data() + state * (TableType::TER_COUNT + TableType::VAR_COUNT);
+
+			if (state < table.actionTable.size())
+				for (size_t terminal = 0; terminal < TableType::TER_COUNT; terminal++)
+					row[terminal] = LRPackedEntry::pack(table.actionTable[state][terminal]);
+
+			if (state < table.gotoTable.size())
+				for (size_t variable = 0; variable < TableType::VAR_COUNT; variable++)
+					row[TableType::TER_COUNT + variable] = LRPackedEntry::pack(table.gotoTable[state][variable]);
+		}
+
+		TableFileHeader header;
+		header.kind = TableFileKind::TFK_LR;
+		header.terminalCount = (uint32_t)TableType::TER_COUNT;
+		header.variableCount = (uint32_t)TableType::VAR_COUNT;
+		header.setWordCount = (uint32_t)SetType::WORD_COUNT;
+		header.productionCount = (uint32_t)productions.size();
+		header.stateCount = (uint32_t)stateCount;
+
+		writeTableFile(path, header, {
+			{ productions.data(), productions.size() * sizeof(TableFileProduction) },
+			{ sets.data(), sets.size() * sizeof(uint64_t) },
+			{ rows.data(), rows.size() * sizeof(LRPackedEntry) },
+			});
+	}
+
+	/**
+	 * @brief Saves an LL parsing table, with the metadata of the productions of its grammar, to a table file, to be loaded by `loadLLTable()`.
+	 * @param[in] table The table to be saved.
+	 * @param[in] path The path of the file; it is overwritten if it exists.
+	 * @throws std::logic_error If an error entry of the table has an action: function addresses cannot be saved (set such actions after loading the table).
+	 * @throws std::runtime_error If the file cannot be written.
+	 * @throws std::length_error If the grammar is too large for the format.
+	 */
+	template <typename GrammarT, typename TerminalT, typename VariableT>
+	void saveLLTable(const LLParsingTable<GrammarT, TerminalT, VariableT>& table, const std::filesystem::path& path)
+	{
+		constexpr size_t terCount = (size_t)TerminalT::T_COUNT;
+		constexpr size_t varCount = (size_t)VariableT::NT_COUNT;
+
+		const std::vector<TableFileProduction> productions = toTableFileProductions(table.grammar);
+
+		std::vector<TableFileLLEntry> rows(varCount * terCount);
+
+		for (size_t variable = 0; variable < varCount; variable++)
+			for (size_t terminal = 0; terminal < terCount; terminal++) {
+				const LLTableEntry& entry = table.table[variable][terminal];
+				TableFileLLEntry& saved = rows[variable * terCount + terminal];
+
+				// error entries use the union for an action, and "no action" is `SIZE_MAX`
+				if (entry.isError && entry.prodIndex != SIZE_MAX)
+					throw std::logic_error(std::format("LL table entry ({}, {}) has an action, which cannot be saved to a file.", variable, terminal));
+
+				if (not entry.isError && entry.prodIndex >= UINT32_MAX)
+					throw std::length_error(std::format("LL table entry ({}, {}) refers to production {}, which cannot be saved to a file.", variable, terminal, entry.prodIndex));
+
+				saved.flags = (entry.isError ? TableFileLLEntry::F_ERROR : 0) | (entry.isEmpty ? TableFileLLEntry::F_EMPTY : 0);
+				saved.prodIndex = entry.isError ? UINT32_MAX : (uint32_t)entry.prodIndex;
+			}
+
+		TableFileHeader header;
+		header.kind = TableFileKind::TFK_LL;
+		header.terminalCount = (uint32_t)terCount;
+		header.variableCount = (uint32_t)varCount;
+		header.productionCount = (uint32_t)productions.size();
+
+		writeTableFile(path, header, {
+			{ productions.data(), productions.size() * sizeof(TableFileProduction) },
+			{ rows.data(), rows.size() * sizeof(TableFileLLEntry) },
+			});
+	}
+
+	/**
+	 * @brief Loads an LL parsing table saved by `saveLLTable()` for a given grammar.
+	 * @details Unlike an LR parser, an LL parser expands the bodies of the productions (including their actions and synthesized records) on its stack, so it needs the grammar itself and not just the metadata saved in the file. Hence, the table is read into an LLParsingTable of `grammar`; the file is only mapped while it is read. The metadata in the file is checked against `grammar`, so a table is never used with a grammar it was not generated for.
+	 * @param[in] path The path of the file.
+	 * @tparam TableT The type of the table; an LLParsingTable.
+	 * @param[in] grammar The grammar the table was generated for.
+	 * @returns The loaded (and frozen) table.
+	 * @throws std::runtime_error If the file cannot be mapped, is not a valid LL table file, is for other terminal or non-terminal types, or its productions do not match those of `grammar`.
+	 */
+	template <typename TableT>
+	TableT loadLLTable(const std::filesystem::path& path, decltype(TableT::grammar) grammar)
+	{
+		constexpr size_t terCount = std::tuple_size_v<typename TableT::EntryArrType>;
+		constexpr size_t varCount = std::tuple_size_v<typename TableT::EntryArrType2D>;
+
+		const MappedFile file{ path };
+		TableFileHeader header;
+
+		if (file.size() < sizeof(header))
+			throw std::runtime_error(std::format("File `{}` is not a parsing table file.", path.string()));
+
+		std::memcpy(&header, file.data(), sizeof(header));
+		header.validate(path, file.size(), TableFileKind::TFK_LL, terCount, varCount, 0);
+
+		const std::vector<TableFileProduction> expected = toTableFileProductions(grammar);
+		const auto* productions = reinterpret_cast<const TableFileProduction*>(file.data() + header.productionsOffset());
+
+		if (expected.size() != header.productionCount)
+			throw std::runtime_error(std::format("The parsing table file `{}` is for a grammar of {} productions, but the grammar has {}.", path.string(), header.productionCount, expected.size()));
+
+		for (size_t prodIndex = 0; prodIndex < expected.size(); prodIndex++)
+			if (productions[prodIndex] != expected[prodIndex])
+				throw std::runtime_error(std::format("Production {} of the grammar does not match the one the parsing table file `{}` was saved for.", prodIndex, path.string()));
+
+		TableT table;
+		table.grammar = std::move(grammar);
+
+		const auto* rows = reinterpret_cast<const TableFileLLEntry*>(file.data() + header.rowsOffset());
+
+		for (size_t variable = 0; variable < varCount; variable++)
+			for (size_t terminal = 0; terminal < terCount; terminal++) {
+				const TableFileLLEntry& saved = rows[variable * terCount + terminal];
+				LLTableEntry& entry = table.table[variable][terminal];
+
+				entry.isError = saved.flags & TableFileLLEntry::F_ERROR;
+				entry.isEmpty = saved.flags & TableFileLLEntry::F_EMPTY;
+				entry.prodIndex = saved.prodIndex == UINT32_MAX ? SIZE_MAX : saved.prodIndex;
+			}
+
+		try {
+			table.freeze();
+		}
+		catch (const std::logic_error& error) {
+			throw std::runtime_error(std::format("The parsing table file `{}` is corrupted: {}", path.string(), error.what()));
+		}
+
+		return table;
+	}
+
+}
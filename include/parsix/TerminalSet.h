@@ -0,0 +1,301 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief A set of terminals stored as a fixed-width bitset, with a bit for every terminal (indexed by the value of its enumerator).
+	 * @details Membership tests and insertions are a single bit operation, and union, inclusion and equality work a 64-bit word at a time. Iterating over the set yields the terminals in increasing order, as terminal symbols (non-terminal symbols are never members), so it can stand in for a `std::set` of terminal symbols.
+	 * @tparam SymbolT The type of a grammar symbol. Its terminal type must have a `T_COUNT` enumerator.
+	 */
+	template <typename SymbolT>
+	class TerminalSet {
+	public:
+
+		/**
+		 * @brief Aliases the type of a terminal.
+		 */
+		using TerminalType = decltype(SymbolT{}.as.terminal);
+
+		/**
+		 * @brief The total number of terminals.
+		 */
+		static constexpr size_t TER_COUNT = (size_t)TerminalType::T_COUNT;
+
+		/**
+		 * @brief The number of bits of a word.
+		 */
+		static constexpr size_t WORD_BITS = 64;
+
+		/**
+		 * @brief The number of words needed for a bit for every terminal.
+		 */
+		static constexpr size_t WORD_COUNT = (TER_COUNT + WORD_BITS - 1) / WORD_BITS;
+
+	private:
+
+		/**
+		 * @brief The bits of the terminals.
+		 */
+		std::array<uint64_t, WORD_COUNT> m_Words{};
+
+	public:
+
+		/**
+		 * @brief Iterates over the terminals of a set in increasing order, yielding them as terminal symbols.
+		 */
+		class iterator {
+			const TerminalSet* m_Set = nullptr;
+			size_t m_Terminal = TER_COUNT;
+
+			/**
+			 * @brief Moves on to the first member not smaller than the current terminal.
+			 */
+			constexpr void _skip_to_member() noexcept(true) {
+				while (this->m_Terminal < TER_COUNT) {
+					const uint64_t rest = this->m_Set->m_Words[this->m_Terminal / WORD_BITS] >> (this->m_Terminal % WORD_BITS);
+
+					if (rest) {
+						this->m_Terminal += std::countr_zero(rest);
+						return;
+					}
+
+					this->m_Terminal = (this->m_Terminal / WORD_BITS + 1) * WORD_BITS;
+				}
+
+				this->m_Terminal = TER_COUNT;
+			}
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = SymbolT;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = SymbolT;
+
+			constexpr iterator() = default;
+			constexpr iterator(const TerminalSet* set, size_t terminal) noexcept(true) : m_Set{ set }, m_Terminal{ terminal } { this->_skip_to_member(); }
+
+			constexpr SymbolT operator*() const noexcept(true) {
+				return SymbolT{ .isTerminal = true, .as {.terminal = (TerminalType)this->m_Terminal} };
+			}
+
+			constexpr iterator& operator++() noexcept(true) {
+				this->m_Terminal++;
+				this->_skip_to_member();
+				return *this;
+			}
+
+			constexpr iterator operator++(int) noexcept(true) {
+				iterator old = *this;
+				++*this;
+				return old;
+			}
+
+			constexpr bool operator==(const iterator& other) const noexcept(true) { return this->m_Terminal == other.m_Terminal; }
+		};
+
+		using const_iterator = iterator;
+		using value_type = SymbolT;
+
+		/**
+		 * @brief Default constructor. Constructs an empty set.
+		 */
+		constexpr TerminalSet() = default;
+
+		/**
+		 * @brief Constructs a set from a list of symbols; non-terminals are ignored.
+		 */
+		constexpr TerminalSet(std::initializer_list<SymbolT> symbols) {
+			for (const SymbolT& symbol : symbols)
+				this->insert(symbol);
+		}
+
+		/**
+		 * @brief Constructs a set from its words, as returned by `words()` (e.g., when reading a set back from a file). Bits past the last terminal are cleared.
+		 * @param[in] words The `WORD_COUNT` words of the set; terminal `t` is bit `t % WORD_BITS` of word `t / WORD_BITS`.
+		 */
+		static constexpr TerminalSet fromWords(const uint64_t* words) noexcept(true) {
+			TerminalSet set;
+
+			for (size_t i = 0; i < WORD_COUNT; i++)
+				set.m_Words[i] = words[i];
+
+			if constexpr (TER_COUNT % WORD_BITS != 0)
+				set.m_Words[WORD_COUNT - 1] &= (uint64_t(1) << (TER_COUNT % WORD_BITS)) - 1;
+
+			return set;
+		}
+
+		/**
+		 * @brief Gets the words of the set (see `fromWords()`).
+		 */
+		constexpr const std::array<uint64_t, WORD_COUNT>& words() const noexcept(true) { return this->m_Words; }
+
+		constexpr iterator begin() const noexcept(true) { return iterator{ this, 0 }; }
+		constexpr iterator end() const noexcept(true) { return iterator{ this, TER_COUNT }; }
+
+		/**
+		 * @brief Checks whether a terminal is in the set.
+		 */
+		constexpr bool contains(TerminalType terminal) const noexcept(true) {
+			return (this->m_Words[(size_t)terminal / WORD_BITS] >> ((size_t)terminal % WORD_BITS)) & 1;
+		}
+
+		/**
+		 * @brief Checks whether a symbol is in the set. Non-terminals never are.
+		 */
+		constexpr bool contains(const SymbolT& symbol) const noexcept(true) {
+			return symbol.isTerminal && this->contains(symbol.as.terminal);
+		}
+
+		/**
+		 * @brief Adds a terminal to the set.
+		 * @returns `true` if the terminal was not in the set; `false` otherwise.
+		 */
+		constexpr bool insert(TerminalType terminal) noexcept(true) {
+			uint64_t& word = this->m_Words[(size_t)terminal / WORD_BITS];
+			const uint64_t bit = uint64_t(1) << ((size_t)terminal % WORD_BITS);
+
+			const bool isNew = not (word & bit);
+			word |= bit;
+
+			return isNew;
+		}
+
+		/**
+		 * @brief Adds a terminal symbol to the set. Non-terminals are ignored.
+		 * @returns `true` if the symbol was not in the set; `false` otherwise.
+		 */
+		constexpr bool insert(const SymbolT& symbol) noexcept(true) {
+			return symbol.isTerminal && this->insert(symbol.as.terminal);
+		}
+
+		/**
+		 * @brief Removes a terminal from the set.
+		 * @returns The number of terminals removed (`0` or `1`), as `std::set::erase()` does.
+		 */
+		constexpr size_t erase(TerminalType terminal) noexcept(true) {
+			const bool present = this->contains(terminal);
+			this->m_Words[(size_t)terminal / WORD_BITS] &= ~(uint64_t(1) << ((size_t)terminal % WORD_BITS));
+
+			return present;
+		}
+
+		/**
+		 * @brief Removes a terminal symbol from the set.
+		 * @returns The number of symbols removed (`0` or `1`), as `std::set::erase()` does.
+		 */
+		constexpr size_t erase(const SymbolT& symbol) noexcept(true) {
+			return symbol.isTerminal ? this->erase(symbol.as.terminal) : 0;
+		}
+
+		/**
+		 * @brief Adds all of the terminals of another set to this set (word-wise OR).
+		 * @returns `true` if this set has changed; `false` otherwise.
+		 */
+		constexpr bool unite(const TerminalSet& other) noexcept(true) {
+			uint64_t added = 0;
+
+			for (size_t i = 0; i < WORD_COUNT; i++) {
+				added |= other.m_Words[i] & ~this->m_Words[i];
+				this->m_Words[i] |= other.m_Words[i];
+			}
+
+			return added != 0;
+		}
+
+		/**
+		 * @brief Adds all of the terminals of another set to this set (word-wise OR).
+		 */
+		constexpr TerminalSet& operator|=(const TerminalSet& other) noexcept(true) {
+			this->unite(other);
+			return *this;
+		}
+
+		/**
+		 * @brief Checks whether every terminal of another set is in this set.
+		 */
+		constexpr bool includes(const TerminalSet& other) const noexcept(true) {
+			for (size_t i = 0; i < WORD_COUNT; i++)
+				if (other.m_Words[i] & ~this->m_Words[i])
+					return false;
+
+			return true;
+		}
+
+		/**
+		 * @brief Gets the number of terminals in the set.
+		 */
+		constexpr size_t size() const noexcept(true) {
+			size_t count = 0;
+
+			for (uint64_t word : this->m_Words)
+				count += std::popcount(word);
+
+			return count;
+		}
+
+		/**
+		 * @brief Checks whether the set is empty.
+		 */
+		constexpr bool empty() const noexcept(true) {
+			for (uint64_t word : this->m_Words)
+				if (word)
+					return false;
+
+			return true;
+		}
+
+		/**
+		 * @brief Removes all of the terminals of the set.
+		 */
+		constexpr void clear() noexcept(true) { this->m_Words = {}; }
+
+		/**
+		 * @brief Gets a hash of the set.
+		 */
+		constexpr size_t hash() const noexcept(true) {
+			size_t seed = 0;
+
+			for (uint64_t word : this->m_Words)
+				seed ^= (size_t)word + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+
+			return seed;
+		}
+
+		/**
+		 * @brief Compares two sets for equality (word by word).
+		 */
+		constexpr bool operator==(const TerminalSet&) const = default;
+
+		/**
+		 * @brief Converts this set to a string. This is syntactic sugar over toString.
+		 */
+		operator std::string() const {
+			return this->toString();
+		}
+
+		/**
+		 * @brief Converts this set to a string, e.g., `{ a, b }`.
+		 */
+		std::string toString() const {
+			std::string str = "{";
+
+			for (bool first = true; const SymbolT& symbol : *this) {
+				str += (first ? " " : ", ") + (std::string)symbol;
+				first = false;
+			}
+
+			return str + " }";
+		}
+
+	};
+
+}
@@ -0,0 +1,270 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "lexana/LexicalAnalyzer.h"
+
+// DECLARATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief A stage between a lexical analyzer and a parser: it lexes ahead in batches into a ring buffer of tokens, from which the parser consumes them by index.
+	 * @details It can be the `LexicalAnalyzerT` of the parsers (it has `getNextToken()`, `peak()`, `getSourceCode()` and the position functions), wrapping any lexical analyzer that has them. Whenever the parser needs a token that has not been lexed yet, up to a batch of tokens (and never past `TEOF`) is lexed one after the other into the ring, so the lexical analyzer runs in a tight loop of its own rather than interleaved with the parser; looking `k` tokens ahead (see `peak(k)`, `at()`) only lexes up to the `k`th, and never lexes a token twice.
+		* The tokens are stored as the lexical analyzer returns them, so the ring is most compact with OffsetToken objects (a name, an offset and a length; see StreamingLexer). The positions (line and column) after every token are kept in a separate ring, since they are only needed to report errors: `getPosition()` is the position after the last consumed token, as if there were no buffer.
+		* An exception thrown by the lexical analyzer while lexing ahead is held until the parser reaches the token that could not be lexed, and is rethrown then.
+		* `getSourceCode()` is that of the lexical analyzer, i.e., it starts from the last **lexed** token, which may be up to a batch past the last consumed one. Likewise, a StreamingLexer must keep a history (see `StreamingLexer::DEFAULT_HISTORY`) large enough to also cover the tokens lexed ahead, if the text of the consumed ones is needed.
+	 * @tparam LexicalAnalyzerT The type of the wrapped lexical analyzer.
+	 */
+	template <typename LexicalAnalyzerT>
+	class TokenBuffer {
+
+		/**
+		 * @brief Aliases the type of a token.
+		 */
+		using TokenType = decltype(LexicalAnalyzerT{}.getNextToken());
+
+		/**
+		 * @brief Aliases the type of a position (a line and a column, both starting at 1).
+		 */
+		using PositionType = std::pair<size_t, size_t>;
+
+		/**
+		 * @brief The wrapped lexical analyzer.
+		 */
+		LexicalAnalyzerT* mp_LexicalAnalyzer = nullptr;
+
+		/**
+		 * @brief The flags every token is lexed with (see `lexana::LA_FLAG`).
+		 */
+		unsigned m_Flags = (unsigned)lexana::LA_FLAG::LAF_ALLOW_WHITE_SPACE_CHARS;
+
+		/**
+		 * @brief The maximum number of tokens lexed at once.
+		 */
+		size_t m_BatchSize = DEFAULT_BATCH_SIZE;
+
+		/**
+		 * @brief The ring of lexed tokens, and that of the positions after them; their size is a power of 2.
+		 */
+		std::vector<TokenType> m_Tokens;
+		std::vector<PositionType> m_Positions;
+
+		/**
+		 * @brief `m_Tokens.size() - 1`, which maps the index of a token to its slot in the ring.
+		 */
+		size_t m_Mask = 0;
+
+		/**
+		 * @brief The index of the next token to be consumed, and one past that of the last lexed token.
+		 * @details The tokens in [`m_Next`, `m_End`) are in the ring.
+		 */
+		uint64_t m_Next = 0, m_End = 0;
+
+		/**
+		 * @brief The position before the first token.
+		 */
+		PositionType m_StartPosition{ 1, 1 };
+
+		/**
+		 * @brief Whether `TEOF` has been lexed; no token is lexed after it.
+		 */
+		bool m_ReachedEnd = false;
+
+		/**
+		 * @brief The exception the lexical analyzer threw while lexing the token at `m_End`, if any; no token is lexed after it.
+		 */
+		std::exception_ptr m_Error;
+
+		void _fill(uint64_t index);
+		void _grow(size_t minCapacity);
+
+	public:
+
+		/**
+		 * @brief The default maximum number of tokens lexed at once.
+		 */
+		static constexpr size_t DEFAULT_BATCH_SIZE = 256;
+
+		/**
+		 * @brief Default constructor. The buffer wraps no lexical analyzer; it must not be used.
+		 */
+		TokenBuffer() = default;
+
+		/**
+		 * @brief Constructs a buffer over a lexical analyzer, which must outlive it and must not be used but through it.
+		 * @param[in] lexer The lexical analyzer.
+		 * @param[in] batchSize The maximum number of tokens lexed at once (at least 1).
+		 * @param[in] flags The flags every token is lexed with (see `lexana::LA_FLAG`); by default, the ones the parsers use.
+		 */
+		explicit TokenBuffer(LexicalAnalyzerT& lexer, size_t batchSize = DEFAULT_BATCH_SIZE, unsigned flags = (unsigned)lexana::LA_FLAG::LAF_ALLOW_WHITE_SPACE_CHARS) :
+			mp_LexicalAnalyzer{ &lexer }, m_Flags{ flags }, m_BatchSize{ std::max<size_t>(batchSize, 1) }, m_StartPosition{ lexer.getPosition() }
+		{
+			// room for a batch past a batch of lookahead
+			this->_grow(2 * this->m_BatchSize);
+		}
+
+		/**
+		 * @brief Gets the token `k` tokens past the next one to be consumed (`at(0)` is the next one), lexing up to it if needed.
+		 * @details The reference is invalidated by the next call to any non-const function. Past `TEOF`, it is `TEOF`.
+		 * @throws Whatever the lexical analyzer throws for one of the tokens up to it.
+		 */
+		const TokenType& at(size_t k) {
+			const uint64_t index = this->m_Next + k;
+
+			if (index >= this->m_End) [[unlikely]] {
+				this->_fill(index);
+
+				// `TEOF` was lexed before it
+				if (index >= this->m_End)
+					return this->m_Tokens[(size_t)(this->m_End - 1) & this->m_Mask];
+			}
+
+			return this->m_Tokens[(size_t)index & this->m_Mask];
+		}
+
+		/**
+		 * @brief Gets the next token and consumes it; past `TEOF`, it is `TEOF`.
+		 * @param[in] flags Ignored (the flags are given to the constructor); it is there for interface compatibility with the lexical analyzers of lexana.
+		 * @throws Whatever the lexical analyzer throws for it.
+		 */
+		TokenType getNextToken(unsigned flags = 0) {
+			(void)flags;
+
+			const TokenType token = this->at(0);
+
+			// `TEOF` is never consumed, so that it is returned forever
+			if (this->m_Next + 1 < this->m_End || not this->m_ReachedEnd)
+				this->m_Next++;
+
+			return token;
+		}
+
+		/**
+		 * @brief Gets the next token without consuming it.
+		 */
+		TokenType peak() { return this->at(0); }
+
+		/**
+		 * @brief Gets the token `k` tokens past the next one without consuming anything (`peak(0)` is `peak()`).
+		 */
+		TokenType peak(size_t k) { return this->at(k); }
+
+		/**
+		 * @brief Gets the index of the next token to be consumed, i.e., the number of tokens consumed so far.
+		 */
+		uint64_t index() const noexcept(true) { return this->m_Next; }
+
+		/**
+		 * @brief Gets the number of tokens lexed but not consumed yet.
+		 */
+		size_t buffered() const noexcept(true) { return (size_t)(this->m_End - this->m_Next); }
+
+		/**
+		 * @brief Gets the wrapped lexical analyzer.
+		 */
+		LexicalAnalyzerT& getLexicalAnalyzer() const noexcept(true) { return *this->mp_LexicalAnalyzer; }
+
+		/**
+		 * @brief Gets the source code of the lexical analyzer (see the class documentation).
+		 */
+		std::string_view getSourceCode() const { return this->mp_LexicalAnalyzer->getSourceCode(); }
+
+		/**
+		 * @brief Gets the text of a token, if the lexical analyzer can (see `StreamingLexer::text()`).
+		 */
+		std::string_view text(const TokenType& token) const requires requires (const LexicalAnalyzerT& lexer, const TokenType& t) { lexer.text(t); } {
+			return this->mp_LexicalAnalyzer->text(token);
+		}
+
+		/**
+		 * @brief Gets the position after the last consumed token (before the first token, if none is consumed yet).
+		 */
+		PositionType getPosition() const noexcept(true) {
+			return this->m_Next == 0 ? this->m_StartPosition : this->m_Positions[(size_t)(this->m_Next - 1) & this->m_Mask];
+		}
+
+		size_t getLine() const noexcept(true) { return this->getPosition().first; }
+		size_t getCol() const noexcept(true) { return this->getPosition().second; }
+
+	};
+
+}
+
+// IMPLEMENTATION
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Lexes the tokens up to the one at `index` (not less than `m_End`), and more up to a batch, growing the ring if they do not fit in it. It stops at `TEOF`, which may come before `index`.
+	 * @details The tokens before `m_Next` are overwritten, except for the last one, whose position is that of the buffer.
+	 * @throws Whatever the lexical analyzer throws for a token up to the one at `index`; the exception for a token past it is held (see `m_Error`).
+	 */
+	template <typename LexicalAnalyzerT>
+	void TokenBuffer<LexicalAnalyzerT>::_fill(uint64_t index)
+	{
+		if (this->m_ReachedEnd)
+			return;
+
+		if (this->m_Error)
+			std::rethrow_exception(this->m_Error);
+
+		const uint64_t wanted = std::max<uint64_t>(index + 1, this->m_End + this->m_BatchSize);
+
+		// keep the slot of the last consumed token (for `getPosition()`)
+		if (const size_t capacity = (size_t)(wanted - this->m_Next) + 1; capacity > this->m_Tokens.size())
+			this->_grow(capacity);
+
+		LexicalAnalyzerT& lexer = *this->mp_LexicalAnalyzer;
+
+		while (this->m_End < wanted) {
+			const size_t slot = (size_t)this->m_End & this->m_Mask;
+
+			try {
+				this->m_Tokens[slot] = lexer.getNextToken(this->m_Flags);
+			}
+			catch (...) {
+				// it is the parser's turn to see the exception once it reaches this token
+				if (this->m_End <= index)
+					throw;
+
+				this->m_Error = std::current_exception();
+				return;
+			}
+
+			this->m_Positions[slot] = lexer.getPosition();
+			this->m_End++;
+
+			if (this->m_Tokens[slot].name == TokenType::TEOF.name) {
+				this->m_ReachedEnd = true;
+				return;
+			}
+		}
+	}
+
+	/**
+	 * @brief Grows the rings to hold at least `minCapacity` tokens (a power of 2), keeping the tokens from the last consumed one on in their slots.
+	 */
+	template <typename LexicalAnalyzerT>
+	void TokenBuffer<LexicalAnalyzerT>::_grow(size_t minCapacity)
+	{
+		const size_t capacity = std::bit_ceil(std::max<size_t>(minCapacity, 2));
+
+		std::vector<TokenType> tokens(capacity);
+		std::vector<PositionType> positions(capacity);
+
+		for (uint64_t i = this->m_Next == 0 ? 0 : this->m_Next - 1; i < this->m_End; i++) {
+			tokens[(size_t)i & (capacity - 1)] = this->m_Tokens[(size_t)i & this->m_Mask];
+			positions[(size_t)i & (capacity - 1)] = this->m_Positions[(size_t)i & this->m_Mask];
+		}
+
+		this->m_Tokens = std::move(tokens);
+		this->m_Positions = std::move(positions);
+		this->m_Mask = capacity - 1;
+	}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Runs a batch of independent tasks on a number of threads, balancing the load by work stealing.
+	 * @details The tasks of a batch are numbered `0` to `taskCount - 1` and are initially split into contiguous blocks, one per worker. Every worker runs the tasks of its own block from its back; once its block is exhausted, it steals tasks from the front of the blocks of the other workers. Hence, a worker that gets a block of cheap tasks (e.g., small files) ends up helping the workers that got the expensive ones.
+	 * @note The worker threads are created for every batch and joined before `run()` returns; the pool itself holds no threads between batches.
+	 */
+	class WorkStealingPool {
+
+		/**
+		 * @brief The maximum number of worker threads used to run a batch.
+		 */
+		size_t m_ThreadCount;
+
+	public:
+
+		/**
+		 * @brief Aliases the type of a task. It is called with the number of the task and the number of the worker running it (in `[0, getThreadCount())`).
+		 */
+		using TaskType = std::function<void(size_t task, size_t worker)>;
+
+		/**
+		 * @brief Constructs a pool.
+		 * @param[in] threadCount The maximum number of worker threads used to run a batch. If `0`, the number of hardware threads is used.
+		 */
+		explicit WorkStealingPool(size_t threadCount = 0);
+
+		/**
+		 * @brief Gets the maximum number of worker threads used to run a batch.
+		 */
+		size_t getThreadCount() const { return this->m_ThreadCount; }
+
+		void run(size_t taskCount, const TaskType& task) const;
+
+	};
+
+}
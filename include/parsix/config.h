@@ -0,0 +1,37 @@
+#pragma once
+
+/**
+ * @brief Controls whether the library compiles in its trace-level log messages.
+ * @details Trace messages are the ones emitted on the hot paths of the parsers and of the table-construction algorithms (e.g., every push/pop of the LR stack, every expansion/match of the LL parser, every CLOSURE step). Formatting them is expensive (most of them stringify whole stacks or item sets), so they are only compiled in debug builds by default.
+ * @details Define `PARSIX_TRACE` to `1` (or `0`) before including any parsix header to force tracing on (or off) regardless of the build type.
+ */
+#ifndef PARSIX_TRACE
+#ifdef _DEBUG
+#define PARSIX_TRACE 1
+#else
+#define PARSIX_TRACE 0
+#endif
+#endif
+
+/**
+ * @brief Controls whether the parsers compile in the collection of parse statistics (see ParseStats).
+ * @details When it is `0` (the default), attaching a ParseStats object to a parse context has no effect and the parsers carry no trace of the counters. When it is `1`, every parse whose context has a ParseStats object attached updates its counters; a parse without one only pays for a pointer test per event.
+ * @details Define `PARSIX_STATS` to `1` before including any parsix header (or configure with `-DPARSIX_STATS=ON`) to collect statistics.
+ */
+#ifndef PARSIX_STATS
+#define PARSIX_STATS 0
+#endif
+
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief `true` if trace-level log messages are compiled into the library; `false` otherwise. Mirrors the value of `PARSIX_TRACE`.
+	 */
+	inline constexpr bool TRACE_ENABLED = PARSIX_TRACE;
+
+	/**
+	 * @brief `true` if the parsers collect parse statistics into the ParseStats object attached to a parse context; `false` otherwise. Mirrors the value of `PARSIX_STATS`.
+	 */
+	inline constexpr bool STATS_ENABLED = PARSIX_STATS;
+
+}
@@ -42,4 +42,37 @@ namespace m0st4fa::parsix {
 	};
 	std::string toString(ProdElementType);
 	std::ostream& operator<<(std::ostream&, ProdElementType);
+
+	/**
+	 * @brief The kind of LR parsing table to be constructed from a grammar.
+	 * @note The kinds differ in the item sets they are built from (LR(0) or LR(1) items) and in the terminals on which they place reductions.
+	 */
+	enum class LRTableType {
+		//! @brief An LR(0) table; built from LR(0) items and reduces on every terminal.
+		LTT_LR0,
+		//! @brief An SLR(1) table; built from LR(0) items and reduces on the FOLLOW set of the head of the production.
+		LTT_SLR1,
+		//! @brief A canonical LR(1) table; built from LR(1) items and reduces on the lookaheads of the item.
+		LTT_CLR1,
+		//! @brief An LALR(1) table; has the states of the LR(0) table, with LR(1) lookaheads computed for their kernels.
+		LTT_LALR1,
+		//! @brief The number of LRTableType enumerators.
+		LTT_COUNT
+	};
+	std::string toString(LRTableType);
+	std::ostream& operator<<(std::ostream&, LRTableType);
+
+	/**
+	 * @brief The status of a push-driven parse after it has been fed (see `LRParser::feed()`).
+	 */
+	enum class PushStatus {
+		//! @brief The parse is suspended until it is fed more input.
+		PS_NEED_INPUT,
+		//! @brief The parser has accepted the input; it must not be fed anymore.
+		PS_ACCEPTED,
+		//! @brief The number of PushStatus enumerators.
+		PS_COUNT
+	};
+	std::string toString(PushStatus);
+	std::ostream& operator<<(std::ostream&, PushStatus);
 }
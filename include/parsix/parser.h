@@ -1,7 +1,12 @@
 #pragma once
 #include <concepts>
+#include <format>
+#include <memory>
+#include <string>
+#include <string_view>
 
 #include "lexana/LexicalAnalyzer.h"
+#include "parsix/Logging.h"
 #include "parsix/PDataStructs.h"
 
 // Parser class
@@ -23,6 +28,7 @@ namespace m0st4fa::parsix {
 
 	/**
 	* @brief A general parser class, designed to contain things common to any parser.
+	* @details **Reentrancy**: a parser holds nothing but its configuration, i.e., the (immutable, shared) parsing table, the start symbol and the lexical analyzer it was constructed with (messages are logged through the shared logger, see `get_logger()`). Derived parsers keep all of the state of a parse (stack, current token, error count, etc.) in a context object local to the call, so the same parser (or many parsers sharing the same table) may parse concurrently from different threads, provided that each parse uses its own lexical analyzer.
 	* @tparam LexicalAnalyzerT The type of the lexical analyzer object used by the parser.
 	* @tparam SymbolT The type of grammar symbol objects of the language of the parser.
 	* @tparam ParsingTableT The type of the parsing table object used by the parser.
@@ -51,28 +57,74 @@ namespace m0st4fa::parsix {
 
 		/**
 		 * @brief The parsing table of the parser.
+		 * @note The table is immutable and may be shared by any number of parsers (even ones running on different threads).
 		 */
-		mutable ParsingTableT p_Table;
+		std::shared_ptr<const ParsingTableT> p_Table;
 
 		/**
-		 * @brief The logger used to log information to the different streams.
+		 * @brief The maximum number of errors that you can possibly recover from before failing (aborting).
 		 */
-		Logger p_Logger;
+		static constexpr size_t ERR_RECOVERY_LIMIT = 5;
 
 		/**
-		 * @brief The maximum number of errors that you can possibly recover from before failing (aborting).
+		 * @brief `true` if this parser emits trace-level log messages; `false` otherwise.
 		 */
-		static constexpr size_t ERR_RECOVERY_LIMIT = 5;
+		static constexpr bool TRACE = TRACE_ENABLED;
+
+		/**
+		 * @brief Logs a trace-level message, building it lazily.
+		 * @details `msgFn` is only invoked (and, thus, the message is only formatted) if tracing is compiled in. Otherwise, the call, together with all of the formatting and string conversions it would do, is removed from the build.
+		 * @param[in] info The logger information object used to log the message.
+		 * @param[in] msgFn A callable taking no arguments and returning the message (anything convertible to `std::string`).
+		 */
+		template <typename MsgFnT>
+		void log_trace(const LoggerInfo& info, MsgFnT&& msgFn) const {
+			if constexpr (TRACE)
+				get_logger().log(info, std::forward<MsgFnT>(msgFn)());
+		}
+
+		/**
+		 * @brief Gets the lexical analyzer the parser was constructed with.
+		 */
+		LexicalAnalyzerT& get_lexical_analyzer() const { return *this->mp_LexicalAnalyzer; }
+
+		/**
+		 * @brief Gets the source code against which the parsing is being done by a given lexical analyzer.
+		 */
+		static std::string_view get_source_code(const LexicalAnalyzerT& lexer) { return lexer.getSourceCode(); }
 
 		/**
 		 * @brief Gets the source code against which the parsing is being done.
 		 */
-		std::string_view get_source_code() const { return this->mp_LexicalAnalyzer->getSourceCode(); }
+		std::string_view get_source_code() const { return get_source_code(*this->mp_LexicalAnalyzer); }
+
+		/**
+		 * @brief The maximum number of characters of the source code shown in a message (see `get_source_excerpt()`).
+		 */
+		static constexpr size_t SOURCE_EXCERPT_SIZE = 256;
+
+		/**
+		 * @brief Gets at most SOURCE_EXCERPT_SIZE characters of the source code of a given lexical analyzer, to be shown in a message.
+		 * @details Messages must never contain the whole source code, which may be huge (e.g., when it is streamed; see StreamingLexer).
+		 */
+		static std::string get_source_excerpt(const LexicalAnalyzerT& lexer) {
+			const std::string_view src = get_source_code(lexer);
+
+			if (src.size() <= SOURCE_EXCERPT_SIZE)
+				return std::string{ src };
+
+			return std::format("{}... ({} more characters)", src.substr(0, SOURCE_EXCERPT_SIZE), src.size() - SOURCE_EXCERPT_SIZE);
+		}
+
+		/**
+		 * @brief Gets the next token from a given lexical analyzer.
+		 */
+		static TokenType get_next_token(LexicalAnalyzerT& lexer) { return lexer.getNextToken((unsigned)lexana::LA_FLAG::LAF_ALLOW_WHITE_SPACE_CHARS); }
 
 		/**
 		 * @brief Gets the next token from the lexical analyzer.
 		 */
-		TokenType get_next_token() const { return this->mp_LexicalAnalyzer->getNextToken((unsigned)lexana::LA_FLAG::LAF_ALLOW_WHITE_SPACE_CHARS); }
+		TokenType get_next_token() const { return get_next_token(*this->mp_LexicalAnalyzer); }
 
 		/**
 		 * @brief Gets the head of the first production (or set of productions) in the grammar.
@@ -90,14 +142,14 @@ namespace m0st4fa::parsix {
 		 * @brief Main converting constructor.
 		 * @todo Check for argument "validity".
 		 * @param[in] lexer The lexical analyzer used by the parser.
-		 * @param[in] parsingTable The parsing table object of the finite state machine object that the parser uses.
+		 * @param[in] parsingTable The parsing table object of the finite state machine object that the parser uses. It is shared, not copied; hence, constructing a parser is O(1).
 		 * @param[in] startSymbol The head symbol for the first production (or set of productions) of the grammar.
 		 */
 		Parser(
 			LexicalAnalyzerT& lexer, 
-			const ParsingTableT& parsingTable, 
+			std::shared_ptr<const ParsingTableT> parsingTable, 
 			const SymbolT& startSymbol) :
-			mp_LexicalAnalyzer{ &lexer }, p_Table{ parsingTable }, m_StartSymbol{ startSymbol }
+			mp_LexicalAnalyzer{ &lexer }, m_StartSymbol{ startSymbol }, p_Table{ std::move(parsingTable) }
 		{
 			// TODO: check for argument correctness
 
@@ -3,9 +3,11 @@
 #include <vector>
 #include <set>
 
+#include "parsix/config.h"
 #include "parsix/exception.h"
 #include "parsix/stack.h"
-#include "utility/Logger.h"
+#include "parsix/TerminalSet.h"
+#include "parsix/Logging.h"
 
 
 namespace m0st4fa::parsix {
@@ -30,13 +32,6 @@ namespace m0st4fa::parsix {
 		*/
 		size_t m_Size = 0;
 
-	protected:
-
-		/**
-		 * @brief The logger object used to log information to different output streams.
-		 */
-		Logger p_Logger;
-
 	public:
 
 		/**
@@ -85,14 +80,14 @@ namespace m0st4fa::parsix {
 
 			// the head must be a non-terminal
 			if (head.isTerminal) {
-				this->p_Logger.log(LoggerInfo::ERR_INVALID_VAL, "The head of a production must be a non-terminal.");
+				get_logger().log(LoggerInfo::ERR_INVALID_VAL, "The head of a production must be a non-terminal.");
 
 				throw std::logic_error("The head of a production must be a non-terminal.");
 			}
 
 			// the body cannot be empty
 			if (prodBody.empty()) {
-				this->p_Logger.log(LoggerInfo::ERR_EMPTY_PROD_BODY, "The body of a production cannot be empty.");
+				get_logger().log(LoggerInfo::ERR_EMPTY_PROD_BODY, "The body of a production cannot be empty.");
 
 				throw std::logic_error("The body of a production cannot be empty.");
 			}
@@ -386,10 +381,14 @@ namespace m0st4fa::parsix {
 		 *
 		 * @param other The other grammatical symbol to be checked.
 		 *
-		 * @return `true` if both symbols are equal; `false` otherwise.
+		 * @return `true` if both symbols are of the same kind (both terminals or both non-terminals) and are equal; `false` otherwise.
 		 */
 		bool operator==(const GrammaticalSymbol& other) const {
 
+			// a terminal never equals a non-terminal, even if their enumerators have the same underlying value
+			if (isTerminal != other.isTerminal)
+				return false;
+
 			if (isTerminal)
 				return as.terminal == other.as.terminal;
 			else
@@ -520,13 +519,6 @@ namespace m0st4fa::parsix {
 		 */
 		SymVecType symbols;
 
-	protected:
-
-		/**
-		 * @brief The logger used to write information to the different output streams.
-		 */
-		Logger m_Logger;
-
 	public:
 
 		/**
@@ -608,7 +600,7 @@ namespace m0st4fa::parsix {
 		 * @brief Checks whether the FIRST set for this string is already calculated.
 		 * @return `true` if the FIRST is already calculated for this string of symbols; `false` otherwise.
 		 */
-		bool FIRSTCalculated() { return this->m_CalculatedFIRST; };
+		bool FIRSTCalculated() const { return this->m_CalculatedFIRST; };
 
 		/**
 		 * @brief Returns the cached FIRST set if already calculated; otherwise it logs an error message and throws an exception.
@@ -624,7 +616,7 @@ namespace m0st4fa::parsix {
 			static std::string msg = "The FIRST set of the non-terminals of this grammar symbol string is yet to be calculated.";
 
 			// if FIRST is not already calculated
-			this->m_Logger.log(LoggerInfo::ERR_MISSING_VAL, msg);
+			get_logger().log(LoggerInfo::ERR_MISSING_VAL, msg);
 			throw std::runtime_error(msg);
 		}
 	};
@@ -673,13 +665,21 @@ namespace m0st4fa::parsix {
 		 * @brief Aliases the type of a vector of productions.
 		 */
 		using ProdVecType = std::vector<ProductionT>;
-		// TODO: consider making this use terminals instead for storage efficiency
 		/**
 		 * @brief Aliases the type of a vector of sets of symbol objects.
-		 * @todo **FOR DEVELOPERS** Consider changing it into a vector of sets of *terminals* for storage efficiency.
 		 */
 		using VectorSetSymbolType = std::vector<std::set<SymbolType>>;
 
+		/**
+		 * @brief Aliases the type of a terminal (enumeration type).
+		 */
+		using TerminalType = decltype(SymbolType{}.as.terminal);
+
+		/**
+		 * @brief Aliases the type of a set of terminals, stored as a bitset.
+		 */
+		using TerminalSetType = TerminalSet<SymbolType>;
+
 		/**
 		 * @brief Aliases the type of a symbol string.
 		 */
@@ -687,15 +687,25 @@ namespace m0st4fa::parsix {
 
 		/**
 		* @brief Caches the FIRST set of this production vector.
-		* @details The index of a non-terminal will hold its FIRST set.
+		* @details The index of a non-terminal will hold its FIRST set. This is a copy of `m_FIRSTSets` as sets of symbols.
 		*/
 		VectorSetSymbolType FIRST {0};
 
 		/**
 		 * @brief Caches the FOLLOW set of this production vector.
-		 * @details The index of a non-terminal will hold its FIRST or FOLLOW set.
+		 * @details The index of a non-terminal will hold its FOLLOW set. This is a copy of `m_FOLLOWSets` as sets of symbols.
 		 */
 		VectorSetSymbolType FOLLOW {0};
+
+		/**
+		 * @brief The FIRST set of every non-terminal, as a bitset. A non-terminal is nullable iff its set has `EPSILON`.
+		 */
+		std::vector<TerminalSetType> m_FIRSTSets;
+
+		/**
+		 * @brief The FOLLOW set of every non-terminal, as a bitset.
+		 */
+		std::vector<TerminalSetType> m_FOLLOWSets;
 		
 		/**
 		 * @brief Indicates whether the FIRST set of this production vector was calculated and is cached or not.
@@ -707,21 +717,34 @@ namespace m0st4fa::parsix {
 		 */
 		bool m_CalculatedFOLLOW = false;
 
-		bool _augment_FIRST_of_prod_using_symbol(const ProductionT&, const SymbolType&, bool&, size_t);
-		
-		bool _augment_FOLLOW_of_nonTerminal(VariableType, size_t, size_t);
+		/**
+		 * @brief The indices of the productions (alternatives) of every non-terminal, in increasing order.
+		 */
+		std::vector<std::vector<size_t>> m_Alternatives;
 
-	protected:
+		/**
+		 * @brief Indicates whether the alternatives of the non-terminals are indexed (and the index is up to date) or not.
+		 */
+		bool m_IndexedAlternatives = false;
+
+		TerminalSetType _FIRST_of_body(const ProductionT&, size_t) const;
 
 		/**
-		 * @brief The vector storing the production objects.
+		 * @brief Copies bitsets into sets of symbols.
 		 */
-		ProdVecType p_Vector{};
+		static void _to_symbol_sets(const std::vector<TerminalSetType>& from, VectorSetSymbolType& to) {
+			to.assign(from.size(), {});
+
+			for (size_t i = 0; i < from.size(); i++)
+				to[i].insert(from[i].begin(), from[i].end());
+		}
+
+	protected:
 
 		/**
-		 * @brief The logger object used to log information to output streams.
+		 * @brief The vector storing the production objects.
 		 */
-		Logger p_Logger{};
+		ProdVecType p_Vector{};
 
 	public:
 
@@ -754,7 +777,7 @@ namespace m0st4fa::parsix {
 	     *
 	     * @param[in] prod The production rule to be added.
 	     */
-		void pushProduction(const ProductionT& prod) { this->p_Vector.push_back(prod); }
+		void pushProduction(const ProductionT& prod) { this->p_Vector.push_back(prod); this->m_IndexedAlternatives = false; }
 
 		// element access methods
 
@@ -799,7 +822,7 @@ namespace m0st4fa::parsix {
 		/**
 		 * @brief Clears (eliminates all of the elements of) the production vector.
 		 */
-		void clear() { this->p_Vector.clear(); this->FIRST.clear(); this->FOLLOW.clear(); }
+		void clear() { this->p_Vector.clear(); this->FIRST.clear(); this->FOLLOW.clear(); this->m_FIRSTSets.clear(); this->m_FOLLOWSets.clear(); this->m_Alternatives.clear(); this->m_IndexedAlternatives = false; }
 
 		/**
 		 * @brief Checks whether the production vector is empty or not.
@@ -812,12 +835,12 @@ namespace m0st4fa::parsix {
 		 *
 		 * @param[in] production The production rule to be added.
 		 */
-		void push_back(const ProductionT& production) { p_Vector.push_back(production); }
+		void push_back(const ProductionT& production) { p_Vector.push_back(production); this->m_IndexedAlternatives = false; }
 
 		/**
 		 * @brief Removes the last element from the production vector.
 		 */
-		void pop_back() { p_Vector.pop_back(); }
+		void pop_back() { p_Vector.pop_back(); this->m_IndexedAlternatives = false; }
 
 		// conversion methods
 		/**
@@ -842,13 +865,36 @@ namespace m0st4fa::parsix {
 			return str;
 		}
 
+		// alternatives index methods
+		bool indexAlternatives();
+
+		/**
+		 * @returns `true` if the alternatives of the non-terminals are indexed; `false` otherwise.
+		 */
+		bool alternativesIndexed() const { return this->m_IndexedAlternatives; }
+
+		/**
+		 * @brief Gets the productions (alternatives) of a particular non-terminal.
+		 * @param[in] nonTerminal The non-terminal whose alternatives are to be returned.
+		 * @return The indices of the productions whose head is `nonTerminal`, in increasing order.
+		 * @throw MissingValueException If the alternatives are not yet indexed.
+		 */
+		const std::vector<size_t>& getAlternatives(VariableType nonTerminal) const {
+
+			if (this->m_IndexedAlternatives)
+				return this->m_Alternatives[(size_t)nonTerminal];
+
+			get_logger().log(LoggerInfo::ERR_MISSING_VAL, "The alternatives of the non-terminals of this production vector are yet to be indexed.");
+			throw MissingValueException("The alternatives of the non-terminals of this production vector are yet to be indexed.");
+		}
+
 		// FIRST and FOLLOW calculation methods
 		bool calculateFIRST();
 
 		/**
 		 * @returns `true` if the FIRST set of this production vector is already calculated; `false` otherwise.
 		 */
-		bool FIRSTCalculated() { return this->m_CalculatedFIRST; };
+		bool FIRSTCalculated() const { return this->m_CalculatedFIRST; };
 
 		/**
 		 * @brief Gets the FIRST set of a particular terminal using the FIRST set of this production vector.
@@ -863,7 +909,7 @@ namespace m0st4fa::parsix {
 				return this->FIRST[(size_t)nonTerminal];
 
 			// handle the non-presence of the FIRST set for this production vector
-			this->p_Logger.log(LoggerInfo::ERR_MISSING_VAL, "The FIRST set of the non-terminals of this production vector is yet to be calculated.");
+			get_logger().log(LoggerInfo::ERR_MISSING_VAL, "The FIRST set of the non-terminals of this production vector is yet to be calculated.");
 			throw MissingValueException( "The FIRST set of the non-terminals of this production vector is yet to be calculated." );
 		};
 
@@ -875,12 +921,35 @@ namespace m0st4fa::parsix {
 			return this->FIRST;
 		}
 
+		/**
+		 * @brief Gets the FIRST set of a particular non-terminal as a bitset.
+		 * @param[in] nonTerminal The non-terminal whose FIRST set is to be returned.
+		 * @return FIRST(`nonTerminal`); it has `EPSILON` iff `nonTerminal` is nullable.
+		 * @throw MissingValueException If FIRST(`nonTerminal`) is not yet calculated.
+		 */
+		const TerminalSetType& getFIRSTSet(VariableType nonTerminal) const {
+
+			if (this->m_CalculatedFIRST)
+				return this->m_FIRSTSets[(size_t)nonTerminal];
+
+			get_logger().log(LoggerInfo::ERR_MISSING_VAL, "The FIRST set of the non-terminals of this production vector is yet to be calculated.");
+			throw MissingValueException("The FIRST set of the non-terminals of this production vector is yet to be calculated.");
+		}
+
+		/**
+		 * @brief Checks whether a non-terminal derives the empty string.
+		 * @throw MissingValueException If FIRST(`nonTerminal`) is not yet calculated.
+		 */
+		bool isNullable(VariableType nonTerminal) const {
+			return this->getFIRSTSet(nonTerminal).contains(TerminalType::T_EPSILON);
+		}
+
 		bool calculateFOLLOW();
 
 		/**
 		 * @returns `true` if the FOLLOW set of this production vector is already calculated; `false` otherwise.
 		 */
-		bool FOLLOWCalculated() { return this->m_CalculatedFOLLOW; };
+		bool FOLLOWCalculated() const { return this->m_CalculatedFOLLOW; };
 		
 		/**
 		 * @brief Gets the FOLLOW set of a particular terminal using the FOLLOW set of this production vector.
@@ -888,14 +957,14 @@ namespace m0st4fa::parsix {
 		 * @return FOLLOW(`nonTerminal`).
 		 * @throw MissingValueException If FOLLOW(`nonTerminal`) is not yet calculated.
 		 */
-		std::set<SymbolType> getFOLLOW(const VariableType nonTerminal) {
+		std::set<SymbolType> getFOLLOW(const VariableType nonTerminal) const {
 
 			// if FOLLOW is already calculated
 			if (this->m_CalculatedFOLLOW)
 				return this->FOLLOW[(size_t)nonTerminal];
 
 			// handle the non-presence of the FOLLOW set for this production vector
-			this->p_Logger.log(LoggerInfo::ERR_MISSING_VAL, "The FOLLOW set of the non-terminals of this production vector is yet to be calculated.");
+			get_logger().log(LoggerInfo::ERR_MISSING_VAL, "The FOLLOW set of the non-terminals of this production vector is yet to be calculated.");
 			throw MissingValueException("The FOLLOW set of the non-terminals of this production vector is yet to be calculated.");
 		};
 		
@@ -903,10 +972,25 @@ namespace m0st4fa::parsix {
 		 * @brief Gets a constant reference to the entire FOLLOW (calculated so far) for this production vector.
 		 * @return A constant reference to the entire FOLLOW set (calculated so far) for this production vector.
 		 */
-		const VectorSetSymbolType& getFOLLOW() {
+		const VectorSetSymbolType& getFOLLOW() const {
 			return this->FOLLOW;
 		}
 
+		/**
+		 * @brief Gets the FOLLOW set of a particular non-terminal as a bitset.
+		 * @param[in] nonTerminal The non-terminal whose FOLLOW set is to be returned.
+		 * @return FOLLOW(`nonTerminal`).
+		 * @throw MissingValueException If FOLLOW(`nonTerminal`) is not yet calculated.
+		 */
+		const TerminalSetType& getFOLLOWSet(VariableType nonTerminal) const {
+
+			if (this->m_CalculatedFOLLOW)
+				return this->m_FOLLOWSets[(size_t)nonTerminal];
+
+			get_logger().log(LoggerInfo::ERR_MISSING_VAL, "The FOLLOW set of the non-terminals of this production vector is yet to be calculated.");
+			throw MissingValueException("The FOLLOW set of the non-terminals of this production vector is yet to be calculated.");
+		}
+
 	};
 
 	// ALIASES
@@ -916,432 +1000,153 @@ namespace m0st4fa::parsix {
 
 namespace m0st4fa::parsix {
 
-	/** 1st Algorithm, assuming non-terminal `E` and a boolean isCalculated
-	* If isCaculated, return; else proceed.
-	* Go through every production of `E`.
-	* Take the FIRST set of the first grammar symbol `T` of that production (and cache it for possible use later).
-	* Ignore that grammar symbol if it is currSymbol (this avoids lots of indirect recursion).
-		* Note that this is not a problem, since in this case the FIRST set of the `E` is a subset of the FIRST set of `T`.
-	*	 - However, we are already calculating the FIRST set of `E`.
-	*	 - Operate in two modes, the mode in which you have a currSymbol and the in which you do not.
-	* Loop and do this until the FIRST set of that grammar symbol does not contain epsilon.
-	*	 - If, while looping you encounter `E` or `E` is the first grammar symbol of the production, put the production in pending list with the index of `E`.
-	*		 - In case epsilon is in the FIRST set of `E`, we will need to rescan this production again from after index.
-	*	 - If you reach the end of the production, if the last (cached) FIRST set has epsilon, make sure it is in FIRST set of `E`.
-	* Set isCalculated to true.
-	*/
-
-	/** 
-	* **Algorithm**\n
-	* - Loop through every production of the grammar until you cannot add another terminal to the first set of any non-terminal.
-	* - Variable added asserts whether we added any terminal in the last iteration to the FIRST set of any non-terminal.
-	* - For every production `P` and its head `H`:
-	*	 - For every grammar symbol `S` of the body of `P`:
-	*		- If `S` == `H`, check whether `FIRST(H)` contains epsilon:
-	*			- If it does, check whether we are at the end of the body of `P`:
-	*				- If we are, add epsilon to `FIRST(H)` [Note: already added].
-	*				- If we are not, move on to the next grammar symbol.
-	*			- If it does not, move on to the next production.
-	*		- If `S` is a terminal `T`, add `T` to `FIRST(H)` and move on to the next production.
-	*			- If `T` is added (was not already there), set added to true.
-	*		- If `S` is a non-terminal `N`:
-	*			- `F` = `FIRST(N)`, `FE` = `F` has epsilon?, `HE` = `S` has epsilon?
-	*			- Add the current `F` to `FIRST(H)`.
-	*				- If any terminal was added (was not already there) set added to true.
-	*			- If (`FE` && !`HE`) remove the epsilon from `FIRST(H)`.
-	*				- Note: the condition means: if `F` has epsilon and `FIRST(H)` didn't have epsilon before merging the two FIRST sets.
-	*			- If FE, check whether we are at the end of the body of `P`:
-	*				- If we are, add epsilon to `FIRST(H)`.
-	*					- If it was added (was not already there) set added to true.
-	*				- If we are not, move on to the next grammar symbol of the body of `P`.
-	*		- Move on to the next production.
-	*
-	*/
-
 	/**
-	 * @brief Calculates the FIRST set for all productions in the ProductionVector.
-	 *
-	 * @tparam ProductionT The type of production objects.
-	 * 
-	 * @return `true` if the FIRST set has been calculated, `false` otherwise.
+	 * @brief Indexes (if not already indexed) the productions of every non-terminal, so that getAlternatives() does not have to scan the whole production vector.
+	 * @details The index is invalidated whenever a production is added or removed.
+	 * @return `true` if the alternatives have been indexed.
 	 */
 	template<typename ProductionT>
-	bool ProductionVector<ProductionT>::calculateFIRST()
+	bool ProductionVector<ProductionT>::indexAlternatives()
 	{
-
-		// if FIRST is already calculated, return
-		if (this->m_CalculatedFIRST) {
-			this->p_Logger.logDebug("FIRST set for this production vector has already been calculated!");
+		if (this->m_IndexedAlternatives)
 			return true;
-		}
-
-		using SetPair = std::pair<std::set<SymbolType>, bool>;
-
-		// resize the FIRST set to accommodate an entry for all non-terminals
-		this->FIRST.resize((size_t)decltype(SymbolType().as.nonTerminal)::NT_COUNT);
-		bool added = false;
-
-		this->p_Logger.logDebug("\nCALCULATING FIRST SET:\n");
-		this->p_Logger.logDebug(std::format("Productions:\n {}", (std::string)*this));
-
-		while (true) {
-
-			// loop through every production
-			for (const ProductionT& prod : this->getProdVector()) {
-
-				// loop through every symbol of the production
-				for (size_t index = 1; const auto & stackElement : prod.prodBody) {
-
-					// if the current stack element of the production is not a grammar symbol
-					if (stackElement.type != ProdElementType::PET_GRAM_SYMBOL)
-						// move on to the next stack element of the production
-						continue;
-
-					// if the current stack element is a grammar symbol
-
-					// get the symbol and its first set (if any)
-					const SymbolType& symbol = stackElement.as.gramSymbol;
-
-					// continue or not to the next symbol?
-					bool cont = _augment_FIRST_of_prod_using_symbol(prod, symbol, added, index);
-
-					// increment the index of the current element
-					++index;
-
-					if (!cont)
-						break;
-
-				}
-
-			}
-
-			this->p_Logger.logDebug(std::format("Is there any new terminal added in this round? {}", added ? "true" : "false"));
-			if (-not added) {
 
-				//// if we still have extra rounds
-				//if (extraRound--)
-				//	// reduce the number of rounds and continue to the next iteration
-				//	continue;
+		this->m_Alternatives.assign((size_t)VariableType::NT_COUNT, {});
 
-				this->p_Logger.logDebug("Finished creating the FIRST set of all non-terminals of this grammar");
+		for (size_t prodIndex = 0; const ProductionT& prod : this->p_Vector)
+			this->m_Alternatives[(size_t)prod.prodHead.as.nonTerminal].push_back(prodIndex++);
 
-#ifdef _DEBUG	
-				for (size_t i = 0; const std::set<SymbolType>&set : this->FIRST) {
-
-					// if the set is empty, continue (in this case it does not belong to a non-terminal)
-					if (set.empty()) {
-						i++;
-						continue;
-					}
-
-					// get variable
-					auto variable = (decltype(set.start()->as.nonTerminal))i++;
-
-					this->p_Logger.logDebug(std::format("FIRST({}) = {}", toString(variable), m0st4fa::toString(set)));
-				}
-#endif
-
-
-				break;
-			}
-
-			added = false;
-		}
-
-		// if we reached here, that means that FIRST has been calculated
-		return this->m_CalculatedFIRST = true;
+		return this->m_IndexedAlternatives = true;
 	}
 
 	/**
-	 * @brief Augments FIRST for the head of a production, based on the currently available information (the current context).
-	 * 
-	 * @tparam ProductionT The type of the production.
-	 * @param[in] prod The production for which to calculate the FIRST set.
-	 * @param[in] symbol The symbol of the production body whose FIRST set will be added to the FIRST set of this production.
-	 * @param[out] added A boolean flag that is set to true if a new terminal (from FIRST(`symbol`)) is added to the FIRST set of the head of the production.
-	 * @param[in] index The index of the `symbol` in the production body. This is used to check whether `symbol` is the last symbol in the production body or not.
-	 * 
-	 * @details This function implements logic for augmenting the FIRST set of a production's head symbol using another symbol. It considers various cases depending on whether the `symbol` is a terminal or a non-terminal and the context within the production body.
-	 *
-	 * - If the `symbol` is a terminal, it's directly added to the FIRST set of the
-	 *   head symbol.
-	 * - If the `symbol` is a non-terminal:
-	 *   - The FIRST set of the non-terminal is used to augment the head's FIRST set.
-	 *   - Epsilon might be added to the head's FIRST set depending on whether the
-	 *     non-terminal's FIRST set contains epsilon, the position within the
-	 *     production body, and whether the head itself has epsilon in its FIRST set.
-	 *
-	 * @note This function is an internal implementation detail and should not be called directly by user code.
-	 * 
-	 * @returns `true` if the FIRST set of `symbol` has epsilon and is not the last symbol in the production body (and thus, we should seek the FIRST of the next symbol in order in the production body); `false` otherwise.
+	 * @brief Calculates FIRST of the grammar symbols of the body of a production, starting from a given element, using the FIRST sets (calculated so far) of the non-terminals.
+	 * @param[in] production The production.
+	 * @param[in] from The index of the first element of the body to take into account. Non-grammar-symbol elements are skipped.
+	 * @returns FIRST of the symbols; it has `EPSILON` iff all of them are nullable (in particular, if there are none).
 	 */
 	template<typename ProductionT>
-	bool ProductionVector<ProductionT>::_augment_FIRST_of_prod_using_symbol(const ProductionT& prod, const SymbolType& symbol, bool& added, size_t index)
+	auto ProductionVector<ProductionT>::_FIRST_of_body(const ProductionT& production, size_t from) const -> TerminalSetType
 	{
+		TerminalSetType first;
 
-		const SymbolType& head = prod.prodHead;
-		auto setIndexH = (size_t)head.as.nonTerminal;
-		std::set<SymbolType>& fsetH = this->FIRST[setIndexH];
-
-		// check whether the first set contains epsilon
-		bool containsEpsilonH = fsetH.contains(SymbolType::EPSILON);
-
-		// if the symbol is a non-terminal
-		if (!symbol.isTerminal) {
-
-			// get the first set of the symbol	
-			auto setIndexN = (size_t)symbol.as.nonTerminal;
-			std::set<SymbolType>& fsetN = this->FIRST[setIndexN];
-
-			// check whether the first set contains epsilon
-			bool containsEpsilonN = fsetN.contains(SymbolType::EPSILON);
-			// if the symbol is the same as head
-			if (symbol == head) {
-				/**
-				* If `S` ==`H`, check whether `FIRST(H)` contains epsilon:
-				*	 - If it does, check whether we are at the end of the body of `P`:
-				*		 - If we are, add epsilon to `FIRST(H)` [Note: already added].
-				*		 - If we are not, move on to the next grammar symbol.
-				*	 - If it does not, move on to the next production.
-				*/
-
-				// 1. if the first set does not contain epsilon
-				if (!containsEpsilonN)
-					// move on to the next production
-					return false;
-
-				// 2. if FIRST contains epsilon
-
-				// move on to the next grammar symbol, which will automatically move on to the next production if this is the last grammar symbol
-				// Note: epsilon is already added (that's why we are here in the first place)
-				return true;
-			}
-
-			// if the symbol is different from head
-			/**
-			* If `S` is a non-terminal `N`:
-				* `F` = `FIRST(N)`, `FE` = `F` has epsilon?, `HE` = `S` has epsilon?
-				* Add the current `F` to `FIRST(H)`.
-					* If any terminal was added (was not already there) set added to true.
-				* If (`FE` && !`HE`) remove the epsilon from `FIRST(H)`.
-					* Note: the condition means: if `F` has epsilon and `FIRST(H)` didn't have epsilon before mergin the two FIRST sets.
-				* If FE, check whether we are at the end of the body of `P`:
-					* If we are, add epsilon to `FIRST(H)`.
-					* If it was added (was not already there) set added to true.
-					* If we are not, move on to the next grammar symbol of the body of `P`.
-			*/
-
-			if (fsetN.empty())
-				return false;
-
-			// loop through each symbol of the FIRST set of the current non-terminal
-			for (const auto& symbol : fsetN) {
-
-				// skip to the next symbol if the current is epsilon (optimize this out if you could)
-				if (symbol == SymbolType::EPSILON)
-					return true;
-
-				// add the symbol to the FIRST set of the head
-				// BUG: the symbol is inserted although it exists
-				auto p = this->FIRST[setIndexH].insert(symbol);
+		for (size_t index = from; index < production.prodBody.size(); index++) {
+			const auto& stackElement = production.prodBody[index];
 
-				// if it was added, set the boolean
-				if (p.second) {
-					added = true;
-
-					this->p_Logger.logDebug(
-						std::format("Added terminal {} to FIRST({}), which is now: {}",
-							(std::string)symbol,
-							(std::string)head,
-							m0st4fa::toString(this->FIRST[setIndexH])));
-
-				}
-			}
-
-			// if the non-terminal contains epsilon
-			if (containsEpsilonN) {
-				// check whether we are at the end of the production
-				bool atEnd = index == prod.prodBody.size();
-
-				// if we are not at the end of the production
-				if (!atEnd)
-					// continue to the next grammar symbol
-					return false;
-
-				// if we are at the end of the production
-
-				if (!containsEpsilonH) {
-					// add epsilon to the FIRST set of the head
-					auto p = this->FIRST[setIndexH].insert(SymbolType::EPSILON);
+			if (stackElement.type != ProdElementType::PET_GRAM_SYMBOL)
+				continue;
 
-					if (p.second) {
-						added = true;
+			const SymbolType& symbol = stackElement.as.gramSymbol;
 
-						this->p_Logger.logDebug(
-							std::format("Added terminal {} to FIRST({}), which is now: {}",
-								(std::string)SymbolType::EPSILON,
-								(std::string)head,
-								m0st4fa::toString(this->FIRST[setIndexH])));
-					}
-				}
+			if (symbol.isTerminal) {
+				// epsilon derives nothing; move on to the next symbol
+				if (symbol.as.terminal == TerminalType::T_EPSILON)
+					continue;
 
+				first.insert(symbol.as.terminal);
+				return first;
 			}
 
-			// if does not, continue to the next grammar symbol
-			return false;
-		}
-		else {
-			/**
-				*If `S` is a terminal `T`, add `T` to `FIRST(H)` and move on to the next production.
-				*	 - If `T` is added(was not already there), set added to true.
-			*/
-
-			// add epsilon to the FIRST set of the head
-			if (auto p = this->FIRST[setIndexH].insert(symbol); p.second) {
-				added = true;
-
-				this->p_Logger.logDebug(
-					std::format("Added terminal {} to FIRST({}), which is now: {}",
-						(std::string)symbol,
-						(std::string)head,
-						m0st4fa::toString(this->FIRST[setIndexH])));
-			}
+			const TerminalSetType& fset = this->m_FIRSTSets[(size_t)symbol.as.nonTerminal];
+			first |= fset;
+			first.erase(TerminalType::T_EPSILON);
 
-			// continue to the next production
-			return false;
+			if (not fset.contains(TerminalType::T_EPSILON))
+				return first;
 		}
 
-		// THIS IS UNREACHABLE
-		// go to the next production by default
-		return false;
+		first.insert(TerminalType::T_EPSILON);
+		return first;
 	}
 
 	/**
-	 * @brief Augments the FOLLOW set of nonterminal, using (only) a single input production.
-	 * 
-	 * @tparam ProductionT The type of the production.
-	 * @param[in] nonTerminal The non-terminal whose FOLLOW set is to be calculated and augmented.
-	 * @param[in] prodIndex The index of the production that will be used to calculate FOLLOW in the ProductionVector.
-	 * @param[in] variableIndex The index of the non-terminal (whose FOLLOW will be calculated) in the production.
-	 * 
-	 * @return `true` if a new terminal was added to the FOLLOW set; `false` otherwise.
-	 * 
-	 * @details  This function calculates the FOLLOW set of a non-terminal symbol within a production. It considers the position of the non-terminal within the production body and the FOLLOW set of the production's head symbol.
-	 *
-	 * The algorithm iterates through subsequent symbols in the production body after the target non-terminal:
+	* **Algorithm** (worklist over productions)\n
+	* - For every non-terminal `N`, record the productions having `N` in their bodies; they are the only ones whose FIRST may grow when FIRST(`N`) grows.
+	* - Start with every production in the worklist. While the worklist is not empty, take a production `P` with head `H` out of it:
+	*	 - Add FIRST of the body of `P` (see `_FIRST_of_body()`) to `FIRST(H)`.
+	*	 - If `FIRST(H)` has grown, put every production having `H` in its body back into the worklist (if it is not already in it).
+	* - FIRST sets are bitsets, so every step is a few word-wise ORs. The result is also copied into sets of symbols for `getFIRST()`.
+	*/
+
+	/**
+	 * @brief Calculates the FIRST set for all productions in the ProductionVector.
 	 *
-	 * - If a subsequent symbol is a terminal, it's directly added to the FOLLOW set of the target non-terminal.
-	 * - If a subsequent symbol is a non-terminal:
-	 *   - The FIRST set of the non-terminal is used to contribute to the FOLLOW set of the target non-terminal.
-	 *   - Epsilon might be removed from the FOLLOW set of the target non-terminal depending on whether the subsequent non-terminal's FIRST set contains epsilon and the position within the production body.
+	 * @tparam ProductionT The type of production objects.
+	 * 
+	 * @return `true` if the FIRST set has been calculated, `false` otherwise.
 	 */
 	template<typename ProductionT>
-	bool ProductionVector<ProductionT>::_augment_FOLLOW_of_nonTerminal(VariableType nonTerminal, size_t prodIndex, size_t variableIndex)
+	bool ProductionVector<ProductionT>::calculateFIRST()
 	{
 
-		// head-related values
-		const ProductionT& production = this->getProdVector().at(prodIndex);
-		const size_t prodBdySz = production.prodBody.size();
-		const SymbolType& head = production.prodHead;
-		size_t headIndex = (size_t)head.as.nonTerminal;
-		const std::set<SymbolType>& headFollow = this->FOLLOW.at(headIndex);
-
-		// current symbol related values
-		const size_t currSymIndex = (size_t)nonTerminal;
-		std::set<SymbolType>& currSymFollow = this->FOLLOW.at(currSymIndex);
-		bool added = false;
-
-		auto cpyToFollow = [this, currSymIndex, nonTerminal, &currSymFollow, &added](const SymbolType& sym) {
-			auto p = currSymFollow.insert(sym);
-
-			// if a new element was added (exclude epsilon)
-			if (p.second && *p.first != SymbolType::EPSILON) {
-				added = true;
-				this->p_Logger.logDebug(
-					std::format("Added terminal {} to FOLLOW({}), which is now: {}",
-						(std::string)sym,
-						toString(nonTerminal),
-						m0st4fa::toString(this->FOLLOW[currSymIndex])));
-
-			}
-
-		};
-
-
-		// test if this non-terminal is the last of its production body
-		bool lastSymbol = variableIndex == prodBdySz - 1;
+		// if FIRST is already calculated, return
+		if (this->m_CalculatedFIRST) {
+			get_logger().logDebug("FIRST set for this production vector has already been calculated!");
+			return true;
+		}
 
-		// if this is the last symbol of the production body
-		if (lastSymbol) {
-			// add FOLLOW(head) to FOLLOW(currSymbol)
-			std::for_each(headFollow.begin(), headFollow.end(), cpyToFollow);
-			return added;
-		};
+		const size_t varCount = (size_t)VariableType::NT_COUNT;
+		const size_t prodCount = this->p_Vector.size();
 
-		for (size_t varIndex = variableIndex + 1; varIndex < prodBdySz; varIndex++) {
+		this->m_FIRSTSets.assign(varCount, TerminalSetType{});
 
-			// check if the current symbol we are examining in the production is a grammar symbol 
-			if (production.prodBody.at(varIndex).type != ProdElementType::PET_GRAM_SYMBOL) {
-				// check if we are at the end of the production
-				bool atEnd = varIndex + 1 == prodBdySz;
+		if constexpr (TRACE_ENABLED) {
+			get_logger().logDebug("\nCALCULATING FIRST SET:\n");
+			get_logger().logDebug(std::format("Productions:\n {}", (std::string)*this));
+		}
 
-				// continue to the next symbol if we are not at the end of the production
-				if (-not atEnd)
+		// the productions having every non-terminal in their bodies
+		std::vector<std::vector<size_t>> dependents(varCount);
+		for (size_t prodIndex = 0; prodIndex < prodCount; prodIndex++)
+			for (const auto& stackElement : this->p_Vector[prodIndex].prodBody) {
+				if (stackElement.type != ProdElementType::PET_GRAM_SYMBOL || stackElement.as.gramSymbol.isTerminal)
 					continue;
 
-				// if we are at the end of the production add FOLLOW(head) to FOLLOW(currSym)
-				std::for_each(headFollow.begin(), headFollow.end(), cpyToFollow);
-
-				break;
+				std::vector<size_t>& prods = dependents[(size_t)stackElement.as.gramSymbol.as.nonTerminal];
+				if (prods.empty() || prods.back() != prodIndex)
+					prods.push_back(prodIndex);
 			}
 
-			const SymbolType symbol = production.prodBody.at(varIndex).as.gramSymbol;
-			size_t symIndex = (size_t)symbol.as.nonTerminal;
+		// every production is processed at least once; the first ones are processed first
+		std::vector<size_t> worklist(prodCount);
+		std::vector<bool> queued(prodCount, true);
+		for (size_t i = 0; i < prodCount; i++)
+			worklist[i] = prodCount - 1 - i;
 
-			// if the symbol is a terminal
-			if (symbol.isTerminal) {
-				auto p = this->FOLLOW.at(currSymIndex).insert(symbol);
+		while (not worklist.empty()) {
+			const size_t prodIndex = worklist.back();
+			worklist.pop_back();
+			queued[prodIndex] = false;
 
-				this->p_Logger.logDebug(
-					std::format("Added terminal {} to FOLLOW({}), which is now: {}",
-						(std::string)symbol,
-						toString(nonTerminal),
-						m0st4fa::toString(this->FOLLOW[currSymIndex])));
+			const ProductionT& prod = this->p_Vector[prodIndex];
+			const size_t head = (size_t)prod.prodHead.as.nonTerminal;
 
-				// return whether a new element has been inserted
-				return p.second;
-			}
-
-			// if the symbol is a non-terminal 
-			// assumes that FIRST(symbol) is already calculated
-			const std::set<SymbolType>& symbolFrst = this->FIRST.at(symIndex);
-			std::for_each(symbolFrst.begin(), symbolFrst.end(), cpyToFollow);
-
-			// Try erase epsilon from follow: returns 1 or 0, the number of removed elements
-			// Note: this also indicates whether we had epsilon or not.
-			bool containsEpsilon = currSymFollow.erase(SymbolType::EPSILON);
+			if (not this->m_FIRSTSets[head].unite(this->_FIRST_of_body(prod, 0)))
+				continue;
 
-			// if the FOLLOW set of the curr symbol does not contain epsilon
-			if (-not containsEpsilon)
-				return added;
+			if constexpr (TRACE_ENABLED)
+				get_logger().logDebug(std::format("FIRST({}) is now: {}", (std::string)prod.prodHead, this->m_FIRSTSets[head].toString()));
 
-			/**
-			* Check if we are at the end of `P`:
-				* If we are, add `FOLLOW(H)` to `FOLLOW(S)`.
-				* If we are not, continue to the next symbol.
-			*/
-			// check if we are at the end of the production
-			bool atEnd = varIndex + 1 == prodBdySz;
+			// FIRST(head) has grown; the productions using it must be processed again
+			for (size_t dependent : dependents[head])
+				if (not queued[dependent]) {
+					queued[dependent] = true;
+					worklist.push_back(dependent);
+				}
+		}
 
-			if (-not atEnd)
-				continue;
+		_to_symbol_sets(this->m_FIRSTSets, this->FIRST);
 
-			// if we are at the end of the production add FOLLOW(head) to FOLLOW(currSym)
-			std::for_each(headFollow.begin(), headFollow.end(), cpyToFollow);
+		get_logger().logDebug("Finished creating the FIRST set of all non-terminals of this grammar");
 
-		}
+#ifdef _DEBUG	
+		for (size_t i = 0; i < varCount; i++)
+			if (not this->m_FIRSTSets[i].empty())
+				get_logger().logDebug(std::format("FIRST({}) = {}", toString((VariableType)i), this->m_FIRSTSets[i].toString()));
+#endif
 
-		return added;
+		// if we reached here, that means that FIRST has been calculated
+		return this->m_CalculatedFIRST = true;
 	}
 
 	/**
@@ -1361,142 +1166,95 @@ namespace m0st4fa::parsix {
 
 		// if follow is already calculated, return
 		if (this->m_CalculatedFOLLOW) {
-			this->p_Logger.logDebug("FOLLOW set for this production vector has already been calculated!");
+			get_logger().logDebug("FOLLOW set for this production vector has already been calculated!");
 			return true;
 		}
 
 		// check that FIRST is calculated before proceeding
 		if (!this->m_CalculatedFIRST) {
-			this->p_Logger.log(LoggerInfo::ERR_MISSING_VAL, "FIRST set is not calculated for the production vector: FIRST set must be calculated for a production vector before proceeding to calculate the FOLLOW set for that production vector.");
+			get_logger().log(LoggerInfo::ERR_MISSING_VAL, "FIRST set is not calculated for the production vector: FIRST set must be calculated for a production vector before proceeding to calculate the FOLLOW set for that production vector.");
 			throw std::runtime_error("FIRST set is not calculated for the production vector!");
 		};
 
 		/** 
-		# General Algorithm:
-		* - Loop through every production of the grammar until you cannot add another terminal to the FOLLOW set of any non-terminal.
-		* - Variable added asserts whether we added any terminal in the last iteration to the FOLLOW set of any non-terminal.
-		* - For every production `P` and its head `H`:
-		*		- For every grammar symbol `S` of the body of `P`:
-		*			- If `S` is a terminal, get to the next grammar symbol.
-		*			- If `S` is a non-terminal call `getFOLLOWOfNonTerminal`.
+		# Algorithm (propagation over the inclusion graph):
+		* - FOLLOW(S) has the end marker, for the start symbol `S`.
+		* - For every occurrence of a non-terminal `N` in a production `H -> alpha N beta`:
+		*	- Add FIRST(`beta`) (without epsilon) to FOLLOW(`N`). This part never changes, so it is done once.
+		*	- If `beta` is nullable, FOLLOW(`H`) is included in FOLLOW(`N`): add an edge from `H` to `N`.
+		* - Start with every non-terminal in the worklist. While the worklist is not empty, take a non-terminal `H` out of it and add FOLLOW(`H`) to FOLLOW(`N`) for every edge from `H` to `N`; put `N` back into the worklist if FOLLOW(`N`) has grown.
 		**/
 
-		/*
-		## Algorithm for getFOLLOWOfNonTerminal():
-		#### input:
-		*- Non-terminal `N`.
-		*- Index `I1` of the current production `P` within the production vector.
-		*- Index of `N` within this production.
-		#### output: 
-		*- Augments FOLLOW(N) using currently available information.
-		#### method: 
-		*- For every symbol `S` after `N` in production `P` whose index is `I2`:
-		*	- If `S` is a terminal, add `S` to `FOLLOW(N)` and return.
-		*	- If `S` is a non-terminal, add FIRST(`S`) to `FOLLOW(N)`, then check whether `FOLLOW(N)` contains epsilon:
-		*		- If `FOLLOW(N)` contains epsilon:
-		*			- remove epsilon.
-		*				- Check if we are at the end of `P`:
-		*					- If we are, add `FOLLOW(H)` to FOLLOW(`S`).
-		*					- If we are not, continue to the next symbol.
-		*		- If `FOLLOW(N)` doesn't contain epsilon, return.
-		*/
+		const size_t varCount = (size_t)VariableType::NT_COUNT;
 
-		// make sure FOLLOW can hold all the non-terminals
-		this->FOLLOW.resize((size_t)decltype(SymbolType().as.nonTerminal)::NT_COUNT);
+		this->m_FOLLOWSets.assign(varCount, TerminalSetType{});
 
-		
-		bool added = false;
+		if constexpr (TRACE_ENABLED) {
+			get_logger().logDebug("\nCALCULATING FOLLOW SET:\n");
+			get_logger().logDebug(std::format("Productions:\n {}", (std::string)*this));
+		}
 
-		this->p_Logger.logDebug("\nCALCULATING FOLLOW SET:\n");
-		this->p_Logger.logDebug(std::format("Productions:\n {}", (std::string)*this));
+		const size_t startHeadIndex = (size_t)this->p_Vector.at(0).prodHead.as.nonTerminal;
+		this->m_FOLLOWSets[startHeadIndex].insert(TerminalType::T_EOF);
 
-		const ProductionT& startProd = getProdVector().at(0);
-		const SymbolType& startSym = startProd.prodHead;
-		size_t startHeadIndex = (size_t)startSym.as.nonTerminal;
+		// the non-terminals whose FOLLOW sets include FOLLOW of every non-terminal
+		std::vector<std::vector<size_t>> successors(varCount);
 
-		this->FOLLOW.at(startHeadIndex).insert(SymbolType::END_MARKER);
+		for (const ProductionT& prod : this->p_Vector) {
+			const size_t head = (size_t)prod.prodHead.as.nonTerminal;
 
-		while (true) {
+			for (size_t symIndex = 0; symIndex < prod.prodBody.size(); symIndex++) {
+				const auto& stackElement = prod.prodBody[symIndex];
 
-			/** \cond
-			* Loop through every production of the grammar until you cannot add another terminal to the FOLLOW set of any non-terminal.
-			* Variable added asserts whether we added any terminal in the last iteration to the FOLLOW set of any non-terminal.
-			* For every production `P` and its head `H`:
-				* For every grammar symbol `S` of the body of `P`:
-					* If `S` is a terminal, get to the next grammar symbol.
-					* If `S` is a non-terminal call `getFOLLOWOfNonTerminal`.
-			\endcond
-			*/
+				if (stackElement.type != ProdElementType::PET_GRAM_SYMBOL || stackElement.as.gramSymbol.isTerminal)
+					continue;
 
-			for (size_t prodIndex = 0; const auto & prod : this->getProdVector()) {
+				const size_t nonTerminal = (size_t)stackElement.as.gramSymbol.as.nonTerminal;
 
-				for (size_t symIndex = 0; const auto& stackElement : prod.prodBody) {
+				TerminalSetType rest = this->_FIRST_of_body(prod, symIndex + 1);
+				const bool restIsNullable = rest.erase(TerminalType::T_EPSILON);
 
-					// if the current stack element of the production is not a grammar symbol
-					if (stackElement.type != ProdElementType::PET_GRAM_SYMBOL) {
-						// move on to the next stack element of the production
-						symIndex++;
-						continue;
-					}
+				this->m_FOLLOWSets[nonTerminal] |= rest;
 
-					// if the current stack element is a grammar symbol
+				if (restIsNullable && nonTerminal != head)
+					successors[head].push_back(nonTerminal);
+			}
+		}
 
-					// get the symbol and its first set (if any)
-					const SymbolType& symbol = stackElement.as.gramSymbol;
+		std::vector<size_t> worklist(varCount);
+		std::vector<bool> queued(varCount, true);
+		for (size_t i = 0; i < varCount; i++)
+			worklist[i] = varCount - 1 - i;
 
-					// if the symbol is a terminal, get to the next symbol
-					if (symbol.isTerminal) {
-						symIndex++;
-						continue;
-					}
+		while (not worklist.empty()) {
+			const size_t head = worklist.back();
+			worklist.pop_back();
+			queued[head] = false;
 
-					// if the symbol is a non-terminal
-					bool _added = this->_augment_FOLLOW_of_nonTerminal(symbol.as.nonTerminal, prodIndex, symIndex);
+			for (size_t nonTerminal : successors[head]) {
+				if (not this->m_FOLLOWSets[nonTerminal].unite(this->m_FOLLOWSets[head]))
+					continue;
 
-					// set added
-					if (_added)
-						added = true;
+				if constexpr (TRACE_ENABLED)
+					get_logger().logDebug(std::format("FOLLOW({}) is now: {}", toString((VariableType)nonTerminal), this->m_FOLLOWSets[nonTerminal].toString()));
 
-					// increment the index of the symbol
-					symIndex++;
+				if (not queued[nonTerminal]) {
+					queued[nonTerminal] = true;
+					worklist.push_back(nonTerminal);
 				}
-
-				prodIndex++;
 			}
+		}
 
-			this->p_Logger.logDebug(std::format("Is there any new terminal added to any FOLLOW set in this round? {}", added ? "true" : "false"));
-			if (-not added) {
+		_to_symbol_sets(this->m_FOLLOWSets, this->FOLLOW);
 
-				//// if we still have extra rounds
-				//if (extraRound--)
-				//	// reduce the number of rounds and continue to the next iteration
-				//	continue;
+		get_logger().logDebug("Finished creating the FOLLOW set of all non-terminals of this grammar");
 
-				this->p_Logger.logDebug("Finished creating the FOLLOW set of all non-terminals of this grammar");
 #if defined(_DEBUG)
-				for (size_t i = 0; const std::set<SymbolType>&set : this->FOLLOW) {
-
-					// if the set is empty, continue (in this case it does not belong to a non-terminal)
-					if (set.empty()) {
-						i++;
-						continue;
-					}
-
-					// get variable
-					auto variable = (decltype(set.start()->as.nonTerminal))i++;
-
-					this->p_Logger.logDebug(std::format("FOLLOW({}) = {}", toString(variable), m0st4fa::toString(set)));
-
-				}
+		for (size_t i = 0; i < varCount; i++)
+			if (not this->m_FOLLOWSets[i].empty())
+				get_logger().logDebug(std::format("FOLLOW({}) = {}", toString((VariableType)i), this->m_FOLLOWSets[i].toString()));
 #endif
 
-				break;
-			}
-
-			added = false;
-
-		}
-
 		// if we reached here, that means that FOLLOW has been calculated
 		return this->m_CalculatedFOLLOW = true;
 	}
@@ -1512,7 +1270,9 @@ namespace m0st4fa::parsix {
 
 		// if FIRST is already calculated, return
 		if (this->m_CalculatedFIRST) {
-			this->m_Logger.logDebug(std::format("FIRST({}) has not already been calculated!", (std::string)*this));
+			if constexpr (TRACE_ENABLED)
+				get_logger().logDebug(std::format("FIRST({}) has already been calculated!", (std::string)*this));
+
 			return true;
 		}
 
@@ -1567,7 +1327,7 @@ namespace m0st4fa::parsix {
 			// in this case there is probably a logic error made by the programmar
 			if (fset.empty()) {
 				std::string msg = (std::string)"FIRST(" + (std::string)symbol + ") is empty.";
-				this->m_Logger.log(LoggerInfo::ERR_MISSING_VAL, msg + "\n\t\t\tThis may be due to:\n\t\t\t\t1.`A` wrong FIRST set (possibly one of a different grammar).\n\t\t\t\t2. An incomplete FIRST set.");
+				get_logger().log(LoggerInfo::ERR_MISSING_VAL, msg + "\n\t\t\tThis may be due to:\n\t\t\t\t1.`A` wrong FIRST set (possibly one of a different grammar).\n\t\t\t\t2. An incomplete FIRST set.");
 				throw std::logic_error(msg);
 			}
 
@@ -1593,11 +1353,11 @@ namespace m0st4fa::parsix {
 
 #ifdef _DEBUG
 		if (this->FIRST.empty()) {
-			this->m_Logger.logDebug(std::format("FIRST({}) is empty", (std::string)*this));
+			get_logger().logDebug(std::format("FIRST({}) is empty", (std::string)*this));
 			goto epilogue;
 		}
 
-		this->m_Logger.logDebug(std::format("FIRST({}) = {}", (std::string)*this, m0st4fa::toString(this->FIRST)));
+		get_logger().logDebug(std::format("FIRST({}) = {}", (std::string)*this, m0st4fa::toString(this->FIRST)));
 #endif
 
 	epilogue:
@@ -1,9 +1,17 @@
 #pragma once
 #include <array>
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <format>
 
 #include "parsix/production.h"
+#include "parsix/TerminalSet.h"
 
 // LL PARSER
 namespace m0st4fa::parsix {
@@ -43,6 +51,70 @@ namespace m0st4fa::parsix {
 		};
 	};
 
+	/**
+	 * @brief A read-only view of a **frozen** LLParsingTable object. Its lookups are not bounds-checked and never throw.
+	 * @tparam TableT The type of the viewed table.
+	 */
+	template <typename TableT>
+	class LLTableView {
+
+		/**
+		 * @brief The row of the first variable.
+		 */
+		const typename TableT::EntryArrType* m_Rows = nullptr;
+
+		/**
+		 * @brief The synchronization sets of the viewed table (see `LLParsingTable::syncSets`).
+		 */
+		const typename TableT::SyncSetType* m_SyncSets = nullptr;
+
+		/**
+		 * @brief The reversed production bodies of the viewed table (see `LLParsingTable::reversedBodies`).
+		 */
+		const typename TableT::BodyElementType* m_Bodies = nullptr;
+
+		/**
+		 * @brief The offsets of the reversed production bodies of the viewed table (see `LLParsingTable::bodyOffsets`).
+		 */
+		const size_t* m_BodyOffsets = nullptr;
+
+	public:
+
+		/**
+		 * @brief Converting constructor.
+		 * @param[in] rows The row of the first variable of the viewed table.
+		 * @param[in] syncSets The synchronization set of the first variable of the viewed table.
+		 * @param[in] bodies The reversed production bodies of the viewed table.
+		 * @param[in] bodyOffsets The offsets of the reversed production bodies within `bodies`.
+		 */
+		LLTableView(const typename TableT::EntryArrType* rows, const typename TableT::SyncSetType* syncSets, const typename TableT::BodyElementType* bodies, const size_t* bodyOffsets) noexcept(true) :
+			m_Rows{ rows }, m_SyncSets{ syncSets }, m_Bodies{ bodies }, m_BodyOffsets{ bodyOffsets } {}
+
+		/**
+		 * @brief Accesses the entry corresponding to `variable` and `terminal`. No boundary-checking.
+		 */
+		const LLTableEntry& operator()(size_t variable, size_t terminal) const noexcept(true) {
+			return this->m_Rows[variable][terminal];
+		}
+
+		/**
+		 * @brief Checks whether the entry corresponding to `variable` and `terminal` is not an error, i.e., whether panic mode synchronizes `variable` on `terminal`, with a single bit test. No boundary-checking.
+		 */
+		bool synchronizes(size_t variable, size_t terminal) const noexcept(true) {
+			return this->m_SyncSets[variable].contains((typename TableT::SyncSetType::TerminalType)terminal);
+		}
+
+		/**
+		 * @brief Gets the body of the production at `prodIndex`, reversed (i.e., in the order in which it is pushed onto the parsing stack). No boundary-checking.
+		 */
+		std::span<const typename TableT::BodyElementType> body(size_t prodIndex) const noexcept(true) {
+			const size_t begin = this->m_BodyOffsets[prodIndex];
+
+			return { this->m_Bodies + begin, this->m_BodyOffsets[prodIndex + 1] - begin };
+		}
+
+	};
+
 	/**
 	 * @brief An LL parsing table.
 	 * 
@@ -63,6 +135,16 @@ namespace m0st4fa::parsix {
 		 */
 		using EntryArrType2D = std::array<EntryArrType, (size_t)VariableT::NT_COUNT>;
 
+		/**
+		 * @brief Aliases the type of a grammar symbol.
+		 */
+		using SymbolType = std::remove_cvref_t<decltype(std::declval<const GrammarT&>()[0].prodHead)>;
+
+		/**
+		 * @brief Aliases the type of the synchronization set of a variable.
+		 */
+		using SyncSetType = TerminalSet<SymbolType>;
+
 		/**
 		 * @brief Aliases the type of an iterator of EntryArrType2D.
 		 */
@@ -80,10 +162,32 @@ namespace m0st4fa::parsix {
 		 */
 		GrammarT grammar;
 
+		/**
+		 * @brief Aliases the type of an element of a production body (typically an LLStackElement).
+		 */
+		using BodyElementType = std::remove_cvref_t<decltype(*std::declval<const GrammarT&>()[0].begin())>;
+
 		/**
 		 * @brief The underlying storage of the table.
 		 */
-		mutable EntryArrType2D table;
+		EntryArrType2D table;
+
+		/**
+		 * @brief The synchronization set of every variable: the terminals whose entry in its row is not an error. Built by `freeze()`.
+		 * @details Panic mode checks every token it skips against the set of the variable on top of the stack, so that skipping a token is a bit test rather than a lookup of a whole entry.
+		 */
+		std::array<SyncSetType, (size_t)VariableT::NT_COUNT> syncSets{};
+
+		/**
+		 * @brief The bodies of all of the productions of the grammar, each reversed, one after the other (in the order of the productions). Built by `freeze()`.
+		 * @details An expansion pushes the reversed body of its production onto the stack as is, in one pass over contiguous memory, instead of walking the production backwards; the bodies are short, so their (trivially copyable) elements are pushed one by one.
+		 */
+		std::vector<BodyElementType> reversedBodies;
+
+		/**
+		 * @brief The reversed body of production `i` is [`bodyOffsets[i]`, `bodyOffsets[i + 1]`) within `reversedBodies`. Built by `freeze()`.
+		 */
+		std::vector<size_t> bodyOffsets;
 
 		/**
 		 * @brief Accesses a given entry within the table, using a variable as the 1D index and the terminal as the 2D index.
@@ -197,6 +301,54 @@ namespace m0st4fa::parsix {
 			return table.at(intVariable);
 		}
 
+		/**
+		 * @brief Validates the table, so that it can be accessed through an LLTableView object (without any checks), and lays out the reversed production bodies (see `reversedBodies`) and the synchronization sets (see `syncSets`).
+		 * @details Every non-error entry must refer to a production within the grammar, and no production may have an empty body.
+		 * @attention The table (and its grammar) must not be modified after it is frozen; otherwise, it has to be frozen again.
+		 * @throws std::logic_error If an entry refers to a production that is not within the grammar, or a production has an empty body.
+		 */
+		void freeze() {
+			const size_t prodCount = this->grammar.size();
+
+			for (size_t variable = 0; variable < table.size(); variable++) {
+				this->syncSets[variable] = SyncSetType{};
+
+				for (size_t terminal = 0; terminal < table[variable].size(); terminal++) {
+					const LLTableEntry& entry = table[variable][terminal];
+
+					if (entry.isError)
+						continue;
+
+					if (entry.prodIndex >= prodCount)
+						throw std::logic_error(std::format("LL table entry ({}, {}) refers to production {}, which is not within the grammar.", variable, terminal, entry.prodIndex));
+
+					this->syncSets[variable].insert((TerminalT)terminal);
+				}
+			}
+
+			this->reversedBodies.clear();
+			this->bodyOffsets.assign(1, 0);
+			this->bodyOffsets.reserve(prodCount + 1);
+
+			for (size_t prodIndex = 0; prodIndex < prodCount; prodIndex++) {
+				const auto& prod = this->grammar[prodIndex];
+
+				if (prod.begin() == prod.end())
+					throw std::logic_error(std::format("Production {} has an empty body.", prodIndex));
+
+				this->reversedBodies.insert(this->reversedBodies.end(), prod.rbegin(), prod.rend());
+				this->bodyOffsets.push_back(this->reversedBodies.size());
+			}
+		}
+
+		/**
+		 * @brief Gets a read-only view of the table, whose lookups are not checked.
+		 * @attention The table must have been frozen (see `freeze()`), and must outlive the view.
+		 */
+		LLTableView<LLParsingTable> view() const noexcept(true) {
+			return LLTableView<LLParsingTable>{ this->table.data(), this->syncSets.data(), this->reversedBodies.data(), this->bodyOffsets.data() };
+		}
+
 		/**
 		 * @brief Gets the iterator pointing at the beginning of the underlying array object storing the entry objects.
 		*/
@@ -307,7 +459,7 @@ namespace m0st4fa::parsix {
 		 * @param[in] rhs The right-hand side of the comparison.
 		 * @returns `true` if this object and `rhs` are equal; `false` otherwise.
 		 */
-		bool operator==(const LRTableEntry& rhs) const {
+		constexpr bool operator==(const LRTableEntry& rhs) const {
 			bool initCond = isEmpty == rhs.isEmpty && type == rhs.type;
 
 			if (!initCond)
@@ -352,7 +504,7 @@ namespace m0st4fa::parsix {
 		* @note Being empty is considered erroneous. "Empty" is defined as: being of type LRTableEntryType::TET_ERROR or being empty.
 		* @returns `true` if this entry is of type LRTableEntryType::TET_ERROR or is empty; `false` otherwise.
 		**/ 
-		inline bool isError() const {
+		constexpr bool isError() const {
 			return isEmpty || this->type == LRTableEntryType::TET_ERROR;
 		}
 
@@ -360,7 +512,7 @@ namespace m0st4fa::parsix {
 		 * @brief Checks whether this is an accept entry.
 		 * @returns `true` if the type of this entry is LRTableEntryType::TET_ACCEPT; `false` otherwise.
 		 */
-		inline bool isAccept() const {
+		constexpr bool isAccept() const {
 			return this->type == LRTableEntryType::TET_ACCEPT;
 		}
 	};
@@ -370,27 +522,30 @@ namespace m0st4fa::parsix {
 	/**
 	 * @brief Creates a table entry of type LRTableEntryType::TET_ACTION_SHIFT.
 	 */
-#define TE_SHIFT(state) m0st4fa::LRTableEntry{false, m0st4fa::LRTableEntryType::TET_ACTION_SHIFT, state}
+#define TE_SHIFT(state) m0st4fa::parsix::LRTableEntry{false, m0st4fa::parsix::LRTableEntryType::TET_ACTION_SHIFT, state}
 
 	/**
 	  * @brief Creates a table entry of type LRTableEntryType::TET_ACTION_REDUCE.
 	  */
-#define TE_REDUCE(prodNum) m0st4fa::LRTableEntry{false, m0st4fa::LRTableEntryType::TET_ACTION_REDUCE, prodNum}
+#define TE_REDUCE(prodNum) m0st4fa::parsix::LRTableEntry{false, m0st4fa::parsix::LRTableEntryType::TET_ACTION_REDUCE, prodNum}
 
 	/**
 	   * @brief Creates a table entry of type LRTableEntryType::TET_ACTION_GOTO.
 	   */
-#define TE_GOTO(state) m0st4fa::LRTableEntry{false, m0st4fa::LRTableEntryType::TET_GOTO, state}
+#define TE_GOTO(state) m0st4fa::parsix::LRTableEntry{false, m0st4fa::parsix::LRTableEntryType::TET_GOTO, state}
 		
 	 /**
 	   * @brief Creates a table entry of type LRTableEntryType::TET_ACTION_ACCEPT.
 	   */
-#define TE_ACCEPT() m0st4fa::LRTableEntry{false, m0st4fa::LRTableEntryType::TET_ACCEPT}
+#define TE_ACCEPT() m0st4fa::parsix::LRTableEntry{false, m0st4fa::parsix::LRTableEntryType::TET_ACCEPT}
 
 	 /**
 		* @brief Creates a table entry of type LRTableEntryType::TET_ACTION_ERROR.
 		*/
-#define TE_ERROR() m0st4fa::LRTableEntry{false, m0st4fa::LRTableEntryType::TET_ERROR}
+#define TE_ERROR() m0st4fa::parsix::LRTableEntry{false, m0st4fa::parsix::LRTableEntryType::TET_ERROR}
+
+	template <typename GrammarT>
+	class LRTableView;
 
 	/**
 	 * @brief Represents an LR parsing table.
@@ -564,6 +719,13 @@ namespace m0st4fa::parsix {
 			return res;
 		}
 
+		/**
+		 * @brief Gets the number of states (rows) of the table.
+		 */
+		size_t getStateCount() const noexcept(true) {
+			return std::max(this->actionTable.size(), this->gotoTable.size());
+		}
+
 		/**
 		 * @brief Reserves rows in both the Action and GOTO tables. It simply resizes (using the `resize` method of vectors) the tables.
 		 * @param[in] newRowNum The new size of the rows of both tables.
@@ -573,6 +735,134 @@ namespace m0st4fa::parsix {
 			this->gotoTable.resize(newRowNum);
 		}
 
+		/**
+		 * @brief Validates the table, so that it can be accessed through an LRTableView object (without any checks).
+		 * @details Both tables are first padded to the same number of rows. Then, every entry is checked: Action rows may only contain shift, reduce and accept entries, GOTO rows may only contain GOTO entries, and every state and production number must be within the table and the grammar, respectively.
+		 * @attention The table must not be modified after it is frozen; otherwise, it has to be frozen again.
+		 * @throws std::logic_error If the table contains an invalid entry.
+		 */
+		void freeze() {
+			this->reserveRows(std::max(this->actionTable.size(), this->gotoTable.size()));
+
+			const size_t stateCount = this->actionTable.size();
+			const size_t prodCount = this->grammar.size();
+
+			const auto throwInvalid = [](size_t state, const LRTableEntry& entry) {
+				throw std::logic_error(std::format("Invalid LR table entry `{}` at state {}.", entry.toString(), state));
+				};
+
+			for (size_t state = 0; state < stateCount; state++) {
+				for (const LRTableEntry& entry : this->actionTable[state]) {
+					if (entry.isEmpty)
+						continue;
+
+					switch (entry.type) {
+					case LRTableEntryType::TET_ACTION_SHIFT:
+						if (entry.number >= stateCount)
+							throwInvalid(state, entry);
+						break;
+					case LRTableEntryType::TET_ACTION_REDUCE:
+						if (entry.number >= prodCount)
+							throwInvalid(state, entry);
+						break;
+					case LRTableEntryType::TET_ACCEPT:
+					case LRTableEntryType::TET_ERROR:
+						break;
+					default:
+						throwInvalid(state, entry);
+					}
+				}
+
+				for (const LRTableEntry& entry : this->gotoTable[state])
+					if (not entry.isEmpty && (entry.type != LRTableEntryType::TET_GOTO || entry.number >= stateCount))
+						throwInvalid(state, entry);
+			}
+		}
+
+		/**
+		 * @brief Gets a read-only view of the table, whose lookups are not checked.
+		 * @attention The table must have been frozen (see `freeze()`), and must outlive the view. The view is invalidated by any change to the table.
+		 */
+		LRTableView<GrammarT> view() const noexcept(true) {
+			return LRTableView<GrammarT>{ *this };
+		}
+
+	};
+
+	/**
+	 * @brief A read-only view of a **frozen** LRParsingTable object. Its lookups are neither bounds-checked nor can they modify the table.
+	 * @details The view is only a few pointers, so it is meant to be created when needed (e.g., once per call within the parsing loop) rather than kept around.
+	 * @tparam GrammarT The type of object representing the grammar. Generally, it is a vector of production record objects.
+	 */
+	template <typename GrammarT>
+	class LRTableView {
+
+		/**
+		 * @brief Aliases the type of the viewed table.
+		 */
+		using TableType = LRParsingTable<GrammarT>;
+
+		/**
+		 * @brief Aliases the type of a terminal.
+		 */
+		using TerminalType = typename TableType::TerminalType;
+
+		/**
+		 * @brief Aliases the type of a non-terminal.
+		 */
+		using VariableType = typename TableType::VariableType;
+
+		/**
+		 * @brief Aliases the type of a production.
+		 */
+		using ProductionType = std::remove_cvref_t<typename TableType::ProductionType>;
+
+		/**
+		 * @brief The first row of the Action table.
+		 */
+		const typename TableType::ActionArrayType* m_Actions = nullptr;
+
+		/**
+		 * @brief The first row of the GOTO table.
+		 */
+		const typename TableType::GotoArrayType* m_Gotos = nullptr;
+
+		/**
+		 * @brief The first production of the grammar.
+		 */
+		const ProductionType* m_Productions = nullptr;
+
+	public:
+
+		/**
+		 * @brief Converting constructor. Views a frozen table.
+		 * @param[in] table The table to be viewed.
+		 */
+		explicit LRTableView(const TableType& table) noexcept(true) :
+			m_Actions{ table.actionTable.data() }, m_Gotos{ table.gotoTable.data() }, m_Productions{ table.grammar.getVector().data() }
+		{}
+
+		/**
+		 * @brief Gets the Action entry at this `state` and this `terminal`. No boundary-checking.
+		 */
+		const LRTableEntry& atAction(size_t state, TerminalType terminal) const noexcept(true) {
+			return this->m_Actions[state][(size_t)terminal];
+		}
+
+		/**
+		 * @brief Gets the GOTO entry at this `state` and this `nonTerminal`. No boundary-checking.
+		 */
+		const LRTableEntry& atGoto(size_t state, VariableType nonTerminal) const noexcept(true) {
+			return this->m_Gotos[state][(size_t)nonTerminal];
+		}
+
+		/**
+		 * @brief Gets the production whose number is `prodNumber`. No boundary-checking.
+		 */
+		const ProductionType& production(size_t prodNumber) const noexcept(true) {
+			return this->m_Productions[prodNumber];
+		}
+
 	};
 
 };
\ No newline at end of file
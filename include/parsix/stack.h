@@ -44,10 +44,11 @@ namespace m0st4fa::parsix {
 	struct LLActionRecord;
 
 	template <typename SymbolT, typename SynthesizedT, typename ActionT>
-	concept StackElementConstraints = requires (SymbolT sym1, SymbolT sym2) { sym1 = sym2; } && std::is_trivially_destructible_v<SynthesizedT> && std::is_trivially_destructible_v<ActionT>;
+	concept StackElementConstraints = std::is_trivially_copyable_v<SymbolT> && std::is_trivially_copyable_v<SynthesizedT> && std::is_trivially_copyable_v<ActionT>;
 
 	/**
 	 * @brief Represents an element of the stack of an LL parser.
+	 * @details The element is trivially copyable (all of its members must be), so that copying the production bodies laid out by `LLParsingTable::freeze()` onto the stack is cheap.
 	 * @tparam SymbolT The type of symbol objects stored in the stack.
 	 * @tparam SynthesizedT The type of synthetic record objects stored in the stack.
 	 * @tparam ActionT The type of action record objects stored in the stack.
@@ -65,11 +66,10 @@ namespace m0st4fa::parsix {
 		 */
 		ProdElementType type;
 
-		// TODO: try enhance this
 		/**
 		 * @brief Used to store the actual element. The element can be of any of the types: SymbolT, SynthesizedT or ActionT. The type is indicated by the field `type`.
-		 * @details The element can be of any of three types.
-		 * @todo This should have been a `union` type, but then non-trivial fields of the union would not be possible and this would be a huge limit on what members can store. It is a dilemma.
+		 * @details The element can be of any of three types; only the member indicated by `type` is meaningful.
+		 * @note This is not a `union`, since a union of members with default member initializers (the records have some) cannot be default-constructed by every compiler.
 		 */
 		struct {
 
@@ -89,31 +89,6 @@ namespace m0st4fa::parsix {
 			ActionT actRecord;
 		} as;
 
-		/**
-		 * @brief The copy operator of LLStackElement.
-		 * @param[in] other The rhs (right-hand side) of the copy operator.
-		 * @return A reference to this LLStackElement object after being (possibly) modified.
-		 */
-		LLStackElement& operator=(const LLStackElement& other) {
-			type = other.type;
-			switch (type) {
-
-			case ProdElementType::PET_GRAM_SYMBOL:
-				as.gramSymbol = other.as.gramSymbol;
-				break;
-
-			case ProdElementType::PET_SYNTH_RECORD:
-				as.synRecord = other.as.synRecord;
-				break;
-
-			case ProdElementType::PET_ACTION_RECORD:
-				as.actRecord = other.as.actRecord;
-				break;
-			}
-
-			return *this;
-		}
-
 		/**
 		 * @brief Equality operator.
 		 * @param[in] other The rhs of this operator.
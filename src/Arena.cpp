@@ -0,0 +1,60 @@
+#include <algorithm>
+
+#include "parsix/Arena.h"
+
+namespace m0st4fa::parsix {
+
+	thread_local Arena* Arena::s_Current = nullptr;
+
+	/**
+	 * @brief Allocates memory when the current chunk cannot satisfy the request: moves on to the next chunk that can (allocating a new one if none can).
+	 * @param[in] size The number of bytes to allocate.
+	 * @param[in] alignment The alignment of the memory; a power of 2.
+	 * @returns A pointer to `size` bytes aligned to `alignment`.
+	 */
+	void* Arena::_allocate_slow(size_t size, size_t alignment)
+	{
+		const size_t needed = size + alignment - 1;
+
+		// the chunks after the current one are left over from before the last reset; reuse them
+		size_t next = this->m_Ptr ? this->m_CurrChunk + 1 : 0;
+		while (next < this->m_Chunks.size() && this->m_Chunks[next].size < needed)
+			next++;
+
+		if (next == this->m_Chunks.size()) {
+			const size_t chunkSize = std::max(this->m_ChunkSize, needed);
+			this->m_Chunks.push_back(Chunk{ std::make_unique<std::byte[]>(chunkSize), chunkSize });
+		}
+
+		Chunk& chunk = this->m_Chunks[next];
+		this->m_CurrChunk = next;
+		this->m_Ptr = chunk.memory.get();
+		this->m_End = this->m_Ptr + chunk.size;
+
+		return this->allocate(size, alignment);
+	}
+
+	/**
+	 * @brief Releases everything allocated from the arena and frees all of its memory.
+	 */
+	void Arena::release() noexcept(true)
+	{
+		this->m_Chunks.clear();
+		this->m_CurrChunk = 0;
+		this->m_Ptr = this->m_End = nullptr;
+	}
+
+	/**
+	 * @brief Gets the total number of bytes owned by the arena (used or not).
+	 */
+	size_t Arena::getCapacity() const noexcept(true)
+	{
+		size_t capacity = 0;
+
+		for (const Chunk& chunk : this->m_Chunks)
+			capacity += chunk.size;
+
+		return capacity;
+	}
+
+}
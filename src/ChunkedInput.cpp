@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#include "parsix/ChunkedInput.h"
+
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Constructs a streamed input. Nothing is read until the window is first extended.
+	 * @param[in] stream The stream the source is read from.
+	 * @param[in] chunkSize The number of bytes read at a time; it must not be `0`.
+	 * @throws std::invalid_argument If `stream` is `nullptr` or `chunkSize` is `0`.
+	 */
+	ChunkedInput::ChunkedInput(std::unique_ptr<std::istream> stream, size_t chunkSize) :
+		m_Stream{ std::move(stream) }, m_ChunkSize{ chunkSize }
+	{
+		if (this->m_Stream == nullptr || chunkSize == 0)
+			throw std::invalid_argument("A chunked input needs a stream and a non-zero chunk size.");
+	}
+
+	/**
+	 * @brief Constructs a streamed input reading a file.
+	 * @throws std::runtime_error If the file cannot be opened.
+	 */
+	ChunkedInput ChunkedInput::open(const std::filesystem::path& path, size_t chunkSize)
+	{
+		auto file = std::make_unique<std::ifstream>(path, std::ios::binary);
+
+		if (not *file)
+			throw std::runtime_error(std::format("Cannot open file `{}` for parsing.", path.string()));
+
+		return ChunkedInput{ std::move(file), chunkSize };
+	}
+
+	/**
+	 * @brief Constructs a mapped input: its window is the whole file.
+	 * @throws std::runtime_error If the file cannot be mapped.
+	 */
+	ChunkedInput ChunkedInput::map(const std::filesystem::path& path)
+	{
+		ChunkedInput input;
+		input.m_Mapping = MappedFile{ path };
+		input.m_Window = std::string_view{ reinterpret_cast<const char*>(input.m_Mapping.data()), input.m_Mapping.size() };
+
+		return input;
+	}
+
+	/**
+	 * @brief Constructs a viewed input: its window is `source`, which must outlive the input.
+	 */
+	ChunkedInput ChunkedInput::view(std::string_view source)
+	{
+		ChunkedInput input;
+		input.m_Window = source;
+
+		return input;
+	}
+
+	/**
+	 * @brief Constructs a pushed input with an empty window; its bytes are given to `append()`.
+	 */
+	ChunkedInput ChunkedInput::pushed()
+	{
+		ChunkedInput input;
+		input.m_AtEnd = false;
+
+		return input;
+	}
+
+	/**
+	 * @brief Drops the bytes before the discard point from the window, moving the kept bytes to the beginning of its storage.
+	 * @returns The number of kept bytes.
+	 */
+	size_t ChunkedInput::_compact()
+	{
+		const size_t drop = (size_t)std::min<uint64_t>(this->m_DiscardOffset - std::min(this->m_DiscardOffset, this->m_WindowOffset), this->m_Window.size());
+		const size_t keep = this->m_Window.size() - drop;
+
+		if (drop != 0 && keep != 0)
+			std::memmove(this->m_Buffer.data(), this->m_Buffer.data() + drop, keep);
+
+		this->m_WindowOffset += drop;
+
+		return keep;
+	}
+
+	/**
+	 * @brief Reads the next chunk of the source into the window, dropping the bytes before the discard point first.
+	 * @details The kept bytes are moved to the beginning of the storage of the window, which only grows if they take more than the chunk size.
+	 * @returns `true` if any byte was read; `false` if the window already reaches the end of the source, or if this is a pushed input (whose bytes only come from `append()`).
+	 * @throws std::runtime_error If reading the stream fails.
+	 */
+	bool ChunkedInput::extend()
+	{
+		if (this->m_AtEnd || this->m_Stream == nullptr)
+			return false;
+
+		const size_t keep = this->_compact();
+		this->m_Buffer.resize(keep + this->m_ChunkSize);
+
+		this->m_Stream->read(this->m_Buffer.data() + keep, (std::streamsize)this->m_ChunkSize);
+		const size_t read = (size_t)this->m_Stream->gcount();
+
+		if (this->m_Stream->bad())
+			throw std::runtime_error("Cannot read the next chunk of the input.");
+
+		if (read < this->m_ChunkSize)
+			this->m_AtEnd = true;
+
+		this->m_Buffer.resize(keep + read);
+		this->m_Window = std::string_view{ this->m_Buffer.data(), this->m_Buffer.size() };
+
+		return read != 0;
+	}
+
+	/**
+	 * @brief Appends bytes to the window of a pushed input, dropping the bytes before the discard point first.
+	 * @note Views of the window (e.g., those returned by `text()`) are invalidated.
+	 * @throws std::logic_error If this is not a pushed input, or `finish()` has already been called.
+	 */
+	void ChunkedInput::append(std::string_view bytes)
+	{
+		if (this->m_AtEnd || this->m_Stream != nullptr)
+			throw std::logic_error("Only a pushed input that is not finished can be appended to.");
+
+		const size_t keep = this->_compact();
+		this->m_Buffer.resize(keep);
+		this->m_Buffer.insert(this->m_Buffer.end(), bytes.begin(), bytes.end());
+		this->m_Window = std::string_view{ this->m_Buffer.data(), this->m_Buffer.size() };
+	}
+
+	/**
+	 * @brief Marks the end of the source of a pushed input: the window now reaches it.
+	 * @throws std::logic_error If this is not a pushed input.
+	 */
+	void ChunkedInput::finish()
+	{
+		if (this->m_Stream != nullptr)
+			throw std::logic_error("Only a pushed input can be finished.");
+
+		this->m_AtEnd = true;
+	}
+
+	/**
+	 * @brief Gets the text of the source between `offset` and `offset + length`.
+	 * @returns A view of the text within the window; it is invalidated when the window is extended.
+	 * @throws std::out_of_range If the text is not (entirely) within the window, e.g., because it was already dropped.
+	 */
+	std::string_view ChunkedInput::text(uint64_t offset, size_t length) const
+	{
+		if (offset < this->m_WindowOffset || offset + length > this->windowEnd())
+			throw std::out_of_range(std::format("The text at offsets [{}, {}) is not within the input window [{}, {}).", offset, offset + length, this->m_WindowOffset, this->windowEnd()));
+
+		return this->m_Window.substr((size_t)(offset - this->m_WindowOffset), length);
+	}
+
+}
@@ -0,0 +1,38 @@
+#include <atomic>
+
+#include "parsix/Logging.h"
+
+namespace m0st4fa::parsix {
+
+	namespace {
+
+		/**
+		 * @brief The logger used when none is installed.
+		 */
+		Logger s_DefaultLogger;
+
+		/**
+		 * @brief The installed logger.
+		 */
+		std::atomic<Logger*> s_Logger{ &s_DefaultLogger };
+
+	}
+
+	/**
+	 * @brief Gets the logger every parsix object logs through.
+	 * @returns The logger installed with `set_logger()`, or the default one.
+	 */
+	Logger& get_logger() noexcept(true) {
+		return *s_Logger.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * @brief Installs the logger every parsix object logs through.
+	 * @details It may be called while other threads log; they switch to the new logger with their next message. The logger must outlive every use of the library (or be replaced first).
+	 * @param[in] logger The logger to install, or `nullptr` to restore the default one.
+	 */
+	void set_logger(Logger* logger) noexcept(true) {
+		s_Logger.store(logger ? logger : &s_DefaultLogger, std::memory_order_release);
+	}
+
+}
@@ -0,0 +1,126 @@
+#include <format>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+#include "parsix/MappedFile.h"
+
+namespace m0st4fa::parsix {
+
+#ifdef _WIN32
+
+	MappedFile::MappedFile(const std::filesystem::path& path)
+	{
+		const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if (file == INVALID_HANDLE_VALUE)
+			throw std::runtime_error(std::format("Cannot open file `{}` for mapping.", path.string()));
+
+		LARGE_INTEGER size{};
+		if (not GetFileSizeEx(file, &size)) {
+			CloseHandle(file);
+			throw std::runtime_error(std::format("Cannot get the size of file `{}`.", path.string()));
+		}
+
+		// an empty file cannot be mapped; it is just an empty mapping
+		if (size.QuadPart == 0) {
+			CloseHandle(file);
+			return;
+		}
+
+		const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+
+		if (mapping == nullptr)
+			throw std::runtime_error(std::format("Cannot map file `{}`.", path.string()));
+
+		// the view keeps the mapping alive
+		const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(mapping);
+
+		if (data == nullptr)
+			throw std::runtime_error(std::format("Cannot map file `{}`.", path.string()));
+
+		this->m_Data = static_cast<const std::byte*>(data);
+		this->m_Size = (size_t)size.QuadPart;
+	}
+
+	void MappedFile::_unmap() noexcept(true)
+	{
+		if (this->m_Data != nullptr)
+			UnmapViewOfFile(this->m_Data);
+
+		this->m_Data = nullptr;
+		this->m_Size = 0;
+	}
+
+#else
+
+	MappedFile::MappedFile(const std::filesystem::path& path)
+	{
+		const int fd = ::open(path.c_str(), O_RDONLY);
+
+		if (fd < 0)
+			throw std::runtime_error(std::format("Cannot open file `{}` for mapping.", path.string()));
+
+		struct stat info{};
+		if (::fstat(fd, &info) != 0) {
+			::close(fd);
+			throw std::runtime_error(std::format("Cannot get the size of file `{}`.", path.string()));
+		}
+
+		// an empty file cannot be mapped; it is just an empty mapping
+		if (info.st_size == 0) {
+			::close(fd);
+			return;
+		}
+
+		// the mapping stays valid after the descriptor is closed
+		void* data = ::mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+
+		if (data == MAP_FAILED)
+			throw std::runtime_error(std::format("Cannot map file `{}`.", path.string()));
+
+		this->m_Data = static_cast<const std::byte*>(data);
+		this->m_Size = (size_t)info.st_size;
+	}
+
+	void MappedFile::_unmap() noexcept(true)
+	{
+		if (this->m_Data != nullptr)
+			::munmap(const_cast<std::byte*>(this->m_Data), this->m_Size);
+
+		this->m_Data = nullptr;
+		this->m_Size = 0;
+	}
+
+#endif
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept(true) :
+		m_Data{ std::exchange(other.m_Data, nullptr) }, m_Size{ std::exchange(other.m_Size, 0) }
+	{}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept(true)
+	{
+		if (this != &other) {
+			this->_unmap();
+			this->m_Data = std::exchange(other.m_Data, nullptr);
+			this->m_Size = std::exchange(other.m_Size, 0);
+		}
+
+		return *this;
+	}
+
+}
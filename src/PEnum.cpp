@@ -60,4 +60,62 @@ namespace m0st4fa::parsix {
 	std::ostream& operator<<(std::ostream& os, ProdElementType type) {
 		return os << toString(type);
 	};
-}
\ No newline at end of file
+
+	/**
+	 * @brief Converts an LRTableType enumerator to a string.
+	 * @param[in] type An object of LRTableType type.
+	 * @returns A string representation of `type`.
+	 */
+	std::string toString(LRTableType type) {
+		static_assert((size_t)LRTableType::LTT_COUNT == 4);
+		static constexpr const char* const names[] = {
+			"LR(0)",
+			"SLR(1)",
+			"CLR(1)",
+			"LALR(1)",
+		};
+
+		const char* name = type == LRTableType::LTT_COUNT ?
+			std::to_string((unsigned)LRTableType::LTT_COUNT).data() : names[static_cast<int>(type)];
+
+		return name;
+	}
+
+	/**
+	 * @brief Prints an LRTableType enumerator to the standard output stream.
+	 * @param[in] os The output stream to which the object is printed.
+	 * @param[in] type The LRTableType object to be printed.
+	 * @return The output stream to which `type` was printed.
+	 */
+	std::ostream& operator<<(std::ostream& os, LRTableType type) {
+		return os << toString(type);
+	};
+
+	/**
+	 * @brief Converts a PushStatus enumerator to a string.
+	 * @param[in] status An object of PushStatus type.
+	 * @returns A string representation of `status`.
+	 */
+	std::string toString(PushStatus status) {
+		static_assert((size_t)PushStatus::PS_COUNT == 2);
+		static constexpr const char* const names[] = {
+			"NEED_INPUT",
+			"ACCEPTED",
+		};
+
+		if (status == PushStatus::PS_COUNT)
+			return std::to_string((unsigned)PushStatus::PS_COUNT);
+
+		return names[static_cast<int>(status)];
+	}
+
+	/**
+	 * @brief Prints a PushStatus enumerator to the standard output stream.
+	 * @param[in] os The output stream to which the object is printed.
+	 * @param[in] status The PushStatus object to be printed.
+	 * @return The output stream to which `status` was printed.
+	 */
+	std::ostream& operator<<(std::ostream& os, PushStatus status) {
+		return os << toString(status);
+	};
+}
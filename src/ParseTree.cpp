@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <format>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+#include "parsix/ParseTree.h"
+
+namespace m0st4fa::parsix {
+
+	/**
+	 * @brief Adds a node for a production whose children are the last `childCount` subtrees without a parent; it becomes a subtree without a parent itself.
+	 */
+	void ParseTree::_add_node(uint32_t production, uint32_t childCount)
+	{
+		const uint32_t index = (uint32_t)this->m_Nodes.size();
+		ParseTreeNode node{ .id = production, .childCount = childCount };
+
+		if (childCount == 0) {
+			// an empty span at the end of the node before it
+			if (not this->m_Nodes.empty())
+				node.offset = this->m_Nodes.back().offset + this->m_Nodes.back().length;
+		}
+		else {
+			const ParseTreeNode& firstChild = this->m_Nodes[this->m_Roots[this->m_Roots.size() - childCount]];
+			const ParseTreeNode& lastChild = this->m_Nodes[this->m_Roots.back()];
+			const uint32_t first = this->m_Roots[this->m_Roots.size() - childCount] + 1 - firstChild.subtreeSize;
+
+			node.subtreeSize = index - first + 1;
+			node.offset = firstChild.offset;
+			node.length = (uint32_t)(lastChild.offset + lastChild.length - firstChild.offset);
+
+			this->m_Roots.resize(this->m_Roots.size() - childCount);
+		}
+
+		this->m_Nodes.push_back(node);
+		this->m_Roots.push_back(index);
+	}
+
+	/**
+	 * @brief Records that a symbol of the body of the innermost pending production is complete, and adds the nodes of the pending productions it completes (innermost first).
+	 */
+	void ParseTree::_complete_symbol()
+	{
+		while (not this->m_Pending.empty() && --this->m_Pending.back().remaining == 0) {
+			const Pending pending = this->m_Pending.back();
+			this->m_Pending.pop_back();
+
+			// the node is complete, and so is the symbol of the body of the production that it is for
+			this->_add_node(pending.production, pending.symbolCount);
+		}
+	}
+
+	/**
+	 * @brief Begins a node for a production expanded by an LL parser; it is added once its `symbolCount` children are complete (as leaves, or as the nodes of their own expansions).
+	 * @param[in] production The number of the production.
+	 * @param[in] symbolCount The number of grammar symbols of the body of the production (epsilon excluded); for `0`, the node is added right away.
+	 */
+	void ParseTree::expand(uint32_t production, uint32_t symbolCount)
+	{
+		if (this->m_Failed)
+			return;
+
+		if (symbolCount != 0) {
+			this->m_Pending.push_back(Pending{ .production = production, .symbolCount = symbolCount, .remaining = symbolCount });
+			return;
+		}
+
+		this->_add_node(production, 0);
+
+		if (not this->m_Pending.empty())
+			this->_complete_symbol();
+	}
+
+	/**
+	 * @brief Saves the tree to a binary stream: a FileHeader, followed by the nodes.
+	 * @throws std::logic_error If building the tree has failed, or the tree is not complete (it has more than one root, or nodes pending).
+	 * @throws std::runtime_error If the stream cannot be written.
+	 */
+	void ParseTree::save(std::ostream& stream) const
+	{
+		if (this->m_Failed)
+			throw std::logic_error("Cannot save a parse tree whose building has failed.");
+
+		if (this->m_Roots.size() > 1 || not this->m_Pending.empty())
+			throw std::logic_error("Cannot save a parse tree that is not complete.");
+
+		const FileHeader header{ .nodeCount = this->m_Nodes.size() };
+
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		stream.write(reinterpret_cast<const char*>(this->m_Nodes.data()), std::streamsize(this->m_Nodes.size() * sizeof(ParseTreeNode)));
+
+		if (not stream)
+			throw std::runtime_error("Cannot write the parse tree to the stream.");
+	}
+
+	/**
+	 * @brief Loads a tree saved by `save()` from a binary stream.
+	 * @details The structure of the tree is checked (every subtree is made of the subtrees of the children of its root, and there is a single root), so a loaded tree can be walked (and evaluated) without further checks.
+		* The nodes are read in bounded blocks, so that the node count of a corrupt header cannot make the tree allocate much more memory than the stream actually holds.
+	 * @throws std::runtime_error If the stream does not hold a tree of this version and byte order, is truncated, or the tree is malformed.
+	 */
+	ParseTree ParseTree::load(std::istream& stream)
+	{
+		FileHeader header;
+		stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+		if (not stream || header.magic != FileHeader::MAGIC)
+			throw std::runtime_error("The stream does not hold a parse tree.");
+
+		if (header.byteOrder != FileHeader::BYTE_ORDER_MARK)
+			throw std::runtime_error("The parse tree was saved on a machine of another byte order.");
+
+		if (header.version != FileHeader::VERSION)
+			throw std::runtime_error(std::format("The parse tree has version {}, but only version {} is supported.", header.version, FileHeader::VERSION));
+
+		if (header.nodeCount >= UINT32_MAX)
+			throw std::runtime_error(std::format("The parse tree has too many nodes ({}).", header.nodeCount));
+
+		constexpr size_t BLOCK_SIZE = 4096;
+		ParseTree tree;
+
+		for (size_t remaining = (size_t)header.nodeCount; remaining != 0; ) {
+			const size_t count = std::min(remaining, BLOCK_SIZE);
+			const size_t read = tree.m_Nodes.size();
+
+			tree.m_Nodes.resize(read + count);
+			stream.read(reinterpret_cast<char*>(tree.m_Nodes.data() + read), std::streamsize(count * sizeof(ParseTreeNode)));
+
+			if (not stream)
+				throw std::runtime_error("The parse tree is truncated.");
+
+			remaining -= count;
+		}
+
+		// replay the nodes as they were built, checking that the children of every node are there
+		for (uint32_t index = 0; index < tree.m_Nodes.size(); index++) {
+			const ParseTreeNode& node = tree.m_Nodes[index];
+			const bool valid = node.isTerminal() ?
+				node.childCount == 0 && node.subtreeSize == 1 :
+				node.childCount <= tree.m_Roots.size() &&
+				node.subtreeSize == (node.childCount == 0 ? 1 : index + 1 - (tree.m_Roots[tree.m_Roots.size() - node.childCount] + 1 - tree.m_Nodes[tree.m_Roots[tree.m_Roots.size() - node.childCount]].subtreeSize));
+
+			if (not valid)
+				throw std::runtime_error(std::format("Node {} of the parse tree is malformed.", index));
+
+			tree.m_Roots.resize(tree.m_Roots.size() - node.childCount);
+			tree.m_Roots.push_back(index);
+		}
+
+		if (tree.m_Roots.size() > 1)
+			throw std::runtime_error(std::format("The parse tree has {} roots instead of one.", tree.m_Roots.size()));
+
+		return tree;
+	}
+
+}
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "parsix/WorkStealingPool.h"
+
+namespace m0st4fa::parsix {
+
+	namespace {
+
+		/**
+		 * @brief The tasks yet to be run by a single worker. Its owner takes tasks from the back; thieves take them from the front.
+		 */
+		struct WorkerQueue {
+			std::mutex mutex;
+			std::deque<size_t> tasks;
+
+			/**
+			 * @brief Takes a task from the back (the owner's end) of the queue.
+			 * @returns `true` if a task was taken; `false` if the queue is empty.
+			 */
+			bool pop(size_t& task) {
+				std::lock_guard lock{ this->mutex };
+
+				if (this->tasks.empty())
+					return false;
+
+				task = this->tasks.back();
+				this->tasks.pop_back();
+				return true;
+			}
+
+			/**
+			 * @brief Takes a task from the front (the thieves' end) of the queue.
+			 * @returns `true` if a task was taken; `false` if the queue is empty.
+			 */
+			bool steal(size_t& task) {
+				std::lock_guard lock{ this->mutex };
+
+				if (this->tasks.empty())
+					return false;
+
+				task = this->tasks.front();
+				this->tasks.pop_front();
+				return true;
+			}
+		};
+
+	}
+
+	WorkStealingPool::WorkStealingPool(size_t threadCount) :
+		m_ThreadCount{ threadCount ? threadCount : std::max<size_t>(std::thread::hardware_concurrency(), 1) }
+	{}
+
+	/**
+	 * @brief Runs a batch of tasks and waits for all of them to finish.
+	 * @details If a task throws, the remaining tasks are still run; once all of them are done, the first exception caught is rethrown.
+	 * @param[in] taskCount The number of tasks of the batch.
+	 * @param[in] task The task to run for every task number in `[0, taskCount)`. It is called concurrently from different threads.
+	 */
+	void WorkStealingPool::run(size_t taskCount, const TaskType& task) const
+	{
+		if (taskCount == 0)
+			return;
+
+		const size_t workerCount = std::min(this->m_ThreadCount, taskCount);
+
+		// split the tasks into contiguous blocks, one per worker
+		std::vector<std::unique_ptr<WorkerQueue>> queues(workerCount);
+		for (size_t worker = 0; worker < workerCount; worker++) {
+			queues[worker] = std::make_unique<WorkerQueue>();
+
+			const size_t begin = taskCount * worker / workerCount;
+			const size_t end = taskCount * (worker + 1) / workerCount;
+			for (size_t i = begin; i < end; i++)
+				queues[worker]->tasks.push_back(i);
+		}
+
+		std::mutex errorMutex;
+		std::exception_ptr error;
+
+		const auto work = [&](size_t worker) {
+			size_t current = 0;
+
+			// no tasks are added once the batch starts, so a worker is done once all of the queues are empty
+			while (true) {
+				bool found = queues[worker]->pop(current);
+
+				for (size_t offset = 1; not found && offset < workerCount; offset++)
+					found = queues[(worker + offset) % workerCount]->steal(current);
+
+				if (not found)
+					return;
+
+				try {
+					task(current, worker);
+				}
+				catch (...) {
+					std::lock_guard lock{ errorMutex };
+
+					if (not error)
+						error = std::current_exception();
+				}
+			}
+			};
+
+		// the calling thread acts as worker 0
+		{
+			std::vector<std::jthread> threads;
+			threads.reserve(workerCount - 1);
+
+			for (size_t worker = 1; worker < workerCount; worker++)
+				threads.emplace_back(work, worker);
+
+			work(0);
+		}
+
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+}
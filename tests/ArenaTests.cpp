@@ -0,0 +1,170 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "parsix/Arena.h"
+
+/**
+ * @file ArenaTests.cpp
+ * @brief Checks that an Arena hands out aligned, disjoint memory, that `reset()` reuses its memory and `release()` frees it, that a moved-from arena is left empty, and that Arena::Scope sets the current arena.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		/**
+		 * @brief An allocation: its memory, size and alignment.
+		 */
+		struct Allocation {
+			std::byte* ptr;
+			size_t size;
+			size_t alignment;
+		};
+
+		/**
+		 * @brief Makes allocations of various sizes and alignments (some larger than a chunk of `chunkSize` bytes), filling each with its own byte value.
+		 */
+		std::vector<Allocation> allocate_some(Arena& arena, size_t chunkSize) {
+			std::vector<Allocation> res;
+
+			for (size_t i = 0; i < 200; i++) {
+				const size_t size = i % 50 == 49 ? 2 * chunkSize : 1 + (i * 7) % 40;
+				const size_t alignment = size_t(1) << (i % 7);
+				std::byte* ptr = static_cast<std::byte*>(arena.allocate(size, alignment));
+
+				std::memset(ptr, (int)(i & 0xFF), size);
+				res.push_back({ ptr, size, alignment });
+			}
+
+			return res;
+		}
+
+		/**
+		 * @brief Checks that every allocation is aligned and still holds its byte value (i.e., no two of them overlap).
+		 */
+		::testing::AssertionResult intact(const std::vector<Allocation>& allocations) {
+			for (size_t i = 0; i < allocations.size(); i++) {
+				const Allocation& allocation = allocations[i];
+
+				if (reinterpret_cast<uintptr_t>(allocation.ptr) % allocation.alignment != 0)
+					return ::testing::AssertionFailure() << "allocation " << i << " is not aligned to " << allocation.alignment << " bytes";
+
+				for (size_t byte = 0; byte < allocation.size; byte++)
+					if (allocation.ptr[byte] != (std::byte)(i & 0xFF))
+						return ::testing::AssertionFailure() << "allocation " << i << " was overwritten";
+			}
+
+			return ::testing::AssertionSuccess();
+		}
+
+		/**
+		 * @brief Checks whether `ptr` is in the memory of one of `allocations`.
+		 */
+		bool is_within(const std::byte* ptr, const std::vector<Allocation>& allocations) {
+			for (const Allocation& allocation : allocations)
+				if (ptr >= allocation.ptr && ptr < allocation.ptr + allocation.size)
+					return true;
+
+			return false;
+		}
+
+		constexpr size_t CHUNK_SIZE = 256;
+
+	}
+
+	TEST(ArenaTests, allocations_are_aligned_and_disjoint) {
+		Arena arena{ CHUNK_SIZE };
+		EXPECT_EQ(arena.getCapacity(), 0);
+
+		const std::vector<Allocation> allocations = allocate_some(arena, CHUNK_SIZE);
+		EXPECT_TRUE(intact(allocations));
+		EXPECT_GE(arena.getCapacity(), 4 * 2 * CHUNK_SIZE);
+
+		struct Point { int x, y; };
+		const Point* point = arena.create<Point>(1, 2);
+		EXPECT_EQ(point->x, 1);
+		EXPECT_EQ(point->y, 2);
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(point) % alignof(Point), 0);
+		EXPECT_TRUE(intact(allocations));
+	}
+
+	TEST(ArenaTests, reset_reuses_memory) {
+		Arena arena{ CHUNK_SIZE };
+		const std::vector<Allocation> first = allocate_some(arena, CHUNK_SIZE);
+		const size_t capacity = arena.getCapacity();
+
+		// the same allocations after a reset get the same memory, and no more of it
+		arena.reset();
+		const std::vector<Allocation> second = allocate_some(arena, CHUNK_SIZE);
+
+		EXPECT_EQ(arena.getCapacity(), capacity);
+		EXPECT_TRUE(intact(second));
+
+		for (size_t i = 0; i < first.size(); i++)
+			EXPECT_EQ(second[i].ptr, first[i].ptr) << "allocation " << i;
+
+		// releasing frees all of it
+		arena.release();
+		EXPECT_EQ(arena.getCapacity(), 0);
+		EXPECT_TRUE(intact(allocate_some(arena, CHUNK_SIZE)));
+	}
+
+	TEST(ArenaTests, moved_from_arena_is_empty) {
+		Arena arena{ CHUNK_SIZE };
+		const std::vector<Allocation> allocations = allocate_some(arena, CHUNK_SIZE);
+		const size_t capacity = arena.getCapacity();
+
+		// the memory (and the allocations in it) now belongs to `moved`
+		Arena moved{ std::move(arena) };
+		EXPECT_EQ(moved.getCapacity(), capacity);
+		EXPECT_EQ(arena.getCapacity(), 0);
+		EXPECT_TRUE(intact(allocations));
+
+		// the moved-from arena does not hand out memory it no longer owns
+		const std::vector<Allocation> others = allocate_some(arena, CHUNK_SIZE);
+		for (const Allocation& other : others)
+			EXPECT_FALSE(is_within(other.ptr, allocations));
+		EXPECT_TRUE(intact(allocations));
+		EXPECT_TRUE(intact(others));
+
+		// move assignment drops the memory of the assigned-to arena
+		Arena assigned{ CHUNK_SIZE };
+		(void)assigned.allocate(CHUNK_SIZE);
+		assigned = std::move(moved);
+		EXPECT_EQ(assigned.getCapacity(), capacity);
+		EXPECT_EQ(moved.getCapacity(), 0);
+		EXPECT_TRUE(intact(allocations));
+
+		// resetting the assigned-to arena rewinds to the memory of the first allocation
+		assigned.reset();
+		EXPECT_EQ(assigned.allocate(1, 1), allocations.front().ptr);
+
+		Arena& self = assigned;
+		assigned = std::move(self);
+		EXPECT_EQ(assigned.getCapacity(), capacity);
+	}
+
+	TEST(ArenaTests, scopes_set_the_current_arena) {
+		Arena outer, inner;
+		EXPECT_EQ(Arena::current(), nullptr);
+
+		{
+			const Arena::Scope outerScope{ outer };
+			EXPECT_EQ(Arena::current(), &outer);
+
+			{
+				const Arena::Scope innerScope{ inner };
+				EXPECT_EQ(Arena::current(), &inner);
+			}
+
+			EXPECT_EQ(Arena::current(), &outer);
+		}
+
+		EXPECT_EQ(Arena::current(), nullptr);
+	}
+
+}
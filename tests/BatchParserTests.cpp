@@ -0,0 +1,104 @@
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "parsix/BatchParser.h"
+
+/**
+ * @file BatchParserTests.cpp
+ * @brief Checks that a BatchParser returns the results of its inputs in their order, whatever the number of its workers, and that it collects the exception of every failed input (or rethrows that of the first one).
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		using BatchExprParser = BatchParser<LRExprParser>;
+
+		/**
+		 * @brief Makes a lexical analyzer for a source of a batch.
+		 * @details The lexical analyzer refers to its input, which is kept by the thread parsing it: a thread parses one source at a time.
+		 */
+		ExprLexer make_lexer(std::string_view source) {
+			thread_local ChunkedInput input;
+			input = ChunkedInput::view(source);
+
+			return ExprLexer{ input, ExprScanner{} };
+		}
+
+		/**
+		 * @brief Makes expressions of different sizes (and values).
+		 */
+		std::vector<std::string> make_sources(size_t count) {
+			std::vector<std::string> res;
+
+			for (size_t i = 0; i < count; i++)
+				res.push_back(std::to_string(i) + "*(" + make_expression_source(64 << (i % 8)) + ")");
+
+			return res;
+		}
+
+	}
+
+	TEST(BatchParserTests, results_are_in_input_order) {
+		const std::vector<std::string> sources = make_sources(64);
+		const std::vector<std::string_view> views{ sources.begin(), sources.end() };
+
+		for (const size_t threadCount : { 1, 4 }) {
+			const BatchExprParser parser{ lr_expression_parser(), threadCount };
+			const std::vector<Result> results = parser.parseAll(views, make_lexer, Result{});
+
+			ASSERT_EQ(results.size(), sources.size());
+
+			for (size_t i = 0; i < sources.size(); i++)
+				EXPECT_EQ(results[i].value, parse_expression(lr_expression_parser(), sources[i])) << "source " << i << ", " << threadCount << " threads";
+		}
+	}
+
+	TEST(BatchParserTests, errors_are_collected) {
+		std::vector<std::string> sources = make_sources(32);
+
+		// a lexical error, then syntax errors
+		sources[3] += "#";
+		sources[17] += "+";
+		sources[30].insert(0, ")");
+
+		const std::vector<std::string_view> views{ sources.begin(), sources.end() };
+		const BatchExprParser parser{ lr_expression_parser(), 4 };
+
+		std::vector<std::exception_ptr> errors;
+		const std::vector<Result> results = parser.parseAll(views, make_lexer, Result{}, ErrorRecoveryType::ERT_NONE, &errors);
+
+		ASSERT_EQ(results.size(), sources.size());
+		ASSERT_EQ(errors.size(), sources.size());
+
+		for (size_t i = 0; i < sources.size(); i++) {
+			if (i == 3) {
+				EXPECT_THROW(std::rethrow_exception(errors[i]), std::runtime_error);
+			}
+			else if (i == 17 || i == 30) {
+				EXPECT_THROW(std::rethrow_exception(errors[i]), std::logic_error) << "source " << i;
+			}
+			else {
+				EXPECT_EQ(errors[i], nullptr) << "source " << i;
+				EXPECT_EQ(results[i].value, parse_expression(lr_expression_parser(), sources[i])) << "source " << i;
+				continue;
+			}
+
+			// the result of a failed parse is a default-constructed one
+			EXPECT_EQ(results[i].value, Result{}.value) << "source " << i;
+		}
+
+		// without a vector of errors, that of the first failed source is rethrown
+		EXPECT_THROW((void)parser.parseAll(views, make_lexer, Result{}), std::runtime_error);
+
+		sources.erase(sources.begin() + 3);
+		const std::vector<std::string_view> rest{ sources.begin(), sources.end() };
+		EXPECT_THROW((void)parser.parseAll(rest, make_lexer, Result{}), std::logic_error);
+	}
+
+}
@@ -0,0 +1,75 @@
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "parsix/CompactItem.h"
+
+/**
+ * @file CompactItemTests.cpp
+ * @brief Checks that a CompactItem keeps its fields (up to their maxima) and is ordered by them, and that a LookaheadPool interns every lookahead set once.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		using ExprSet = TerminalSet<ExprSymbol>;
+
+		constexpr CompactItem MAX_ITEM{ CompactItem::MAX_PROD_INDEX, CompactItem::MAX_DOT_POS, CompactItem::MAX_LOOKAHEADS_ID };
+
+		// no field spills over into another, even at their maxima
+		static_assert(MAX_ITEM.prodIndex() == CompactItem::MAX_PROD_INDEX);
+		static_assert(MAX_ITEM.dotPos() == CompactItem::MAX_DOT_POS);
+		static_assert(MAX_ITEM.lookaheadsId() == CompactItem::MAX_LOOKAHEADS_ID);
+		static_assert(CompactItem{ CompactItem::MAX_PROD_INDEX, 0, 0 }.dotPos() == 0);
+		static_assert(CompactItem{ 0, CompactItem::MAX_DOT_POS, 0 }.prodIndex() == 0 && CompactItem{ 0, CompactItem::MAX_DOT_POS, 0 }.lookaheadsId() == 0);
+
+	}
+
+	TEST(CompactItemTests, fields_are_kept_and_ordered) {
+		const CompactItem item{ 1234, 5, 678 };
+		EXPECT_EQ(item.prodIndex(), 1234);
+		EXPECT_EQ(item.dotPos(), 5);
+		EXPECT_EQ(item.lookaheadsId(), 678);
+
+		// advancing the dot and changing the lookaheads keep the other fields
+		EXPECT_EQ(item.advanced(), (CompactItem{ 1234, 6, 678 }));
+		EXPECT_EQ(item.withLookaheads(9), (CompactItem{ 1234, 5, 9 }));
+
+		// the core is the production and the dot, without the lookaheads
+		EXPECT_EQ(item.core(), item.withLookaheads(0).core());
+		EXPECT_NE(item.core(), item.advanced().core());
+
+		// ordered by production, then dot, then lookaheads
+		EXPECT_LT((CompactItem{ 1, CompactItem::MAX_DOT_POS, CompactItem::MAX_LOOKAHEADS_ID }), (CompactItem{ 2, 0, 0 }));
+		EXPECT_LT((CompactItem{ 1, 1, CompactItem::MAX_LOOKAHEADS_ID }), (CompactItem{ 1, 2, 0 }));
+		EXPECT_LT((CompactItem{ 1, 1, 1 }), (CompactItem{ 1, 1, 2 }));
+	}
+
+	TEST(CompactItemTests, lookahead_sets_are_interned_once) {
+		using enum ExprTerminal;
+
+		LookaheadPool<ExprSymbol> pool;
+
+		// the empty set is always there, as set 0
+		EXPECT_EQ(pool.size(), 1);
+		EXPECT_EQ(pool.intern(ExprSet{}), 0);
+
+		const ExprSet plus{ terminal<ExprSymbol>(T_PLUS) }, plusEof{ terminal<ExprSymbol>(T_PLUS), terminal<ExprSymbol>(T_EOF) };
+		const size_t plusId = pool.intern(plus), plusEofId = pool.intern(plusEof);
+		EXPECT_NE(plusId, plusEofId);
+		EXPECT_EQ(pool.intern(plusEof), plusEofId);
+		EXPECT_EQ(pool.intern(ExprSet{ terminal<ExprSymbol>(T_EOF), terminal<ExprSymbol>(T_PLUS) }), plusEofId);
+		EXPECT_EQ(pool.size(), 3);
+
+		EXPECT_EQ(pool.at(plusId), plus);
+		EXPECT_EQ(pool[plusEofId], plusEof);
+		EXPECT_THROW((void)pool.at(3), std::out_of_range);
+
+		pool.clear();
+		EXPECT_EQ(pool.size(), 1);
+		EXPECT_EQ(pool.intern(plusEof), 1);
+	}
+
+}
@@ -0,0 +1,102 @@
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "parsix/GLRParser.h"
+#include "parsix/LRTableBuilder.h"
+
+/**
+ * @file GLRParserTests.cpp
+ * @brief Checks the parse forests of a GLRParser: every tree of an ambiguous expression is in the forest of the ambiguous expression grammar, and the forest of the (LALR(1)) expression grammar is the single tree an LRParser builds.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		using GLRExprParser = GLRParser<LRExprGrammar, ExprLexer, ExprSymbol>;
+		using ExprForest = GLRExprParser::ForestType;
+
+		const GLRExprParser& glr_expression_parser() {
+			LRTableBuilder<LRExprGrammar> builder{ make_lr_expression_grammar() };
+			static const GLRExprParser parser{ g_ExprLexer, GLRExprParser::prepareTable(builder), variable<ExprSymbol>(ExprVariable::NT_EP) };
+
+			return parser;
+		}
+
+		const GLRExprParser& glr_ambiguous_parser() {
+			LRTableBuilder<LRExprGrammar> builder{ make_ambiguous_expression_grammar() };
+			static const GLRExprParser parser{ g_ExprLexer, GLRExprParser::prepareTable(builder), variable<ExprSymbol>(ExprVariable::NT_EP) };
+
+			return parser;
+		}
+
+		/**
+		 * @brief Parses an expression with a GLR parser.
+		 * @returns The parse forest of the expression.
+		 * @throws std::logic_error If the expression is invalid.
+		 */
+		ExprForest parse_forest(const GLRExprParser& parser, std::string_view source) {
+			ChunkedInput input = ChunkedInput::view(source);
+			ExprLexer lexer{ input, ExprScanner{} };
+			GLRExprParser::ParseContext ctx;
+
+			return parser.parse(ctx, lexer);
+		}
+
+	}
+
+	TEST(GLRParserTests, ambiguous_expression_forest) {
+		// the trees of n operators are the binary trees of n inner nodes, counted by the Catalan numbers
+		EXPECT_EQ(parse_forest(glr_ambiguous_parser(), "1").countTrees(), 1);
+		EXPECT_EQ(parse_forest(glr_ambiguous_parser(), "1+2*3").countTrees(), 2);
+		EXPECT_EQ(parse_forest(glr_ambiguous_parser(), "1+2+3+4").countTrees(), 5);
+		EXPECT_EQ(parse_forest(glr_ambiguous_parser(), "1*2+3*4+5*6").countTrees(), 42);
+
+		// parentheses leave a single way to group the operators
+		EXPECT_EQ(parse_forest(glr_ambiguous_parser(), "(1+2)*3").countTrees(), 1);
+
+		const ExprForest forest = parse_forest(glr_ambiguous_parser(), "1+2*3");
+		ASSERT_NE(forest.root, ExprForest::NONE);
+		EXPECT_TRUE(forest.isAmbiguous());
+
+		// the root spans the whole input, and is derived either by E -> E + E or by E -> E * E
+		EXPECT_TRUE(forest.nodes[forest.root].isAmbiguous());
+		EXPECT_EQ(forest.nodes[forest.root].start, 0);
+		EXPECT_EQ(forest.nodes[forest.root].end, 5);
+
+		const auto alternatives = forest.getAlternatives(forest.root);
+		ASSERT_EQ(alternatives.size(), 2);
+		EXPECT_NE(alternatives[0]->prodNumber, alternatives[1]->prodNumber);
+
+		for (const auto* alternative : alternatives) {
+			EXPECT_TRUE(alternative->prodNumber == 1 || alternative->prodNumber == 2);
+			EXPECT_EQ(alternative->childCount, 3);
+		}
+	}
+
+	TEST(GLRParserTests, unambiguous_expression_forest) {
+		for (const std::string& source : { std::string{ "1" }, std::string{ "12+3*(45+6)" }, make_expression_source(1 << 12) }) {
+			const ExprForest forest = parse_forest(glr_expression_parser(), source);
+			EXPECT_EQ(forest.countTrees(), 1);
+			EXPECT_FALSE(forest.isAmbiguous());
+
+			// the tree is the one an LRParser builds with the same table
+			ParseTree extracted, expected;
+			forest.extractTree(extracted);
+			(void)parse_expression(lr_expression_parser(), source, &expected);
+
+			EXPECT_FALSE(extracted.hasFailed());
+			EXPECT_EQ(extracted, expected);
+		}
+	}
+
+	TEST(GLRParserTests, invalid_input_is_rejected) {
+		EXPECT_THROW(parse_forest(glr_ambiguous_parser(), "1+*2"), std::logic_error);
+		EXPECT_THROW(parse_forest(glr_ambiguous_parser(), "(1+2"), std::logic_error);
+		EXPECT_THROW(parse_forest(glr_expression_parser(), "1(2)"), std::logic_error);
+	}
+
+}
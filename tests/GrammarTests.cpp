@@ -0,0 +1,271 @@
+#include <initializer_list>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "parsix/TerminalSet.h"
+
+/**
+ * @file GrammarTests.cpp
+ * @brief Checks the FIRST and FOLLOW sets of the grammars against those of the textbook (the Dragon Book) and against those computed by repeated full passes over the productions, and checks the TerminalSet objects they are kept in.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		/**
+		 * @brief Makes a TerminalSet of some terminals.
+		 */
+		template <typename SymbolT, typename TerminalT>
+		TerminalSet<SymbolT> make_set(std::initializer_list<TerminalT> terminals) {
+			TerminalSet<SymbolT> res;
+
+			for (TerminalT terminal : terminals)
+				res.insert(terminal);
+
+			return res;
+		}
+
+		/**
+		 * @brief Calculates the FIRST and FOLLOW sets of the non-terminals of a grammar the way the textbook does: by passing over all of the productions until no set grows.
+		 * @returns The FIRST and FOLLOW sets, as sets of terminal numbers, indexed by non-terminal. FIRST of a nullable non-terminal has `EPSILON`.
+		 */
+		template <typename GrammarT>
+		std::pair<std::vector<std::set<size_t>>, std::vector<std::set<size_t>>> first_and_follow_by_passes(const GrammarT& grammar) {
+			using SymbolType = std::remove_cvref_t<decltype(grammar.at(0).prodHead)>;
+			using TerminalType = decltype(SymbolType{}.as.terminal);
+			using VariableType = decltype(SymbolType{}.as.nonTerminal);
+
+			const size_t epsilon = (size_t)TerminalType::T_EPSILON;
+			std::vector<std::set<size_t>> first((size_t)VariableType::NT_COUNT), follow((size_t)VariableType::NT_COUNT);
+
+			// FIRST of the body of a production from its `from`-th element; it has `EPSILON` if all of them are nullable
+			const auto firstOfBody = [&](const auto& production, size_t from) {
+				std::set<size_t> res;
+
+				for (size_t index = from; index < production.prodBody.size(); index++) {
+					const auto& element = production.prodBody[index];
+
+					if (element.type != ProdElementType::PET_GRAM_SYMBOL)
+						continue;
+
+					const SymbolType& symbol = element.as.gramSymbol;
+
+					if (symbol.isTerminal) {
+						if ((size_t)symbol.as.terminal == epsilon)
+							continue;
+
+						res.insert((size_t)symbol.as.terminal);
+						return res;
+					}
+
+					const std::set<size_t>& fset = first[(size_t)symbol.as.nonTerminal];
+					res.insert(fset.begin(), fset.end());
+					res.erase(epsilon);
+
+					if (not fset.contains(epsilon))
+						return res;
+				}
+
+				res.insert(epsilon);
+				return res;
+			};
+
+			for (bool changed = true; changed; ) {
+				changed = false;
+
+				for (const auto& production : grammar) {
+					std::set<size_t>& fset = first[(size_t)production.prodHead.as.nonTerminal];
+					const size_t size = fset.size();
+
+					fset.merge(firstOfBody(production, 0));
+					changed |= fset.size() != size;
+				}
+			}
+
+			follow[(size_t)grammar.at(0).prodHead.as.nonTerminal].insert((size_t)TerminalType::T_EOF);
+
+			for (bool changed = true; changed; ) {
+				changed = false;
+
+				for (const auto& production : grammar) {
+					for (size_t index = 0; index < production.prodBody.size(); index++) {
+						const auto& element = production.prodBody[index];
+
+						if (element.type != ProdElementType::PET_GRAM_SYMBOL || element.as.gramSymbol.isTerminal)
+							continue;
+
+						std::set<size_t>& fset = follow[(size_t)element.as.gramSymbol.as.nonTerminal];
+						const size_t size = fset.size();
+						std::set<size_t> rest = firstOfBody(production, index + 1);
+
+						if (rest.contains(epsilon)) {
+							const std::set<size_t>& headFollow = follow[(size_t)production.prodHead.as.nonTerminal];
+							rest.insert(headFollow.begin(), headFollow.end());
+						}
+
+						rest.erase(epsilon);
+						fset.merge(rest);
+						changed |= fset.size() != size;
+					}
+				}
+			}
+
+			return { first, follow };
+		}
+
+		/**
+		 * @brief Checks the FIRST and FOLLOW sets calculated by a grammar against those calculated by `first_and_follow_by_passes()`.
+		 */
+		template <typename GrammarT>
+		::testing::AssertionResult same_as_by_passes(GrammarT grammar) {
+			using SymbolType = std::remove_cvref_t<decltype(grammar.at(0).prodHead)>;
+			using VariableType = decltype(SymbolType{}.as.nonTerminal);
+
+			const auto [first, follow] = first_and_follow_by_passes(grammar);
+			grammar.calculateFIRST();
+			grammar.calculateFOLLOW();
+
+			const auto toNumbers = [](const auto& set) {
+				std::set<size_t> res;
+
+				for (const SymbolType& symbol : set)
+					res.insert((size_t)symbol.as.terminal);
+
+				return res;
+			};
+
+			for (size_t variable = 0; variable < (size_t)VariableType::NT_COUNT; variable++) {
+				if (toNumbers(grammar.getFIRSTSet((VariableType)variable)) != first[variable])
+					return ::testing::AssertionFailure() << "FIRST(" << toString((VariableType)variable) << ") is not that of the passes";
+
+				if (toNumbers(grammar.getFOLLOWSet((VariableType)variable)) != follow[variable])
+					return ::testing::AssertionFailure() << "FOLLOW(" << toString((VariableType)variable) << ") is not that of the passes";
+			}
+
+			return ::testing::AssertionSuccess();
+		}
+
+	}
+
+	TEST(GrammarTests, textbook_first_and_follow) {
+		using enum ExprTerminal;
+		using enum ExprVariable;
+		const auto set = make_set<ExprSymbol, ExprTerminal>;
+
+		// the Dragon Book, Example 4.30
+		LLExprGrammar grammar = make_ll_expression_grammar();
+		grammar.calculateFIRST();
+		grammar.calculateFOLLOW();
+
+		for (ExprVariable variable : { NT_E, NT_T, NT_F })
+			EXPECT_EQ(grammar.getFIRSTSet(variable), set({ T_LEFT_PAREN, T_ID })) << toString(variable);
+
+		EXPECT_EQ(grammar.getFIRSTSet(NT_E_TAIL), set({ T_PLUS, T_EPSILON }));
+		EXPECT_EQ(grammar.getFIRSTSet(NT_T_TAIL), set({ T_STAR, T_EPSILON }));
+		EXPECT_TRUE(grammar.isNullable(NT_E_TAIL));
+		EXPECT_FALSE(grammar.isNullable(NT_E));
+
+		EXPECT_EQ(grammar.getFOLLOWSet(NT_E), set({ T_RIGHT_PAREN, T_EOF }));
+		EXPECT_EQ(grammar.getFOLLOWSet(NT_E_TAIL), set({ T_RIGHT_PAREN, T_EOF }));
+		EXPECT_EQ(grammar.getFOLLOWSet(NT_T), set({ T_PLUS, T_RIGHT_PAREN, T_EOF }));
+		EXPECT_EQ(grammar.getFOLLOWSet(NT_T_TAIL), set({ T_PLUS, T_RIGHT_PAREN, T_EOF }));
+		EXPECT_EQ(grammar.getFOLLOWSet(NT_F), set({ T_PLUS, T_STAR, T_RIGHT_PAREN, T_EOF }));
+
+		// the sets of symbols agree with the bitsets
+		EXPECT_EQ(grammar.getFOLLOW(NT_F), (std::set<ExprSymbol>{ grammar.getFOLLOWSet(NT_F).begin(), grammar.getFOLLOWSet(NT_F).end() }));
+	}
+
+	TEST(GrammarTests, cyclic_follow_inclusions) {
+		using enum AssignTerminal;
+		using enum AssignVariable;
+		const auto set = make_set<AssignSymbol, AssignTerminal>;
+
+		// FOLLOW(L) and FOLLOW(R) include each other (L -> * R and R -> L)
+		AssignGrammar grammar = make_assignment_grammar();
+		grammar.calculateFIRST();
+		grammar.calculateFOLLOW();
+
+		for (AssignVariable variable : { NT_S, NT_L, NT_R })
+			EXPECT_EQ(grammar.getFIRSTSet(variable), set({ T_STAR, T_ID })) << toString(variable);
+
+		EXPECT_EQ(grammar.getFOLLOWSet(NT_S), set({ T_EOF }));
+		EXPECT_EQ(grammar.getFOLLOWSet(NT_L), set({ T_EQUAL, T_EOF }));
+		EXPECT_EQ(grammar.getFOLLOWSet(NT_R), set({ T_EQUAL, T_EOF }));
+	}
+
+	TEST(GrammarTests, worklists_reach_the_fixpoint_of_the_passes) {
+		EXPECT_TRUE(same_as_by_passes(make_lr_expression_grammar()));
+		EXPECT_TRUE(same_as_by_passes(make_ll_expression_grammar()));
+		EXPECT_TRUE(same_as_by_passes(make_lr_json_grammar()));
+		EXPECT_TRUE(same_as_by_passes(make_ll_json_grammar()));
+		EXPECT_TRUE(same_as_by_passes(make_assignment_grammar()));
+		EXPECT_TRUE(same_as_by_passes(make_generated_grammar(MAX_STATEMENT_KINDS)));
+	}
+
+	TEST(GrammarTests, terminal_sets_span_words) {
+		using Set = TerminalSet<GenSymbol>;
+		static_assert(Set::WORD_COUNT > 1);
+
+		// terminals on both sides of the word boundaries
+		const GenTerminal low = GenTerminal::T_ID, boundary = GenTerminal(Set::WORD_BITS), last = GenTerminal((size_t)GenTerminal::T_COUNT - 1);
+		Set set;
+		EXPECT_TRUE(set.empty());
+		EXPECT_TRUE(set.insert(boundary));
+		EXPECT_FALSE(set.insert(boundary));
+		EXPECT_TRUE(set.insert(last));
+		EXPECT_TRUE(set.insert(low));
+		EXPECT_EQ(set.size(), 3);
+		EXPECT_TRUE(set.contains(boundary));
+		EXPECT_FALSE(set.contains(GenTerminal(Set::WORD_BITS - 1)));
+
+		// iterated in the order of the terminals
+		std::vector<GenTerminal> members;
+		for (const GenSymbol& symbol : set)
+			members.push_back(symbol.as.terminal);
+		EXPECT_EQ(members, (std::vector<GenTerminal>{ low, boundary, last }));
+
+		// union and inclusion
+		Set other{ terminal<GenSymbol>(GenTerminal::T_SEMI), terminal<GenSymbol>(last) };
+		EXPECT_FALSE(set.includes(other));
+		EXPECT_TRUE(other.unite(set));
+		EXPECT_FALSE(other.unite(set));
+		EXPECT_TRUE(other.includes(set));
+		EXPECT_EQ(other.size(), 4);
+
+		EXPECT_EQ(set.erase(boundary), 1);
+		EXPECT_EQ(set.erase(boundary), 0);
+		EXPECT_EQ(set.size(), 2);
+		EXPECT_NE(set, other);
+		set |= other;
+		EXPECT_EQ(set, other);
+		EXPECT_EQ(set.hash(), other.hash());
+	}
+
+	TEST(GrammarTests, alternatives_are_indexed_by_head) {
+		using enum ExprVariable;
+
+		LRExprGrammar grammar = make_lr_expression_grammar();
+		EXPECT_THROW((void)grammar.getAlternatives(NT_E), MissingValueException);
+
+		EXPECT_TRUE(grammar.indexAlternatives());
+		EXPECT_EQ(grammar.getAlternatives(NT_EP), std::vector<size_t>{ 0 });
+		EXPECT_EQ(grammar.getAlternatives(NT_E), (std::vector<size_t>{ 1, 2 }));
+		EXPECT_EQ(grammar.getAlternatives(NT_T), (std::vector<size_t>{ 3, 4 }));
+		EXPECT_EQ(grammar.getAlternatives(NT_F), (std::vector<size_t>{ 5, 6 }));
+		EXPECT_TRUE(grammar.getAlternatives(NT_E_TAIL).empty());
+
+		// adding a production invalidates the index
+		push_production(grammar, variable<ExprSymbol>(NT_E), { terminal<ExprSymbol>(ExprTerminal::T_ID) });
+		EXPECT_FALSE(grammar.alternativesIndexed());
+		EXPECT_THROW((void)grammar.getAlternatives(NT_E), MissingValueException);
+
+		EXPECT_TRUE(grammar.indexAlternatives());
+		EXPECT_EQ(grammar.getAlternatives(NT_E), (std::vector<size_t>{ 1, 2, 7 }));
+	}
+
+}
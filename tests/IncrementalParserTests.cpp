@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "parsix/IncrementalParser.h"
+
+/**
+ * @file IncrementalParserTests.cpp
+ * @brief Checks that reparsing an expression after edits with an IncrementalParser gives the result of parsing the edited expression from scratch, and that the text the edits did not affect is not parsed again.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		using IncrementalExprParser = IncrementalParser<LRExprParser, Result>;
+
+		/**
+		 * @brief Gets the spans (offset and length) of the identifiers of an expression.
+		 */
+		std::vector<std::pair<size_t, size_t>> find_identifiers(std::string_view source) {
+			std::vector<std::pair<size_t, size_t>> res;
+
+			for (size_t offset = 0; offset < source.size(); ) {
+				if (source[offset] < '0' || source[offset] > '9') {
+					offset++;
+					continue;
+				}
+
+				const size_t end = std::min(source.find_first_not_of("0123456789", offset), source.size());
+				res.emplace_back(offset, end - offset);
+				offset = end;
+			}
+
+			return res;
+		}
+
+		/**
+		 * @brief Parses an expression from scratch.
+		 */
+		size_t full_parse(std::string_view source) {
+			return parse_expression(lr_expression_parser(), source);
+		}
+
+	}
+
+	TEST(IncrementalParserTests, parse_is_full_parse) {
+		const std::string source = make_expression_source(1 << 12);
+		IncrementalExprParser parser{ lr_expression_parser(), source, ExprScanner{} };
+
+		EXPECT_EQ(parser.parse().value, full_parse(source));
+		EXPECT_EQ(parser.getStats().resumeOffset, 0);
+	}
+
+	TEST(IncrementalParserTests, edits_reparse_as_full_parses) {
+		// checkpoints and subtrees are recorded densely, so that every edit resumes from a checkpoint and reuses subtrees
+		IncrementalExprParser parser{ lr_expression_parser(), make_expression_source(1 << 12), ExprScanner{}, Result{}, 8, 4 };
+		(void)parser.parse();
+
+		std::mt19937 random{ 42 };
+		const auto pick = [&random](size_t count) { return std::uniform_int_distribution<size_t>{ 0, count - 1 }(random); };
+
+		for (size_t edit = 0; edit < 200; edit++) {
+			const std::string& source = parser.getSource();
+			const std::vector<std::pair<size_t, size_t>> identifiers = find_identifiers(source);
+			const auto [offset, length] = identifiers[pick(identifiers.size())];
+			const std::string number = std::to_string(pick(100000));
+
+			switch (pick(3)) {
+			case 0: // replace an identifier
+				(void)parser.edit(offset, length, number);
+				break;
+			case 1: // add a term after an identifier
+				(void)parser.edit(offset + length, 0, "+" + number);
+				break;
+			default: { // swap the operator after an identifier, if any
+				const size_t op = source.find_first_of("+*", offset + length);
+
+				if (op == std::string::npos)
+					(void)parser.edit(offset, 0, number);
+				else
+					(void)parser.edit(op, 1, source[op] == '+' ? "*" : "+");
+			}
+			}
+
+			ASSERT_EQ(parser.getResult().value, full_parse(parser.getSource())) << "after edit " << edit;
+		}
+	}
+
+	TEST(IncrementalParserTests, edits_reuse_unaffected_text) {
+		const std::string source = make_expression_source(1 << 16);
+		const size_t tokenCount = count_tokens<ExprTerminal, ExprScanner>(source);
+		IncrementalExprParser parser{ lr_expression_parser(), source, ExprScanner{} };
+		(void)parser.parse();
+
+		// near the end: the parse resumes from a checkpoint close to the edit
+		const size_t last = source.rfind('1');
+		const size_t atEnd = parser.edit(last, 1, "1234").value;
+		EXPECT_EQ(atEnd, full_parse(parser.getSource()));
+		EXPECT_GT(parser.getStats().resumeOffset, source.size() / 2);
+		EXPECT_LT(parser.getStats().tokenCount, tokenCount / 10);
+
+		// near the beginning: the subtrees after the edit are pushed whole
+		const size_t atBeginning = parser.edit(2, 1, "56").value;
+		EXPECT_EQ(atBeginning, full_parse(parser.getSource()));
+		EXPECT_GT(parser.getStats().reusedSubtreeCount, 0);
+		EXPECT_GT(parser.getStats().reusedByteCount, source.size() / 2);
+		EXPECT_LT(parser.getStats().tokenCount, tokenCount / 10);
+	}
+
+	TEST(IncrementalParserTests, invalid_edit_is_fixed_by_a_later_edit) {
+		const std::string source = make_expression_source(1 << 12);
+		IncrementalExprParser parser{ lr_expression_parser(), source, ExprScanner{} };
+		(void)parser.parse();
+
+		const size_t plus = source.find('+', source.size() / 2);
+		EXPECT_THROW((void)parser.edit(plus, 0, "+"), std::logic_error);
+		EXPECT_EQ(parser.getSource().size(), source.size() + 1);
+
+		const size_t fixed = parser.edit(plus, 1, "").value;
+		EXPECT_EQ(fixed, full_parse(source));
+		EXPECT_EQ(parser.getSource(), source);
+		EXPECT_THROW((void)parser.edit(source.size(), 1, ""), std::out_of_range);
+	}
+
+}
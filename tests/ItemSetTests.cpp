@@ -0,0 +1,91 @@
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "parsix/Item.h"
+
+/**
+ * @file ItemSetTests.cpp
+ * @brief Checks that item sets find their items by core: that they are compared and hashed regardless of the order of their items, that inserting an item of a core already in the set merges the lookaheads, and that CLOSURE and GOTO give the sets of the textbook (the Dragon Book, Fig. 4.31).
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		using ExprProduction = std::remove_cvref_t<decltype(LRExprGrammar{}.at(0))>;
+		using ExprItem = Item<ExprProduction>;
+		using ExprItemSet = ItemSet<ExprItem>;
+		using ExprLookaheads = LookAheadSet<ExprSymbol>;
+
+		/**
+		 * @brief Makes the item of production `prodNumber` of `grammar` with the dot at `dotPos` and lookaheads `lookaheads`.
+		 */
+		ExprItem make_item(const LRExprGrammar& grammar, size_t prodNumber, size_t dotPos, std::vector<ExprTerminal> lookaheads = {}) {
+			ExprLookaheads set;
+
+			for (ExprTerminal terminal : lookaheads)
+				set.insert(terminal);
+
+			return ExprItem{ grammar.at(prodNumber), dotPos, set };
+		}
+
+	}
+
+	TEST(ItemSetTests, items_are_found_by_core) {
+		using enum ExprTerminal;
+
+		const LRExprGrammar grammar = make_lr_expression_grammar();
+		const ExprItem first = make_item(grammar, 1, 0, { T_PLUS }), second = make_item(grammar, 3, 1, { T_EOF }), third = make_item(grammar, 6, 1);
+
+		// the order of the items does not matter
+		const ExprItemSet set{ first, second, third };
+		const ExprItemSet reordered{ third, first, second };
+		EXPECT_EQ(set, reordered);
+		EXPECT_EQ(set.hash(), reordered.hash());
+
+		// the lookaheads do, except for the cores
+		const ExprItemSet other{ make_item(grammar, 1, 0, { T_STAR }), second, third };
+		EXPECT_FALSE(set == other);
+		EXPECT_TRUE(set.hasIdenticalCore(other));
+		EXPECT_FALSE(set.hasIdenticalCore(ExprItemSet{ first, second, make_item(grammar, 6, 0) }));
+
+		// inserting an item of a core in the set merges its lookaheads into those of the item of the set
+		ExprItemSet merged = set;
+		EXPECT_TRUE(merged.insert(make_item(grammar, 1, 0, { T_EOF })));
+		EXPECT_FALSE(merged.insert(make_item(grammar, 1, 0, { T_PLUS })));
+		EXPECT_EQ(merged.size(), 3);
+		EXPECT_EQ(merged.get(grammar.at(1), 0), make_item(grammar, 1, 0, { T_PLUS, T_EOF }));
+		EXPECT_TRUE(merged.contains(make_item(grammar, 1, 0, { T_EOF })));
+		EXPECT_FALSE(merged.contains(make_item(grammar, 1, 0, { T_STAR })));
+		EXPECT_FALSE(merged.contains(make_item(grammar, 1, 1, { T_EOF })));
+
+		EXPECT_TRUE(merged.insert(make_item(grammar, 1, 1)));
+		EXPECT_EQ(merged.size(), 4);
+	}
+
+	TEST(ItemSetTests, textbook_closure_and_goto) {
+		LRExprGrammar grammar = make_lr_expression_grammar();
+		grammar.calculateFIRST();
+
+		// I0 = CLOSURE({ [E' -> .E] }): every production of E, T and F, with the dot at the beginning
+		ExprItemSet kernel{ make_item(grammar, 0, 0) };
+		const ExprItemSet closure = kernel.CLOSURE(&grammar);
+
+		ExprItemSet expected;
+		for (size_t prodNumber = 0; prodNumber < grammar.size(); prodNumber++)
+			expected.insert(make_item(grammar, prodNumber, 0));
+
+		EXPECT_EQ(closure, expected);
+
+		// I1 = GOTO(I0, E) = { [E' -> E.], [E -> E. + T] }
+		const ExprItemSet gotoE = kernel.GOTO(variable<ExprSymbol>(ExprVariable::NT_E), &grammar);
+		EXPECT_EQ(gotoE, (ExprItemSet{ make_item(grammar, 0, 1), make_item(grammar, 1, 1) }));
+
+		// I5 = GOTO(I0, id) = { [F -> id.] }
+		const ExprItemSet gotoId = kernel.GOTO(terminal<ExprSymbol>(ExprTerminal::T_ID), &grammar);
+		EXPECT_EQ(gotoId, ExprItemSet{ make_item(grammar, 6, 1) });
+	}
+
+}
@@ -0,0 +1,296 @@
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "parsix/LLParser.h"
+#include "parsix/LRTableBuilder.h"
+
+/**
+ * @file LLParserTests.cpp
+ * @brief Checks the LL expression and JSON parsers, made from the LL(1) grammars of the benchmarks (see grammars.cpp): that they parse as the LR parsers of the same languages do, and how they recover from errors.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		using LLExprTable = LLParsingTable<LLExprGrammar, ExprTerminal, ExprVariable>;
+		using LLExprParser = LLParser<LLExprGrammar, ExprLexer, ExprSymbol, LLExprTable, fsm::FSMTable, std::string_view>;
+		using LLObservedExprParser = LLParser<LLExprGrammar, ObservedExprLexer, ExprSymbol, LLExprTable, fsm::FSMTable, std::string_view>;
+
+		using LLJsonTable = LLParsingTable<LLJsonGrammar, JsonTerminal, JsonVariable>;
+		using LLJsonParser = LLParser<LLJsonGrammar, JsonLexer, JsonSymbol, LLJsonTable, fsm::FSMTable, std::string_view>;
+
+		using JsonState = LRState<Value, OffsetToken<JsonTerminal>>;
+		using JsonStack = LRStackType<Value, OffsetToken<JsonTerminal>>;
+
+		/**
+		 * @brief The actions of the LR JSON grammar: only the acceptance has one (the document is merely recognized).
+		 */
+		constexpr auto make_json_actions() {
+			return LRActionTable{ [](JsonStack&, JsonState&, Result& result) { result.value = 1; } };
+		}
+
+		using LRJsonParser = LRParser<LRJsonGrammar, JsonLexer, JsonSymbol, JsonState, LRParsingTable<LRJsonGrammar>, fsm::FSMTable, std::string, decltype(make_json_actions())>;
+
+		JsonLexer g_JsonLexer;
+
+		/**
+		 * @brief A leaf of a parse tree: its terminal and the span of its text.
+		 */
+		using Leaf = std::tuple<uint32_t, uint64_t, uint32_t>;
+
+		/**
+		 * @brief Gets the leaves of a parse tree, in the order of the input.
+		 */
+		std::vector<Leaf> get_leaves(const ParseTree& tree) {
+			std::vector<Leaf> res;
+
+			for (const ParseTreeNode& node : tree)
+				if (node.isTerminal())
+					res.emplace_back(node.terminal(), node.offset, node.length);
+
+			return res;
+		}
+
+		/**
+		 * @brief Evaluates the parse tree of an expression built by the LL expression parser, as the actions of the LR expression grammar evaluate the expression (see `make_expression_actions()`).
+		 * @details The value of a tail is the sum (or product) of its operands; `+` and `*` being associative, the value of the expression does not depend on how they are grouped.
+		 */
+		size_t evaluate_ll_expression(const ParseTree& tree) {
+			return tree.evaluate<size_t>([](const ParseTreeNode& node, std::span<size_t> children) -> size_t {
+				if (node.isTerminal())
+					return node.terminal() == (uint32_t)ExprTerminal::T_ID ? node.length : 0;
+
+				switch (node.production()) {
+				case 0: // E -> T E_TAIL
+					return children[0] + children[1];
+				case 1: // E_TAIL -> + T E_TAIL
+					return children[1] + children[2];
+				case 2: // E_TAIL -> epsilon
+					return 0;
+				case 3: // T -> F T_TAIL
+					return children[0] * children[1];
+				case 4: // T_TAIL -> * F T_TAIL
+					return children[1] * children[2];
+				case 5: // T_TAIL -> epsilon
+					return 1;
+				case 6: // F -> ( E )
+					return children[1];
+				default: // F -> id
+					return children[0];
+				}
+				});
+		}
+
+		/**
+		 * @brief Counts the nodes of a parse tree whose production has `head` as its head.
+		 */
+		template <typename GrammarT>
+		size_t count_nodes(const ParseTree& tree, const GrammarT& grammar, JsonVariable head) {
+			size_t res = 0;
+
+			for (const ParseTreeNode& node : tree)
+				res += not node.isTerminal() && grammar.at(node.production()).prodHead.as.nonTerminal == head;
+
+			return res;
+		}
+
+		/**
+		 * @brief Parses a source with an LL parser, building its parse tree.
+		 */
+		template <typename LexerT, typename ScannerT, typename ParserT>
+		ParseTree ll_parse_tree(const ParserT& parser, std::string_view source) {
+			ChunkedInput input = ChunkedInput::view(source);
+			LexerT lexer{ input, ScannerT{} };
+			ParseTree tree;
+			typename ParserT::ParseContext ctx;
+			ctx.tree = &tree;
+
+			(void)parser.template parse<Result>(ctx, lexer);
+
+			return tree;
+		}
+
+		/**
+		 * @brief The context of a parse when the lexical analyzer returned a token.
+		 */
+		struct Snapshot {
+			ExprToken token;
+			ExprToken currInputToken;
+			std::vector<ExprSymbol> stack;
+			size_t errorNum;
+		};
+
+	}
+
+	TEST(LLParserTests, expression_parse_is_lr_parse) {
+		const LLExprParser parser{ variable<ExprSymbol>(ExprVariable::NT_E), LLExprParser::prepareTable(make_ll_table<LLExprTable>(make_ll_expression_grammar())), g_ExprLexer };
+
+		for (const std::string& source : { std::string{ "12+3*(45+6)*7" }, make_expression_source(1 << 12) }) {
+			ParseTree lrTree;
+			const size_t expected = parse_expression(lr_expression_parser(), source, &lrTree);
+			const ParseTree llTree = ll_parse_tree<ExprLexer, ExprScanner>(parser, source);
+
+			ASSERT_FALSE(llTree.hasFailed());
+			EXPECT_EQ(evaluate_ll_expression(llTree), expected);
+			EXPECT_EQ(get_leaves(llTree), get_leaves(lrTree));
+		}
+	}
+
+	TEST(LLParserTests, json_parse_is_lr_parse) {
+		const LLJsonGrammar llGrammar = make_ll_json_grammar();
+		const LRJsonGrammar lrGrammar = make_lr_json_grammar();
+		const LLJsonParser llParser{ variable<JsonSymbol>(JsonVariable::NT_VALUE), LLJsonParser::prepareTable(make_ll_table<LLJsonTable>(llGrammar)), g_JsonLexer };
+		const LRJsonParser lrParser{ g_JsonLexer, LRJsonParser::prepareTable(LRTableBuilder<LRJsonGrammar>{ lrGrammar }.build(LRTableType::LTT_LALR1)), variable<JsonSymbol>(JsonVariable::NT_START), make_json_actions() };
+
+		for (const std::string& source : { std::string{ R"({"a": [1, true, {}], "b": {"c": null}})" }, make_json_source(1 << 12) }) {
+			ChunkedInput input = ChunkedInput::view(source);
+			JsonLexer lexer{ input, JsonScanner{} };
+			ParseTree lrTree;
+			LRJsonParser::ParseContext ctx;
+			ctx.tree = &lrTree;
+			ASSERT_EQ(lrParser.parse(ctx, lexer, Result{}).value, 1);
+
+			const ParseTree llTree = ll_parse_tree<JsonLexer, JsonScanner>(llParser, source);
+
+			ASSERT_FALSE(llTree.hasFailed());
+			ASSERT_FALSE(lrTree.hasFailed());
+
+			// every value of the document is a VALUE node of both trees
+			EXPECT_GT(count_nodes(lrTree, lrGrammar, JsonVariable::NT_VALUE), 0);
+			EXPECT_EQ(count_nodes(llTree, llGrammar, JsonVariable::NT_VALUE), count_nodes(lrTree, lrGrammar, JsonVariable::NT_VALUE));
+			EXPECT_EQ(get_leaves(llTree), get_leaves(lrTree));
+		}
+	}
+
+	TEST(LLParserTests, prepared_tables_are_not_copied) {
+		const ExprSymbol start = variable<ExprSymbol>(ExprVariable::NT_E);
+		const LLExprTable table = make_ll_table<LLExprTable>(make_ll_expression_grammar());
+		const std::shared_ptr<const LLExprTable> prepared = LLExprParser::prepareTable(table);
+
+		// only the prepared copy is frozen (and has the reversed production bodies); the table given is left as is
+		EXPECT_FALSE(prepared->reversedBodies.empty());
+		EXPECT_TRUE(table.reversedBodies.empty());
+
+		{
+			const LLExprParser first{ start, prepared, g_ExprLexer }, second{ start, prepared, g_ExprLexer };
+			EXPECT_EQ(prepared.use_count(), 3);
+
+			// a parser given a table (rather than a prepared one) prepares a copy of its own
+			const LLExprParser own{ start, table, g_ExprLexer };
+			EXPECT_EQ(prepared.use_count(), 3);
+
+			const std::string source = "12+3*(45+6)";
+			const std::vector<Leaf> expected = get_leaves(ll_parse_tree<ExprLexer, ExprScanner>(own, source));
+			EXPECT_EQ(get_leaves(ll_parse_tree<ExprLexer, ExprScanner>(first, source)), expected);
+			EXPECT_EQ(get_leaves(ll_parse_tree<ExprLexer, ExprScanner>(second, source)), expected);
+		}
+
+		EXPECT_EQ(prepared.use_count(), 1);
+	}
+
+	TEST(LLParserTests, panic_mode_synchronizes_variables) {
+		const std::shared_ptr<const LLExprTable> table = LLObservedExprParser::prepareTable(make_ll_table<LLExprTable>(make_ll_expression_grammar()));
+
+		// T cannot begin with `)`: T is given up once the token after `)` is in its synchronization set; E_TAIL cannot begin with the `2` left, so it is given up at the end of the input
+		const std::string source = "1+)2";
+		ChunkedInput input = ChunkedInput::view(source);
+		ObservedExprLexer lexer{ input, ExprScanner{} };
+		const LLObservedExprParser parser{ variable<ExprSymbol>(ExprVariable::NT_E), table, lexer };
+
+		LLObservedExprParser::ParseContext ctx;
+		std::vector<Snapshot> snapshots;
+		lexer.onToken = [&](const ExprToken& token) {
+			std::vector<ExprSymbol> stack;
+
+			for (const auto& element : ctx.stack)
+				if (element.type == ProdElementType::PET_GRAM_SYMBOL)
+					stack.push_back(element.as.gramSymbol);
+
+			snapshots.push_back({ token, ctx.currInputToken, std::move(stack), ctx.errorNum });
+		};
+
+		(void)parser.parse<Result>(ctx, lexer, ErrorRecoveryType::ERT_PANIC_MODE);
+
+		ASSERT_EQ(snapshots.size(), 5);
+
+		// `2` is the sync token of T, which has been popped while `)` was the current token
+		const Snapshot& first = snapshots[3];
+		EXPECT_TRUE(table->view().synchronizes((size_t)ExprVariable::NT_T, (size_t)ExprTerminal::T_ID));
+		EXPECT_EQ(first.token.name, ExprTerminal::T_ID);
+		EXPECT_EQ(first.token.offset, 3);
+		EXPECT_EQ(first.currInputToken.name, ExprTerminal::T_RIGHT_PAREN);
+		EXPECT_EQ(first.stack, std::vector{ variable<ExprSymbol>(ExprVariable::NT_E_TAIL) });
+		EXPECT_EQ(first.errorNum, 1);
+
+		// the end of the input is the sync token of E_TAIL, the last symbol on the stack
+		const Snapshot& second = snapshots[4];
+		EXPECT_FALSE(table->view().synchronizes((size_t)ExprVariable::NT_E_TAIL, (size_t)ExprTerminal::T_ID));
+		EXPECT_TRUE(table->view().synchronizes((size_t)ExprVariable::NT_E_TAIL, (size_t)ExprTerminal::T_EOF));
+		EXPECT_EQ(second.token.name, ExprTerminal::T_EOF);
+		EXPECT_EQ(second.currInputToken.offset, 3);
+		EXPECT_TRUE(second.stack.empty());
+		EXPECT_EQ(second.errorNum, 2);
+
+		EXPECT_EQ(ctx.errorNum, 2);
+		EXPECT_TRUE(ctx.stack.empty());
+	}
+
+	TEST(LLParserTests, frozen_table_is_viewed_as_is) {
+		LLExprTable table = make_ll_table<LLExprTable>(make_ll_expression_grammar());
+		table.freeze();
+
+		// the view has the very entries of the table
+		const auto view = table.view();
+		for (size_t variable = 0; variable < (size_t)ExprVariable::NT_COUNT; variable++)
+			for (size_t terminal = 0; terminal < (size_t)ExprTerminal::T_COUNT; terminal++)
+				EXPECT_EQ(&view(variable, terminal), &table.table[variable][terminal]);
+
+		// an entry may only refer to a production of the grammar
+		LLTableEntry& entry = table.table[(size_t)ExprVariable::NT_F][(size_t)ExprTerminal::T_PLUS];
+		entry.isError = false;
+		entry.isEmpty = false;
+		entry.prodIndex = table.grammar.size();
+		EXPECT_THROW(table.freeze(), std::logic_error);
+		EXPECT_THROW((void)LLExprParser::prepareTable(table), std::logic_error);
+
+		entry.prodIndex = table.grammar.size() - 1;
+		EXPECT_NO_THROW(table.freeze());
+	}
+
+	TEST(LLParserTests, errors_are_counted_per_parse) {
+		const LLExprParser parser{ variable<ExprSymbol>(ExprVariable::NT_E), LLExprParser::prepareTable(make_ll_table<LLExprTable>(make_ll_expression_grammar())), g_ExprLexer };
+		const auto parse = [&parser](LLExprParser::ParseContext& ctx, std::string_view source) {
+			ChunkedInput input = ChunkedInput::view(source);
+			ExprLexer lexer{ input, ExprScanner{} };
+
+			(void)parser.parse<Result>(ctx, lexer, ErrorRecoveryType::ERT_PANIC_MODE);
+		};
+
+		// the count of a context starts over with every parse
+		LLExprParser::ParseContext ctx;
+		for (size_t i = 0; i < 3; i++) {
+			parse(ctx, "1+)2");
+			EXPECT_EQ(ctx.errorNum, 2) << "parse " << i;
+		}
+
+		// and is not shared with the parses of other contexts (on this thread or another)
+		LLExprParser::ParseContext other;
+		parse(other, "1+2");
+		EXPECT_EQ(other.errorNum, 0);
+
+		std::thread{ [&] { parse(other, "1+)2"); } }.join();
+		EXPECT_EQ(other.errorNum, 2);
+		EXPECT_EQ(ctx.errorNum, 2);
+	}
+
+}
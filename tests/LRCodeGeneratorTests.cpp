@@ -0,0 +1,53 @@
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "ExprParser.h"
+
+/**
+ * @file LRCodeGeneratorTests.cpp
+ * @brief Checks the expression parser generated by LRCodeGenerator (into ExprParser.h, by generate_expression_parser.cpp, when `ParsixTests` is built) against the LR expression parser it was generated from.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		using GeneratedExprParser = generated::ExprParser<ExprTerminal, ExprStack>;
+
+		/**
+		 * @brief Parses an expression with the generated parser, reading it through a StreamingLexer.
+		 */
+		size_t parse_generated_expression(std::string_view source) {
+			ChunkedInput input = ChunkedInput::view(source);
+			ExprLexer lexer{ input, ExprScanner{} };
+
+			return GeneratedExprParser::parse([&lexer] { return lexer.getNextToken(); }, make_expression_actions(), Result{}).value;
+		}
+
+	}
+
+	TEST(LRCodeGeneratorTests, generated_parser_is_lr_parser) {
+		static_assert(GeneratedExprParser::PRODUCTION_COUNT == 7);
+
+		for (const std::string& source : { std::string{ "12+3*(45+6)" }, std::string{ "((1))" }, make_expression_source(1 << 12), make_expression_source(1 << 16) })
+			EXPECT_EQ(parse_generated_expression(source), parse_expression(lr_expression_parser(), source));
+
+		// the parser reuses the storage of a given stack
+		ExprStack stack;
+		const std::string source = make_expression_source(1 << 12);
+		ChunkedInput input = ChunkedInput::view(source);
+		ExprLexer lexer{ input, ExprScanner{} };
+		EXPECT_EQ(GeneratedExprParser::parse(stack, [&lexer] { return lexer.getNextToken(); }, make_expression_actions(), Result{}).value, parse_expression(lr_expression_parser(), source));
+	}
+
+	TEST(LRCodeGeneratorTests, generated_parser_rejects_invalid_input) {
+		for (const std::string_view source : { "12+", "12+*3", "(12", "12)", "" }) {
+			EXPECT_THROW((void)parse_generated_expression(source), std::logic_error) << source;
+			EXPECT_THROW((void)parse_expression(lr_expression_parser(), source), std::logic_error) << source;
+		}
+	}
+
+}
@@ -0,0 +1,131 @@
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "parsix/LRCompressedTable.h"
+#include "parsix/LRTableBuilder.h"
+
+/**
+ * @file LRCompressedTableTests.cpp
+ * @brief Checks that LRCompressedTable keeps every entry of the tables it compresses, that default reductions do not change how the expression parser parses (nor where it detects errors), and that entries whose numbers do not fit are rejected.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		using LRCompressedExprTable = LRCompressedTable<LRExprGrammar>;
+		using LRCompressedExprParser = LRParser<LRExprGrammar, ExprLexer, ExprSymbol, ExprState, LRCompressedExprTable, fsm::FSMTable, std::string, ExprActions>;
+
+		/**
+		 * @brief Checks that a compressed table has the entries of the table it was compressed from, cell by cell.
+		 */
+		template <typename GrammarT>
+		::testing::AssertionResult same_entries(const LRParsingTable<GrammarT>& expected, const LRCompressedTable<GrammarT>& actual) {
+			using TerminalType = typename LRCompressedTable<GrammarT>::TerminalType;
+			using VariableType = typename LRCompressedTable<GrammarT>::VariableType;
+
+			if (expected.getStateCount() != actual.getStateCount())
+				return ::testing::AssertionFailure() << std::format("The table has {} states instead of {}.", actual.getStateCount(), expected.getStateCount());
+
+			for (size_t state = 0; state < expected.getStateCount(); state++) {
+				for (size_t terminal = 0; terminal < (size_t)TerminalType::T_COUNT; terminal++)
+					if (not (actual.atAction(state, (TerminalType)terminal) == expected.view().atAction(state, (TerminalType)terminal)))
+						return ::testing::AssertionFailure() << std::format("The Action entry of state {} on terminal {} is `{}` instead of `{}`.", state, terminal, (std::string)actual.atAction(state, (TerminalType)terminal), (std::string)expected.view().atAction(state, (TerminalType)terminal));
+
+				for (size_t variable = 0; variable < (size_t)VariableType::NT_COUNT; variable++)
+					if (not (actual.atGoto(state, (VariableType)variable) == expected.view().atGoto(state, (VariableType)variable)))
+						return ::testing::AssertionFailure() << std::format("The GOTO entry of state {} on non-terminal {} is `{}` instead of `{}`.", state, variable, (std::string)actual.atGoto(state, (VariableType)variable), (std::string)expected.view().atGoto(state, (VariableType)variable));
+
+				if (actual.getGotos(state) != expected.getGotos(state))
+					return ::testing::AssertionFailure() << std::format("The GOTO non-terminals of state {} differ.", state);
+
+				if (actual.getActions(state) != expected.getActions(state))
+					return ::testing::AssertionFailure() << std::format("The Action terminals of state {} differ.", state);
+			}
+
+			return ::testing::AssertionSuccess();
+		}
+
+		/**
+		 * @brief Builds a table of a grammar, frozen as LRCompressedTable freezes the tables it compresses.
+		 */
+		template <typename GrammarT>
+		LRParsingTable<GrammarT> build_table(const GrammarT& grammar, LRTableType type) {
+			LRParsingTable<GrammarT> table = LRTableBuilder<GrammarT>{ grammar }.build(type);
+			table.freeze();
+
+			return table;
+		}
+
+		/**
+		 * @brief Parses an expression, and gets its value or the token at which the parse failed.
+		 */
+		template <typename ParserT>
+		std::pair<size_t, ExprToken> try_parse_expression(const ParserT& parser, std::string_view source) {
+			ChunkedInput input = ChunkedInput::view(source);
+			ExprLexer lexer{ input, ExprScanner{} };
+			typename ParserT::ParseContext ctx;
+
+			try {
+				return { parser.parse(ctx, lexer, Result{}).value, ExprToken{} };
+			}
+			catch (const std::logic_error&) {
+				return { SIZE_MAX, ctx.currInputToken };
+			}
+		}
+
+	}
+
+	TEST(LRCompressedTableTests, entries_are_kept) {
+		for (const LRTableType type : { LRTableType::LTT_LALR1, LRTableType::LTT_CLR1 }) {
+			const LRExprTable expressionTable = build_table(make_lr_expression_grammar(), type);
+			EXPECT_TRUE(same_entries(expressionTable, LRCompressedExprTable{ expressionTable, false })) << toString(type);
+
+			const LRParsingTable<AssignGrammar> assignmentTable = build_table(make_assignment_grammar(), type);
+			EXPECT_TRUE(same_entries(assignmentTable, LRCompressedTable<AssignGrammar>{ assignmentTable, false })) << toString(type);
+		}
+	}
+
+	TEST(LRCompressedTableTests, default_reductions_parse_as_uncompressed) {
+		const LRExprTable table = build_table(make_lr_expression_grammar(), LRTableType::LTT_LALR1);
+		const LRCompressedExprTable compressed{ table };
+		const LRCompressedExprParser parser{ g_ExprLexer, LRCompressedExprParser::prepareTable(compressed), variable<ExprSymbol>(ExprVariable::NT_EP), make_expression_actions() };
+
+		// default reductions make the table smaller, and fill some error entries of the states having one
+		EXPECT_LT(compressed.getByteSize(), (LRCompressedExprTable{ table, false }.getByteSize()));
+		EXPECT_FALSE(same_entries(table, compressed));
+
+		for (const std::string& source : { std::string{ "12+3*(45+6)" }, make_expression_source(1 << 12) })
+			EXPECT_EQ(try_parse_expression(parser, source), try_parse_expression(lr_expression_parser(), source));
+
+		// the default reductions are taken on the erroneous token, but the error is detected before it is shifted
+		for (const std::string source : { "12+3*", "12+3 4", "(12+3", "12+3)*4", "12*(+3)" }) {
+			const auto [value, token] = try_parse_expression(parser, source);
+			const auto [expectedValue, expectedToken] = try_parse_expression(lr_expression_parser(), source);
+
+			EXPECT_EQ(value, SIZE_MAX) << source;
+			EXPECT_EQ(expectedValue, SIZE_MAX) << source;
+			EXPECT_EQ(token.name, expectedToken.name) << source;
+			EXPECT_EQ(token.offset, expectedToken.offset) << source;
+		}
+	}
+
+	TEST(LRCompressedTableTests, numbers_must_fit) {
+		const size_t largest = LRPackedEntry::NUMBER_MASK - 1;
+
+		EXPECT_EQ(LRPackedEntry::pack(TE_SHIFT(largest)).unpack(), (TE_SHIFT(largest)));
+		EXPECT_EQ(LRPackedEntry::pack(TE_REDUCE(largest)).unpack(), (TE_REDUCE(largest)));
+		EXPECT_EQ(LRPackedEntry::pack(TE_ACCEPT()).unpack(), (TE_ACCEPT()));
+		EXPECT_TRUE(LRPackedEntry::pack(LRTableEntry{}).isEmpty());
+
+		// the value of the number mask stands for "no number"
+		EXPECT_THROW((void)LRPackedEntry::pack(TE_SHIFT(largest + 1)), std::range_error);
+		EXPECT_THROW((void)LRPackedEntry::pack(TE_GOTO(size_t(1) << 32)), std::range_error);
+	}
+
+}
@@ -0,0 +1,272 @@
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "parsix/LRTableBuilder.h"
+
+/**
+ * @file LRParserTests.cpp
+ * @brief Checks the LR expression parser (see fixtures.h): how it is constructed from a prepared table, and how it parses.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		using LRObservedExprParser = LRParser<LRExprGrammar, ObservedExprLexer, ExprSymbol, ExprState, LRExprTable, fsm::FSMTable, std::string, ExprActions>;
+
+		/**
+		 * @brief The context of a parse when the lexical analyzer returned a token.
+		 */
+		struct Snapshot {
+			ExprToken token;
+			ExprToken currInputToken;
+			std::vector<ExprState> stack;
+			size_t errorNum;
+		};
+
+		/**
+		 * @brief The data of a state of the expression parser, counting its conversions to strings (i.e., how many times a message containing it was formatted).
+		 */
+		struct CountedValue {
+			static inline size_t s_Conversions = 0;
+
+			size_t value = 0;
+
+			operator std::string() const {
+				s_Conversions++;
+				return std::to_string(this->value);
+			}
+
+			explicit operator bool() const { return true; }
+			bool operator==(const CountedValue&) const = default;
+		};
+
+		using CountedState = LRState<CountedValue, ExprToken>;
+		using CountedStack = LRStackType<CountedValue, ExprToken>;
+		using CountedActions = decltype(make_expression_actions<CountedStack, CountedState>());
+		using LRCountedExprParser = LRParser<LRExprGrammar, ExprLexer, ExprSymbol, CountedState, LRExprTable, fsm::FSMTable, std::string, CountedActions>;
+
+	}
+
+	TEST(LRParserTests, parsers_share_prepared_tables) {
+		using PreparedTable = LRExprParser::PreparedTableType;
+		const ExprSymbol start = variable<ExprSymbol>(ExprVariable::NT_EP);
+
+		// only a prepared table can be shared
+		static_assert(std::is_constructible_v<LRExprParser, ExprLexer&, std::shared_ptr<const PreparedTable>, const ExprSymbol&, const ExprActions&>);
+		static_assert(not std::is_constructible_v<LRExprParser, ExprLexer&, std::shared_ptr<const LRExprTable>, const ExprSymbol&, const ExprActions&>);
+
+		const std::shared_ptr<const PreparedTable> table = LRExprParser::prepareTable(LRTableBuilder<LRExprGrammar>{ make_lr_expression_grammar() }.build(LRTableType::LTT_LALR1));
+		const LRExprParser first{ g_ExprLexer, table, start, make_expression_actions() }, second{ g_ExprLexer, table, start, make_expression_actions() };
+
+		// a prepared table made by hand is as good as one made by prepareTable()
+		const LRExprParser third{ g_ExprLexer, std::make_shared<const PreparedTable>(table->table()), start, make_expression_actions() };
+
+		for (const std::string& source : { std::string{ "12+3*(45+6)" }, make_expression_source(1 << 12) }) {
+			const size_t expected = parse_expression(lr_expression_parser(), source);
+
+			EXPECT_EQ(parse_expression(first, source), expected);
+			EXPECT_EQ(parse_expression(second, source), expected);
+			EXPECT_EQ(parse_expression(third, source), expected);
+		}
+
+		EXPECT_THROW((LRExprParser{ g_ExprLexer, std::shared_ptr<const PreparedTable>{}, start, make_expression_actions() }), std::logic_error);
+	}
+
+	TEST(LRParserTests, prepared_tables_are_not_copied) {
+		const ExprSymbol start = variable<ExprSymbol>(ExprVariable::NT_EP);
+		const LRExprTable table = LRTableBuilder<LRExprGrammar>{ make_lr_expression_grammar() }.build(LRTableType::LTT_LALR1);
+		const std::shared_ptr<const LRExprParser::PreparedTableType> prepared = LRExprParser::prepareTable(table);
+
+		// FIRST and FOLLOW are calculated once, on the prepared copy; the table given is left as is
+		EXPECT_TRUE(prepared->table().grammar.FIRSTCalculated());
+		EXPECT_TRUE(prepared->table().grammar.FOLLOWCalculated());
+
+		const LRExprTable unprepared{ make_lr_expression_grammar() };
+		(void)LRExprParser::prepareTable(unprepared);
+		EXPECT_FALSE(unprepared.grammar.FIRSTCalculated());
+		EXPECT_FALSE(unprepared.grammar.FOLLOWCalculated());
+
+		{
+			const LRExprParser first{ g_ExprLexer, prepared, start, make_expression_actions() }, second{ g_ExprLexer, prepared, start, make_expression_actions() };
+			EXPECT_EQ(prepared.use_count(), 3);
+
+			// a parser given a table (rather than a prepared one) prepares a copy of its own
+			const LRExprParser own{ g_ExprLexer, table, start, make_expression_actions() };
+			EXPECT_EQ(prepared.use_count(), 3);
+
+			const std::string source = "12+3*(45+6)";
+			EXPECT_EQ(parse_expression(first, source), parse_expression(own, source));
+			EXPECT_EQ(parse_expression(second, source), parse_expression(own, source));
+		}
+
+		EXPECT_EQ(prepared.use_count(), 1);
+	}
+
+	TEST(LRParserTests, parses_on_many_threads_share_a_parser) {
+		constexpr size_t THREAD_COUNT = 4, SOURCE_COUNT = 64;
+		const LRExprParser& parser = lr_expression_parser();
+
+		std::vector<std::string> sources;
+		std::vector<size_t> expected;
+		for (size_t i = 0; i < SOURCE_COUNT; i++) {
+			sources.push_back(std::to_string(i) + "*(" + make_expression_source(64 << (i % 8)) + ")");
+			expected.push_back(parse_expression(parser, sources.back()));
+		}
+
+		// all of the state of a parse lives in its context: each thread reuses one context for all of its parses, and the parser is shared as is
+		std::vector<size_t> values(SOURCE_COUNT);
+		std::vector<std::thread> threads;
+		for (size_t thread = 0; thread < THREAD_COUNT; thread++)
+			threads.emplace_back([&, thread] {
+				LRExprParser::ParseContext ctx;
+
+				for (size_t i = thread; i < SOURCE_COUNT; i += THREAD_COUNT) {
+					ChunkedInput input = ChunkedInput::view(sources[i]);
+					ExprLexer lexer{ input, ExprScanner{} };
+					values[i] = parser.parse(ctx, lexer, Result{}).value;
+				}
+			});
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		EXPECT_EQ(values, expected);
+	}
+
+	TEST(LRParserTests, panic_mode_shifts_the_goto_of_the_sync_variable) {
+		const std::shared_ptr<const LRObservedExprParser::PreparedTableType> table = LRObservedExprParser::prepareTable(LRTableBuilder<LRExprGrammar>{ make_lr_expression_grammar() }.build(LRTableType::LTT_LALR1));
+
+		// `(` cannot follow `12`: the states are popped down to the initial one, `(` and `34` are skipped and the parse resumes at `+`, which follows E
+		const std::string source = "12(34+5";
+		ChunkedInput input = ChunkedInput::view(source);
+		ObservedExprLexer lexer{ input, ExprScanner{} };
+		const LRObservedExprParser parser{ lexer, table, variable<ExprSymbol>(ExprVariable::NT_EP), make_expression_actions() };
+		LRObservedExprParser::ParseContext ctx;
+		std::vector<Snapshot> snapshots;
+		lexer.onToken = [&](const ExprToken& token) { snapshots.push_back({ token, ctx.currInputToken, ctx.stack, ctx.errorNum }); };
+
+		const size_t value = parser.parse(ctx, lexer, Result{}, ErrorRecoveryType::ERT_PANIC_MODE).value;
+
+		ASSERT_EQ(snapshots.size(), 6);
+
+		// while `34` and `+` are skipped, only the initial state is left
+		for (const Snapshot& skipping : { snapshots[2], snapshots[3] }) {
+			ASSERT_EQ(skipping.stack.size(), 1);
+			EXPECT_EQ(skipping.stack.back().state, 0);
+			EXPECT_EQ(skipping.errorNum, 1);
+		}
+
+		// `+` is the sync token: when the token after it is read, the GOTO of E in the initial state has been pushed (with no data) and `+` shifted on top of it
+		const Snapshot& synced = snapshots[4];
+		EXPECT_EQ(synced.token.offset, 6);
+		EXPECT_EQ(synced.currInputToken.name, ExprTerminal::T_PLUS);
+		EXPECT_EQ(synced.currInputToken.offset, 5);
+		EXPECT_EQ(table->recovery().syncVariable(0, ExprTerminal::T_PLUS), ExprVariable::NT_E);
+		ASSERT_EQ(synced.stack.size(), 3);
+		EXPECT_EQ(synced.stack[1].state, table->table().view().atGoto(0, ExprVariable::NT_E).number);
+		EXPECT_EQ(synced.stack[1].data.value, 0);
+		EXPECT_EQ(synced.stack[2].state, table->table().view().atAction(synced.stack[1].state, ExprTerminal::T_PLUS).number);
+		EXPECT_EQ(synced.errorNum, 1);
+
+		// the rest is parsed as `E+5`
+		EXPECT_EQ(ctx.errorNum, 1);
+		EXPECT_EQ(value, 1);
+	}
+
+	TEST(LRParserTests, trace_messages_are_only_formatted_if_enabled) {
+		const LRCountedExprParser parser{ g_ExprLexer, LRCountedExprParser::prepareTable(LRTableBuilder<LRExprGrammar>{ make_lr_expression_grammar() }.build(LRTableType::LTT_LALR1)), variable<ExprSymbol>(ExprVariable::NT_EP), make_expression_actions<CountedStack, CountedState>() };
+		const std::string source = "12+3*(45+6)";
+
+		// every push and pop traces the stack, which converts the data of each of its states
+		CountedValue::s_Conversions = 0;
+		EXPECT_EQ(parse_expression(parser, source), parse_expression(lr_expression_parser(), source));
+
+		if constexpr (TRACE_ENABLED) {
+			EXPECT_GT(CountedValue::s_Conversions, 0);
+		}
+		else {
+			EXPECT_EQ(CountedValue::s_Conversions, 0);
+		}
+	}
+
+	TEST(LRParserTests, fed_tokens_parse_as_pulled_tokens) {
+		const LRExprParser& parser = lr_expression_parser();
+		const std::string source = "12+3*(45+6)*7";
+		const std::vector<LexedToken> tokens = read_expression_tokens(source);
+
+		LRExprParser::ParseContext ctx;
+		Result result;
+		EXPECT_THROW((void)parser.feed(ctx, tokens.front().first, result), std::logic_error);
+
+		// the parse is suspended after every token but the end of the input
+		parser.beginPush(ctx);
+		for (size_t i = 0; i + 1 < tokens.size(); i++)
+			ASSERT_EQ(parser.feed(ctx, tokens[i].first, result), PushStatus::PS_NEED_INPUT) << "token " << i;
+
+		EXPECT_EQ(parser.feed(ctx, tokens.back().first, result), PushStatus::PS_ACCEPTED);
+		EXPECT_TRUE(ctx.accepted);
+		EXPECT_EQ(result.value, parse_expression(parser, source));
+		EXPECT_THROW((void)parser.feed(ctx, tokens.back().first, result), std::logic_error);
+
+		// the context can be reused for another parse, which does not recover from errors
+		parser.beginPush(ctx);
+		EXPECT_EQ(parser.feed(ctx, tokens.front().first, result), PushStatus::PS_NEED_INPUT);
+		EXPECT_THROW((void)parser.feed(ctx, tokens.front().first, result), std::logic_error);
+	}
+
+	TEST(LRParserTests, fed_bytes_parse_as_pulled_tokens) {
+		const LRExprParser& parser = lr_expression_parser();
+
+		// a push-driven parse of a source, fed a piece of it at a time
+		struct Feed {
+			std::string source;
+			size_t pieceSize;
+			size_t fed = 0;
+			ChunkedInput input = ChunkedInput::pushed();
+			ExprLexer lexer{ input, ExprScanner{} };
+			LRExprParser::ParseContext ctx;
+			Result result;
+		};
+
+		std::vector<std::unique_ptr<Feed>> feeds;
+		for (const size_t pieceSize : { 1, 5, 333 }) {
+			feeds.push_back(std::make_unique<Feed>(make_expression_source(1 << 12), pieceSize));
+			parser.beginPush(feeds.back()->ctx);
+		}
+
+		// the parses are multiplexed on this thread, as the pieces of their sources arrive
+		for (size_t done = 0; done < feeds.size(); ) {
+			done = 0;
+
+			for (const std::unique_ptr<Feed>& feed : feeds) {
+				if (feed->fed == feed->source.size()) {
+					done++;
+					continue;
+				}
+
+				const std::string_view piece = std::string_view{ feed->source }.substr(feed->fed, feed->pieceSize);
+				feed->fed += piece.size();
+				feed->input.append(piece);
+
+				if (feed->fed == feed->source.size()) {
+					feed->input.finish();
+					EXPECT_EQ(parser.feed(feed->ctx, feed->lexer, feed->result), PushStatus::PS_ACCEPTED);
+				}
+				else
+					EXPECT_EQ(parser.feed(feed->ctx, feed->lexer, feed->result), PushStatus::PS_NEED_INPUT);
+			}
+		}
+
+		for (const std::unique_ptr<Feed>& feed : feeds)
+			EXPECT_EQ(feed->result.value, parse_expression(parser, feed->source)) << "pieces of " << feed->pieceSize << " bytes";
+	}
+
+}
@@ -0,0 +1,328 @@
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "parsix/LRTableBuilder.h"
+
+/**
+ * @file LRTableBuilderTests.cpp
+ * @brief Checks the tables constructed by LRTableBuilder against the tables of the textbook (the Dragon Book), for the expression grammar (see `make_lr_expression_grammar()`) and the grammar of assignments (see `make_assignment_grammar()`).
+ * @details The builder numbers its states in its own order, so tables are compared up to the numbering of their states (see `same_table()`); that order does not depend on the number of threads the tables are built on.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		/**
+		 * @brief Makes the SLR(1) table of the expression grammar, as constructed in the Dragon Book (Fig. 4.37), with the productions numbered as in `make_lr_expression_grammar()`.
+		 */
+		LRExprTable make_textbook_table() {
+			using enum ExprTerminal;
+			using enum ExprVariable;
+
+			LRExprTable table{ make_lr_expression_grammar() };
+			table.reserveRows(12);
+
+			for (size_t state : { 0, 4, 6, 7 }) {
+				table.atAction(state, T_ID) = TE_SHIFT(5);
+				table.atAction(state, T_LEFT_PAREN) = TE_SHIFT(4);
+			}
+
+			// the reductions on FOLLOW(E) and FOLLOW(T) = FOLLOW(F)
+			for (const auto& [state, prodNumber] : { std::pair<size_t, size_t>{ 2, 2 }, { 3, 4 }, { 5, 6 }, { 9, 1 }, { 10, 3 }, { 11, 5 } }) {
+				for (ExprTerminal terminal : { T_PLUS, T_RIGHT_PAREN, T_EOF })
+					table.atAction(state, terminal) = TE_REDUCE(prodNumber);
+
+				if (prodNumber >= 3)
+					table.atAction(state, T_STAR) = TE_REDUCE(prodNumber);
+			}
+
+			table.atAction(1, T_PLUS) = TE_SHIFT(6);
+			table.atAction(1, T_EOF) = TE_ACCEPT();
+			table.atAction(2, T_STAR) = TE_SHIFT(7);
+			table.atAction(8, T_PLUS) = TE_SHIFT(6);
+			table.atAction(8, T_RIGHT_PAREN) = TE_SHIFT(11);
+			table.atAction(9, T_STAR) = TE_SHIFT(7);
+
+			table.atGoto(0, NT_E) = TE_GOTO(1);
+			table.atGoto(0, NT_T) = TE_GOTO(2);
+			table.atGoto(0, NT_F) = TE_GOTO(3);
+			table.atGoto(4, NT_E) = TE_GOTO(8);
+			table.atGoto(4, NT_T) = TE_GOTO(2);
+			table.atGoto(4, NT_F) = TE_GOTO(3);
+			table.atGoto(6, NT_T) = TE_GOTO(9);
+			table.atGoto(6, NT_F) = TE_GOTO(3);
+			table.atGoto(7, NT_F) = TE_GOTO(10);
+
+			return table;
+		}
+
+		/**
+		 * @brief Checks that two tables are the same up to the numbering of their states.
+		 * @details The states of `expected` are matched with those of `actual` by following the shifts and the GOTOs from state 0 in both tables at once; every pair of matched states must have the same entries (with the states they lead to matched as well), and the matching must be one-to-one and cover both tables.
+		 */
+		template <typename TableT>
+		::testing::AssertionResult same_table(const TableT& expected, const TableT& actual) {
+			if (expected.getStateCount() != actual.getStateCount())
+				return ::testing::AssertionFailure() << std::format("The table has {} states instead of {}.", actual.getStateCount(), expected.getStateCount());
+
+			const size_t stateCount = expected.getStateCount();
+			std::vector<size_t> toActual(stateCount, SIZE_MAX), toExpected(stateCount, SIZE_MAX);
+			std::vector<size_t> pending{ 0 };
+			toActual[0] = toExpected[0] = 0;
+
+			const auto compare = [&](size_t state, const LRTableEntry& expectedEntry, const LRTableEntry& actualEntry, const std::string& symbol) -> ::testing::AssertionResult {
+				const std::string where = std::format("state {} (numbered {} by the builder) on `{}`", state, toActual[state], symbol);
+
+				if (expectedEntry.isError() || actualEntry.isError()) {
+					if (expectedEntry.isError() != actualEntry.isError())
+						return ::testing::AssertionFailure() << std::format("The entries of {} differ: `{}` instead of `{}`.", where, actualEntry.toString(), expectedEntry.toString());
+
+					return ::testing::AssertionSuccess();
+				}
+
+				if (expectedEntry.type != actualEntry.type)
+					return ::testing::AssertionFailure() << std::format("The entries of {} have different types.", where);
+
+				if (expectedEntry.type == LRTableEntryType::TET_ACTION_REDUCE && expectedEntry.number != actualEntry.number)
+					return ::testing::AssertionFailure() << std::format("The entry of {} reduces by production {} instead of {}.", where, actualEntry.number, expectedEntry.number);
+
+				if (expectedEntry.type != LRTableEntryType::TET_ACTION_SHIFT && expectedEntry.type != LRTableEntryType::TET_GOTO)
+					return ::testing::AssertionSuccess();
+
+				// match the states the entries lead to
+				const size_t target = expectedEntry.number, actualTarget = actualEntry.number;
+
+				if (toActual[target] == SIZE_MAX && toExpected[actualTarget] == SIZE_MAX) {
+					toActual[target] = actualTarget;
+					toExpected[actualTarget] = target;
+					pending.push_back(target);
+				}
+				else if (toActual[target] != actualTarget)
+					return ::testing::AssertionFailure() << std::format("The entry of {} leads to state {} instead of the state matching state {}.", where, actualTarget, target);
+
+				return ::testing::AssertionSuccess();
+			};
+
+			while (not pending.empty()) {
+				const size_t state = pending.back();
+				pending.pop_back();
+
+				for (size_t terminal = 0; terminal < TableT::TER_COUNT; terminal++)
+					if (::testing::AssertionResult res = compare(state, expected.actionTable[state][terminal], actual.actionTable[toActual[state]][terminal], toString((typename TableT::TerminalType)terminal)); not res)
+						return res;
+
+				for (size_t variable = 0; variable < TableT::VAR_COUNT; variable++)
+					if (::testing::AssertionResult res = compare(state, expected.gotoTable[state][variable], actual.gotoTable[toActual[state]][variable], toString((typename TableT::VariableType)variable)); not res)
+						return res;
+			}
+
+			for (size_t state = 0; state < stateCount; state++)
+				if (toActual[state] == SIZE_MAX)
+					return ::testing::AssertionFailure() << std::format("State {} is unreachable from state 0.", state);
+
+			return ::testing::AssertionSuccess();
+		}
+
+	}
+
+	TEST(LRTableBuilderTests, slr1_expression_table) {
+		LRTableBuilder<LRExprGrammar> builder{ make_lr_expression_grammar() };
+		const LRExprTable table = builder.build(LRTableType::LTT_SLR1);
+
+		EXPECT_FALSE(builder.hasConflicts());
+		EXPECT_EQ(builder.getStateCount(), 12);
+		EXPECT_TRUE(same_table(make_textbook_table(), table));
+	}
+
+	TEST(LRTableBuilderTests, lr0_expression_conflicts) {
+		LRTableBuilder<LRExprGrammar> builder{ make_lr_expression_grammar() };
+		const LRExprTable table = builder.build(LRTableType::LTT_LR0);
+
+		// E -> T. and E -> E + T. are reduced on every terminal, `*` included, where T -> T. * F shifts
+		EXPECT_EQ(builder.getStateCount(), 12);
+		ASSERT_EQ(builder.getConflicts().size(), 2);
+
+		for (const auto& conflict : builder.getConflicts()) {
+			EXPECT_TRUE(conflict.isShiftReduce());
+			EXPECT_EQ(conflict.terminal, ExprTerminal::T_STAR);
+			EXPECT_EQ(conflict.kept.type, LRTableEntryType::TET_ACTION_SHIFT);
+			EXPECT_EQ(table.actionTable[conflict.state][(size_t)ExprTerminal::T_STAR], conflict.kept);
+		}
+	}
+
+	TEST(LRTableBuilderTests, clr1_expression_states) {
+		LRTableBuilder<LRExprGrammar> builder{ make_lr_expression_grammar() };
+		const LRExprTable table = builder.build(LRTableType::LTT_CLR1);
+
+		// the 12 states of the LR(0) automaton, of which those reachable both inside and outside of parentheses are split by lookahead
+		EXPECT_FALSE(builder.hasConflicts());
+		EXPECT_EQ(builder.getStateCount(), 22);
+		EXPECT_EQ(table.getStateCount(), 22);
+
+		// a single state accepts
+		size_t acceptCount = 0;
+
+		for (size_t state = 0; state < table.getStateCount(); state++)
+			acceptCount += table.actionTable[state][(size_t)ExprTerminal::T_EOF].isAccept();
+
+		EXPECT_EQ(acceptCount, 1);
+	}
+
+	TEST(LRTableBuilderTests, lalr1_expression_table) {
+		LRTableBuilder<LRExprGrammar> builder{ make_lr_expression_grammar() };
+		const LRExprTable table = builder.build(LRTableType::LTT_LALR1);
+
+		// the grammar is SLR(1), and merging the states of its LR(1) automaton gives back its SLR(1) table
+		EXPECT_FALSE(builder.hasConflicts());
+		EXPECT_EQ(builder.getStateCount(), 12);
+		EXPECT_TRUE(same_table(make_textbook_table(), table));
+	}
+
+	TEST(LRTableBuilderTests, lalr1_assignment_grammar) {
+		const AssignGrammar grammar = make_assignment_grammar();
+
+		// SLR(1): `=` is in FOLLOW(R), so the state of S -> L . = R and R -> L . both shifts and reduces on it
+		LRTableBuilder<AssignGrammar> slr{ grammar };
+		(void)slr.build(LRTableType::LTT_SLR1);
+
+		ASSERT_EQ(slr.getConflicts().size(), 1);
+		EXPECT_TRUE(slr.getConflicts().front().isShiftReduce());
+		EXPECT_EQ(slr.getConflicts().front().terminal, AssignTerminal::T_EQUAL);
+
+		// LALR(1): the only lookahead of R -> L . in that state is `$`, and the states are those of the LR(0) automaton
+		LRTableBuilder<AssignGrammar> lalr{ grammar };
+		const LRParsingTable<AssignGrammar> table = lalr.build(LRTableType::LTT_LALR1);
+
+		EXPECT_FALSE(lalr.hasConflicts());
+		EXPECT_EQ(lalr.getStateCount(), slr.getStateCount());
+		EXPECT_EQ(lalr.getStateCount(), 10);
+		EXPECT_EQ(table.getStateCount(), 10);
+
+		// canonical LR(1): 4 states more, which have the cores of the states reached after `=`
+		LRTableBuilder<AssignGrammar> clr{ grammar };
+		(void)clr.build(LRTableType::LTT_CLR1);
+
+		EXPECT_FALSE(clr.hasConflicts());
+		EXPECT_EQ(clr.getStateCount(), 14);
+	}
+
+	TEST(LRTableBuilderTests, parallel_build_is_sequential_build) {
+		// the states are numbered deterministically, so the very same table is built on any number of threads
+		const GenGrammar grammar = make_generated_grammar(16);
+
+		for (LRTableType type : { LRTableType::LTT_SLR1, LRTableType::LTT_LALR1, LRTableType::LTT_CLR1 }) {
+			LRTableBuilder<GenGrammar> sequential{ grammar }, parallel{ grammar };
+			const LRParsingTable<GenGrammar> expected = sequential.build(type, 1);
+			const LRParsingTable<GenGrammar> actual = parallel.build(type, 4);
+
+			SCOPED_TRACE(toString(type));
+			EXPECT_EQ(parallel.getStateCount(), sequential.getStateCount());
+			EXPECT_EQ(parallel.getConflicts().size(), sequential.getConflicts().size());
+			EXPECT_TRUE(actual.actionTable == expected.actionTable);
+			EXPECT_TRUE(actual.gotoTable == expected.gotoTable);
+		}
+	}
+
+	TEST(LRTableBuilderTests, goto_targets_are_memoized) {
+		using enum ExprTerminal;
+		using enum ExprVariable;
+
+		// the memoized targets are those of the shifts and GOTOs of the table
+		LRTableBuilder<LRExprGrammar> builder{ make_lr_expression_grammar() };
+		const LRExprTable table = builder.build(LRTableType::LTT_LALR1);
+
+		for (size_t state = 0; state < builder.getStateCount(); state++) {
+			for (size_t index = 0; index < (size_t)T_COUNT; index++) {
+				const ExprTerminal term = (ExprTerminal)index;
+				const LRTableEntry& entry = table.view().atAction(state, term);
+				const size_t expected = entry.type == LRTableEntryType::TET_ACTION_SHIFT ? entry.number : SIZE_MAX;
+
+				EXPECT_EQ(builder.getGoto(state, terminal<ExprSymbol>(term)), expected) << std::format("state {} on `{}`", state, toString(term));
+			}
+
+			for (size_t index = 0; index < (size_t)NT_COUNT; index++) {
+				const ExprVariable var = (ExprVariable)index;
+				const LRTableEntry& entry = table.view().atGoto(state, var);
+				const size_t expected = entry.type == LRTableEntryType::TET_GOTO && not entry.isEmpty ? entry.number : SIZE_MAX;
+
+				EXPECT_EQ(builder.getGoto(state, variable<ExprSymbol>(var)), expected) << std::format("state {} on `{}`", state, toString(var));
+			}
+		}
+
+		EXPECT_EQ(builder.getGoto(builder.getStateCount(), terminal<ExprSymbol>(T_ID)), SIZE_MAX);
+
+		// conflict resolution does not affect the transitions: however the conflicts of the ambiguous grammar after `E + E` are resolved in the table, the transitions on `+` and `*` are kept
+		LRTableBuilder<LRExprGrammar> ambiguous{ make_ambiguous_expression_grammar() };
+		(void)ambiguous.build(LRTableType::LTT_LALR1);
+		EXPECT_TRUE(ambiguous.hasConflicts());
+
+		const size_t afterE = ambiguous.getGoto(0, variable<ExprSymbol>(NT_E));
+		const size_t afterPlus = ambiguous.getGoto(afterE, terminal<ExprSymbol>(T_PLUS));
+		const size_t afterSum = ambiguous.getGoto(afterPlus, variable<ExprSymbol>(NT_E));
+		ASSERT_NE(afterSum, SIZE_MAX);
+		EXPECT_NE(ambiguous.getGoto(afterSum, terminal<ExprSymbol>(T_PLUS)), SIZE_MAX);
+		EXPECT_NE(ambiguous.getGoto(afterSum, terminal<ExprSymbol>(T_STAR)), SIZE_MAX);
+	}
+
+	TEST(LRTableBuilderTests, frozen_table_is_viewed_as_is) {
+		using enum ExprTerminal;
+		using enum ExprVariable;
+
+		LRExprTable table = make_textbook_table();
+		table.freeze();
+
+		// the view has the very entries (and productions) of the table
+		const auto view = table.view();
+		for (size_t state = 0; state < table.getStateCount(); state++) {
+			for (size_t terminal = 0; terminal < (size_t)T_COUNT; terminal++)
+				EXPECT_EQ(&view.atAction(state, (ExprTerminal)terminal), &table.actionTable[state][terminal]);
+
+			for (size_t variable = 0; variable < (size_t)NT_COUNT; variable++)
+				EXPECT_EQ(&view.atGoto(state, (ExprVariable)variable), &table.gotoTable[state][variable]);
+		}
+
+		for (size_t prodNumber = 0; prodNumber < table.grammar.size(); prodNumber++)
+			EXPECT_EQ(&view.production(prodNumber), &table.grammar.at(prodNumber));
+
+		// freezing pads the Action and GOTO tables to the same number of rows
+		LRExprTable padded{ make_lr_expression_grammar() };
+		padded.atAction(0, T_ID) = TE_SHIFT(1);
+		padded.atGoto(3, NT_E) = TE_GOTO(2);
+		padded.freeze();
+		EXPECT_EQ(padded.actionTable.size(), 4);
+		EXPECT_EQ(padded.gotoTable.size(), 4);
+		EXPECT_EQ(padded.view().atAction(3, T_ID), LRTableEntry{});
+	}
+
+	TEST(LRTableBuilderTests, invalid_entries_are_not_frozen) {
+		using enum ExprTerminal;
+		using enum ExprVariable;
+
+		const auto freezeWith = [](auto set) {
+			LRExprTable table = make_textbook_table();
+			set(table);
+			table.freeze();
+		};
+
+		// states and productions out of range
+		EXPECT_THROW(freezeWith([](LRExprTable& table) { table.atAction(0, T_PLUS) = TE_SHIFT(12); }), std::logic_error);
+		EXPECT_THROW(freezeWith([](LRExprTable& table) { table.atAction(0, T_PLUS) = TE_REDUCE(7); }), std::logic_error);
+		EXPECT_THROW(freezeWith([](LRExprTable& table) { table.atGoto(0, NT_E) = TE_GOTO(12); }), std::logic_error);
+
+		// entries in the wrong table
+		EXPECT_THROW(freezeWith([](LRExprTable& table) { table.atAction(0, T_PLUS) = TE_GOTO(1); }), std::logic_error);
+		EXPECT_THROW(freezeWith([](LRExprTable& table) { table.atGoto(0, NT_E) = TE_SHIFT(1); }), std::logic_error);
+
+		// the last state and production are in range
+		EXPECT_NO_THROW(freezeWith([](LRExprTable& table) { table.atAction(0, T_PLUS) = TE_SHIFT(11); }));
+		EXPECT_NO_THROW(freezeWith([](LRExprTable& table) { table.atAction(0, T_PLUS) = TE_REDUCE(6); }));
+	}
+
+}
@@ -0,0 +1,97 @@
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "parsix/CompactItem.h"
+#include "parsix/Logging.h"
+
+/**
+ * @file LoggingTests.cpp
+ * @brief Checks that every parsix object logs through the one logger `get_logger()` returns, that `set_logger()` installs a program's own logger until the default one is restored, and that the logger can be swapped while parses run on other threads.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	// items carry no logger, so they are copied as plain values
+	static_assert(std::is_trivially_copyable_v<CompactItem>);
+
+	namespace {
+
+		/**
+		 * @brief Restores the default logger when a test ends, whether it passed or not.
+		 */
+		struct LoggerGuard {
+			~LoggerGuard() { set_logger(nullptr); }
+		};
+
+	}
+
+	TEST(LoggingTests, default_logger_is_shared) {
+		Logger* const logger = &get_logger();
+		EXPECT_EQ(&get_logger(), logger);
+
+		Logger* other = nullptr;
+		std::thread{ [&other] { other = &get_logger(); } }.join();
+		EXPECT_EQ(other, logger);
+	}
+
+	TEST(LoggingTests, installed_logger_is_used_until_reset) {
+		const LoggerGuard guard;
+		Logger* const defaultLogger = &get_logger();
+
+		Logger logger;
+		set_logger(&logger);
+		EXPECT_EQ(&get_logger(), &logger);
+
+		Logger* other = nullptr;
+		std::thread{ [&other] { other = &get_logger(); } }.join();
+		EXPECT_EQ(other, &logger);
+
+		// installing another logger replaces the first one, and nullptr brings back the default one
+		Logger second;
+		set_logger(&second);
+		EXPECT_EQ(&get_logger(), &second);
+
+		set_logger(nullptr);
+		EXPECT_EQ(&get_logger(), defaultLogger);
+	}
+
+	TEST(LoggingTests, logger_is_swapped_while_parses_run) {
+		constexpr size_t THREAD_COUNT = 4, PARSE_COUNT = 64;
+		const LoggerGuard guard;
+		const LRExprParser& parser = lr_expression_parser();
+
+		// an invalid expression is parsed, so that errors are logged while the logger is swapped
+		std::vector<size_t> errors(THREAD_COUNT);
+		std::vector<std::thread> threads;
+		for (size_t thread = 0; thread < THREAD_COUNT; thread++)
+			threads.emplace_back([&, thread] {
+				LRExprParser::ParseContext ctx;
+
+				for (size_t i = 0; i < PARSE_COUNT; i++) {
+					const std::string_view source = "12(34+5";
+					ChunkedInput input = ChunkedInput::view(source);
+					ExprLexer lexer{ input, ExprScanner{} };
+
+					(void)parser.parse(ctx, lexer, Result{}, ErrorRecoveryType::ERT_PANIC_MODE);
+					errors[thread] += ctx.errorNum;
+				}
+			});
+
+		Logger first, second;
+		for (size_t i = 0; i < 1000; i++)
+			set_logger(i % 3 == 0 ? nullptr : i % 3 == 1 ? &first : &second);
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		// `(` cannot follow `12`: every parse recovers from exactly one error, whichever logger reported it
+		for (size_t thread = 0; thread < THREAD_COUNT; thread++) {
+			EXPECT_EQ(errors[thread], PARSE_COUNT) << "thread " << thread;
+		}
+	}
+
+}
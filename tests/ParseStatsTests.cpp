@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "parsix/LLParser.h"
+#include "parsix/ParseStats.h"
+
+/**
+ * @file ParseStatsTests.cpp
+ * @brief Checks the statistics the LR and LL expression parsers collect into a ParseStats object against those of a known input.
+ * @details These tests are compiled (with the rest of the parsers they use) into their own executable, with `PARSIX_STATS=1` (see CMakeLists.txt).
+ */
+
+static_assert(m0st4fa::parsix::STATS_ENABLED, "ParseStatsTests must be compiled with `PARSIX_STATS=1`.");
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		using LLExprTable = LLParsingTable<LLExprGrammar, ExprTerminal, ExprVariable>;
+		using LLExprParser = LLParser<LLExprGrammar, ExprLexer, ExprSymbol, LLExprTable, fsm::FSMTable, std::string_view>;
+
+		/**
+		 * @brief The input all of the tests parse: 5 terminals, plus the end of the input. Its value is 1 + 1 * 1 (that of an identifier is its length).
+		 */
+		constexpr std::string_view SOURCE = "1+2*3";
+
+		/**
+		 * @brief Parses `source` with the LR expression parser, adding the statistics of the parse to `stats`.
+		 */
+		size_t lr_parse(std::string_view source, ParseStats& stats, ErrorRecoveryType errorRecoveryType = ErrorRecoveryType::ERT_NONE) {
+			ChunkedInput input = ChunkedInput::view(source);
+			ExprLexer lexer{ input, ExprScanner{} };
+			LRExprParser::ParseContext ctx;
+			ctx.stats = &stats;
+
+			return lr_expression_parser().parse(ctx, lexer, Result{}, errorRecoveryType).value;
+		}
+
+		/**
+		 * @brief Gets the number of depths recorded by the stack depth histogram of `stats`.
+		 */
+		uint64_t count_depths(const ParseStats& stats) {
+			return std::accumulate(stats.stackDepthHistogram.begin(), stats.stackDepthHistogram.end(), uint64_t{ 0 });
+		}
+
+	}
+
+	TEST(ParseStatsTests, lr_counts_shifts_and_reductions) {
+		ParseStats stats;
+		EXPECT_EQ(lr_parse(SOURCE, stats), 2);
+
+		// id + id * id: a shift per terminal; F -> id three times, T -> F twice, E -> T, T -> T * F and E -> E + T once each (production 0 is accepted, not reduced by)
+		EXPECT_EQ(stats.shifts, 5);
+		EXPECT_EQ(stats.reductions, 8);
+		EXPECT_EQ(stats.reductionsByProduction, (std::vector<uint64_t>{ 0, 1, 1, 1, 2, 0, 3 }));
+		EXPECT_EQ(stats.tokens, 6);
+		EXPECT_EQ(stats.expansions, 0);
+		EXPECT_EQ(stats.matches, 0);
+		EXPECT_EQ(stats.errorRecoveries, 0);
+
+		// the deepest stack is that of the shift of the last id: 0 E + T * id
+		EXPECT_EQ(stats.maxStackDepth, 6);
+		// a depth per push: the start state, the shifts and the reductions
+		EXPECT_EQ(count_depths(stats), 1 + 5 + 8);
+
+		// the counters accumulate over parses until they are reset
+		EXPECT_EQ(lr_parse(SOURCE, stats), 2);
+		EXPECT_EQ(stats.shifts, 10);
+		EXPECT_EQ(stats.reductions, 16);
+		EXPECT_EQ(stats.reductionsByProduction[6], 6);
+		EXPECT_EQ(stats.tokens, 12);
+		EXPECT_EQ(stats.maxStackDepth, 6);
+
+		stats.reset();
+		EXPECT_EQ(stats.shifts, 0);
+		EXPECT_EQ(stats.reductions, 0);
+		EXPECT_EQ(stats.reductionsByProduction, std::vector<uint64_t>(7, 0));
+		EXPECT_EQ(stats.tokens, 0);
+		EXPECT_EQ(stats.maxStackDepth, 0);
+		EXPECT_EQ(count_depths(stats), 0);
+	}
+
+	TEST(ParseStatsTests, ll_counts_expansions_and_matches) {
+		const LLExprParser parser{ variable<ExprSymbol>(ExprVariable::NT_E), LLExprParser::prepareTable(make_ll_table<LLExprTable>(make_ll_expression_grammar())), g_ExprLexer };
+		ChunkedInput input = ChunkedInput::view(SOURCE);
+		ExprLexer lexer{ input, ExprScanner{} };
+		ParseStats stats;
+		LLExprParser::ParseContext ctx;
+		ctx.stats = &stats;
+
+		(void)parser.parse<Result>(ctx, lexer, ErrorRecoveryType::ERT_NONE);
+
+		// E and T twice each, F three times, then E_TAIL -> + T E_TAIL, T_TAIL -> * F T_TAIL, and T_TAIL and E_TAIL by epsilon at the end of their terms
+		EXPECT_EQ(stats.expansions, 11);
+		EXPECT_EQ(stats.matches, 5);
+		EXPECT_EQ(stats.tokens, 6);
+		EXPECT_EQ(stats.shifts, 0);
+		EXPECT_EQ(stats.reductions, 0);
+		EXPECT_EQ(stats.errorRecoveries, 0);
+		// a depth per expansion, plus that of the start symbol
+		EXPECT_EQ(count_depths(stats), 1 + 11);
+	}
+
+	TEST(ParseStatsTests, error_recoveries_are_counted) {
+		ParseStats stats;
+
+		// the missing `)` of "12(34+5" is recovered from once, skipping `(` and `34`
+		EXPECT_EQ(lr_parse("12(34+5", stats, ErrorRecoveryType::ERT_PANIC_MODE), 1);
+		EXPECT_EQ(stats.errorRecoveries, 1);
+		EXPECT_EQ(stats.tokens, 6);
+
+		// merging adds the counters of the parses up
+		ParseStats total;
+		ParseStats valid;
+		EXPECT_EQ(lr_parse(SOURCE, valid), 2);
+		total.merge(stats);
+		total.merge(valid);
+		EXPECT_EQ(total.shifts, stats.shifts + valid.shifts);
+		EXPECT_EQ(total.reductions, stats.reductions + valid.reductions);
+		EXPECT_EQ(total.tokens, 12);
+		EXPECT_EQ(total.errorRecoveries, 1);
+		EXPECT_EQ(total.maxStackDepth, std::max(stats.maxStackDepth, valid.maxStackDepth));
+		EXPECT_EQ(count_depths(total), count_depths(stats) + count_depths(valid));
+	}
+
+}
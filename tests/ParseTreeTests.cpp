@@ -0,0 +1,147 @@
+#include <cstring>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+
+/**
+ * @file ParseTreeTests.cpp
+ * @brief Checks the parse trees an LRParser builds of expressions, by evaluating them as the semantic actions do, and that trees are saved to and loaded from streams unchanged, while invalid trees and streams are rejected.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		/**
+		 * @brief Evaluates the parse tree of an expression as the actions of the LR expression grammar do (see `make_expression_actions()`).
+		 */
+		size_t evaluate_expression(const ParseTree& tree) {
+			return tree.evaluate<size_t>([](const ParseTreeNode& node, std::span<size_t> children) -> size_t {
+				if (node.isTerminal())
+					return node.terminal() == (uint32_t)ExprTerminal::T_ID ? node.length : 0;
+
+				switch (node.production()) {
+				case 1: // E -> E + T
+					return children[0] + children[2];
+				case 3: // T -> T * F
+					return children[0] * children[2];
+				case 5: // F -> ( E )
+					return children[1];
+				default: // E -> T; T -> F; F -> id
+					return children[0];
+				}
+				});
+		}
+
+		/**
+		 * @brief Saves a tree to a string.
+		 */
+		std::string save_tree(const ParseTree& tree) {
+			std::ostringstream stream{ std::ios::binary };
+			tree.save(stream);
+
+			return std::move(stream).str();
+		}
+
+		/**
+		 * @brief Loads a tree from a string.
+		 */
+		ParseTree load_tree(const std::string& bytes) {
+			std::istringstream stream{ bytes, std::ios::binary };
+
+			return ParseTree::load(stream);
+		}
+
+	}
+
+	TEST(ParseTreeTests, lr_parse_tree) {
+		const std::string source = make_expression_source(1 << 12);
+		ParseTree tree;
+		const size_t value = parse_expression(lr_expression_parser(), source, &tree);
+
+		ASSERT_FALSE(tree.hasFailed());
+		ASSERT_FALSE(tree.empty());
+		EXPECT_EQ(evaluate_expression(tree), value);
+
+		// the root is the node of E (the augmented production is not part of the tree), and spans the whole expression
+		const ParseTreeNode& root = tree[tree.root()];
+		EXPECT_EQ(root.production(), 1);
+		EXPECT_EQ(root.subtreeSize, tree.size());
+		EXPECT_EQ(root.offset, 0);
+		EXPECT_EQ(source.substr(root.offset + root.length).find_first_not_of(" \t\r\n"), std::string::npos);
+
+		// every leaf of an identifier spans its digits
+		for (const ParseTreeNode& node : tree)
+			if (node.isTerminal() && node.terminal() == (uint32_t)ExprTerminal::T_ID) {
+				ASSERT_GT(node.length, 0);
+				EXPECT_EQ(source.substr(node.offset, node.length).find_first_not_of("0123456789"), std::string::npos) << "at offset " << node.offset;
+			}
+	}
+
+	TEST(ParseTreeTests, save_load_round_trip) {
+		ParseTree tree;
+		const size_t value = parse_expression(lr_expression_parser(), make_expression_source(1 << 16), &tree);
+
+		const ParseTree loaded = load_tree(save_tree(tree));
+
+		EXPECT_EQ(loaded, tree);
+		EXPECT_EQ(evaluate_expression(loaded), value);
+	}
+
+	TEST(ParseTreeTests, invalid_streams_are_rejected) {
+		ParseTree tree;
+		(void)parse_expression(lr_expression_parser(), "12+3*(45+6)", &tree);
+		const std::string bytes = save_tree(tree);
+		constexpr size_t HEADER_SIZE = 24, NODE_COUNT_OFFSET = 16;
+
+		EXPECT_THROW(load_tree(""), std::runtime_error);
+		EXPECT_THROW(load_tree("not a parse tree, but long enough"), std::runtime_error);
+
+		// truncated
+		EXPECT_THROW(load_tree(bytes.substr(0, bytes.size() - 1)), std::runtime_error);
+		EXPECT_THROW(load_tree(bytes.substr(0, HEADER_SIZE - 1)), std::runtime_error);
+
+		// another version
+		std::string version = bytes;
+		version[12]++;
+		EXPECT_THROW(load_tree(version), std::runtime_error);
+
+		// two roots: the nodes of the tree twice
+		std::string twoRoots = bytes + bytes.substr(HEADER_SIZE);
+		const uint64_t nodeCount = 2 * tree.size();
+		std::memcpy(twoRoots.data() + NODE_COUNT_OFFSET, &nodeCount, sizeof(nodeCount));
+		EXPECT_THROW(load_tree(twoRoots), std::runtime_error);
+
+		// a root with more children than there are subtrees
+		std::string malformed = bytes;
+		ParseTreeNode root;
+		std::memcpy(&root, malformed.data() + malformed.size() - sizeof(root), sizeof(root));
+		root.childCount += 2;
+		std::memcpy(malformed.data() + malformed.size() - sizeof(root), &root, sizeof(root));
+		EXPECT_THROW(load_tree(malformed), std::runtime_error);
+	}
+
+	TEST(ParseTreeTests, incomplete_trees_are_not_saved) {
+		ParseTree tree;
+		std::ostringstream stream{ std::ios::binary };
+
+		// two subtrees without a parent
+		tree.addLeaf((uint32_t)ExprTerminal::T_ID, 0, 1);
+		tree.addLeaf((uint32_t)ExprTerminal::T_PLUS, 1, 1);
+		EXPECT_THROW(tree.save(stream), std::logic_error);
+
+		tree.fail();
+		EXPECT_TRUE(tree.hasFailed());
+		EXPECT_THROW(tree.save(stream), std::logic_error);
+
+		// a syntax error fails the tree being built
+		tree.clear();
+		EXPECT_THROW(parse_expression(lr_expression_parser(), "1+*2", &tree), std::logic_error);
+		EXPECT_THROW(tree.save(stream), std::logic_error);
+	}
+
+}
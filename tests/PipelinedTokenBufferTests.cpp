@@ -0,0 +1,112 @@
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "parsix/PipelinedTokenBuffer.h"
+
+/**
+ * @file PipelinedTokenBufferTests.cpp
+ * @brief Checks that a PipelinedTokenBuffer returns the tokens of the lexical analyzer it wraps, whatever the sizes of its batches and of its ring, that its lookahead is bounded by the ring, that the exceptions of the lexical analyzer are rethrown at the token they were thrown for, and that it can be destroyed before the end of the input.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		using PipelinedExprLexer = PipelinedTokenBuffer<ExprLexer>;
+
+		constexpr size_t BATCH_SIZES[] = { 1, 2, 3 };
+		constexpr size_t BATCH_COUNTS[] = { 2, 4 };
+
+	}
+
+	TEST(PipelinedTokenBufferTests, tokens_are_lexer_tokens) {
+		const std::string source = make_expression_source(1 << 12);
+		const std::vector<LexedToken> expected = read_expression_tokens(source);
+
+		for (const size_t batchSize : BATCH_SIZES)
+			for (const size_t batchCount : BATCH_COUNTS) {
+				ChunkedInput input = ChunkedInput::view(source);
+				ExprLexer lexer{ input, ExprScanner{} };
+				PipelinedExprLexer tokens{ lexer, batchSize, batchCount };
+
+				EXPECT_EQ(read_tokens(tokens), expected) << batchSize << " tokens per batch, " << batchCount << " batches";
+
+				// past `TEOF`, it is `TEOF`
+				EXPECT_EQ(tokens.getNextToken(), expected.back().first);
+				EXPECT_EQ(tokens.index(), expected.size() - 1);
+			}
+	}
+
+	TEST(PipelinedTokenBufferTests, lookahead_is_bounded_by_the_ring) {
+		const std::string source = make_expression_source(1 << 10);
+		const std::vector<LexedToken> expected = read_expression_tokens(source);
+
+		for (const size_t batchSize : BATCH_SIZES)
+			for (const size_t batchCount : BATCH_COUNTS) {
+				ChunkedInput input = ChunkedInput::view(source);
+				ExprLexer lexer{ input, ExprScanner{} };
+				PipelinedExprLexer tokens{ lexer, batchSize, batchCount };
+
+				for (size_t consumed = 0; consumed < 64; consumed++) {
+					const size_t k = tokens.maxLookahead();
+
+					ASSERT_GE(k, batchCount - 1);
+					EXPECT_EQ(tokens.at(k), expected[consumed + k].first) << consumed << " tokens consumed";
+					EXPECT_THROW((void)tokens.at(k + 1), std::out_of_range) << consumed << " tokens consumed";
+					EXPECT_EQ(tokens.getNextToken(), expected[consumed].first);
+				}
+			}
+	}
+
+	TEST(PipelinedTokenBufferTests, lexer_errors_are_rethrown_at_their_token) {
+		// `#` cannot be scanned: the lexical analyzer throws for the fifth token
+		const std::string source = "12+3*#+4";
+		ChunkedInput directInput = ChunkedInput::view(source);
+		ExprLexer direct{ directInput, ExprScanner{} };
+		std::vector<ExprToken> expected;
+
+		for (size_t i = 0; i < 4; i++)
+			expected.push_back(direct.getNextToken());
+
+		ASSERT_THROW((void)direct.getNextToken(), std::runtime_error);
+
+		for (const size_t batchSize : BATCH_SIZES)
+			for (const size_t batchCount : BATCH_COUNTS) {
+				ChunkedInput input = ChunkedInput::view(source);
+				ExprLexer lexer{ input, ExprScanner{} };
+				PipelinedExprLexer tokens{ lexer, batchSize, batchCount };
+
+				for (const ExprToken& token : expected) {
+					EXPECT_EQ(tokens.getNextToken(), token);
+
+					if (tokens.maxLookahead() >= 4 - tokens.index()) {
+						EXPECT_THROW((void)tokens.at(4 - tokens.index()), std::runtime_error);
+					}
+				}
+
+				EXPECT_THROW((void)tokens.peak(), std::runtime_error);
+				EXPECT_THROW((void)tokens.getNextToken(), std::runtime_error);
+				EXPECT_EQ(tokens.index(), 4);
+			}
+	}
+
+	TEST(PipelinedTokenBufferTests, destroyed_before_the_end) {
+		const std::string source = make_expression_source(1 << 16);
+
+		for (const size_t consumed : { 0, 1, 5 })
+			for (const size_t batchSize : BATCH_SIZES) {
+				ChunkedInput input = ChunkedInput::view(source);
+				ExprLexer lexer{ input, ExprScanner{} };
+
+				// the producer fills the ring and waits for a free slot, until the buffer is destroyed
+				PipelinedExprLexer tokens{ lexer, batchSize, 2 };
+
+				for (size_t i = 0; i < consumed; i++)
+					(void)tokens.getNextToken();
+			}
+	}
+
+}
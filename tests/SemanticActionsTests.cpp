@@ -0,0 +1,74 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "parsix/SemanticActions.h"
+
+/**
+ * @file SemanticActionsTests.cpp
+ * @brief Checks that an LRActionTable calls the action of the production it is given (and no other), and only calls the action of production 0 on acceptance.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		using Stack = std::vector<size_t>;
+
+		/**
+		 * @brief Makes an action that records the number of its production in `calls`.
+		 */
+		auto record(std::vector<size_t>& calls, size_t prodNumber) {
+			return [&calls, prodNumber](Stack&, size_t&) { calls.push_back(prodNumber); };
+		}
+
+	}
+
+	TEST(SemanticActionsTests, reductions_call_the_action_of_their_production) {
+		std::vector<size_t> calls;
+		size_t accepted = 0;
+		const LRActionTable actions{
+			[&accepted](Stack&, size_t&, Result&) { accepted++; },
+			record(calls, 1),
+			NoAction{},
+			record(calls, 3)
+		};
+		static_assert(decltype(actions)::ACTION_COUNT == 4);
+
+		Stack stack;
+		size_t newState = 0;
+		for (size_t prodNumber : { 3, 1, 2, 4, 100, 1 })
+			actions.reduce(prodNumber, stack, newState);
+
+		// production 2 has no action, and neither do the productions after the last action
+		EXPECT_EQ(calls, (std::vector<size_t>{ 3, 1, 1 }));
+
+		// the action of production 0 only runs on acceptance
+		actions.reduce(0, stack, newState);
+		EXPECT_EQ(accepted, 0);
+
+		calls.clear();
+		actions.reduceProduction<3>(stack, newState);
+		actions.reduceProduction<2>(stack, newState);
+		actions.reduceProduction<7>(stack, newState);
+		EXPECT_EQ(calls, std::vector<size_t>{ 3 });
+	}
+
+	TEST(SemanticActionsTests, acceptance_calls_the_action_of_production_0) {
+		Stack stack;
+		size_t newState = 0;
+		Result result;
+
+		const LRActionTable actions{ [](Stack& stack, size_t&, Result& result) { result.value = stack.size(); }, NoAction{} };
+		stack.resize(3);
+		EXPECT_TRUE(actions.accept(stack, newState, result));
+		EXPECT_EQ(result.value, 3);
+
+		// without an action for production 0, there is nothing to call
+		result.value = 0;
+		EXPECT_FALSE(LRActionTable{ NoAction{} }.accept(stack, newState, result));
+		EXPECT_FALSE(LRActionTable<>{}.accept(stack, newState, result));
+		EXPECT_EQ(result.value, 0);
+	}
+
+}
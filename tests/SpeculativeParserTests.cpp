@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "parsix/SpeculativeParser.h"
+
+/**
+ * @file SpeculativeParserTests.cpp
+ * @brief Checks that parsing an expression in parallel with a SpeculativeParser, split after its `+` operators, gives the result (or the error) of a sequential parse.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		using SpeculativeExprParser = SpeculativeParser<LRExprParser>;
+
+		/**
+		 * @brief Adds the value of the real sum a chunk was parsed on in place of its guess to the value of the sum it reduced it to.
+		 */
+		void merge_sum(std::span<const ExprState> reduced, ExprState& state) {
+			state.data.value += reduced.front().data.value;
+		}
+
+		/**
+		 * @brief Gets the tokens of an expression, ending with `TEOF`.
+		 */
+		std::vector<ExprToken> lex_expression(std::string_view source) {
+			ChunkedInput input = ChunkedInput::view(source);
+			ExprLexer lexer{ input, ExprScanner{} };
+			std::vector<ExprToken> tokens;
+
+			do
+				tokens.push_back(lexer.getNextToken());
+			while (tokens.back().name != ExprTerminal::T_EOF);
+
+			return tokens;
+		}
+
+		/**
+		 * @brief Gets the message of the std::logic_error thrown by `parse`; empty if it throws none.
+		 */
+		template <typename ParseT>
+		std::string logic_error_of(ParseT&& parse) {
+			try {
+				(void)parse();
+			}
+			catch (const std::logic_error& error) {
+				return error.what();
+			}
+
+			return {};
+		}
+
+	}
+
+	TEST(SpeculativeParserTests, speculative_parse_is_sequential_parse) {
+		const SpeculativeExprParser parser{ lr_expression_parser(), { ExprTerminal::T_PLUS }, 4, 4 };
+		SpeculativeExprParser::ParseContext ctx;
+
+		for (const size_t size : { size_t{ 1 } << 10, size_t{ 1 } << 16, size_t{ 1 } << 18 }) {
+			const std::string source = make_expression_source(size);
+			const std::vector<ExprToken> tokens = lex_expression(source);
+
+			EXPECT_EQ(parser.parse(ctx, tokens, Result{}, merge_sum).value, parse_expression(lr_expression_parser(), source)) << source.size() << " bytes";
+
+			// inputs of less than MIN_CHUNK_TOKENS tokens per chunk are split into fewer chunks
+			EXPECT_EQ(ctx.chunkCount, std::min<size_t>(std::max<size_t>(tokens.size() / SpeculativeExprParser::MIN_CHUNK_TOKENS, 1), 4));
+
+			// the lines of the expression are alike, so every guess holds, and the chunks are stitched together with the merge function
+			EXPECT_EQ(ctx.reparsedChunks, 0);
+		}
+	}
+
+	TEST(SpeculativeParserTests, invalid_input_is_rejected) {
+		const SpeculativeExprParser parser{ lr_expression_parser(), { ExprTerminal::T_PLUS }, 4, 4 };
+		SpeculativeExprParser::ParseContext ctx;
+
+		// the error is in the last chunk
+		std::string source = make_expression_source(1 << 16);
+		source.insert(source.rfind('+'), "+");
+		const std::vector<ExprToken> tokens = lex_expression(source);
+
+		const std::string expected = logic_error_of([&] { return parse_expression(lr_expression_parser(), source); });
+		ASSERT_FALSE(expected.empty());
+		EXPECT_EQ(logic_error_of([&] { return parser.parse(ctx, tokens, Result{}, merge_sum); }), expected);
+		EXPECT_GT(ctx.chunkCount, 1);
+
+		// the tokens must end with TEOF
+		EXPECT_THROW((void)parser.parse(ctx, std::span{ tokens }.first(tokens.size() - 1), Result{}, merge_sum), std::invalid_argument);
+	}
+
+}
@@ -0,0 +1,82 @@
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "parsix/StaticLRTable.h"
+
+/**
+ * @file StaticLRTableTests.cpp
+ * @brief Checks the SLR(1) table of the expression grammar constructed at compile time (see `buildStaticLRTable()`): its entries are checked with `static_assert`, and an LRParser specialized on it parses as the LR expression parser does.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		using enum ExprTerminal;
+		using enum ExprVariable;
+
+		constexpr ExprSymbol T(ExprTerminal terminal) { return ExprSymbol{ .isTerminal = true, .as {.terminal = terminal } }; }
+		constexpr ExprSymbol N(ExprVariable variable) { return ExprSymbol{ .isTerminal = false, .as {.nonTerminal = variable } }; }
+
+		using ExprProduction = StaticProduction<ExprSymbol, 3>;
+
+		/**
+		 * @brief The expression grammar, with the productions numbered as in `make_lr_expression_grammar()`.
+		 */
+		constexpr StaticGrammar EXPRESSION_GRAMMAR{
+			ExprProduction{ N(NT_EP), { N(NT_E) } },
+			ExprProduction{ N(NT_E), { N(NT_E), T(T_PLUS), N(NT_T) } },
+			ExprProduction{ N(NT_E), { N(NT_T) } },
+			ExprProduction{ N(NT_T), { N(NT_T), T(T_STAR), N(NT_F) } },
+			ExprProduction{ N(NT_T), { N(NT_F) } },
+			ExprProduction{ N(NT_F), { T(T_LEFT_PAREN), N(NT_E), T(T_RIGHT_PAREN) } },
+			ExprProduction{ N(NT_F), { T(T_ID) } }
+		};
+
+		constexpr auto EXPRESSION_TABLE = buildStaticLRTable<EXPRESSION_GRAMMAR>();
+
+		// the table of the Dragon Book (Fig. 4.37), up to the numbering of the states
+		static_assert(EXPRESSION_TABLE.getStateCount() == 12);
+		static_assert(EXPRESSION_TABLE.getConflictCount() == 0);
+
+		constexpr size_t AFTER_E = EXPRESSION_TABLE.atGoto(0, NT_E).number;
+		constexpr size_t AFTER_ID = EXPRESSION_TABLE.atAction(0, T_ID).number;
+		constexpr size_t AFTER_E_PLUS = EXPRESSION_TABLE.atAction(AFTER_E, T_PLUS).number;
+		constexpr size_t AFTER_E_PLUS_T = EXPRESSION_TABLE.atGoto(AFTER_E_PLUS, NT_T).number;
+
+		static_assert(EXPRESSION_TABLE.atAction(0, T_ID).type == LRTableEntryType::TET_ACTION_SHIFT);
+		static_assert(EXPRESSION_TABLE.atAction(0, T_PLUS).isError());
+		static_assert(EXPRESSION_TABLE.atAction(AFTER_E, T_EOF) == TE_ACCEPT());
+		static_assert(EXPRESSION_TABLE.atAction(AFTER_E, T_PLUS).type == LRTableEntryType::TET_ACTION_SHIFT);
+
+		// F -> id is reduced on FOLLOW(F) = { +, *, ), $ } only
+		static_assert(EXPRESSION_TABLE.atAction(AFTER_ID, T_PLUS) == TE_REDUCE(6));
+		static_assert(EXPRESSION_TABLE.atAction(AFTER_ID, T_STAR) == TE_REDUCE(6));
+		static_assert(EXPRESSION_TABLE.atAction(AFTER_ID, T_RIGHT_PAREN) == TE_REDUCE(6));
+		static_assert(EXPRESSION_TABLE.atAction(AFTER_ID, T_EOF) == TE_REDUCE(6));
+		static_assert(EXPRESSION_TABLE.atAction(AFTER_ID, T_ID).isError());
+
+		// E -> E + T is reduced on FOLLOW(E) = { +, ), $ }; `*` is shifted
+		static_assert(EXPRESSION_TABLE.atAction(AFTER_E_PLUS_T, T_PLUS) == TE_REDUCE(1));
+		static_assert(EXPRESSION_TABLE.atAction(AFTER_E_PLUS_T, T_RIGHT_PAREN) == TE_REDUCE(1));
+		static_assert(EXPRESSION_TABLE.atAction(AFTER_E_PLUS_T, T_EOF) == TE_REDUCE(1));
+		static_assert(EXPRESSION_TABLE.atAction(AFTER_E_PLUS_T, T_STAR).type == LRTableEntryType::TET_ACTION_SHIFT);
+
+		using StaticExprTable = StaticLRTableRef<EXPRESSION_TABLE>;
+		using StaticExprParser = LRParser<std::remove_cvref_t<decltype(EXPRESSION_GRAMMAR)>, ExprLexer, ExprSymbol, ExprState, StaticExprTable, fsm::FSMTable, std::string, ExprActions>;
+
+	}
+
+	TEST(StaticLRTableTests, static_parser_is_lr_parser) {
+		const StaticExprParser parser{ g_ExprLexer, StaticExprTable{}, variable<ExprSymbol>(NT_EP), make_expression_actions() };
+
+		for (const std::string& source : { std::string{ "12+3*(45+6)" }, make_expression_source(1 << 12), make_expression_source(1 << 16) })
+			EXPECT_EQ(parse_expression(parser, source), parse_expression(lr_expression_parser(), source));
+
+		EXPECT_THROW((void)parse_expression(parser, "12+*3"), std::logic_error);
+	}
+
+}
@@ -0,0 +1,123 @@
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+
+/**
+ * @file StreamingLexerTests.cpp
+ * @brief Checks that reading an expression through a streamed (or mapped) ChunkedInput gives the tokens and the parse of reading it from memory, that the window of a streamed input stays bounded by its chunk size and the history of the lexer, and that the text of a token can be got while it is within the history.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		/**
+		 * @brief Makes an expression spread over many lines, so that the positions of its tokens are checked as well.
+		 */
+		std::string make_multiline_source(size_t size) {
+			std::string res = make_expression_source(size);
+
+			for (size_t offset = res.find('+'); offset != std::string::npos; offset = res.find('+', offset + 40))
+				res.insert(offset + 1, "\n  ");
+
+			return res;
+		}
+
+		/**
+		 * @brief Makes a streamed input of `source`, read `chunkSize` bytes at a time.
+		 */
+		ChunkedInput make_streamed(const std::string& source, size_t chunkSize) {
+			return ChunkedInput{ std::make_unique<std::istringstream>(source), chunkSize };
+		}
+
+		/**
+		 * @brief A file that is removed when the object is destroyed.
+		 */
+		struct TemporaryFile {
+			std::filesystem::path path;
+
+			TemporaryFile(const std::string& name, const std::string& contents) : path{ std::filesystem::temp_directory_path() / name } {
+				std::ofstream{ this->path, std::ios::binary } << contents;
+			}
+
+			~TemporaryFile() {
+				std::error_code error;
+				std::filesystem::remove(this->path, error);
+			}
+		};
+
+	}
+
+	TEST(StreamingLexerTests, streamed_tokens_are_viewed_tokens) {
+		constexpr size_t HISTORY = 256;
+		const std::string source = make_multiline_source(1 << 16);
+		const std::vector<LexedToken> expected = read_expression_tokens(source);
+
+		for (size_t chunkSize : { 1, 7, 4096 }) {
+			ChunkedInput input = make_streamed(source, chunkSize);
+			ExprLexer lexer{ input, ExprScanner{}, HISTORY };
+
+			SCOPED_TRACE(std::format("chunks of {} bytes", chunkSize));
+			EXPECT_EQ(read_tokens(lexer), expected);
+
+			// only the history and the chunk being read are kept, however large the source
+			EXPECT_LE(input.capacity(), 4 * (HISTORY + chunkSize));
+		}
+	}
+
+	TEST(StreamingLexerTests, text_is_kept_within_the_history) {
+		constexpr size_t HISTORY = 64;
+		const std::string source = make_multiline_source(1 << 12);
+		ChunkedInput input = make_streamed(source, 16);
+		ExprLexer lexer{ input, ExprScanner{}, HISTORY };
+
+		const ExprToken first = lexer.getNextToken();
+		EXPECT_EQ(lexer.text(first), source.substr(first.offset, first.length));
+
+		// the last token is still there, while the first one has long been dropped
+		ExprToken last = first;
+		while (last.offset < source.size() / 2)
+			last = lexer.getNextToken();
+
+		EXPECT_EQ(lexer.text(last), source.substr(last.offset, last.length));
+		EXPECT_THROW((void)lexer.text(first), std::out_of_range);
+	}
+
+	TEST(StreamingLexerTests, streamed_parse_is_viewed_parse) {
+		const std::string source = make_multiline_source(1 << 16);
+		const size_t expected = parse_expression(lr_expression_parser(), source);
+
+		ChunkedInput input = make_streamed(source, 1024);
+		ExprLexer lexer{ input, ExprScanner{}, 256 };
+		LRExprParser::ParseContext ctx;
+		EXPECT_EQ(lr_expression_parser().parse(ctx, lexer, Result{}).value, expected);
+	}
+
+	TEST(StreamingLexerTests, files_are_streamed_or_mapped) {
+		const std::string source = make_multiline_source(1 << 14);
+		const TemporaryFile file{ "parsix_streaming_lexer_tests.txt", source };
+		const std::vector<LexedToken> expected = read_expression_tokens(source);
+
+		ChunkedInput streamed = ChunkedInput::open(file.path, 512);
+		ExprLexer streamedLexer{ streamed, ExprScanner{} };
+		EXPECT_EQ(read_tokens(streamedLexer), expected);
+
+		ChunkedInput mapped = ChunkedInput::map(file.path);
+		EXPECT_EQ(mapped.window(), source);
+		ExprLexer mappedLexer{ mapped, ExprScanner{} };
+		EXPECT_EQ(read_tokens(mappedLexer), expected);
+
+		EXPECT_THROW((void)ChunkedInput::open(file.path.string() + ".missing"), std::runtime_error);
+		EXPECT_THROW((ChunkedInput{ nullptr }), std::invalid_argument);
+		EXPECT_THROW((ChunkedInput{ std::make_unique<std::istringstream>(source), 0 }), std::invalid_argument);
+	}
+
+}
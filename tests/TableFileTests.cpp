@@ -0,0 +1,143 @@
+#include <filesystem>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "parsix/LRTableBuilder.h"
+#include "parsix/TableFile.h"
+
+/**
+ * @file TableFileTests.cpp
+ * @brief Checks that the LR and LL tables saved to table files are loaded back unchanged, that a parser using a mapped table parses as one using the table it was saved from, and that invalid files are rejected.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		using LRJsonTable = LRParsingTable<LRJsonGrammar>;
+		using LLJsonTable = LLParsingTable<LLJsonGrammar, JsonTerminal, JsonVariable>;
+
+		using MappedExprTable = MappedLRTable<ExprSymbol>;
+		using MappedExprParser = LRParser<MappedExprTable::GrammarType, ExprLexer, ExprSymbol, ExprState, MappedExprTable, fsm::FSMTable, std::string, ExprActions>;
+
+		/**
+		 * @brief A file of the temporary directory, removed when the object is destroyed.
+		 */
+		struct TemporaryFile {
+			std::filesystem::path path;
+
+			explicit TemporaryFile(std::string_view name) : path{ std::filesystem::temp_directory_path() / std::format("parsix_tests_{}.tbl", name) } {}
+
+			~TemporaryFile() {
+				std::error_code error;
+				std::filesystem::remove(this->path, error);
+			}
+		};
+
+	}
+
+	TEST(TableFileTests, lr_table_round_trip) {
+		LRTableBuilder<LRJsonGrammar> builder{ make_lr_json_grammar() };
+		LRJsonTable table = builder.build(LRTableType::LTT_LALR1);
+		table.freeze();
+
+		const TemporaryFile file{ "lr_table_round_trip" };
+		saveLRTable(table, file.path);
+		const MappedLRTable<JsonSymbol> mapped{ file.path };
+
+		ASSERT_EQ(mapped.getStateCount(), table.getStateCount());
+
+		for (size_t state = 0; state < table.getStateCount(); state++) {
+			for (size_t terminal = 0; terminal < LRJsonTable::TER_COUNT; terminal++) {
+				const LRTableEntry& expected = table.actionTable[state][terminal];
+				const LRTableEntry actual = mapped.atAction(state, (JsonTerminal)terminal);
+
+				EXPECT_EQ(actual.isError(), expected.isError()) << std::format("state {}, terminal {}", state, terminal);
+				if (not expected.isError()) {
+					EXPECT_EQ(actual, expected) << std::format("state {}, terminal {}", state, terminal);
+				}
+			}
+
+			for (size_t variable = 0; variable < LRJsonTable::VAR_COUNT; variable++) {
+				const LRTableEntry& expected = table.gotoTable[state][variable];
+				const LRTableEntry actual = mapped.atGoto(state, (JsonVariable)variable);
+
+				EXPECT_EQ(actual.isError(), expected.isError()) << std::format("state {}, variable {}", state, variable);
+				if (not expected.isError()) {
+					EXPECT_EQ(actual, expected) << std::format("state {}, variable {}", state, variable);
+				}
+			}
+		}
+
+		// the metadata of the productions
+		ASSERT_EQ(mapped.grammar.size(), table.grammar.size());
+
+		for (size_t prodNumber = 0; prodNumber < table.grammar.size(); prodNumber++) {
+			EXPECT_EQ(mapped.grammar[prodNumber].prodHead, table.grammar[prodNumber].prodHead);
+			EXPECT_EQ(mapped.grammar[prodNumber].size(), table.grammar[prodNumber].prodBody.size());
+		}
+	}
+
+	TEST(TableFileTests, mapped_table_parses) {
+		const TemporaryFile file{ "mapped_table_parses" };
+		saveLRTable(LRTableBuilder<LRExprGrammar>{ make_lr_expression_grammar() }.build(LRTableType::LTT_LALR1), file.path);
+
+		const MappedExprParser parser{ g_ExprLexer, MappedExprParser::prepareTable(MappedExprTable{ file.path }), variable<ExprSymbol>(ExprVariable::NT_EP), make_expression_actions() };
+
+		for (const std::string& source : { std::string{ "1" }, std::string{ "12+3*(45+6)" }, make_expression_source(1 << 12) })
+			EXPECT_EQ(parse_expression(parser, source), parse_expression(lr_expression_parser(), source));
+
+		EXPECT_THROW(parse_expression(parser, "1+*2"), std::logic_error);
+	}
+
+	TEST(TableFileTests, ll_table_round_trip) {
+		LLJsonTable table = make_ll_table<LLJsonTable>(make_ll_json_grammar());
+		table.freeze();
+
+		const TemporaryFile file{ "ll_table_round_trip" };
+		saveLLTable(table, file.path);
+		const LLJsonTable loaded = loadLLTable<LLJsonTable>(file.path, make_ll_json_grammar());
+
+		for (size_t variable = 0; variable < (size_t)JsonVariable::NT_COUNT; variable++)
+			for (size_t terminal = 0; terminal < (size_t)JsonTerminal::T_COUNT; terminal++) {
+				const LLTableEntry& expected = table.table[variable][terminal];
+				const LLTableEntry& actual = loaded.table[variable][terminal];
+
+				EXPECT_EQ(actual.isError, expected.isError) << std::format("variable {}, terminal {}", variable, terminal);
+				EXPECT_EQ(actual.isEmpty, expected.isEmpty) << std::format("variable {}, terminal {}", variable, terminal);
+				if (not expected.isError) {
+					EXPECT_EQ(actual.prodIndex, expected.prodIndex) << std::format("variable {}, terminal {}", variable, terminal);
+				}
+			}
+
+		// the synchronization sets are calculated again when the table is frozen
+		for (size_t variable = 0; variable < (size_t)JsonVariable::NT_COUNT; variable++)
+			EXPECT_EQ(loaded.syncSets[variable].words(), table.syncSets[variable].words());
+	}
+
+	TEST(TableFileTests, invalid_files_are_rejected) {
+		const TemporaryFile lrFile{ "invalid_files_are_rejected_lr" }, llFile{ "invalid_files_are_rejected_ll" };
+		saveLRTable(LRTableBuilder<LRExprGrammar>{ make_lr_expression_grammar() }.build(LRTableType::LTT_LALR1), lrFile.path);
+		saveLLTable(make_ll_table<LLJsonTable>(make_ll_json_grammar()), llFile.path);
+
+		// a table of other symbols, or of another kind
+		EXPECT_THROW(MappedLRTable<JsonSymbol>{ lrFile.path }, std::runtime_error);
+		EXPECT_THROW(MappedLRTable<JsonSymbol>{ llFile.path }, std::runtime_error);
+		EXPECT_THROW(loadLLTable<LLJsonTable>(lrFile.path, make_ll_json_grammar()), std::runtime_error);
+
+		// a table of another grammar
+		LLJsonGrammar other = make_ll_json_grammar();
+		push_production(other, variable<JsonSymbol>(JsonVariable::NT_VALUE), { terminal<JsonSymbol>(JsonTerminal::T_COLON) });
+		EXPECT_THROW(loadLLTable<LLJsonTable>(llFile.path, other), std::runtime_error);
+
+		// a truncated file
+		std::filesystem::resize_file(lrFile.path, std::filesystem::file_size(lrFile.path) - 8);
+		EXPECT_THROW(MappedExprTable{ lrFile.path }, std::runtime_error);
+	}
+
+}
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "fixtures.h"
+#include "parsix/TokenBuffer.h"
+
+/**
+ * @file TokenBufferTests.cpp
+ * @brief Checks that a TokenBuffer returns the tokens (and positions) of the lexical analyzer it wraps, also when its ring grows for a lookahead, that `peak(k)` looks `k` tokens ahead, and that an exception of the lexical analyzer is rethrown at the token it was thrown for, not when the batch of that token is lexed.
+ */
+
+namespace m0st4fa::parsix::test {
+
+	namespace {
+
+		using BufferedExprLexer = TokenBuffer<ExprLexer>;
+
+		constexpr size_t BATCH_SIZES[] = { 1, 3, 64 };
+
+	}
+
+	TEST(TokenBufferTests, tokens_are_lexer_tokens) {
+		const std::string source = make_expression_source(1 << 12);
+		const std::vector<LexedToken> expected = read_expression_tokens(source);
+
+		for (const size_t batchSize : BATCH_SIZES) {
+			ChunkedInput input = ChunkedInput::view(source);
+			ExprLexer lexer{ input, ExprScanner{} };
+			BufferedExprLexer tokens{ lexer, batchSize };
+
+			EXPECT_EQ(read_tokens(tokens), expected) << batchSize << " tokens per batch";
+
+			// past `TEOF`, it is `TEOF`
+			EXPECT_EQ(tokens.getNextToken(), expected.back().first);
+			EXPECT_EQ(tokens.index(), expected.size() - 1);
+		}
+	}
+
+	TEST(TokenBufferTests, tokens_are_kept_when_the_ring_grows) {
+		const std::string source = make_expression_source(1 << 12);
+		const std::vector<LexedToken> expected = read_expression_tokens(source);
+
+		for (const size_t batchSize : BATCH_SIZES) {
+			ChunkedInput input = ChunkedInput::view(source);
+			ExprLexer lexer{ input, ExprScanner{} };
+			const auto start = lexer.getPosition();
+			BufferedExprLexer tokens{ lexer, batchSize };
+			std::vector<LexedToken> actual;
+
+			// every lookahead is longer than the previous one, so that the ring grows again and again
+			for (size_t lookahead = 1; actual.empty() || actual.back().first.name != ExprTerminal::T_EOF; lookahead++) {
+				(void)tokens.peak(lookahead * 3);
+				ASSERT_EQ(tokens.getPosition(), actual.empty() ? start : actual.back().second);
+
+				const ExprToken token = tokens.getNextToken();
+				actual.emplace_back(token, tokens.getPosition());
+			}
+
+			EXPECT_EQ(actual, expected) << batchSize << " tokens per batch";
+		}
+	}
+
+	TEST(TokenBufferTests, peak_looks_ahead) {
+		const std::string source = make_expression_source(1 << 10);
+		const std::vector<LexedToken> expected = read_expression_tokens(source);
+
+		for (const size_t batchSize : BATCH_SIZES) {
+			ChunkedInput input = ChunkedInput::view(source);
+			ExprLexer lexer{ input, ExprScanner{} };
+			BufferedExprLexer tokens{ lexer, batchSize };
+
+			for (size_t consumed = 0; consumed < expected.size(); consumed++) {
+				for (const size_t k : { 0, 1, 7, 40 }) {
+					// past `TEOF`, it is `TEOF`
+					ASSERT_EQ(tokens.peak(k), expected[std::min(consumed + k, expected.size() - 1)].first) << consumed << " tokens consumed, " << k << " tokens ahead";
+					ASSERT_EQ(tokens.index(), consumed);
+				}
+
+				const ExprToken next = tokens.peak();
+				EXPECT_EQ(tokens.getNextToken(), next);
+			}
+		}
+	}
+
+	TEST(TokenBufferTests, lexer_errors_are_rethrown_at_their_token) {
+		// `#` cannot be scanned: the lexical analyzer throws for the fifth token
+		const std::string source = "12+3*#+4";
+		ChunkedInput directInput = ChunkedInput::view(source);
+		ExprLexer direct{ directInput, ExprScanner{} };
+		std::vector<ExprToken> expected;
+
+		for (size_t i = 0; i < 4; i++)
+			expected.push_back(direct.getNextToken());
+
+		ASSERT_THROW((void)direct.getNextToken(), std::runtime_error);
+
+		for (const size_t batchSize : BATCH_SIZES) {
+			ChunkedInput input = ChunkedInput::view(source);
+			ExprLexer lexer{ input, ExprScanner{} };
+			BufferedExprLexer tokens{ lexer, batchSize };
+
+			// the tokens before it are returned, even if the exception was thrown while lexing their batch
+			EXPECT_EQ(tokens.peak(3), expected[3]) << batchSize << " tokens per batch";
+
+			for (const ExprToken& token : expected)
+				EXPECT_EQ(tokens.getNextToken(), token) << batchSize << " tokens per batch";
+
+			EXPECT_THROW((void)tokens.peak(), std::runtime_error) << batchSize << " tokens per batch";
+			EXPECT_THROW((void)tokens.getNextToken(), std::runtime_error) << batchSize << " tokens per batch";
+			EXPECT_EQ(tokens.index(), 4);
+		}
+	}
+
+}
@@ -0,0 +1,76 @@
+#include <array>
+
+#include "fixtures.h"
+#include "parsix/LRTableBuilder.h"
+
+// SYMBOL NAMES
+std::string toString(AssignTerminal terminal)
+{
+	static constexpr std::array<const char*, (size_t)AssignTerminal::T_COUNT> names{ "id", "*", "=", "$", "epsilon" };
+
+	return names.at((size_t)terminal);
+}
+
+std::string toString(AssignVariable variable)
+{
+	static constexpr std::array<const char*, (size_t)AssignVariable::NT_COUNT> names{ "S'", "S", "L", "R" };
+
+	return names.at((size_t)variable);
+}
+
+namespace m0st4fa::parsix::test {
+
+	/**
+	 * @brief Makes the (augmented) grammar of assignments of the Dragon Book (Example 4.48), which is LALR(1) but not SLR(1):
+	 * @details S' -> S; S -> L = R | R; L -> * R | id; R -> L.
+	 */
+	AssignGrammar make_assignment_grammar()
+	{
+		using enum AssignTerminal;
+		using enum AssignVariable;
+		const auto T = terminal<AssignSymbol, AssignTerminal>;
+		const auto N = variable<AssignSymbol, AssignVariable>;
+
+		AssignGrammar grammar;
+		push_production(grammar, N(NT_SP), { N(NT_S) });
+		push_production(grammar, N(NT_S), { N(NT_L), T(T_EQUAL), N(NT_R) });
+		push_production(grammar, N(NT_S), { N(NT_R) });
+		push_production(grammar, N(NT_L), { T(T_STAR), N(NT_R) });
+		push_production(grammar, N(NT_L), { T(T_ID) });
+		push_production(grammar, N(NT_R), { N(NT_L) });
+
+		return grammar;
+	}
+
+	/**
+	 * @brief Makes the (augmented) ambiguous expression grammar, without the precedence and associativity of the operators:
+	 * @details E' -> E; E -> E + E | E * E | ( E ) | id.
+	 */
+	LRExprGrammar make_ambiguous_expression_grammar()
+	{
+		using enum ExprTerminal;
+		using enum ExprVariable;
+		const auto T = terminal<ExprSymbol, ExprTerminal>;
+		const auto N = variable<ExprSymbol, ExprVariable>;
+
+		LRExprGrammar grammar;
+		push_production(grammar, N(NT_EP), { N(NT_E) });
+		push_production(grammar, N(NT_E), { N(NT_E), T(T_PLUS), N(NT_E) });
+		push_production(grammar, N(NT_E), { N(NT_E), T(T_STAR), N(NT_E) });
+		push_production(grammar, N(NT_E), { T(T_LEFT_PAREN), N(NT_E), T(T_RIGHT_PAREN) });
+		push_production(grammar, N(NT_E), { T(T_ID) });
+
+		return grammar;
+	}
+
+	/**
+	 * @brief Gets the LR expression parser, whose table is the LALR(1) table of the expression grammar.
+	 */
+	const LRExprParser& lr_expression_parser()
+	{
+		static const LRExprParser parser{ g_ExprLexer, LRExprParser::prepareTable(LRTableBuilder<LRExprGrammar>{ make_lr_expression_grammar() }.build(LRTableType::LTT_LALR1)), variable<ExprSymbol>(ExprVariable::NT_EP), make_expression_actions() };
+
+		return parser;
+	}
+
+}
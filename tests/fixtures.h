@@ -0,0 +1,158 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @file fixtures.h
+ * @brief The grammars of the tests of `ParsixTests` that the benchmarks do not have (those of the benchmarks are reused; see grammars.h), and the LR expression parser most tests use.
+ * @details As in bench.h, the grammar symbols (and their `toString()` functions) are declared before any parsix header is included.
+ */
+
+// ASSIGNMENT GRAMMAR SYMBOLS
+enum class AssignTerminal {
+	T_ID,
+	T_STAR,
+	T_EQUAL,
+	T_EOF,
+	T_EPSILON,
+	T_COUNT
+};
+
+enum class AssignVariable {
+	NT_SP,
+	NT_S,
+	NT_L,
+	NT_R,
+	NT_COUNT
+};
+
+std::string toString(AssignTerminal);
+std::string toString(AssignVariable);
+
+#include "grammars.h"
+#include "parsix/LRParser.h"
+#include "parsix/ParseTree.h"
+
+namespace m0st4fa::parsix::test {
+
+	using namespace bench;
+
+	// GRAMMARS
+	using AssignSymbol = Symbol<AssignTerminal, AssignVariable>;
+	using AssignGrammar = LRGrammarType<AssignSymbol>;
+
+	AssignGrammar make_assignment_grammar();
+	LRExprGrammar make_ambiguous_expression_grammar();
+
+	// LR EXPRESSION PARSER
+	using ExprToken = OffsetToken<ExprTerminal>;
+	using ExprState = LRState<Value, ExprToken>;
+	using ExprStack = LRStackType<Value, ExprToken>;
+
+	/**
+	 * @brief The actions of the LR expression grammar, which evaluate the expression. The value of an identifier is its length, so that no value depends on where its text is.
+	 * @tparam StackT The type of the parsing stack; its states (of type `StateT`) hold data with a `value` member.
+	 */
+	template <typename StackT = ExprStack, typename StateT = ExprState>
+	constexpr auto make_expression_actions() {
+		constexpr auto passLast = [](StackT& stack, StateT& newState) { newState.data = stack.back().data; };
+
+		return LRActionTable{
+			[](StackT& stack, StateT&, Result& result) { result.value = stack.back().data.value; },
+			[](StackT& stack, StateT& newState) { newState.data.value = stack.at(stack.size() - 3).data.value + stack.back().data.value; },
+			passLast,
+			[](StackT& stack, StateT& newState) { newState.data.value = stack.at(stack.size() - 3).data.value * stack.back().data.value; },
+			passLast,
+			[](StackT& stack, StateT& newState) { newState.data = stack.at(stack.size() - 2).data; },
+			[](StackT& stack, StateT& newState) { newState.data.value = stack.back().token.length; }
+		};
+	}
+
+	using ExprActions = decltype(make_expression_actions());
+
+	using LRExprTable = LRParsingTable<LRExprGrammar>;
+	using LRExprParser = LRParser<LRExprGrammar, ExprLexer, ExprSymbol, ExprState, LRExprTable, fsm::FSMTable, std::string, ExprActions>;
+
+	/**
+	 * @brief The lexical analyzer the parsers are constructed with; it is never used, since every parse is given its own.
+	 */
+	inline ExprLexer g_ExprLexer;
+
+	const LRExprParser& lr_expression_parser();
+
+	/**
+	 * @brief A token of an expression, and the position of the lexical analyzer after it.
+	 */
+	using LexedToken = std::pair<ExprToken, std::pair<size_t, size_t>>;
+
+	/**
+	 * @brief Reads the tokens of an expression (up to `TEOF`, included) by calling `getNextToken()` until it returns `TEOF`, with the position after each of them.
+	 * @tparam LexerT An ExprLexer, or a buffer of its tokens (e.g., a TokenBuffer).
+	 * @throws Whatever `lexer` throws.
+	 */
+	template <typename LexerT>
+	std::vector<LexedToken> read_tokens(LexerT& lexer) {
+		std::vector<LexedToken> res;
+
+		do {
+			const ExprToken token = lexer.getNextToken();
+			res.emplace_back(token, lexer.getPosition());
+		} while (res.back().first.name != ExprTerminal::T_EOF);
+
+		return res;
+	}
+
+	/**
+	 * @brief Reads the tokens of an expression and the positions after them with an ExprLexer (see `read_tokens()`).
+	 */
+	inline std::vector<LexedToken> read_expression_tokens(std::string_view source) {
+		ChunkedInput input = ChunkedInput::view(source);
+		ExprLexer lexer{ input, ExprScanner{} };
+
+		return read_tokens(lexer);
+	}
+
+	/**
+	 * @brief An expression lexical analyzer that passes every token it returns to `onToken`, so that a test can look at the context of a parse while it runs.
+	 */
+	struct ObservedExprLexer : ExprLexer {
+
+		/**
+		 * @brief Called with every token returned by `getNextToken()`, before the parser gets it.
+		 */
+		std::function<void(const ExprToken&)> onToken;
+
+		using ExprLexer::ExprLexer;
+
+		ExprToken getNextToken(unsigned flags = 0) {
+			const ExprToken token = ExprLexer::getNextToken(flags);
+
+			if (this->onToken)
+				this->onToken(token);
+
+			return token;
+		}
+	};
+
+	/**
+	 * @brief Parses an expression with an LR expression parser, reading it through a StreamingLexer.
+	 * @param[in] parser The parser.
+	 * @param[in] source The expression.
+	 * @param[out] tree The parse tree to build, if any.
+	 * @returns The value of the expression.
+	 * @throws std::logic_error If the expression is invalid.
+	 */
+	template <typename ParserT>
+	size_t parse_expression(const ParserT& parser, std::string_view source, ParseTree* tree = nullptr) {
+		ChunkedInput input = ChunkedInput::view(source);
+		ExprLexer lexer{ input, ExprScanner{} };
+		typename ParserT::ParseContext ctx;
+		ctx.tree = tree;
+
+		return parser.parse(ctx, lexer, Result{}).value;
+	}
+
+}
@@ -0,0 +1,32 @@
+#include <cstdio>
+#include <exception>
+
+#include "grammars.h"
+#include "parsix/LRCodeGenerator.h"
+#include "parsix/LRTableBuilder.h"
+
+/**
+ * @file generate_expression_parser.cpp
+ * @brief Generates the parser of the LALR(1) table of the expression grammar (see `make_lr_expression_grammar()`) with LRCodeGenerator, into the header given as the first argument. `ParsixTests` is compiled with that header (see LRCodeGeneratorTests.cpp).
+ */
+
+int main(int argc, char** argv) {
+	using namespace m0st4fa::parsix;
+	using namespace m0st4fa::parsix::bench;
+
+	if (argc != 2) {
+		std::fprintf(stderr, "Usage: %s <header>\n", argv[0]);
+		return 1;
+	}
+
+	try {
+		const LRCodeGenerator<LRExprGrammar> generator{ LRTableBuilder<LRExprGrammar>{ make_lr_expression_grammar() }.build(LRTableType::LTT_LALR1) };
+		generator.generate(argv[1], { .namespaceName = "m0st4fa::parsix::test::generated", .className = "ExprParser" });
+	}
+	catch (const std::exception& e) {
+		std::fprintf(stderr, "%s\n", e.what());
+		return 1;
+	}
+
+	return 0;
+}